@@ -35,7 +35,8 @@ namespace Jazz2
 		_currentAnimationState(AnimState::Uninitialized),
 		_currentTransitionState(AnimState::Idle),
 		_currentTransitionCancellable(false),
-		CollisionProxyID(Collisions::NullNode)
+		CollisionProxyID(Collisions::NullNode),
+		RendererProxyID(Collisions::NullNode)
 	{
 	}
 
@@ -438,7 +439,8 @@ namespace Jazz2
 			return _levelHandler->PlaySfx(it->second.Buffers[idx].get(), Vector3f(_pos.X, _pos.Y, 0.0f), gain, pitch);
 		} else {
 			//LOGE_X("Sound effect \"%s\" was not found", identifier.data());
-			return std::shared_ptr<AudioBufferPlayer>(nullptr);
+			static const std::shared_ptr<AudioBufferPlayer> NoSound;
+			return NoSound;
 		}
 	}
 
@@ -1250,6 +1252,15 @@ namespace Jazz2
 		return Sprite::OnDraw(renderQueue);
 	}
 
+	Rectf ActorBase::SpriteRenderer::GetUpdatedAabb()
+	{
+		if (dirtyBits_.test(DirtyBitPositions::AabbBit)) {
+			updateAabb();
+			dirtyBits_.reset(DirtyBitPositions::AabbBit);
+		}
+		return aabb_;
+	}
+
 	void ActorBase::SpriteRenderer::UpdateVisibleFrames()
 	{
 		// Calculate visible frames
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "ActorStore.h"
 #include "ContentResolver.h"
 #include "EventType.h"
 #include "LightEmitter.h"
@@ -81,6 +82,9 @@ namespace Jazz2
 		friend class LevelHandler;
 
 	public:
+		/// Largest distance of the far edge of emitted lights from the actor position (lights of players reach 110 pixels)
+		static constexpr float MaxLightReach = 110.0f;
+
 		ActorBase();
 		~ActorBase();
 
@@ -89,10 +93,14 @@ namespace Jazz2
 		AABBf AABB;
 		AABBf AABBInner;
 		int32_t CollisionProxyID;
+		/// Proxy of the renderer in the culling tree of the level
+		int32_t RendererProxyID;
+		ActorHandle Handle;
 
 		void SetParent(SceneNode* parent);
 		Task<bool> OnActivated(const ActorActivationDetails& details);
 		virtual bool OnHandleCollision(ActorBase* other);
+		/// Emits lights of the actor, far edge of any light must not be farther than `MaxLightReach` from the actor position
 		virtual void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) { }
 
 		bool IsInvulnerable();
@@ -157,6 +165,13 @@ namespace Jazz2
 			void OnUpdate(float timeMult) override;
 			bool OnDraw(RenderQueue& renderQueue) override;
 
+			/// Returns bounds of the renderer after the transformation of this frame
+			Rectf GetUpdatedAabb();
+			/// Checks bounds against the current viewport, renderers are culled by the level instead of viewports
+			void UpdateCulling() {
+				updateCulling();
+			}
+
 			bool IsAnimationRunning()
 			{
 				if (FrameCount <= 0) {
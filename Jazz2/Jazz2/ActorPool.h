@@ -0,0 +1,148 @@
+﻿#pragma once
+
+#include "../Common.h"
+#include "../nCine/Base/AllocManager.h"
+#include "../nCine/Base/PoolAllocator.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2
+{
+	struct ActorPoolStats {
+		/// Number of blocks served from the pool
+		uint32_t Pooled;
+		/// Number of blocks requested from the actors allocator, because the pool was full
+		uint32_t Overflowed;
+		/// Number of blocks currently owned by live actors
+		uint32_t InUse;
+		/// Number of free blocks in the pool
+		uint32_t Free;
+	};
+
+	/// Keeps track of all actor pools, so their memory can be released together
+	class ActorPools
+	{
+	public:
+		/// Releases memory of all unused pools, it should be called when a level is unloaded
+		static void TrimAll()
+		{
+			for (auto trim : _trimFunctions) {
+				trim();
+			}
+		}
+
+	private:
+		template<typename T> friend class ActorPool;
+
+		static inline SmallVector<void(*)(), 0> _trimFunctions;
+	};
+
+	/// Recycles memory of high-churn actor types
+	/*! Actors are still constructed and destroyed normally, so the constructor acts as the reset hook,
+	 *  only the memory block (including the shared pointer control block) is allocated from a fixed-size pool. */
+	template<typename T>
+	class ActorPool
+	{
+	public:
+		/// Number of blocks in the pool, the rest is allocated from the actors allocator
+		static constexpr uint32_t BlocksPerPool = 128;
+
+		template<typename... Args>
+		static std::shared_ptr<T> Create(Args&&... args)
+		{
+			return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+		}
+
+		static const ActorPoolStats& Stats() {
+			return _stats;
+		}
+
+		/// Releases memory of the pool if no block is in use
+		static void Trim()
+		{
+			if (_pool != nullptr && _pool->numAllocations() == 0) {
+				delete _pool;
+				_pool = nullptr;
+				_stats.Free = 0;
+			}
+		}
+
+	private:
+		template<typename U>
+		struct Allocator {
+			using value_type = U;
+
+			Allocator() noexcept { }
+			template<typename V>
+			Allocator(const Allocator<V>&) noexcept { }
+
+			template<typename V>
+			struct rebind {
+				using other = Allocator<V>;
+			};
+
+			U* allocate(std::size_t n)
+			{
+				// Only single objects allocated by std::allocate_shared() are pooled, all have the same size
+				if (n == 1) {
+					if (_pool == nullptr) {
+						_pool = new PoolAllocator("Actor pool", sizeof(U), BlocksPerPool, alignof(U));
+						_stats.Free = BlocksPerPool;
+						if (!_registered) {
+							_registered = true;
+							ActorPools::_trimFunctions.push_back(&Trim);
+						}
+					}
+
+					void* block = _pool->allocate(sizeof(U), alignof(U));
+					if (block != nullptr) {
+						_stats.InUse++;
+						_stats.Pooled++;
+						_stats.Free--;
+						return static_cast<U*>(block);
+					}
+				}
+
+				void* block = theActorsAllocator().allocate(n * sizeof(U), alignof(U));
+				FATAL_ASSERT_MSG_X(block != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", theActorsAllocator().name(), n * sizeof(U));
+				if (n == 1) {
+					_stats.InUse++;
+					_stats.Overflowed++;
+				}
+				return static_cast<U*>(block);
+			}
+
+			void deallocate(U* p, std::size_t n) noexcept
+			{
+				if (n == 1) {
+					_stats.InUse--;
+					if (_pool != nullptr && _pool->owns(p)) {
+						_pool->deallocate(p);
+						_stats.Free++;
+						return;
+					}
+				}
+				theActorsAllocator().deallocate(p);
+			}
+
+			template<typename V>
+			bool operator==(const Allocator<V>&) const noexcept {
+				return true;
+			}
+			template<typename V>
+			bool operator!=(const Allocator<V>&) const noexcept {
+				return false;
+			}
+		};
+
+		/// Pool is never destroyed while any block is in use, so blocks can be released even during static destruction
+		static inline PoolAllocator* _pool = nullptr;
+		static inline ActorPoolStats _stats { };
+		static inline bool _registered = false;
+	};
+}
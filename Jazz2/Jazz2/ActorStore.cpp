@@ -0,0 +1,59 @@
+﻿#include "ActorStore.h"
+#include "ActorBase.h"
+
+namespace Jazz2
+{
+	ActorHandle ActorStore::Add(const std::shared_ptr<ActorBase>& actor)
+	{
+		uint32_t slotIndex;
+		if (!_freeSlots.empty()) {
+			slotIndex = _freeSlots.back();
+			_freeSlots.pop_back();
+		} else {
+			slotIndex = (uint32_t)_slots.size();
+			_slots.push_back({ ActorHandle::NullIndex, 0 });
+		}
+
+		Slot& slot = _slots[slotIndex];
+		slot.DenseIndex = (uint32_t)_actors.size();
+		_actors.push_back(actor);
+		_denseToSlot.push_back(slotIndex);
+
+		ActorHandle handle(slotIndex, slot.Generation);
+		actor->Handle = handle;
+		return handle;
+	}
+
+	ActorBase* ActorStore::Get(ActorHandle handle) const
+	{
+		if (handle.Index >= _slots.size()) {
+			return nullptr;
+		}
+
+		const Slot& slot = _slots[handle.Index];
+		if (slot.Generation != handle.Generation || slot.DenseIndex == ActorHandle::NullIndex) {
+			return nullptr;
+		}
+
+		return _actors[slot.DenseIndex].get();
+	}
+
+	void ActorStore::Clear()
+	{
+		for (uint32_t i = 0; i < _denseToSlot.size(); i++) {
+			ReleaseSlot(_denseToSlot[i]);
+		}
+
+		_actors.clear();
+		_denseToSlot.clear();
+	}
+
+	void ActorStore::ReleaseSlot(uint32_t slotIndex)
+	{
+		Slot& slot = _slots[slotIndex];
+		slot.DenseIndex = ActorHandle::NullIndex;
+		// Bumping the generation invalidates all outstanding handles to this slot
+		slot.Generation++;
+		_freeSlots.push_back(slotIndex);
+	}
+}
@@ -0,0 +1,100 @@
+﻿#pragma once
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2
+{
+	class ActorBase;
+
+	/// Weak reference to an actor that stays valid (but resolves to nothing) after the actor is removed
+	struct ActorHandle {
+		uint32_t Index;
+		uint32_t Generation;
+
+		static constexpr uint32_t NullIndex = UINT32_MAX;
+
+		constexpr ActorHandle() : Index(NullIndex), Generation(0) { }
+		constexpr ActorHandle(uint32_t index, uint32_t generation) : Index(index), Generation(generation) { }
+
+		constexpr bool IsNull() const {
+			return (Index == NullIndex);
+		}
+
+		constexpr bool operator==(const ActorHandle& other) const {
+			return (Index == other.Index && Generation == other.Generation);
+		}
+		constexpr bool operator!=(const ActorHandle& other) const {
+			return !operator==(other);
+		}
+	};
+
+	/// Actor storage with generational handles, actors are kept densely packed in insertion order
+	class ActorStore
+	{
+	public:
+		ActorHandle Add(const std::shared_ptr<ActorBase>& actor);
+		/// Returns the actor referenced by the handle or `nullptr` if it was already removed
+		ActorBase* Get(ActorHandle handle) const;
+		void Clear();
+
+		/// Removes all actors matching the predicate in a single pass, the order of remaining actors is preserved
+		template<typename Predicate>
+		void RemoveAll(Predicate&& predicate)
+		{
+			uint32_t count = (uint32_t)_actors.size();
+			uint32_t target = 0;
+			for (uint32_t i = 0; i < count; i++) {
+				if (predicate(_actors[i])) {
+					ReleaseSlot(_denseToSlot[i]);
+					continue;
+				}
+				if (target != i) {
+					_actors[target] = std::move(_actors[i]);
+					_denseToSlot[target] = _denseToSlot[i];
+					_slots[_denseToSlot[target]].DenseIndex = target;
+				}
+				target++;
+			}
+
+			if (target != count) {
+				_actors.erase(_actors.begin() + target, _actors.end());
+				_denseToSlot.erase(_denseToSlot.begin() + target, _denseToSlot.end());
+			}
+		}
+
+		std::size_t size() const {
+			return _actors.size();
+		}
+		bool empty() const {
+			return _actors.empty();
+		}
+
+		const std::shared_ptr<ActorBase>& operator[](std::size_t index) const {
+			return _actors[index];
+		}
+
+		auto begin() const {
+			return _actors.begin();
+		}
+		auto end() const {
+			return _actors.end();
+		}
+
+	private:
+		struct Slot {
+			uint32_t DenseIndex;
+			uint32_t Generation;
+		};
+
+		SmallVector<std::shared_ptr<ActorBase>, 0> _actors;
+		SmallVector<uint32_t, 0> _denseToSlot;
+		SmallVector<Slot, 0> _slots;
+		SmallVector<uint32_t, 0> _freeSlots;
+
+		void ReleaseSlot(uint32_t slotIndex);
+	};
+}
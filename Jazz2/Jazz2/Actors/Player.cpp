@@ -1,5 +1,6 @@
 ﻿#include "Player.h"
 #include "../ILevelHandler.h"
+#include "../ActorPool.h"
 #include "../Events/EventMap.h"
 #include "../Tiles/TileMap.h"
 #include "SolidObjectBase.h"
@@ -1961,7 +1962,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<T> shot = std::make_shared<T>();
+		std::shared_ptr<T> shot = ActorPool<T>::Create();
 		uint8_t shotParams[1] = { _weaponUpgrades[(int)weaponType] };
 		shot->OnActivated({
 			.LevelHandler = _levelHandler,
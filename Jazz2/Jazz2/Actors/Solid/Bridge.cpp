@@ -102,10 +102,10 @@ namespace Jazz2::Actors::Solid
 				float texScaleY = (float(_currentAnimation->Base->FrameDimensions.Y) / float(texSize.Y));
 				float texBiasY = (float(_currentAnimation->Base->FrameDimensions.Y * row) / float(texSize.X));
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+				auto instanceBlock = command->material().uniformBlock(_instanceHandles.block);
+				instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+				instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(_currentAnimation->Base->FrameDimensions.X, _currentAnimation->Base->FrameDimensions.Y);
+				instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
 				auto& pos = _pieces[i].Pos;
 				command->setTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
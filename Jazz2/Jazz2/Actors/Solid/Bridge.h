@@ -49,5 +49,6 @@ namespace Jazz2::Actors::Solid
 		float _heightFactor;
 
 		SmallVector<BridgePiece, 0> _pieces;
+		InstanceBlockHandles _instanceHandles;
 	};
 }
\ No newline at end of file
@@ -45,7 +45,7 @@ namespace Jazz2::Actors::Weapons
 
 	void FreezerShot::OnFire(const std::shared_ptr<ActorBase>& owner, Vector2f gunspotPos, Vector2f speed, float angle, bool isFacingLeft)
 	{
-		_owner = owner;
+		_owner = owner->Handle;
 		SetFacingLeft(isFacingLeft);
 
 		_gunspotPos = gunspotPos;
@@ -13,7 +13,7 @@ namespace Jazz2::Actors::Weapons
 {
 	ShotBase::ShotBase()
 		:
-		_owner(nullptr),
+		_owner(),
 		_timeLeft(0),
 		_firedUp(false),
 		_upgrades(0),
@@ -33,7 +33,7 @@ namespace Jazz2::Actors::Weapons
 
 	Player* ShotBase::GetOwner()
 	{
-		return dynamic_cast<Player*>(_owner.get());
+		return dynamic_cast<Player*>(_levelHandler->GetActor(_owner));
 	}
 
 	WeaponType ShotBase::GetWeaponType()
@@ -89,7 +89,7 @@ namespace Jazz2::Actors::Weapons
 			AABBf adjustedAABB = AABBInner + Vector2f(_speed.X * timeMult, _speed.Y * timeMult);
 			if (tiles->CheckWeaponDestructible(adjustedAABB, GetWeaponType(), _strength) > 0) {
 				if (GetWeaponType() != WeaponType::Freezer) {
-					if (auto player = dynamic_cast<Player*>(_owner.get())) {
+					if (auto player = GetOwner()) {
 						player->AddScore(50);
 					}
 				}
@@ -25,7 +25,7 @@ namespace Jazz2::Actors::Weapons
 		virtual WeaponType GetWeaponType();
 
 	protected:
-		std::shared_ptr<ActorBase> _owner;
+		ActorHandle _owner;
 		float _timeLeft;
 		bool _firedUp;
 		uint8_t _upgrades;
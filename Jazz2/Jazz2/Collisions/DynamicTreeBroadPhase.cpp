@@ -21,15 +21,18 @@
 // SOFTWARE.
 #include "DynamicTreeBroadPhase.h"
 
+#include "../../nCine/Application.h"
+#include "../../nCine/Base/FrameArena.h"
+
 namespace Jazz2::Collisions
 {
 	DynamicTreeBroadPhase::DynamicTreeBroadPhase()
 	{
 		m_proxyCount = 0;
 
-		m_pairCapacity = 16;
+		m_pairCapacity = 0;
 		m_pairCount = 0;
-		m_pairBuffer = (CollisionPair*)malloc(m_pairCapacity * sizeof(CollisionPair));
+		m_pairBuffer = nullptr;
 
 		m_moveCapacity = 16;
 		m_moveCount = 0;
@@ -39,7 +42,6 @@ namespace Jazz2::Collisions
 	DynamicTreeBroadPhase::~DynamicTreeBroadPhase()
 	{
 		free(m_moveBuffer);
-		free(m_pairBuffer);
 	}
 
 	int32_t DynamicTreeBroadPhase::CreateProxy(const AABBf& aabb, void* userData)
@@ -107,13 +109,14 @@ namespace Jazz2::Collisions
 			return true;
 		}
 
-		// Grow the pair buffer as needed.
+		// Grow the pair buffer as needed, pairs are consumed in the same frame, so the previous buffer is just abandoned in the frame arena.
 		if (m_pairCount == m_pairCapacity) {
 			CollisionPair* oldBuffer = m_pairBuffer;
-			m_pairCapacity = m_pairCapacity + (m_pairCapacity >> 1);
-			m_pairBuffer = (CollisionPair*)malloc(m_pairCapacity * sizeof(CollisionPair));
-			memcpy(m_pairBuffer, oldBuffer, m_pairCount * sizeof(CollisionPair));
-			free(oldBuffer);
+			m_pairCapacity = (m_pairCapacity > 0 ? m_pairCapacity + (m_pairCapacity >> 1) : 16);
+			m_pairBuffer = (CollisionPair*)nCine::theApplication().frameArena().allocate(m_pairCapacity * sizeof(CollisionPair), alignof(CollisionPair));
+			if (m_pairCount > 0) {
+				memcpy(m_pairBuffer, oldBuffer, m_pairCount * sizeof(CollisionPair));
+			}
 		}
 
 		m_pairBuffer[m_pairCount].proxyIdA = std::min(proxyId, m_queryProxyId);
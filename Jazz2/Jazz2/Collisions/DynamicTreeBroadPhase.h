@@ -161,7 +161,9 @@ namespace Jazz2::Collisions
 	template <typename T>
 	void DynamicTreeBroadPhase::UpdatePairs(T* callback)
 	{
-		// Reset pair buffer
+		// Reset pair buffer, it's allocated from the frame arena, so pairs have to be consumed in the same frame
+		m_pairBuffer = nullptr;
+		m_pairCapacity = 0;
 		m_pairCount = 0;
 
 		// Perform tree queries for all moving proxies.
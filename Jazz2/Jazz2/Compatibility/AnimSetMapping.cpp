@@ -1,8 +1,1853 @@
-﻿#pragma once
+﻿#include "AnimSetMapping.h"
+#include "JJ2DefaultPalette.h"
 
-#include "../../Common.h"
+using namespace Death::Containers::Literals;
 
 namespace Jazz2::Compatibility
 {
+	const AnimSetMapping::Entry* AnimSetMapping::Get(int set, int item) const
+	{
+		auto it = _entries.find(GetKey(set, item));
+		return (it != _entries.end() ? &it->second : nullptr);
+	}
 
+	AnimSetMapping AnimSetMapping::GetAnimMapping(JJ2Version version)
+	{
+		AnimSetMapping m(version);
+
+		if (version == JJ2Version::PlusExtension) {
+			// Plus Ammo
+			m.SkipItems(5);
+			m.Add("Pickup"_s, "fast_fire_lori"_s);
+			m.Add("UI"_s, "blaster_upgraded_lori"_s);
+			m.NextSet();
+
+			// Plus Characters
+			m.DiscardItems(3);
+			m.NextSet();
+
+			// Plus Pickups
+			m.Add("Object"_s, "crate_ammo_pepper"_s);
+			m.Add("Object"_s, "crate_ammo_electro"_s);
+			m.Add("Object"_s, "powerup_shield_laser"_s);
+			m.Add("Unknown"_s, "powerup_unknown"_s);
+			m.Add("Object"_s, "powerup_empty"_s);
+			m.Add("Object"_s, "powerup_upgrade_blaster_lori"_s);
+			m.Add("Common"_s, "SugarRushStars"_s);
+			m.Add("Object"_s, "powerup_swap_characters_lori"_s);
+			return m;
+		}
+
+		// Ammo
+		m.Add("Unknown"_s, "flame_blue"_s);
+		m.Add("Common"_s, "Bomb"_s);
+		m.Add("Common"_s, "smoke_poof"_s);
+		m.Add("Common"_s, "explosion_rf"_s);
+		m.Add("Common"_s, "explosion_small"_s);
+		m.Add("Common"_s, "explosion_large"_s);
+		m.Add("Common"_s, "smoke_circling_gray"_s);
+		m.Add("Common"_s, "smoke_circling_brown"_s);
+		m.Add("Unknown"_s, "bubbles"_s);
+		m.Add("Unknown"_s, "brown_thing"_s);
+		m.Add("Common"_s, "explosion_pepper"_s);
+		m.Add("Unknown"_s, "bullet_maybe_electro"_s);
+		m.Add("Unknown"_s, "bullet_maybe_electro_trail"_s);
+		m.Add("Unknown"_s, "flame_red"_s);
+		m.Add("Weapon"_s, "bullet_shield_fireball"_s);
+		m.Add("Unknown"_s, "flare_diag_downleft"_s);
+		m.Add("Unknown"_s, "flare_hor"_s);
+		m.Add("Weapon"_s, "bullet_blaster"_s);
+		m.Add("UI"_s, "blaster_upgraded_jazz"_s);
+		m.Add("UI"_s, "blaster_upgraded_spaz"_s);
+		m.Add("Weapon"_s, "bullet_blaster_upgraded"_s);
+		m.Add("Weapon"_s, "bullet_blaster_upgraded_ver"_s);
+		m.Add("Weapon"_s, "bullet_blaster_ver"_s);
+		m.Add("Weapon"_s, "bullet_bouncer"_s);
+		m.Add("Pickup"_s, "ammo_bouncer_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_bouncer"_s);
+		m.Add("Unknown"_s, "explosion_bouncer"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded"_s);
+		m.Add("Weapon"_s, "bullet_freezer_hor"_s);
+		m.Add("Pickup"_s, "ammo_freezer_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_freezer"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_hor"_s);
+		m.Add("Weapon"_s, "bullet_freezer_ver"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_ver"_s);
+		m.Add("Pickup"_s, "ammo_seeker_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_seeker"_s);
+		m.Add("Weapon"_s, "bullet_seeker_ver_down"_s);
+		m.Add("Weapon"_s, "bullet_seeker_diag_downright"_s);
+		m.Add("Weapon"_s, "bullet_seeker_hor"_s);
+		m.Add("Weapon"_s, "bullet_seeker_ver_up"_s);
+		m.Add("Weapon"_s, "bullet_seeker_diag_upright"_s);
+		m.Add("Weapon"_s, "bullet_seeker_upgraded_ver_down"_s);
+		m.Add("Weapon"_s, "bullet_seeker_upgraded_diag_downright"_s);
+		m.Add("Weapon"_s, "bullet_seeker_upgraded_hor"_s);
+		m.Add("Weapon"_s, "bullet_seeker_upgraded_ver_up"_s);
+		m.Add("Weapon"_s, "bullet_seeker_upgraded_diag_upright"_s);
+		m.Add("Weapon"_s, "bullet_rf_hor"_s);
+		m.Add("Weapon"_s, "bullet_rf_diag_downright"_s);
+		m.Add("Weapon"_s, "bullet_rf_upgraded_diag_downright"_s);
+		m.Add("Pickup"_s, "ammo_rf_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_rf"_s);
+		m.Add("Weapon"_s, "bullet_rf_upgraded_hor"_s);
+		m.Add("Weapon"_s, "bullet_rf_upgraded_ver"_s);
+		m.Add("Weapon"_s, "bullet_rf_upgraded_diag_upright"_s);
+		m.Add("Weapon"_s, "bullet_rf_ver"_s);
+		m.Add("Weapon"_s, "bullet_rf_diag_upright"_s);
+		m.Add("Weapon"_s, "bullet_toaster"_s);
+		m.Add("Pickup"_s, "ammo_toaster_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_toaster"_s);
+		m.Add("Weapon"_s, "bullet_toaster_upgraded"_s);
+		m.Add("Weapon"_s, "bullet_tnt"_s);
+		m.Add("Weapon"_s, "bullet_fireball_hor"_s);
+		m.Add("Weapon"_s, "bullet_fireball_upgraded_hor"_s);
+		m.Add("Weapon"_s, "bullet_fireball_ver"_s);
+		m.Add("Weapon"_s, "bullet_fireball_upgraded_ver"_s);
+		m.Add("Weapon"_s, "bullet_bladegun"_s);
+		m.Add("Pickup"_s, "ammo_pepper_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_pepper"_s);
+		m.Add("Weapon"_s, "bullet_bladegun_upgraded"_s);
+		m.Add("Common"_s, "explosion_upwards"_s);
+		m.Add("Common"_s, "explosion_tiny"_s);
+		m.Add("Common"_s, "explosion_tiny_black"_s);
+		m.Add("Weapon"_s, "bullet_tnt_explosion"_s);
+		m.Add("Pickup"_s, "ammo_electro_upgraded"_s);
+		m.Add("Pickup"_s, "ammo_electro"_s);
+		m.Add("Common"_s, "explosion_freezer_maybe"_s);
+		m.Add("Weapon"_s, "bullet_electro_trail"_s);
+		m.Add("Weapon"_s, "bullet_electro"_s);
+		m.NextSet();
+
+		// Bat
+		m.Add("Bat"_s, "idle"_s);
+		m.Add("Bat"_s, "resting"_s);
+		m.Add("Bat"_s, "takeoff_1"_s);
+		m.Add("Bat"_s, "takeoff_2"_s);
+		m.Add("Bat"_s, "roost"_s);
+		m.NextSet();
+
+		// Bee Boy
+		m.Add("Unknown"_s, "bee_boy"_s);
+		m.NextSet();
+
+		// Bees
+		m.Add("Unknown"_s, "bee_swarm"_s);
+		m.NextSet();
+
+		// Big Box
+		m.Add("Object"_s, "PushBoxCrate"_s);
+		m.NextSet();
+
+		// Big Rock
+		m.Add("Object"_s, "PushBoxRock"_s);
+		m.NextSet();
+
+		// Big Tree
+		m.Add("Pole"_s, "DiamondusTree"_s);
+		m.NextSet();
+
+		// Bilsy
+		m.Add("Bilsy"_s, "throw_fireball"_s);
+		m.Add("Bilsy"_s, "appear"_s);
+		m.Add("Bilsy"_s, "vanish"_s);
+		m.Add("Bilsy"_s, "bullet_fireball"_s);
+		m.Add("Bilsy"_s, "idle"_s);
+		m.NextSet();
+
+		// Bird
+		m.Add("BirdyYellow"_s, "charge_diag_downright"_s);
+		m.Add("BirdyYellow"_s, "charge_ver"_s);
+		m.Add("BirdyYellow"_s, "charge_diag_upright"_s);
+		m.Add("BirdyYellow"_s, "caged"_s);
+		m.Add("BirdyYellow"_s, "cage_destroyed"_s);
+		m.Add("BirdyYellow"_s, "die"_s);
+		m.Add("BirdyYellow"_s, "feather_green"_s);
+		m.Add("BirdyYellow"_s, "feather_red"_s);
+		m.Add("BirdyYellow"_s, "feather_green_and_red"_s);
+		m.Add("BirdyYellow"_s, "fly"_s);
+		m.Add("BirdyYellow"_s, "hurt"_s);
+		m.Add("BirdyYellow"_s, "idle_worried"_s);
+		m.Add("BirdyYellow"_s, "idle_turn_head_left"_s);
+		m.Add("BirdyYellow"_s, "idle_turn_head_right"_s);
+		m.Add("BirdyYellow"_s, "idle_turn_head_left_back"_s);
+		m.Add("BirdyYellow"_s, "idle_turn_head_right_back"_s);
+		m.Add("BirdyYellow"_s, "idle"_s);
+		m.Add("BirdyYellow"_s, "corpse"_s);
+		m.NextSet();
+
+		// Bird 3D
+		m.Add("Unknown"_s, "bird_3d"_s);
+		m.NextSet();
+
+		// Bolly Platform
+		m.Add("Platform"_s, "ball"_s);
+		m.Add("Platform"_s, "ball_chain"_s);
+		m.NextSet();
+
+		// Bonus
+		m.Add("Object"_s, "BonusActive"_s);
+		m.NextSet();
+
+		// Boss
+		m.Add("UI"_s, "boss_health_bar"_s);
+		m.Add("Unknown"_s, "boss_health_bar_2"_s);
+		m.NextSet();
+
+		// Bridge
+		m.Add("Bridge"_s, "Rope"_s);
+		m.Add("Bridge"_s, "Stone"_s);
+		m.Add("Bridge"_s, "Vine"_s);
+		m.Add("Bridge"_s, "StoneRed"_s);
+		m.Add("Bridge"_s, "Log"_s);
+		m.Add("Bridge"_s, "Gem"_s);
+		m.Add("Bridge"_s, "Lab"_s);
+		m.NextSet();
+
+		// Bubba
+		m.Add("Bubba"_s, "spew_fireball"_s);
+		m.Add("Bubba"_s, "corpse"_s);
+		m.Add("Bubba"_s, "jump"_s);
+		m.Add("Bubba"_s, "jump_fall"_s);
+		m.Add("Bubba"_s, "fireball"_s);
+		m.Add("Bubba"_s, "hop"_s);
+		m.Add("Bubba"_s, "tornado"_s);
+		m.Add("Bubba"_s, "tornado_end"_s);
+		m.Add("Bubba"_s, "tornado_start"_s);
+		m.NextSet();
+
+		// Bumbee
+		m.Add("Bee"_s, "Bee"_s);
+		m.Add("Bee"_s, "bee_turn"_s);
+		m.NextSet();
+
+		// Butterfly
+		m.Add("Unknown"_s, "butterfly"_s);
+		m.NextSet();
+
+		// Carrot Pole
+		m.Add("Pole"_s, "Carrotus"_s);
+		m.NextSet();
+
+		// Cat
+		m.Add("Unknown"_s, "cat"_s);
+		m.NextSet();
+
+		// Cat 2
+		m.Add("Unknown"_s, "cat_2"_s);
+		m.NextSet();
+
+		// Caterpillar
+		m.Add("Caterpillar"_s, "exhale_start"_s);
+		m.Add("Caterpillar"_s, "exhale"_s);
+		m.Add("Caterpillar"_s, "disoriented"_s);
+		m.Add("Caterpillar"_s, "idle"_s);
+		m.Add("Caterpillar"_s, "inhale_start"_s);
+		m.Add("Caterpillar"_s, "inhale"_s);
+		m.Add("Caterpillar"_s, "smoke"_s);
+		m.NextSet();
+
+		// Chuck
+		m.Add("Birdy"_s, "charge_diag_downright"_s);
+		m.Add("Birdy"_s, "charge_ver"_s);
+		m.Add("Birdy"_s, "charge_diag_upright"_s);
+		m.Add("Birdy"_s, "caged"_s);
+		m.Add("Birdy"_s, "cage_destroyed"_s);
+		m.Add("Birdy"_s, "die"_s);
+		m.Add("Birdy"_s, "feather_green"_s);
+		m.Add("Birdy"_s, "feather_red"_s);
+		m.Add("Birdy"_s, "feather_green_and_red"_s);
+		m.Add("Birdy"_s, "fly"_s);
+		m.Add("Birdy"_s, "hurt"_s);
+		m.Add("Birdy"_s, "idle_worried"_s);
+		m.Add("Birdy"_s, "idle_turn_head_left"_s);
+		m.Add("Birdy"_s, "idle_turn_head_right"_s);
+		m.Add("Birdy"_s, "idle_turn_head_left_back"_s);
+		m.Add("Birdy"_s, "idle_turn_head_right_back"_s);
+		m.Add("Birdy"_s, "idle"_s);
+		m.Add("Birdy"_s, "corpse"_s);
+		m.NextSet();
+
+		// Common
+		m.Add("Unknown"_s, "blue_flash"_s);
+		m.Add("Common"_s, "water_bubble_1"_s);
+		m.Add("Common"_s, "water_bubble_2"_s);
+		m.Add("Common"_s, "IceBlock"_s);
+		m.Add("Unknown"_s, "flame"_s);
+		m.Add("Common"_s, "smoke_circling_white"_s);
+		m.Add("Common"_s, "SugarRushStars"_s);
+		m.Add("Unknown"_s, "sparkle"_s);
+		m.Add("Common"_s, "water_splash"_s);
+		m.Add("Unknown"_s, "eye_1"_s);
+		m.Add("Unknown"_s, "eye_2"_s);
+		m.Add("Unknown"_s, "heart"_s);
+		m.NextSet();
+
+		// Continue
+		m.Add("Unknown"_s, "continue"_s);
+		m.NextSet();
+
+		// Demon
+		m.Add("Demon"_s, "idle"_s);
+		m.Add("Demon"_s, "attack_start"_s);
+		m.Add("Demon"_s, "attack"_s);
+		m.Add("Demon"_s, "attack_end"_s);
+		m.NextSet();
+
+		// Destructible Scenery
+		m.Add("Unknown"_s, "destructible_scenery"_s);
+		m.NextSet();
+
+		// Devan
+		m.Add("Devan"_s, "bullet"_s);
+		m.Add("Devan"_s, "remote_idle"_s);
+		m.Add("Devan"_s, "remote_warp_out"_s);
+		m.Add("Devan"_s, "disoriented"_s);
+		m.Add("Devan"_s, "freefall"_s);
+		m.Add("Devan"_s, "disoriented_start"_s);
+		m.Add("Devan"_s, "disoriented_warp_out"_s);
+		m.Add("Devan"_s, "idle"_s);
+		m.Add("Devan"_s, "jump_end"_s);
+		m.Add("Devan"_s, "run"_s);
+		m.Add("Devan"_s, "run_end"_s);
+		m.Add("Devan"_s, "shoot"_s);
+		m.Add("Devan"_s, "warp_in"_s);
+		m.Add("Devan"_s, "warp_out"_s);
+		m.NextSet();
+
+		// Devil Devan
+		m.Add("Devan"_s, "demon_spew_fireball"_s);
+		m.Add("Devan"_s, "demon_fireball"_s);
+		m.Add("Devan"_s, "demon_fly"_s);
+		m.Add("Devan"_s, "demon_turn"_s);
+		m.Add("Devan"_s, "demon_transform_start"_s);
+		m.Add("Devan"_s, "demon_transform_end"_s);
+		m.NextSet();
+
+		// Diamondus Pole
+		m.Add("Pole"_s, "Diamondus"_s);
+		m.NextSet();
+
+		// Dog
+		m.Add("Doggy"_s, "attack"_s);
+		m.Add("Doggy"_s, "walk"_s);
+		m.NextSet();
+
+		// Door
+		m.Add("Unknown"_s, "door"_s);
+		m.NextSet();
+
+		// Dragonfly
+		m.Add("Dragonfly"_s, "idle"_s);
+		m.NextSet();
+
+		// Dragon
+		m.Add("Dragon"_s, "attack"_s);
+		m.Add("Dragon"_s, "idle"_s);
+		m.Add("Dragon"_s, "turn"_s);
+		m.NextSet(4);
+
+		// Eva
+		m.Add("Eva"_s, "Blink"_s);
+		m.Add("Eva"_s, "Idle"_s);
+		m.Add("Eva"_s, "KissStart"_s);
+		m.Add("Eva"_s, "KissEnd"_s);
+		m.NextSet();
+
+		// Faces
+		m.Add("UI"_s, "icon_jazz"_s);
+		m.Add("UI"_s, "icon_spaz"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "UI"_s, "icon_lori"_s);
+		m.Add("UI"_s, "icon_frog"_s);
+		m.NextSet(2);
+
+		// Fat Chick
+		m.Add("FatChick"_s, "attack"_s);
+		m.Add("FatChick"_s, "walk"_s);
+		m.NextSet();
+
+		// Fencer
+		m.Add("Fencer"_s, "attack"_s);
+		m.Add("Fencer"_s, "idle"_s);
+		m.NextSet();
+
+		// Fish
+		m.Add("Fish"_s, "attack"_s);
+		m.Add("Fish"_s, "idle"_s);
+		m.NextSet();
+
+		// Flag
+		m.Add("Unknown"_s, "ctf_flag_blue"_s);
+		m.Add("Unknown"_s, "ctf_flag_red"_s);
+		m.NextSet();
+
+		// Flare
+		m.Add("Unknown"_s, "flare"_s);
+		m.NextSet();
+
+		// Font
+		m.Add("UI"_s, "font_large"_s);
+		m.Add("UI"_s, "font_small"_s);
+		m.NextSet();
+
+		// Frog
+		m.Add("Frog"_s, "fall_land"_s);
+		m.Add("Frog"_s, "hurt"_s);
+		m.Add("Frog"_s, "idle"_s);
+		m.Add("Frog"_s, "jump_start"_s);
+		m.Add("Frog"_s, "crouch"_s);
+		m.Add("Frog"_s, "fall"_s);
+		m.Add("Frog"_s, "run"_s);
+		m.Add("Frog"_s, "tongue_diag"_s);
+		m.Add("Frog"_s, "tongue_hor"_s);
+		m.Add("Frog"_s, "tongue_ver"_s);
+		m.NextSet();
+
+		// Fruit Platform
+		m.Add("Platform"_s, "carrotus_fruit"_s);
+		m.Add("Platform"_s, "carrotus_fruit_chain"_s);
+		m.NextSet();
+
+		// Gem Ring
+		m.Add("Unknown"_s, "gem_ring"_s);
+		m.NextSet();
+
+		// Glove
+		m.Add("Unknown"_s, "boxing_glove_hit"_s);
+		m.Add("Unknown"_s, "boxing_glove_idle"_s);
+		m.NextSet();
+
+		// Grass Platform
+		m.Add("Platform"_s, "carrotus_grass"_s);
+		m.Add("Platform"_s, "carrotus_grass_chain"_s);
+		m.NextSet();
+
+		// Madder Hatter
+		m.Add("MadderHatter"_s, "cup"_s);
+		m.Add("MadderHatter"_s, "hat"_s);
+		m.Add("MadderHatter"_s, "attack"_s);
+		m.Add("MadderHatter"_s, "bullet_spit"_s);
+		m.Add("MadderHatter"_s, "walk"_s);
+		m.NextSet();
+
+		// Helmut
+		m.Add("Helmut"_s, "idle"_s);
+		m.Add("Helmut"_s, "walk"_s);
+		m.NextSet(2);
+
+		// Jazz
+		m.Add("Jazz"_s, "airboard"_s);
+		m.Add("Jazz"_s, "airboard_turn"_s);
+		m.Add("Jazz"_s, "buttstomp_end"_s);
+		m.Add("Jazz"_s, "corpse"_s);
+		m.Add("Jazz"_s, "die"_s);
+		m.Add("Jazz"_s, "crouch_start"_s);
+		m.Add("Jazz"_s, "crouch_shoot_end"_s);
+		m.Add("Jazz"_s, "crouch_shoot"_s);
+		m.Add("Jazz"_s, "crouch_end"_s);
+		m.Add("Jazz"_s, "unused_ledge_climb"_s);
+		m.Add("Jazz"_s, "eol"_s);
+		m.Add("Jazz"_s, "fall"_s);
+		m.Add("Jazz"_s, "buttstomp"_s);
+		m.Add("Jazz"_s, "fall_end"_s);
+		m.Add("Jazz"_s, "shoot"_s);
+		m.Add("Jazz"_s, "shoot_ver"_s);
+		m.Add("Jazz"_s, "shoot_ver_end"_s);
+		m.Add("Jazz"_s, "transform_frog"_s);
+		m.Add("Jazz"_s, "vine_shoot_up_end"_s);
+		m.Add("Jazz"_s, "vine_walk"_s);
+		m.Add("Jazz"_s, "vine_shoot_up"_s);
+		m.Add("Jazz"_s, "vine_idle"_s);
+		m.Add("Jazz"_s, "vine_idle_flavor"_s);
+		m.Add("Jazz"_s, "vine_shoot_end"_s);
+		m.Add("Jazz"_s, "vine_shoot"_s);
+		m.Add("Jazz"_s, "copter"_s);
+		m.Add("Jazz"_s, "copter_shoot"_s);
+		m.Add("Jazz"_s, "copter_shoot_start"_s);
+		m.Add("Jazz"_s, "pole_h"_s);
+		m.Add("Jazz"_s, "hurt"_s);
+		m.Add("Jazz"_s, "idle_flavor_1"_s);
+		m.Add("Jazz"_s, "idle_flavor_2"_s);
+		m.Add("Jazz"_s, "idle_flavor_3"_s);
+		m.Add("Jazz"_s, "idle_flavor_4"_s);
+		m.Add("Jazz"_s, "idle_flavor_5"_s);
+		m.Add("Jazz"_s, "unused_jump_shoot_end"_s);
+		m.Add("Jazz"_s, "fall_shoot"_s);
+		m.Add("Jazz"_s, "jump_start"_s);
+		m.Add("Jazz"_s, "jump"_s);
+		m.Add("Jazz"_s, "freefall"_s);
+		m.Add("Jazz"_s, "ledge"_s);
+		m.Add("Jazz"_s, "lift"_s);
+		m.Add("Jazz"_s, "lift_jump_light"_s);
+		m.Add("Jazz"_s, "lift_jump_heavy"_s);
+		m.Add("Jazz"_s, "lookup_start"_s);
+		m.Add("Jazz"_s, "dizzy_walk"_s);
+		m.Add("Jazz"_s, "push"_s);
+		m.Add("Jazz"_s, "shoot_end"_s);
+		m.Add("Jazz"_s, "uppercut_start"_s);
+		m.Add("Jazz"_s, "uppercut"_s);
+		m.Add("Jazz"_s, "uppercut_end"_s);
+		m.Add("Jazz"_s, "fall_diag"_s);
+		m.Add("Jazz"_s, "jump_diag"_s);
+		m.Add("Jazz"_s, "ball"_s);
+		m.Add("Jazz"_s, "run"_s);
+		m.Add("Jazz"_s, "dash_start"_s);
+		m.Add("Jazz"_s, "dash"_s);
+		m.Add("Jazz"_s, "dash_stop"_s);
+		m.Add("Jazz"_s, "run_stop"_s);
+		m.Add("Jazz"_s, "unused_skid"_s);
+		m.Add("Jazz"_s, "Spring"_s);
+		m.Add("Jazz"_s, "idle"_s);
+		m.Add("Jazz"_s, "jump_stationary"_s);
+		m.Add("Jazz"_s, "jump_stationary_end"_s);
+		m.Add("Jazz"_s, "jump_stationary_start"_s);
+		m.Add("Jazz"_s, "dizzy"_s);
+		m.Add("Jazz"_s, "swim_down"_s);
+		m.Add("Jazz"_s, "swim_right"_s);
+		m.Add("Jazz"_s, "swim_turn_1"_s);
+		m.Add("Jazz"_s, "swim_turn_2"_s);
+		m.Add("Jazz"_s, "swim_up"_s);
+		m.Add("Jazz"_s, "swing"_s);
+		m.Add("Jazz"_s, "warp_in"_s);
+		m.Add("Jazz"_s, "warp_in_freefall"_s);
+		m.Add("Jazz"_s, "unused_warp_freefall"_s);
+		m.Add("Jazz"_s, "warp_out_freefall"_s);
+		m.Add("Jazz"_s, "warp_out"_s);
+		m.Add("Jazz"_s, "pole_v"_s);
+		m.Add("Jazz"_s, "transform_frog_end"_s);
+		m.NextSet();
+
+		// Jazz 3D
+		m.Add("Unknown"_s, "jazz_3d"_s);
+		m.NextSet(2);
+
+		// Jungle Pole
+		m.Add("Pole"_s, "Jungle"_s);
+		m.NextSet();
+
+		// Lab Rat
+		m.Add("LabRat"_s, "attack"_s);
+		m.Add("LabRat"_s, "idle"_s);
+		m.Add("LabRat"_s, "walk"_s);
+		m.NextSet();
+
+		// Lizard
+		m.Add("Lizard"_s, "copter_attack"_s);
+		m.Add("Lizard"_s, "bomb"_s);
+		m.Add("Lizard"_s, "copter_idle"_s);
+		m.Add("Lizard"_s, "copter"_s);
+		m.Add("Lizard"_s, "walk"_s);
+		m.NextSet();
+
+		// Lori (TSF, CC)
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "airboard"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "airboard_turn"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "buttstomp_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "corpse"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "die"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "crouch_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "crouch_shoot_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "crouch_shoot"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "crouch_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "unused_ledge_climb"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "eol"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "fall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "buttstomp"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "fall_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "shoot"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "shoot_ver"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "shoot_ver_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "transform_frog"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_shoot_up_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_walk"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_shoot_up"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_idle"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_idle_flavor"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_shoot_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "vine_shoot"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "copter"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "copter_shoot"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "copter_shoot_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "pole_h"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_1"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_2"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_3"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_4"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_5"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "unused_jump_shoot_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "fall_shoot"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "freefall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "ledge"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "lift"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "lift_jump_light"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "lift_jump_heavy"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "lookup_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "dizzy_walk"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "push"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "shoot_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "sidekick_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "sidekick"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "sidekick_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "fall_diag"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_diag"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "ball"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "run"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "dash_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "dash"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "dash_stop"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "run_stop"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "unused_skid"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "Spring"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_stationary"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_stationary_end"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_stationary_start"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "dizzy"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swim_down"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swim_right"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swim_turn_1"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swim_turn_2"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swim_up"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "swing"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "warp_in"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "warp_in_freefall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "unused_warp_freefall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "warp_out_freefall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "warp_out"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "pole_v"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "transform_frog_end"_s);
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+
+		// Lori 2 (TSF, CC)
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Unknown"_s, "lori_2"_s);
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+
+		// Menu
+		m.Add("Unknown"_s, "menu_background"_s);
+		m.Add("UI"_s, "character_art_difficulty_jazz"_s);
+		m.Add("UI"_s, "character_art_difficulty_spaz"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "UI"_s, "character_art_difficulty_lori"_s);
+		m.Add("Unknown"_s, "menu_difficulty_sparkles"_s);
+		m.Add("Unknown"_s, "menu_logo"_s);
+		m.NextSet();
+
+		// Menu Font
+		m.Add("UI"_s, "font_medium"_s);
+		m.NextSet(2);
+
+		// Monkey
+		m.Add("Monkey"_s, "Banana"_s);
+		m.Add("Monkey"_s, "BananaSplat"_s);
+		m.Add("Monkey"_s, "Jump"_s);
+		m.Add("Monkey"_s, "WalkStart"_s);
+		m.Add("Monkey"_s, "WalkEnd"_s);
+		m.Add("Monkey"_s, "Attack"_s);
+		m.Add("Monkey"_s, "Walk"_s);
+		m.NextSet();
+
+		// Moth
+		m.Add("Moth"_s, "Green"_s);
+		m.Add("Moth"_s, "Gray"_s);
+		m.Add("Moth"_s, "Purple"_s);
+		m.Add("Moth"_s, "Pink"_s);
+		m.NextSet(3);
+
+		// Pickups
+		m.Add("Pickup"_s, "1up"_s);
+		m.Add("Pickup"_s, "food_apple"_s);
+		m.Add("Pickup"_s, "food_banana"_s);
+		m.Add("Object"_s, "container_barrel"_s);
+		m.Add("Object"_s, "container_barrel_shrapnel_1"_s);
+		m.Add("Object"_s, "container_barrel_shrapnel_2"_s);
+		m.Add("Object"_s, "container_barrel_shrapnel_3"_s);
+		m.Add("Object"_s, "container_barrel_shrapnel_4"_s);
+		m.Add("Object"_s, "container_box_crush"_s);
+		m.Add("Object"_s, "container_ammo_shrapnel_1"_s);
+		m.Add("Object"_s, "container_ammo_shrapnel_2"_s);
+		m.Add("Pickup"_s, "food_burger"_s);
+		m.Add("Pickup"_s, "food_cake"_s);
+		m.Add("Pickup"_s, "food_candy"_s);
+		m.Add("Object"_s, "checkpoint"_s);
+		m.Add("Pickup"_s, "food_cheese"_s);
+		m.Add("Pickup"_s, "food_cherry"_s);
+		m.Add("Pickup"_s, "food_chicken"_s);
+		m.Add("Pickup"_s, "food_chips"_s);
+		m.Add("Pickup"_s, "food_chocolate"_s);
+		m.Add("Pickup"_s, "food_cola"_s);
+		m.Add("Pickup"_s, "carrot"_s);
+		m.Add("Pickup"_s, "Gem"_s);
+		m.Add("Pickup"_s, "food_cucumber"_s);
+		m.Add("Pickup"_s, "food_cupcake"_s);
+		m.Add("Pickup"_s, "food_donut"_s);
+		m.Add("Pickup"_s, "food_eggplant"_s);
+		m.Add("Unknown"_s, "green_blast_thing"_s);
+		m.Add("Object"_s, "ExitSign"_s);
+		m.Add("Pickup"_s, "fast_fire_jazz"_s);
+		m.Add("Pickup"_s, "fast_fire_spaz"_s);
+		m.Add("Pickup"_s, "food_fries"_s);
+		m.Add("Pickup"_s, "fast_feet"_s);
+		m.Add("Object"_s, "GemSuper"_s);
+		m.Add("Pickup"_s, "Gem2"_s);
+		m.Add("Pickup"_s, "airboard"_s);
+		m.Add("Pickup"_s, "coin_gold"_s);
+		m.Add("Pickup"_s, "food_grapes"_s);
+		m.Add("Pickup"_s, "food_ham"_s);
+		m.Add("Pickup"_s, "carrot_fly"_s);
+		m.Add("UI"_s, "heart"_s);
+		m.Add("Pickup"_s, "freeze_enemies"_s);
+		m.Add("Pickup"_s, "food_ice_cream"_s);
+		m.Add("Common"_s, "ice_break_shrapnel_1"_s);
+		m.Add("Common"_s, "ice_break_shrapnel_2"_s);
+		m.Add("Common"_s, "ice_break_shrapnel_3"_s);
+		m.Add("Common"_s, "ice_break_shrapnel_4"_s);
+		m.Add("Pickup"_s, "food_lemon"_s);
+		m.Add("Pickup"_s, "food_lettuce"_s);
+		m.Add("Pickup"_s, "food_lime"_s);
+		m.Add("Unknown"_s, "shield_lightning"_s);
+		m.Add("Object"_s, "TriggerCrate"_s);
+		m.Add("Pickup"_s, "food_milk"_s);
+		m.Add("Object"_s, "crate_ammo_bouncer"_s);
+		m.Add("Object"_s, "crate_ammo_freezer"_s);
+		m.Add("Object"_s, "crate_ammo_rf"_s);
+		m.Add("Object"_s, "crate_ammo_seeker"_s);
+		m.Add("Object"_s, "crate_ammo_toaster"_s);
+		m.Add("Object"_s, "crate_ammo_tnt"_s);
+		m.Add("Object"_s, "powerup_upgrade_blaster_jazz"_s);
+		m.Add("Object"_s, "powerup_upgrade_bouncer"_s);
+		m.Add("Object"_s, "powerup_upgrade_freezer"_s);
+		m.Add("Object"_s, "powerup_upgrade_seeker"_s);
+		m.Add("Object"_s, "powerup_upgrade_rf"_s);
+		m.Add("Object"_s, "powerup_upgrade_toaster"_s, JJ2DefaultPalette::ToasterPowerUpFix);
+		m.Add("Object"_s, "powerup_upgrade_pepper"_s);
+		m.Add("Object"_s, "powerup_upgrade_electro"_s);
+		m.Add("Object"_s, "powerup_transform_birdy"_s);
+		m.Add("Object"_s, "powerup_swap_characters"_s);
+		m.Add("Object"_s, "powerup_upgrade_blaster_spaz"_s);
+		m.Add("Object"_s, "powerup_shield_fire"_s);
+		m.Add("Object"_s, "powerup_shield_bubble"_s);
+		m.Add("Object"_s, "powerup_shield_lightning"_s);
+		m.Add("Object"_s, "powerup_shield_laser"_s);
+		m.Add("Object"_s, "powerup_empty"_s);
+		m.Add("Pickup"_s, "food_orange"_s);
+		m.Add("Pickup"_s, "carrot_invincibility"_s);
+		m.Add("Pickup"_s, "food_peach"_s);
+		m.Add("Pickup"_s, "food_pear"_s);
+		m.Add("Pickup"_s, "food_soda"_s);
+		m.Add("Pickup"_s, "food_pie"_s);
+		m.Add("Pickup"_s, "food_pizza"_s);
+		m.Add("Pickup"_s, "potion"_s);
+		m.Add("Pickup"_s, "food_pretzel"_s);
+		m.Add("Pickup"_s, "food_sandwich"_s);
+		m.Add("Pickup"_s, "food_strawberry"_s);
+		m.Add("Pickup"_s, "carrot_full"_s);
+		m.Add("Pickup"_s, "coin_silver"_s);
+		m.Add("Unknown"_s, "green_blast_thing_2"_s);
+		m.Add("Common"_s, "generator"_s);
+		m.Add("Pickup"_s, "stopwatch"_s);
+		m.Add("Pickup"_s, "food_taco"_s);
+		m.Add("Pickup"_s, "food_thing"_s);
+		m.Add("Object"_s, "tnt"_s);
+		m.Add("Pickup"_s, "food_hotdog"_s);
+		m.Add("Pickup"_s, "food_watermelon"_s);
+		m.Add("Object"_s, "container_crate_shrapnel_1"_s);
+		m.Add("Object"_s, "container_crate_shrapnel_2"_s);
+		m.NextSet();
+
+		// Pinball
+		m.Add("Pinball"_s, "Bumper500"_s);
+		m.Add("Pinball"_s, "Bumper500Hit"_s);
+		m.Add("Pinball"_s, "BumperCarrot"_s);
+		m.Add("Pinball"_s, "BumperCarrotHit"_s);
+		m.Add("Pinball"_s, "PaddleLeft"_s);
+		m.Add("Pinball"_s, "PaddleRight"_s);
+		m.NextSet();
+
+		// Pink Platform
+		m.Add("Platform"_s, "lab"_s);
+		m.Add("Platform"_s, "lab_chain"_s);
+		m.NextSet();
+
+		// Psych Pole
+		m.Add("Pole"_s, "Psych"_s);
+		m.NextSet();
+
+		// Queen
+		m.Add("Queen"_s, "scream"_s);
+		m.Add("Queen"_s, "ledge"_s);
+		m.Add("Queen"_s, "ledge_recover"_s);
+		m.Add("Queen"_s, "idle"_s);
+		m.Add("Queen"_s, "brick"_s);
+		m.Add("Queen"_s, "fall"_s);
+		m.Add("Queen"_s, "stomp"_s);
+		m.Add("Queen"_s, "backstep"_s);
+		m.NextSet();
+
+		// Rapier
+		m.Add("Rapier"_s, "attack"_s);
+		m.Add("Rapier"_s, "attack_swing"_s);
+		m.Add("Rapier"_s, "idle"_s);
+		m.Add("Rapier"_s, "attack_start"_s);
+		m.Add("Rapier"_s, "attack_end"_s);
+		m.NextSet();
+
+		// Raven
+		m.Add("Raven"_s, "Attack"_s);
+		m.Add("Raven"_s, "Idle"_s);
+		m.Add("Raven"_s, "Turn"_s);
+		m.NextSet();
+
+		// Robot
+		m.Add("Robot"_s, "spike_ball"_s);
+		m.Add("Robot"_s, "attack_start"_s);
+		m.Add("Robot"_s, "attack"_s);
+		m.Add("Robot"_s, "attack_end"_s);
+		m.Add("Robot"_s, "copter"_s);
+		m.Add("Robot"_s, "copter_end"_s);
+		m.Add("Robot"_s, "idle"_s);
+		m.Add("Robot"_s, "run"_s);
+		m.Add("Robot"_s, "shrapnel_1"_s);
+		m.Add("Robot"_s, "shrapnel_2"_s);
+		m.Add("Robot"_s, "shrapnel_3"_s);
+		m.Add("Robot"_s, "shrapnel_4"_s);
+		m.Add("Robot"_s, "shrapnel_5"_s);
+		m.Add("Robot"_s, "shrapnel_6"_s);
+		m.Add("Robot"_s, "shrapnel_7"_s);
+		m.Add("Robot"_s, "shrapnel_8"_s);
+		m.Add("Robot"_s, "shrapnel_9"_s);
+		m.NextSet();
+
+		// Rock
+		m.Add("Object"_s, "rolling_rock"_s);
+		m.NextSet();
+
+		// Rock Turtle
+		m.Add("Unknown"_s, "rock_turtle_idle"_s);
+		m.Add("Unknown"_s, "rock_turtle_walk"_s);
+		m.NextSet(3);
+
+		// Skeleton
+		m.Add("Skeleton"_s, "Bone"_s);
+		m.Add("Skeleton"_s, "Skull"_s);
+		m.Add("Skeleton"_s, "Walk"_s);
+		m.NextSet();
+
+		// Small Tree
+		m.Add("Unknown"_s, "small_tree_fall"_s);
+		m.Add("Unknown"_s, "small_tree_idle"_s);
+		m.NextSet();
+
+		// Snow
+		m.Add("Common"_s, "Snow"_s);
+		m.NextSet();
+
+		// Sonic Ship
+		m.Add("Bolly"_s, "top"_s);
+		m.Add("Bolly"_s, "bottom"_s);
+		m.Add("Bolly"_s, "turret"_s);
+		m.Add("Bolly"_s, "rocket"_s);
+		m.Add("Bolly"_s, "mace"_s);
+		m.Add("Bolly"_s, "mace_chain"_s);
+		m.NextSet();
+
+		// Sonic Platform
+		m.Add("Platform"_s, "sonic"_s);
+		m.Add("Platform"_s, "sonic_chain"_s);
+		m.NextSet();
+
+		// Spark
+		m.Add("Sparks"_s, "idle"_s);
+		m.NextSet();
+
+		// Spaz
+		m.Add("Spaz"_s, "airboard"_s);
+		m.Add("Spaz"_s, "airboard_turn"_s);
+		m.Add("Spaz"_s, "buttstomp_end"_s);
+		m.Add("Spaz"_s, "corpse"_s);
+		m.Add("Spaz"_s, "die"_s);
+		m.Add("Spaz"_s, "crouch_start"_s);
+		m.Add("Spaz"_s, "crouch_shoot_end"_s);
+		m.Add("Spaz"_s, "crouch_shoot"_s);
+		m.Add("Spaz"_s, "crouch_end"_s);
+		m.Add("Spaz"_s, "unused_ledge_climb"_s);
+		m.Add("Spaz"_s, "eol"_s);
+		m.Add("Spaz"_s, "fall"_s);
+		m.Add("Spaz"_s, "buttstomp"_s);
+		m.Add("Spaz"_s, "fall_end"_s);
+		m.Add("Spaz"_s, "shoot"_s);
+		m.Add("Spaz"_s, "shoot_ver"_s);
+		m.Add("Spaz"_s, "shoot_ver_end"_s);
+		m.Add("Spaz"_s, "transform_frog"_s);
+		m.Add("Spaz"_s, "vine_shoot_up_end"_s);
+		m.Add("Spaz"_s, "vine_walk"_s);
+		m.Add("Spaz"_s, "vine_shoot_up"_s);
+		m.Add("Spaz"_s, "vine_idle"_s);
+		m.Add("Spaz"_s, "vine_idle_flavor"_s);
+		m.Add("Spaz"_s, "vine_shoot_end"_s);
+		m.Add("Spaz"_s, "vine_shoot"_s);
+		m.Add("Spaz"_s, "copter"_s);
+		m.Add("Spaz"_s, "copter_shoot"_s);
+		m.Add("Spaz"_s, "copter_shoot_start"_s);
+		m.Add("Spaz"_s, "pole_h"_s);
+		m.Add("Spaz"_s, "hurt"_s);
+		m.Add("Spaz"_s, "idle_flavor_1"_s);
+		m.Add("Spaz"_s, "idle_flavor_2"_s);
+		m.Add("Spaz"_s, "idle_flavor_3"_s);
+		m.Add("Spaz"_s, "idle_flavor_4"_s);
+		m.Add("Spaz"_s, "idle_flavor_5"_s);
+		m.Add("Spaz"_s, "unused_jump_shoot_end"_s);
+		m.Add("Spaz"_s, "fall_shoot"_s);
+		m.Add("Spaz"_s, "jump_start"_s);
+		m.Add("Spaz"_s, "jump"_s);
+		m.Add("Spaz"_s, "freefall"_s);
+		m.Add("Spaz"_s, "ledge"_s);
+		m.Add("Spaz"_s, "lift"_s);
+		m.Add("Spaz"_s, "lift_jump_light"_s);
+		m.Add("Spaz"_s, "lift_jump_heavy"_s);
+		m.Add("Spaz"_s, "lookup_start"_s);
+		m.Add("Spaz"_s, "dizzy_walk"_s);
+		m.Add("Spaz"_s, "push"_s);
+		m.Add("Spaz"_s, "shoot_start"_s);
+		m.Add("Spaz"_s, "sidekick_start"_s);
+		m.Add("Spaz"_s, "sidekick"_s);
+		m.Add("Spaz"_s, "sidekick_end"_s);
+		m.Add("Spaz"_s, "fall_diag"_s);
+		m.Add("Spaz"_s, "jump_diag"_s);
+		m.Add("Spaz"_s, "ball"_s);
+		m.Add("Spaz"_s, "run"_s);
+		m.Add("Spaz"_s, "dash_start"_s);
+		m.Add("Spaz"_s, "dash"_s);
+		m.Add("Spaz"_s, "dash_stop"_s);
+		m.Add("Spaz"_s, "run_stop"_s);
+		m.Add("Spaz"_s, "unused_skid"_s);
+		m.Add("Spaz"_s, "Spring"_s);
+		m.Add("Spaz"_s, "idle"_s);
+		m.Add("Spaz"_s, "jump_stationary"_s);
+		m.Add("Spaz"_s, "jump_stationary_end"_s);
+		m.Add("Spaz"_s, "jump_stationary_start"_s);
+		m.Add("Spaz"_s, "dizzy"_s);
+		m.Add("Spaz"_s, "swim_down"_s);
+		m.Add("Spaz"_s, "swim_right"_s);
+		m.Add("Spaz"_s, "swim_turn_1"_s);
+		m.Add("Spaz"_s, "swim_turn_2"_s);
+		m.Add("Spaz"_s, "swim_up"_s);
+		m.Add("Spaz"_s, "swing"_s);
+		m.Add("Spaz"_s, "warp_in"_s);
+		m.Add("Spaz"_s, "warp_in_freefall"_s);
+		m.Add("Spaz"_s, "unused_warp_freefall"_s);
+		m.Add("Spaz"_s, "warp_out_freefall"_s);
+		m.Add("Spaz"_s, "warp_out"_s);
+		m.Add("Spaz"_s, "pole_v"_s);
+		m.Add("Spaz"_s, "transform_frog_end"_s);
+		m.NextSet();
+
+		// Spaz 2
+		m.Add("Unknown"_s, "spaz_2"_s);
+		m.NextSet();
+
+		// Spaz 3D
+		m.Add("Unknown"_s, "spaz_3d"_s);
+		m.NextSet(2);
+
+		// Spike Ball
+		m.Add("Unknown"_s, "spike_ball"_s);
+		m.NextSet();
+
+		// Spike Ball 3D
+		m.Add("Object"_s, "3d_spike"_s);
+		m.Add("Object"_s, "3d_spike_chain"_s);
+		m.NextSet();
+
+		// Spike Platform
+		m.Add("Platform"_s, "spike"_s);
+		m.Add("Platform"_s, "spike_chain"_s);
+		m.NextSet();
+
+		// Spring
+		m.Add("Spring"_s, "spring_blue_ver"_s);
+		m.Add("Spring"_s, "spring_blue_hor"_s);
+		m.Add("Spring"_s, "spring_blue_ver_reverse"_s);
+		m.Add("Spring"_s, "spring_green_ver_reverse"_s);
+		m.Add("Spring"_s, "spring_red_ver_reverse"_s);
+		m.Add("Spring"_s, "spring_green_ver"_s);
+		m.Add("Spring"_s, "spring_green_hor"_s);
+		m.Add("Spring"_s, "spring_red_ver"_s);
+		m.Add("Spring"_s, "spring_red_hor"_s);
+		m.NextSet();
+
+		// Steam
+		m.Add("Common"_s, "SteamNote"_s);
+		m.NextSet(2);
+
+		// Sucker
+		m.Add("Sucker"_s, "fall"_s);
+		m.Add("Sucker"_s, "inflated"_s);
+		m.Add("Sucker"_s, "inflated_deflate"_s);
+		m.Add("Sucker"_s, "walk"_s);
+		m.NextSet();
+
+		// Tube Turtle
+		m.Add("TurtleTube"_s, "Idle"_s);
+		m.NextSet();
+
+		// Tough Turtle Boss
+		m.Add("TurtleToughBoss"_s, "attack_start"_s);
+		m.Add("TurtleToughBoss"_s, "attack_end"_s);
+		m.Add("TurtleToughBoss"_s, "shell"_s);
+		m.Add("TurtleToughBoss"_s, "mace"_s);
+		m.Add("TurtleToughBoss"_s, "idle"_s);
+		m.Add("TurtleToughBoss"_s, "walk"_s);
+		m.NextSet();
+
+		// Tough Turtle
+		m.Add("TurtleTough"_s, "Walk"_s);
+		m.NextSet();
+
+		// Turtle
+		m.Add("Turtle"_s, "attack"_s);
+		m.Add("Turtle"_s, "idle_flavor"_s);
+		m.Add("Turtle"_s, "turn_start"_s);
+		m.Add("Turtle"_s, "turn_end"_s);
+		m.Add("Turtle"_s, "shell_reverse"_s);
+		m.Add("Turtle"_s, "shell"_s);
+		m.Add("Turtle"_s, "idle"_s);
+		m.Add("Turtle"_s, "walk"_s);
+		m.NextSet();
+
+		// Tweedle
+		m.Add("Tweedle"_s, "magnet_start"_s);
+		m.Add("Tweedle"_s, "spin"_s);
+		m.Add("Tweedle"_s, "magnet_end"_s);
+		m.Add("Tweedle"_s, "shoot_jazz"_s);
+		m.Add("Tweedle"_s, "shoot_spaz"_s);
+		m.Add("Tweedle"_s, "hurt"_s);
+		m.Add("Tweedle"_s, "idle"_s);
+		m.Add("Tweedle"_s, "duck"_s);
+		m.Add("Tweedle"_s, "walk"_s);
+		m.NextSet();
+
+		// Uterus
+		m.Add("Crab"_s, "fall_end"_s);
+		m.Add("Uterus"_s, "closed_start"_s);
+		m.Add("Uterus"_s, "closed_idle"_s);
+		m.Add("Uterus"_s, "idle"_s);
+		m.Add("Uterus"_s, "closed_end"_s);
+		m.Add("Uterus"_s, "shield"_s);
+		m.Add("Crab"_s, "fall"_s);
+		m.Add("Crab"_s, "walk"_s);
+		m.NextSet();
+
+		// Vine
+		m.Add("Object"_s, "vine"_s);
+		m.NextSet();
+
+		// Warp 10
+		m.Add("Object"_s, "Bonus10"_s);
+		m.NextSet();
+
+		// Warp 100
+		m.Add("Object"_s, "Bonus100"_s);
+		m.NextSet();
+
+		// Warp 20
+		m.Add("Object"_s, "Bonus20"_s);
+		m.NextSet();
+
+		// Warp 50
+		m.Add("Object"_s, "Bonus50"_s);
+		m.NextSet(2);
+
+		// Witch
+		m.Add("Witch"_s, "attack"_s);
+		m.Add("Witch"_s, "die"_s);
+		m.Add("Witch"_s, "idle"_s);
+		m.Add("Witch"_s, "bullet_magic"_s);
+		m.NextSet();
+
+		// Bilsy (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_throw_fireball"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_appear"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_vanish"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_bullet_fireball"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_idle"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Lizard (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_copter_attack"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_bomb"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_copter_idle"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_copter"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_walk"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Turtle (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_attack"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_idle_flavor"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_turn_start"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_turn_end"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_shell_reverse"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_shell"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_idle"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_walk"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Dog (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_attack"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_walk"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Spark (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Sparks"_s, "xmas_idle"_s);
+
+		return m;
+	}
+
+	AnimSetMapping AnimSetMapping::GetSampleMapping(JJ2Version version)
+	{
+		AnimSetMapping m(version);
+
+		if (version == JJ2Version::PlusExtension) {
+			// Extension sets don't contain any samples
+			return m;
+		}
+
+		// Ammo
+		m.Add("Weapon"_s, "bullet_blub_1"_s);
+		m.Add("Weapon"_s, "bullet_blub_2"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_1"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_2"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_3"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_4"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_5"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_upgraded_6"_s);
+		m.Add("Weapon"_s, "tnt_explosion"_s);
+		m.Add("Weapon"_s, "ricochet_contact"_s);
+		m.Add("Weapon"_s, "ricochet_bullet_1"_s);
+		m.Add("Weapon"_s, "ricochet_bullet_2"_s);
+		m.Add("Weapon"_s, "ricochet_bullet_3"_s);
+		m.Add("Weapon"_s, "toaster"_s);
+		m.Add("Weapon"_s, "toaster_upgraded"_s);
+		m.Add("Weapon"_s, "bullet_pepper"_s);
+		m.Add("Weapon"_s, "bullet_blaster_jazz_1"_s);
+		m.Add("Weapon"_s, "bullet_blaster_jazz_2"_s);
+		m.Add("Weapon"_s, "bouncer"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_1"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_2"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_3"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_4"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_5"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_6"_s);
+		m.Add("Weapon"_s, "bullet_blaster_jazz_3"_s);
+		m.Add("Weapon"_s, "bullet_blaster_jazz_4"_s);
+		m.Add("Weapon"_s, "bullet_freezer_1"_s);
+		m.Add("Weapon"_s, "bullet_freezer_2"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_1"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_2"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_3"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_4"_s);
+		m.Add("Weapon"_s, "bullet_freezer_upgraded_5"_s);
+		m.Add("Weapon"_s, "bullet_electro_1"_s);
+		m.Add("Weapon"_s, "bullet_electro_2"_s);
+		m.Add("Weapon"_s, "bullet_electro_3"_s);
+		m.Add("Weapon"_s, "bullet_rf"_s);
+		m.Add("Weapon"_s, "bullet_seeker"_s);
+		m.Add("Weapon"_s, "bullet_blaster_spaz_1"_s);
+		m.Add("Weapon"_s, "bullet_blaster_spaz_2"_s);
+		m.Add("Weapon"_s, "bullet_blaster_spaz_3"_s);
+		m.Add("Weapon"_s, "bullet_bouncer_7"_s);
+		m.Add("Weapon"_s, "wall_poof"_s);
+		m.NextSet();
+
+		// Bat
+		m.Add("Bat"_s, "noise"_s);
+		m.NextSet(6);
+
+		// Bilsy
+		m.Add("Bilsy"_s, "appear_2"_s);
+		m.Add("Bilsy"_s, "snap"_s);
+		m.Add("Bilsy"_s, "throw_fireball"_s);
+		m.Add("Bilsy"_s, "fire_start"_s);
+		m.Add("Bilsy"_s, "scary"_s);
+		m.Add("Bilsy"_s, "thunder"_s);
+		m.Add("Bilsy"_s, "appear_1"_s);
+		m.NextSet(4);
+
+		// Bonus
+		m.Add("Unknown"_s, "unknown_bonus1"_s);
+		m.Add("Object"_s, "BonusNotEnoughCoins"_s);
+		m.NextSet(3);
+
+		// Bubba
+		m.Add("Bubba"_s, "hop_1"_s);
+		m.Add("Bubba"_s, "hop_2"_s);
+		m.Add("Bubba"_s, "unknown_bubba_1"_s);
+		m.Add("Bubba"_s, "unknown_bubba_2"_s);
+		m.Add("Bubba"_s, "unknown_bubba_3"_s);
+		m.Add("Bubba"_s, "unknown_bubba_4"_s);
+		m.Add("Bubba"_s, "unknown_bubba_5"_s);
+		m.Add("Bubba"_s, "sneeze"_s);
+		m.Add("Bubba"_s, "tornado"_s);
+		m.NextSet();
+
+		// Bumbee
+		m.Add("Bee"_s, "noise"_s);
+		m.NextSet(5);
+
+		// Caterpillar
+		m.Add("Caterpillar"_s, "dizzy"_s);
+		m.NextSet(2);
+
+		// Common
+		m.Add("Common"_s, "airboard"_s);
+		m.Add("Common"_s, "airboard_turn"_s);
+		m.Add("Common"_s, "airboard_turn_2"_s);
+		m.Add("Common"_s, "base_1"_s);
+		m.Add("Common"_s, "bell_fire"_s);
+		m.Add("Common"_s, "bell_fire_2"_s);
+		m.Add("Common"_s, "benzin"_s);
+		m.Add("Birdy"_s, "fly_1"_s);
+		m.Add("Birdy"_s, "fly_2"_s);
+		m.Add("Common"_s, "scenery_destruct"_s);
+		m.Add("Common"_s, "blub"_s);
+		m.Add("Common"_s, "bubblgun"_s);
+		m.Add("Common"_s, "burn"_s);
+		m.Add("Common"_s, "ambient_fire"_s);
+		m.Add("Common"_s, "can_sps"_s);
+		m.Add("Common"_s, "clock"_s);
+		m.Add("Pickup"_s, "coin"_s);
+		m.Add("Common"_s, "scenery_collapse"_s);
+		m.Add("Common"_s, "cup"_s);
+		m.Add("Common"_s, "damped"_s);
+		m.Add("Common"_s, "down"_s);
+		m.Add("Common"_s, "down_fl_2"_s);
+		m.Add("Pickup"_s, "food_drink_1"_s);
+		m.Add("Pickup"_s, "food_drink_2"_s);
+		m.Add("Pickup"_s, "food_drink_3"_s);
+		m.Add("Pickup"_s, "food_drink_4"_s);
+		m.Add("Pickup"_s, "food_edible_1"_s);
+		m.Add("Pickup"_s, "food_edible_2"_s);
+		m.Add("Pickup"_s, "food_edible_3"_s);
+		m.Add("Pickup"_s, "food_edible_4"_s);
+		m.Add("Common"_s, "electric_1"_s);
+		m.Add("Common"_s, "electric_2"_s);
+		m.Add("Common"_s, "electric_hit"_s);
+		m.Add("Common"_s, "bomb"_s);
+		m.Add("Common"_s, "explosion_small"_s);
+		m.Add("Common"_s, "flamer"_s);
+		m.Add("Common"_s, "flap"_s);
+		m.Add("Common"_s, "foew_1"_s);
+		m.Add("Common"_s, "foew_2"_s);
+		m.Add("Common"_s, "foew_3"_s);
+		m.Add("Common"_s, "foew_4"_s);
+		m.Add("Common"_s, "foew_5"_s);
+		m.Add("Object"_s, "GemSuperBreak"_s);
+		m.Add("Object"_s, "container_crate_break"_s);
+		m.Add("Common"_s, "gunsm1"_s);
+		m.Add("Common"_s, "harp"_s);
+		m.Add("Common"_s, "swish_9"_s);
+		m.Add("Common"_s, "copter_noise"_s);
+		m.Add("Object"_s, "SavepointOpen"_s);
+		m.Add("Common"_s, "holyflut"_s);
+		m.Add("Common"_s, "horn"_s);
+		m.Add("Common"_s, "ice_crush"_s);
+		m.Add("Object"_s, "shell_noise_1"_s);
+		m.Add("Object"_s, "shell_noise_2"_s);
+		m.Add("Object"_s, "shell_noise_3"_s);
+		m.Add("Object"_s, "shell_noise_4"_s);
+		m.Add("Object"_s, "shell_noise_5"_s);
+		m.Add("Object"_s, "shell_noise_6"_s);
+		m.Add("Object"_s, "shell_noise_7"_s);
+		m.Add("Object"_s, "shell_noise_8"_s);
+		m.Add("Object"_s, "shell_noise_9"_s);
+		m.Add("Pickup"_s, "ammo"_s);
+		m.Add("Common"_s, "char_jump"_s);
+		m.Add("Common"_s, "char_double_jump"_s);
+		m.Add("Common"_s, "char_land"_s);
+		m.Add("Common"_s, "land_1"_s);
+		m.Add("Common"_s, "land_2"_s);
+		m.Add("Common"_s, "splat_5"_s);
+		m.Add("Common"_s, "splat_6"_s);
+		m.Add("Common"_s, "land_pop"_s);
+		m.Add("Common"_s, "load_jazz"_s);
+		m.Add("Common"_s, "load_spaz"_s);
+		m.Add("Common"_s, "metal_hit"_s);
+		m.Add("Object"_s, "PowerupBreak"_s);
+		m.Add("Common"_s, "no_coin"_s);
+		m.Add("Pickup"_s, "gem"_s);
+		m.Add("Pickup"_s, "1up"_s);
+		m.Add("Common"_s, "pistol"_s);
+		m.Add("Common"_s, "ploop"_s);
+		m.Add("Common"_s, "plop_1"_s);
+		m.Add("Common"_s, "plop_2"_s);
+		m.Add("Common"_s, "plop_3"_s);
+		m.Add("Common"_s, "plop_4"_s);
+		m.Add("Common"_s, "plop_kork"_s);
+		m.Add("Common"_s, "pre_explosion"_s);
+		m.Add("Common"_s, "pre_copter"_s);
+		m.Add("Common"_s, "char_revup"_s);
+		m.Add("UI"_s, "weapon_change"_s);
+		m.Add("Common"_s, "ring_gun_2"_s);
+		m.Add("Common"_s, "shield_1"_s);
+		m.Add("Common"_s, "shield_4"_s);
+		m.Add("Common"_s, "shield_electric"_s);
+		m.Add("Common"_s, "shield_off"_s);
+		m.Add("Common"_s, "slip"_s);
+		m.Add("Object"_s, "container_barrel_break"_s);
+		m.Add("Common"_s, "splat_1"_s);
+		m.Add("Common"_s, "splat_2"_s);
+		m.Add("Common"_s, "splat_3"_s);
+		m.Add("Common"_s, "splat_4"_s);
+		m.Add("Spring"_s, "Spring"_s);
+		m.Add("Common"_s, "SteamNote"_s);
+		m.Add("Common"_s, "step"_s);
+		m.Add("Common"_s, "stretch"_s);
+		m.Add("Common"_s, "swish_1"_s);
+		m.Add("Common"_s, "swish_2"_s);
+		m.Add("Common"_s, "swish_3"_s);
+		m.Add("Common"_s, "swish_4"_s);
+		m.Add("Common"_s, "swish_5"_s);
+		m.Add("Common"_s, "swish_6"_s);
+		m.Add("Common"_s, "swish_7"_s);
+		m.Add("Common"_s, "swish_8"_s);
+		m.Add("Common"_s, "warp_in"_s);
+		m.Add("Common"_s, "warp_out"_s);
+		m.Add("Common"_s, "char_up"_s);
+		m.Add("Common"_s, "water_splash"_s);
+		m.Add("Common"_s, "wood"_s);
+		m.NextSet(2);
+
+		// Demon
+		m.Add("Demon"_s, "run"_s);
+		m.NextSet(3);
+
+		// Devil Devan
+		m.Add("Devan"_s, "spit_fireball"_s);
+		m.Add("Devan"_s, "flap"_s);
+		m.Add("Devan"_s, "unknown_frog_4"_s);
+		m.Add("Devan"_s, "jump_up"_s);
+		m.Add("Devan"_s, "laugh"_s);
+		m.Add("Devan"_s, "shoot"_s);
+		m.Add("Devan"_s, "transform_demon_stretch_2"_s);
+		m.Add("Devan"_s, "transform_demon_stretch_4"_s);
+		m.Add("Devan"_s, "transform_demon_stretch_1"_s);
+		m.Add("Devan"_s, "transform_demon_stretch_3"_s);
+		m.Add("Devan"_s, "vanish"_s);
+		m.Add("Devan"_s, "unknown_whistle"_s);
+		m.Add("Devan"_s, "transform_demon_wings"_s);
+		m.NextSet(2);
+
+		// Dog
+		m.Add("Doggy"_s, "attack"_s);
+		m.Add("Doggy"_s, "noise"_s);
+		m.Add("Doggy"_s, "woof_1"_s);
+		m.Add("Doggy"_s, "woof_2"_s);
+		m.Add("Doggy"_s, "woof_3"_s);
+		m.NextSet(2);
+
+		// Dragonfly
+		m.Add("Dragonfly"_s, "noise"_s);
+		m.NextSet(2);
+
+		// Ending
+		m.Add("Cinematics"_s, "ending_oh_thank"_s);
+		m.NextSet();
+
+		// End Tape
+		m.Add("Cinematics"_s, "ending_tape_bold"_s);
+		m.Add("Cinematics"_s, "ending_tape_ding"_s);
+		m.Add("Cinematics"_s, "ending_tape_drop"_s);
+		m.Add("Cinematics"_s, "ending_tape_scratch"_s);
+		m.NextSet();
+
+		// Epic Logo
+		m.Add("Cinematics"_s, "logo_epic_1"_s);
+		m.Add("Cinematics"_s, "logo_epic_2"_s);
+		m.NextSet();
+
+		// Eva
+		m.Add("Eva"_s, "Kiss1"_s);
+		m.Add("Eva"_s, "Kiss2"_s);
+		m.Add("Eva"_s, "Kiss3"_s);
+		m.Add("Eva"_s, "Kiss4"_s);
+		m.NextSet(2);
+
+		// Fan
+		m.Add("Unknown"_s, "fan"_s);
+		m.NextSet();
+
+		// Fat Chick
+		m.Add("FatChick"_s, "attack_1"_s);
+		m.Add("FatChick"_s, "attack_2"_s);
+		m.Add("FatChick"_s, "attack_3"_s);
+		m.NextSet();
+
+		// Fencer
+		m.Add("Fencer"_s, "attack"_s);
+		m.NextSet(5);
+
+		// Frog
+		m.Add("Frog"_s, "noise_1"_s);
+		m.Add("Frog"_s, "noise_2"_s);
+		m.Add("Frog"_s, "noise_3"_s);
+		m.Add("Frog"_s, "noise_4"_s);
+		m.Add("Frog"_s, "noise_5"_s);
+		m.Add("Frog"_s, "noise_6"_s);
+		m.Add("Frog"_s, "transform"_s);
+		m.Add("Frog"_s, "tongue"_s);
+		m.NextSet(3);
+
+		// Glove
+		m.Add("Unknown"_s, "boxing_glove_hit"_s);
+		m.NextSet(2);
+
+		// Madder Hatter
+		m.Add("MadderHatter"_s, "cup"_s);
+		m.Add("MadderHatter"_s, "hat"_s);
+		m.Add("MadderHatter"_s, "spit"_s);
+		m.Add("MadderHatter"_s, "bullet_splash_1"_s);
+		m.Add("MadderHatter"_s, "bullet_splash_2"_s);
+		m.NextSet(2);
+
+		// Intro
+		m.Add("Cinematics"_s, "intro_blow"_s);
+		m.Add("Cinematics"_s, "intro_boom_1"_s);
+		m.Add("Cinematics"_s, "intro_boom_2"_s);
+		m.Add("Cinematics"_s, "intro_brake"_s);
+		m.Add("Cinematics"_s, "intro_end"_s);
+		m.Add("Cinematics"_s, "intro_grab"_s);
+		m.Add("Cinematics"_s, "intro_grenade_1"_s);
+		m.Add("Cinematics"_s, "intro_grenade_2"_s);
+		m.Add("Cinematics"_s, "intro_grenade_3"_s);
+		m.Add("Cinematics"_s, "intro_gun_noise_1"_s);
+		m.Add("Cinematics"_s, "intro_gun_noise_2"_s);
+		m.Add("Cinematics"_s, "intro_gun_noise_3"_s);
+		m.Add("Cinematics"_s, "intro_helicopter"_s);
+		m.Add("Cinematics"_s, "intro_hit_spaz"_s);
+		m.Add("Cinematics"_s, "intro_hit_turtle"_s);
+		m.Add("Cinematics"_s, "intro_i_feel"_s);
+		m.Add("Cinematics"_s, "intro_inhale"_s);
+		m.Add("Cinematics"_s, "intro_insect"_s);
+		m.Add("Cinematics"_s, "intro_kater"_s);
+		m.Add("Cinematics"_s, "intro_land"_s);
+		m.Add("Cinematics"_s, "intro_monster_1"_s);
+		m.Add("Cinematics"_s, "intro_monster_2"_s);
+		m.Add("Cinematics"_s, "intro_rock"_s);
+		m.Add("Cinematics"_s, "intro_rope_1"_s);
+		m.Add("Cinematics"_s, "intro_rope_2"_s);
+		m.Add("Cinematics"_s, "intro_run"_s);
+		m.Add("Cinematics"_s, "intro_shot_1"_s);
+		m.Add("Cinematics"_s, "intro_shot_grn"_s);
+		m.Add("Cinematics"_s, "intro_ski"_s);
+		m.Add("Cinematics"_s, "intro_string"_s);
+		m.Add("Cinematics"_s, "intro_swish_1"_s);
+		m.Add("Cinematics"_s, "intro_swish_2"_s);
+		m.Add("Cinematics"_s, "intro_swish_3"_s);
+		m.Add("Cinematics"_s, "intro_swish_4"_s);
+		m.Add("Cinematics"_s, "intro_swish_rock"_s);
+		m.Add("Cinematics"_s, "intro_throw"_s);
+		m.Add("Cinematics"_s, "intro_turtle"_s);
+		m.Add("Cinematics"_s, "intro_uh_turtle"_s);
+		m.Add("Cinematics"_s, "intro_whip"_s);
+		m.NextSet(3);
+
+		// Jazz Sounds
+		m.Add("Jazz"_s, "ledge"_s);
+		m.Add("Jazz"_s, "hurt_1"_s);
+		m.Add("Jazz"_s, "hurt_2"_s);
+		m.Add("Jazz"_s, "hurt_3"_s);
+		m.Add("Jazz"_s, "hurt_4"_s);
+		m.Add("Jazz"_s, "idle"_s);
+		m.Add("Jazz"_s, "hurt_5"_s);
+		m.Add("Jazz"_s, "hurt_6"_s);
+		m.Add("Jazz"_s, "hurt_7"_s);
+		m.Add("Jazz"_s, "hurt_8"_s);
+		m.Add("Jazz"_s, "carrot"_s);
+		m.Add("Jazz"_s, "level_complete"_s);
+		m.NextSet(2);
+
+		// Lab Rat
+		m.Add("LabRat"_s, "attack"_s);
+		m.Add("LabRat"_s, "noise_1"_s);
+		m.Add("LabRat"_s, "noise_2"_s);
+		m.Add("LabRat"_s, "noise_3"_s);
+		m.Add("LabRat"_s, "noise_4"_s);
+		m.Add("LabRat"_s, "noise_5"_s);
+		m.NextSet();
+
+		// Lizard
+		m.Add("Lizard"_s, "noise_1"_s);
+		m.Add("Lizard"_s, "noise_2"_s);
+		m.Add("Lizard"_s, "noise_3"_s);
+		m.Add("Lizard"_s, "noise_4"_s);
+		m.NextSet();
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+
+		// Lori Sounds (TSF, CC)
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "die"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_1"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_2"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_3"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_4"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_5"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_6"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_7"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "hurt_8"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_1"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "idle_flavor_2"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "level_complete"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "fall"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_2"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_3"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "jump_4"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "touch"_s);
+		m.Add(JJ2Version::TSF | JJ2Version::CC, "Lori"_s, "wehoo"_s);
+		m.NextSet(1, JJ2Version::TSF | JJ2Version::CC);
+		m.NextSet(2);
+
+		// Menu Sounds
+		m.Add("UI"_s, "select_1"_s);
+		m.Add("UI"_s, "select_2"_s);
+		m.Add("UI"_s, "select_3"_s);
+		m.Add("UI"_s, "select_4"_s);
+		m.Add("UI"_s, "select_5"_s);
+		m.Add("UI"_s, "select_6"_s);
+		m.Add("UI"_s, "select_7"_s);
+		m.Add("UI"_s, "type_char"_s);
+		m.Add("UI"_s, "type_enter"_s);
+		m.NextSet();
+
+		// Monkey
+		m.Add("Monkey"_s, "BananaSplat"_s);
+		m.Add("Monkey"_s, "BananaThrow"_s);
+		m.NextSet();
+
+		// Moth
+		m.Add("Moth"_s, "flap"_s);
+		m.NextSet();
+
+		// Orange
+		m.Add("Cinematics"_s, "orange_boom_l"_s);
+		m.Add("Cinematics"_s, "orange_boom_r"_s);
+		m.Add("Cinematics"_s, "orange_bubbles_l"_s);
+		m.Add("Cinematics"_s, "orange_bubbles_r"_s);
+		m.Add("Cinematics"_s, "orange_glass_1_l"_s);
+		m.Add("Cinematics"_s, "orange_glass_1_r"_s);
+		m.Add("Cinematics"_s, "orange_glass_2_l"_s);
+		m.Add("Cinematics"_s, "orange_glass_2_r"_s);
+		m.Add("Cinematics"_s, "orange_merge"_s);
+		m.Add("Cinematics"_s, "orange_sweep_0_l"_s);
+		m.Add("Cinematics"_s, "orange_sweep_0_r"_s);
+		m.Add("Cinematics"_s, "orange_sweep_1_l"_s);
+		m.Add("Cinematics"_s, "orange_sweep_1_r"_s);
+		m.Add("Cinematics"_s, "orange_sweep_2_l"_s);
+		m.Add("Cinematics"_s, "orange_sweep_2_r"_s);
+		m.NextSet();
+
+		// P2
+		m.Add("Unknown"_s, "p2_crunch"_s);
+		m.Add("Unknown"_s, "p2_fart"_s);
+		m.Add("Unknown"_s, "p2_foew_1"_s);
+		m.Add("Unknown"_s, "p2_foew_4"_s);
+		m.Add("Unknown"_s, "p2_foew_5"_s);
+		m.Add("Unknown"_s, "p2_frog_1"_s);
+		m.Add("Unknown"_s, "p2_frog_2"_s);
+		m.Add("Unknown"_s, "p2_frog_3"_s);
+		m.Add("Unknown"_s, "p2_frog_4"_s);
+		m.Add("Unknown"_s, "p2_frog_5"_s);
+		m.Add("Unknown"_s, "p2_kiss_4"_s);
+		m.Add("Unknown"_s, "p2_open"_s);
+		m.Add("Unknown"_s, "p2_pinch_1"_s);
+		m.Add("Unknown"_s, "p2_pinch_2"_s);
+		m.Add("Unknown"_s, "p2_plop_1"_s);
+		m.Add("Unknown"_s, "p2_plop_2"_s);
+		m.Add("Unknown"_s, "p2_plop_3"_s);
+		m.Add("Unknown"_s, "p2_plop_4"_s);
+		m.Add("Unknown"_s, "p2_poep"_s);
+		m.Add("Unknown"_s, "p2_ptoei"_s);
+		m.Add("Unknown"_s, "p2_splout"_s);
+		m.Add("Unknown"_s, "p2_splut"_s);
+		m.Add("Unknown"_s, "p2_throw"_s);
+		m.Add("Unknown"_s, "p2_tong"_s);
+		m.NextSet();
+
+		// Pickups
+		m.Add("Pickup"_s, "bonus_check"_s);
+		m.Add("Pickup"_s, "copter"_s);
+		m.Add("Pickup"_s, "stretch"_s);
+		m.NextSet();
+
+		// Pinball
+		m.Add("Pinball"_s, "BumperHit"_s);
+		m.Add("Pinball"_s, "flipper_1"_s);
+		m.Add("Pinball"_s, "flipper_2"_s);
+		m.Add("Pinball"_s, "flipper_3"_s);
+		m.Add("Pinball"_s, "flipper_4"_s);
+		m.NextSet(3);
+
+		// Queen
+		m.Add("Queen"_s, "Spring"_s);
+		m.Add("Queen"_s, "scream"_s);
+		m.NextSet();
+
+		// Rapier
+		m.Add("Rapier"_s, "die"_s);
+		m.Add("Rapier"_s, "noise_1"_s);
+		m.Add("Rapier"_s, "noise_2"_s);
+		m.Add("Rapier"_s, "noise_3"_s);
+		m.Add("Rapier"_s, "clunk"_s);
+		m.NextSet(2);
+
+		// Robot
+		m.Add("Robot"_s, "unknown_big_1"_s);
+		m.Add("Robot"_s, "unknown_big_2"_s);
+		m.Add("Robot"_s, "can_1"_s);
+		m.Add("Robot"_s, "can_2"_s);
+		m.Add("Robot"_s, "attack_start"_s);
+		m.Add("Robot"_s, "attack_end"_s);
+		m.Add("Robot"_s, "attack"_s);
+		m.Add("Robot"_s, "hydro_puf"_s);
+		m.Add("Robot"_s, "idle_1"_s);
+		m.Add("Robot"_s, "idle_2"_s);
+		m.Add("Robot"_s, "jump_can_1"_s);
+		m.Add("Robot"_s, "jump_can_10"_s);
+		m.Add("Robot"_s, "jump_can_2"_s);
+		m.Add("Robot"_s, "jump_can_3"_s);
+		m.Add("Robot"_s, "jump_can_4"_s);
+		m.Add("Robot"_s, "jump_can_5"_s);
+		m.Add("Robot"_s, "jump_can_6"_s);
+		m.Add("Robot"_s, "jump_can_7"_s);
+		m.Add("Robot"_s, "jump_can_8"_s);
+		m.Add("Robot"_s, "jump_can_9"_s);
+		m.Add("Robot"_s, "shrapnel_1"_s);
+		m.Add("Robot"_s, "shrapnel_2"_s);
+		m.Add("Robot"_s, "shrapnel_3"_s);
+		m.Add("Robot"_s, "shrapnel_4"_s);
+		m.Add("Robot"_s, "shrapnel_5"_s);
+		m.Add("Robot"_s, "attack_start_shutter"_s);
+		m.Add("Robot"_s, "out"_s);
+		m.Add("Robot"_s, "poep"_s);
+		m.Add("Robot"_s, "pole"_s);
+		m.Add("Robot"_s, "shoot"_s);
+		m.Add("Robot"_s, "walk_1"_s);
+		m.Add("Robot"_s, "walk_2"_s);
+		m.Add("Robot"_s, "walk_3"_s);
+		m.NextSet();
+
+		// Rock
+		m.Add("Object"_s, "rolling_rock"_s);
+		m.NextSet(2);
+
+		// Rush
+		m.Add("Common"_s, "wind"_s);
+		m.NextSet();
+
+		// Science
+		m.Add("Common"_s, "science_noise"_s);
+		m.NextSet();
+
+		// Skeleton
+		m.Add("Skeleton"_s, "bone_1"_s);
+		m.Add("Skeleton"_s, "bone_2"_s);
+		m.Add("Skeleton"_s, "bone_3"_s);
+		m.Add("Skeleton"_s, "bone_5"_s);
+		m.Add("Skeleton"_s, "bone_6"_s);
+		m.Add("Skeleton"_s, "bone_7"_s);
+		m.NextSet();
+
+		// Small Tree
+		m.Add("Unknown"_s, "small_tree_fall"_s);
+		m.Add("Unknown"_s, "small_tree_ground"_s);
+		m.Add("Unknown"_s, "small_tree_head"_s);
+		m.NextSet(2);
+
+		// Sonic Ship
+		m.Add("Bolly"_s, "missile_1"_s);
+		m.Add("Bolly"_s, "missile_2"_s);
+		m.Add("Bolly"_s, "missile_3"_s);
+		m.Add("Bolly"_s, "noise"_s);
+		m.Add("Bolly"_s, "target_lock"_s);
+		m.NextSet(6);
+
+		// Spaz Sounds
+		m.Add("Spaz"_s, "hurt_1"_s);
+		m.Add("Spaz"_s, "hurt_2"_s);
+		m.Add("Spaz"_s, "idle_flavor_3_bird_land"_s);
+		m.Add("Spaz"_s, "idle_flavor_4"_s);
+		m.Add("Spaz"_s, "idle_flavor_3_bird"_s);
+		m.Add("Spaz"_s, "idle_flavor_3_eat"_s);
+		m.Add("Spaz"_s, "jump_1"_s);
+		m.Add("Spaz"_s, "jump_2"_s);
+		m.Add("Spaz"_s, "idle_flavor_2"_s);
+		m.Add("Spaz"_s, "hihi"_s);
+		m.Add("Spaz"_s, "spring_1"_s);
+		m.Add("Spaz"_s, "double_jump"_s);
+		m.Add("Spaz"_s, "sidekick_1"_s);
+		m.Add("Spaz"_s, "sidekick_2"_s);
+		m.Add("Spaz"_s, "spring_2"_s);
+		m.Add("Spaz"_s, "ooh"_s);
+		m.Add("Spaz"_s, "ledge"_s);
+		m.Add("Spaz"_s, "jump_3"_s);
+		m.Add("Spaz"_s, "jump_4"_s);
+		m.Add("Spaz"_s, "level_complete"_s);
+		m.NextSet(4);
+
+		// Spring
+		m.Add("Spring"_s, "spring_ver_down"_s);
+		m.Add("Spring"_s, "spring_2"_s);
+		m.NextSet();
+
+		// Steam
+		m.Add("Common"_s, "steam"_s);
+		m.NextSet();
+
+		// Stoned
+		m.Add("Unknown"_s, "stoned"_s);
+		m.NextSet();
+
+		// Sucker
+		m.Add("Sucker"_s, "deflate"_s);
+		m.Add("Sucker"_s, "pinch_1"_s);
+		m.Add("Sucker"_s, "pinch_2"_s);
+		m.Add("Sucker"_s, "pinch_3"_s);
+		m.Add("Sucker"_s, "plop_1"_s);
+		m.Add("Sucker"_s, "plop_2"_s);
+		m.Add("Sucker"_s, "plop_3"_s);
+		m.Add("Sucker"_s, "plop_4"_s);
+		m.Add("Sucker"_s, "up"_s);
+		m.NextSet(2);
+
+		// Tough Turtle Boss
+		m.Add("TurtleToughBoss"_s, "attack_start"_s);
+		m.Add("TurtleToughBoss"_s, "attack_end"_s);
+		m.Add("TurtleToughBoss"_s, "mace"_s);
+		m.NextSet(2);
+
+		// Turtle
+		m.Add("Turtle"_s, "attack_bite"_s);
+		m.Add("Turtle"_s, "turn_start"_s);
+		m.Add("Turtle"_s, "shell_collide"_s);
+		m.Add("Turtle"_s, "idle_1"_s);
+		m.Add("Turtle"_s, "idle_2"_s);
+		m.Add("Turtle"_s, "attack_neck"_s);
+		m.Add("Turtle"_s, "noise_1"_s);
+		m.Add("Turtle"_s, "noise_2"_s);
+		m.Add("Turtle"_s, "noise_3"_s);
+		m.Add("Turtle"_s, "noise_4"_s);
+		m.Add("Turtle"_s, "turn_end"_s);
+		m.NextSet(2);
+
+		// Uterus
+		m.Add("Uterus"_s, "closed_start"_s);
+		m.Add("Uterus"_s, "closed_end"_s);
+		m.Add("Crab"_s, "noise_1"_s);
+		m.Add("Crab"_s, "noise_2"_s);
+		m.Add("Crab"_s, "noise_3"_s);
+		m.Add("Crab"_s, "noise_4"_s);
+		m.Add("Crab"_s, "noise_5"_s);
+		m.Add("Crab"_s, "noise_6"_s);
+		m.Add("Crab"_s, "noise_7"_s);
+		m.Add("Crab"_s, "noise_8"_s);
+		m.Add("Crab"_s, "step_1"_s);
+		m.Add("Crab"_s, "step_2"_s);
+		m.NextSet(6);
+
+		// Wind
+		m.Add("Common"_s, "wind_2"_s);
+		m.NextSet();
+
+		// Witch
+		m.Add("Witch"_s, "laugh"_s);
+		m.Add("Witch"_s, "magic"_s);
+		m.NextSet();
+
+		// Bilsy (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_appear_2"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_snap"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_throw_fireball"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_fire_start"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_scary"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_thunder"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Bilsy"_s, "xmas_appear_1"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Lizard (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_noise_1"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_noise_2"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_noise_3"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Lizard"_s, "xmas_noise_4"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Turtle (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_attack_bite"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_turn_start"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_shell_collide"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_idle_1"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_idle_2"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_attack_neck"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_noise_1"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_noise_2"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_noise_3"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_noise_4"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Turtle"_s, "xmas_turn_end"_s);
+		m.NextSet(1, JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC);
+
+		// Dog (Xmas) (HH, TSF, CC)
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_attack"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_noise"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_woof_1"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_woof_2"_s);
+		m.Add(JJ2Version::HH | JJ2Version::TSF | JJ2Version::CC, "Doggy"_s, "xmas_woof_3"_s);
+
+		return m;
+	}
+
+	void AnimSetMapping::DiscardItems(int advanceBy, JJ2Version appliesTo)
+	{
+		if ((_version & appliesTo) != JJ2Version::Unknown) {
+			for (int i = 0; i < advanceBy; i++) {
+				Entry entry = { };
+				entry.Category = Discard;
+				_entries.emplace(GetKey(_currentSet, _currentItem), std::move(entry));
+				_currentItem++;
+			}
+		}
+	}
+
+	void AnimSetMapping::SkipItems(int advanceBy)
+	{
+		_currentItem += advanceBy;
+	}
+
+	void AnimSetMapping::NextSet(int advanceBy, JJ2Version appliesTo)
+	{
+		if ((_version & appliesTo) != JJ2Version::Unknown) {
+			_currentSet += advanceBy;
+			_currentItem = 0;
+		}
+	}
+
+	void AnimSetMapping::Add(JJ2Version appliesTo, const StringView& category, const StringView& name, const uint8_t* palette, bool skipNormalMap, int addBorder, bool allowRealtimePalette)
+	{
+		if ((_version & appliesTo) != JJ2Version::Unknown) {
+			Entry entry;
+			entry.Category = category;
+			entry.Name = name;
+			entry.Palette = palette;
+			entry.SkipNormalMap = skipNormalMap;
+			entry.AddBorder = addBorder;
+			entry.AllowRealtimePalette = allowRealtimePalette;
+			_entries.emplace(GetKey(_currentSet, _currentItem), std::move(entry));
+			_currentItem++;
+		}
+	}
+
+	void AnimSetMapping::Add(const StringView& category, const StringView& name, const uint8_t* palette, bool skipNormalMap, int addBorder, bool allowRealtimePalette)
+	{
+		Add(JJ2Version::All, category, name, palette, skipNormalMap, addBorder, allowRealtimePalette);
+	}
 }
\ No newline at end of file
@@ -1,46 +1,59 @@
 ﻿#pragma once
 
 #include "../../Common.h"
+#include "../../nCine/Base/HashMap.h"
 #include "JJ2Version.h"
 
+#include <Containers/String.h>
 #include <Containers/StringView.h>
 
 using namespace Death::Containers;
+using namespace nCine;
 
 namespace Jazz2::Compatibility
 {
-    class AnimSetMapping
-    {
-    public:
-        static constexpr char Discard[] = ":discard";
-
-        struct Entry {
-            String Category;
-            String Name;
-
-            uint8_t Palette[256];
-            bool SkipNormalMap;
-            int AddBorder;
-            bool AllowRealtimePalette;
-        };
-
-        AnimSetMapping(JJ2Version version)
-            :
-            _version(version)
-        {
-        }
-
-        Entry& Get(int set, int item);
-
-        static AnimSetMapping GetAnimMapping(JJ2Version version);
-
-    private:
-        JJ2Version _version;
-
-        void DiscardItems(int advanceBy, JJ2Version appliesTo = JJ2Version::All);
-        void SkipItems(int advanceBy = 1);
-        void NextSet(int advanceBy = 1, JJ2Version appliesTo = JJ2Version::All);
-        void Add(JJ2Version appliesTo, const StringView& category, const StringView& name, uint8_t* palette = nullptr, bool skipNormalMap = false, int addBorder = 0, bool allowRealtimePalette = false);
-        void Add(const StringView& category, const StringView& name, uint8_t* palette = nullptr, bool skipNormalMap = false, int addBorder = 0, bool allowRealtimePalette = false);
-    };
+	/// Maps animations and samples of original game files to target paths
+	class AnimSetMapping
+	{
+	public:
+		static constexpr char Discard[] = ":discard";
+
+		struct Entry {
+			String Category;
+			String Name;
+
+			/// Optional remapping of palette indices, it has always 256 items
+			const uint8_t* Palette;
+			bool SkipNormalMap;
+			int AddBorder;
+			bool AllowRealtimePalette;
+		};
+
+		AnimSetMapping(JJ2Version version)
+			: _version(version), _currentSet(0), _currentItem(0)
+		{
+		}
+
+		/// Returns target of specified item or `nullptr` if it's not mapped
+		const Entry* Get(int set, int item) const;
+
+		static AnimSetMapping GetAnimMapping(JJ2Version version);
+		static AnimSetMapping GetSampleMapping(JJ2Version version);
+
+	private:
+		JJ2Version _version;
+		int _currentSet;
+		int _currentItem;
+		HashMap<uint32_t, Entry> _entries;
+
+		void DiscardItems(int advanceBy, JJ2Version appliesTo = JJ2Version::All);
+		void SkipItems(int advanceBy = 1);
+		void NextSet(int advanceBy = 1, JJ2Version appliesTo = JJ2Version::All);
+		void Add(JJ2Version appliesTo, const StringView& category, const StringView& name, const uint8_t* palette = nullptr, bool skipNormalMap = false, int addBorder = 0, bool allowRealtimePalette = false);
+		void Add(const StringView& category, const StringView& name, const uint8_t* palette = nullptr, bool skipNormalMap = false, int addBorder = 0, bool allowRealtimePalette = false);
+
+		static uint32_t GetKey(int set, int item) {
+			return ((uint32_t)set << 16) | (uint32_t)item;
+		}
+	};
 }
\ No newline at end of file
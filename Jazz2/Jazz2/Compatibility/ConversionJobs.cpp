@@ -0,0 +1,84 @@
+﻿#include "ConversionJobs.h"
+
+#if defined(WITH_THREADS)
+#	include "../../nCine/Threading/ThreadPool.h"
+#	include "../../nCine/Threading/ThreadSync.h"
+
+#	include <algorithm>
+#	include <memory>
+
+using namespace nCine;
+#endif
+
+namespace Jazz2::Compatibility
+{
+#if defined(WITH_THREADS)
+	namespace
+	{
+		struct JobsState {
+			const std::function<void(int32_t)>* Job;
+			int32_t Remaining;
+			Mutex RemainingMutex;
+			CondVariable Finished;
+		};
+
+		class JobCommand : public IThreadCommand
+		{
+		public:
+			JobCommand(JobsState* state, int32_t index)
+				: _state(state), _index(index)
+			{
+			}
+
+			void execute() override
+			{
+				(*_state->Job)(_index);
+
+				_state->RemainingMutex.lock();
+				_state->Remaining--;
+				if (_state->Remaining == 0) {
+					_state->Finished.signal();
+				}
+				_state->RemainingMutex.unlock();
+			}
+
+		private:
+			JobsState* _state;
+			int32_t _index;
+		};
+	}
+#endif
+
+	void ConversionJobs::Run(int32_t count, const std::function<void(int32_t)>& job)
+	{
+		if (count <= 0) {
+			return;
+		}
+
+#if defined(WITH_THREADS)
+		unsigned int threadCount = std::min((unsigned int)count, Thread::numProcessors());
+		if (threadCount > 1) {
+			JobsState state;
+			state.Job = &job;
+			state.Remaining = count;
+
+			// The pool has to outlive all commands, its destructor drops the ones that are still queued
+			ThreadPool pool(threadCount);
+			for (int32_t i = 0; i < count; i++) {
+				pool.enqueueCommand(std::make_unique<JobCommand>(&state, i));
+			}
+
+			state.RemainingMutex.lock();
+			while (state.Remaining > 0) {
+				state.Finished.wait(state.RemainingMutex);
+			}
+			state.RemainingMutex.unlock();
+			return;
+		}
+#endif
+
+		for (int32_t i = 0; i < count; i++) {
+			job(i);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <functional>
+
+namespace Jazz2::Compatibility
+{
+	/// Runs independent conversion jobs on all available cores
+	class ConversionJobs
+	{
+	public:
+		/// Calls the job for each index from 0 to `count - 1` and waits until all of them are finished
+		/*! Jobs run on a dedicated thread pool, so they don't compete with long-running commands of the application. */
+		static void Run(int32_t count, const std::function<void(int32_t)>& job);
+	};
+}
\ No newline at end of file
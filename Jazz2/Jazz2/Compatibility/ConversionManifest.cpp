@@ -0,0 +1,180 @@
+﻿#include "ConversionManifest.h"
+
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace Jazz2::Compatibility
+{
+	namespace
+	{
+		constexpr uint64_t FnvOffsetBasis = 0xcbf29ce484222325ull;
+		constexpr uint64_t FnvPrime = 0x100000001b3ull;
+	}
+
+	ConversionManifest::ConversionManifest(const StringView& path)
+		: _path(path), _isDirty(false)
+	{
+		auto s = IFileStream::createFileHandle(_path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		if (!s->isOpened()) {
+			return;
+		}
+
+		// Each line contains hexadecimal hash followed by the source path
+		ArrayView<const uint8_t> data = s->ReadView(s->GetSize());
+		const char* ptr = (const char*)data.data();
+		const char* end = ptr + data.size();
+		while (ptr < end) {
+			const char* lineEnd = (const char*)std::memchr(ptr, '\n', end - ptr);
+			if (lineEnd == nullptr) {
+				lineEnd = end;
+			}
+
+			const char* separator = (const char*)std::memchr(ptr, ' ', lineEnd - ptr);
+			if (separator != nullptr && separator + 1 < lineEnd) {
+				uint64_t hash = 0;
+				bool isValid = (separator > ptr);
+				for (const char* c = ptr; c < separator; c++) {
+					uint8_t digit;
+					if (*c >= '0' && *c <= '9') {
+						digit = *c - '0';
+					} else if (*c >= 'a' && *c <= 'f') {
+						digit = *c - 'a' + 10;
+					} else {
+						isValid = false;
+						break;
+					}
+					hash = (hash << 4) | digit;
+				}
+				if (isValid) {
+					_entries[String(separator + 1, lineEnd - separator - 1)] = hash;
+				}
+			}
+
+			ptr = lineEnd + 1;
+		}
+	}
+
+	uint64_t ConversionManifest::HashFile(const StringView& path, uint64_t seed)
+	{
+		constexpr unsigned long int BufferSize = 64 * 1024;
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		if (!s->isOpened()) {
+			return 0;
+		}
+
+		// 64-bit FNV-1a, the seed is mixed in first
+		uint64_t hash = FnvOffsetBasis;
+		for (int i = 0; i < 8; i++) {
+			hash = (hash ^ ((seed >> (i * 8)) & 0xFF)) * FnvPrime;
+		}
+
+		long int remaining = s->GetSize();
+		while (remaining > 0) {
+			ArrayView<const uint8_t> data = s->ReadView(std::min((unsigned long int)remaining, BufferSize));
+			if (data.empty()) {
+				break;
+			}
+			for (uint8_t value : data) {
+				hash = (hash ^ value) * FnvPrime;
+			}
+			remaining -= (long int)data.size();
+		}
+
+		// Zero is reserved for files that cannot be read
+		return (hash != 0 ? hash : 1);
+	}
+
+	uint64_t ConversionManifest::HashCombine(uint64_t hash, const StringView& data)
+	{
+		if (hash == 0) {
+			return 0;
+		}
+
+		// Length is mixed in too, so adjacent strings can't be shifted into each other
+		hash = HashCombine(hash, (uint64_t)data.size());
+		for (char c : data) {
+			hash = (hash ^ (uint8_t)c) * FnvPrime;
+		}
+		return (hash != 0 ? hash : 1);
+	}
+
+	uint64_t ConversionManifest::HashCombine(uint64_t hash, uint64_t value)
+	{
+		if (hash == 0) {
+			return 0;
+		}
+
+		for (int i = 0; i < 8; i++) {
+			hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * FnvPrime;
+		}
+		return (hash != 0 ? hash : 1);
+	}
+
+	bool ConversionManifest::IsUpToDate(const StringView& source, uint64_t hash, const StringView& output)
+	{
+		if (hash == 0 || !fs::exists(output)) {
+			return false;
+		}
+
+		_mutex.lock();
+		auto it = _entries.find(String::nullTerminatedView(source));
+		bool result = (it != _entries.end() && it->second == hash);
+		_mutex.unlock();
+		return result;
+	}
+
+	void ConversionManifest::Update(const StringView& source, uint64_t hash)
+	{
+		_mutex.lock();
+		_entries[String(source)] = hash;
+		_isDirty = true;
+		_mutex.unlock();
+	}
+
+	void ConversionManifest::Remove(const StringView& source)
+	{
+		_mutex.lock();
+		if (_entries.erase(String::nullTerminatedView(source)) > 0) {
+			_isDirty = true;
+		}
+		_mutex.unlock();
+	}
+
+	bool ConversionManifest::Save()
+	{
+		_mutex.lock();
+		if (!_isDirty) {
+			_mutex.unlock();
+			return true;
+		}
+
+		auto s = IFileStream::createFileHandle(_path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Write);
+		if (!s->isOpened()) {
+			_mutex.unlock();
+			LOGE_X("Cannot write conversion manifest \"%s\"", _path.data());
+			return false;
+		}
+
+		char buffer[24];
+		for (auto& [source, hash] : _entries) {
+			int length = std::snprintf(buffer, sizeof(buffer), "%016llx ", (unsigned long long)hash);
+			s->Write(buffer, length);
+			s->Write((void*)source.data(), (unsigned long int)source.size());
+			s->Write((void*)"\n", 1);
+		}
+
+		_isDirty = false;
+		_mutex.unlock();
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "../../Common.h"
+#include "../../nCine/Base/HashMap.h"
+#include "../../nCine/Threading/ThreadSync.h"
+
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	/// Content hashes of converted source files, so unchanged files don't have to be converted again
+	/*! Entries can be queried and updated from multiple threads at once. */
+	class ConversionManifest
+	{
+	public:
+		ConversionManifest(const StringView& path);
+
+		/// Computes hash of the whole file content, the seed should be changed together with the output format
+		static uint64_t HashFile(const StringView& path, uint64_t seed);
+		/// Mixes additional data into the hash, it should be used for all inputs the output depends on
+		static uint64_t HashCombine(uint64_t hash, const StringView& data);
+		static uint64_t HashCombine(uint64_t hash, uint64_t value);
+
+		/// Returns true if the source was converted with the same hash before and the output still exists
+		bool IsUpToDate(const StringView& source, uint64_t hash, const StringView& output);
+		void Update(const StringView& source, uint64_t hash);
+		void Remove(const StringView& source);
+
+		/// Writes all entries back to the manifest file
+		bool Save();
+
+	private:
+		String _path;
+		HashMap<String, uint64_t> _entries;
+		Mutex _mutex;
+		bool _isDirty;
+	};
+}
\ No newline at end of file
@@ -1,8 +1,598 @@
-﻿#pragma once
+﻿#include "EventConverter.h"
+#include "JJ2Level.h"
 
-#include "../../Common.h"
+#include <initializer_list>
 
 namespace Jazz2::Compatibility
 {
+	namespace
+	{
+		/// Stores each value as 16-bit parameter, the same layout as produced by `ConvertParamInt()`
+		std::array<uint8_t, 16> PackParams(std::initializer_list<uint16_t> values)
+		{
+			std::array<uint8_t, 16> result = { };
+			int i = 0;
+			for (uint16_t value : values) {
+				if (i >= (int)result.size()) {
+					break;
+				}
+				result[i] = (uint8_t)(value & 0xFF);
+				result[i + 1] = (uint8_t)(value >> 8);
+				i += 2;
+			}
+			return result;
+		}
 
+		uint16_t GetParam(const std::array<uint8_t, 16>& params, int index)
+		{
+			return (uint16_t)(params[index * 2] | (params[index * 2 + 1] << 8));
+		}
+
+		constexpr auto None = EventConverter::JJ2EventParamType::None;
+		constexpr auto Bool = EventConverter::JJ2EventParamType::Bool;
+		constexpr auto UInt = EventConverter::JJ2EventParamType::UInt;
+		constexpr auto Int = EventConverter::JJ2EventParamType::Int;
+	}
+
+	EventConverter::EventConverter()
+	{
+		AddDefaultConverters();
+	}
+
+	EventConverter::ConversionResult EventConverter::TryConvert(JJ2Level& level, JJ2Event old, uint32_t eventParams) const
+	{
+		const ConversionFunction& converter = _converters[(uint8_t)old];
+		if (converter == nullptr) {
+			return { EventType::Empty };
+		}
+		return converter(level, eventParams);
+	}
+
+	void EventConverter::Add(JJ2Event originalEvent, ConversionFunction converter)
+	{
+		ConversionFunction& target = _converters[(uint8_t)originalEvent];
+		if (target != nullptr) {
+			LOGW_X("Converter for event %u is already defined", (uint32_t)originalEvent);
+			return;
+		}
+		target = std::move(converter);
+	}
+
+	void EventConverter::Override(JJ2Event originalEvent, ConversionFunction converter)
+	{
+		_converters[(uint8_t)originalEvent] = std::move(converter);
+	}
+
+	EventConverter::ConversionFunction EventConverter::NoParamList(EventType ev)
+	{
+		return [ev](JJ2Level& level, uint32_t e) -> ConversionResult {
+			return { ev, { } };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::ConstantParamList(EventType ev, std::array<uint8_t, 16> eventParams)
+	{
+		return [ev, eventParams](JJ2Level& level, uint32_t e) -> ConversionResult {
+			return { ev, eventParams };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::ParamIntToParamList(EventType ev, std::array<std::pair<JJ2EventParamType, int>, 5> paramDefs)
+	{
+		return [ev, paramDefs](JJ2Level& level, uint32_t e) -> ConversionResult {
+			return { ev, ConvertParamInt(e, paramDefs) };
+		};
+	}
+
+	std::array<uint8_t, 16> EventConverter::ConvertParamInt(uint32_t paramInt, std::array<std::pair<JJ2EventParamType, int>, 5> paramTypes)
+	{
+		std::array<uint8_t, 16> result = { };
+
+		int i = 0;
+		for (auto& [type, bits] : paramTypes) {
+			if (type == JJ2EventParamType::None || bits <= 0) {
+				continue;
+			}
+
+			uint32_t mask = (bits >= 32 ? UINT32_MAX : ((1u << bits) - 1));
+			uint32_t value = (paramInt & mask);
+			paramInt = (bits >= 32 ? 0 : (paramInt >> bits));
+
+			uint16_t converted;
+			switch (type) {
+				case JJ2EventParamType::Bool:
+					converted = (value != 0 ? 1 : 0);
+					break;
+				case JJ2EventParamType::Int:
+					// Sign-extend the value to the whole 16-bit parameter
+					if (bits < 32 && (value & (1u << (bits - 1))) != 0) {
+						converted = (uint16_t)(int16_t)((int32_t)value - (int32_t)(1u << bits));
+					} else {
+						converted = (uint16_t)value;
+					}
+					break;
+				default:
+					converted = (uint16_t)value;
+					break;
+			}
+
+			result[i] = (uint8_t)(converted & 0xFF);
+			result[i + 1] = (uint8_t)(converted >> 8);
+			i += 2;
+		}
+
+		return result;
+	}
+
+	void EventConverter::AddDefaultConverters()
+	{
+		// Basic events
+		Add(JJ2Event::EMPTY, NoParamList(EventType::Empty));
+		Add(JJ2Event::SAVE_POINT, ConstantParamList(EventType::Checkpoint, PackParams({ 0 })));
+
+		// Level start positions, parameter is mask of player types
+		Add(JJ2Event::JAZZ_LEVEL_START, ConstantParamList(EventType::LevelStart, PackParams({ 0x01 })));
+		Add(JJ2Event::SPAZ_LEVEL_START, ConstantParamList(EventType::LevelStart, PackParams({ 0x02 })));
+		Add(JJ2Event::LORI_LEVEL_START, ConstantParamList(EventType::LevelStart, PackParams({ 0x04 })));
+		Add(JJ2Event::MP_LEVEL_START, ParamIntToParamList(EventType::LevelStartMultiplayer, {{
+			{ UInt, 2 }	// Team
+		}}));
+
+		// Modifiers
+		Add(JJ2Event::MODIFIER_ONE_WAY, NoParamList(EventType::ModifierOneWay));
+		Add(JJ2Event::MODIFIER_VINE, NoParamList(EventType::ModifierVine));
+		Add(JJ2Event::MODIFIER_HOOK, NoParamList(EventType::ModifierHook));
+		Add(JJ2Event::MODIFIER_SLIDE, ParamIntToParamList(EventType::ModifierSlide, {{
+			{ UInt, 2 }	// Strength
+		}}));
+		Add(JJ2Event::MODIFIER_HURT, ParamIntToParamList(EventType::ModifierHurt, {{
+			{ Bool, 1 },	// Up
+			{ Bool, 1 },	// Down
+			{ Bool, 1 },	// Left
+			{ Bool, 1 }	// Right
+		}}));
+		Add(JJ2Event::MODIFIER_TUBE, ParamIntToParamList(EventType::ModifierTube, {{
+			{ Int, 7 },	// X Speed
+			{ Int, 7 },	// Y Speed
+			{ UInt, 1 },	// Trig Sample
+			{ Bool, 1 },	// BecomeNoclip
+			{ Bool, 1 }	// Noclip Only
+		}}));
+		Add(JJ2Event::MODIFIER_H_POLE, NoParamList(EventType::ModifierHPole));
+		Add(JJ2Event::MODIFIER_V_POLE, NoParamList(EventType::ModifierVPole));
+		Add(JJ2Event::MODIFIER_RICOCHET, NoParamList(EventType::ModifierRicochet));
+		Add(JJ2Event::MODIFIER_SET_WATER, ParamIntToParamList(EventType::ModifierSetWater, {{
+			{ UInt, 8 },	// Height (Tiles)
+			{ Bool, 1 },	// Instant [TODO]
+			{ UInt, 2 }	// Lighting [TODO]
+		}}));
+		Add(JJ2Event::AREA_LIMIT_X_SCROLL, ParamIntToParamList(EventType::ModifierLimitCameraView, {{
+			{ UInt, 10 },	// Left (Tiles)
+			{ UInt, 10 }	// Width (Tiles)
+		}}));
+
+		// Areas
+		Add(JJ2Event::AREA_STOP_ENEMY, NoParamList(EventType::AreaStopEnemy));
+		Add(JJ2Event::AREA_FLOAT_UP, NoParamList(EventType::AreaFloatUp));
+		Add(JJ2Event::AREA_FLY_OFF, NoParamList(EventType::AreaFlyOff));
+		Add(JJ2Event::AREA_REVERT_MORPH, NoParamList(EventType::AreaRevertMorph));
+		Add(JJ2Event::AREA_MORPH_FROG, NoParamList(EventType::AreaMorphToFrog));
+		Add(JJ2Event::AREA_NO_FIRE, NoParamList(EventType::AreaNoFire));
+		Add(JJ2Event::WATER_BLOCK, ParamIntToParamList(EventType::AreaWaterBlock, {{
+			{ Int, 8 }	// Adjust Y
+		}}));
+		Add(JJ2Event::AREA_ACTIVATE_BOSS, ParamIntToParamList(EventType::AreaActivateBoss, {{
+			{ UInt, 1 }	// Music
+		}}));
+		Add(JJ2Event::AREA_TEXT, ParamIntToParamList(EventType::AreaText, {{
+			{ UInt, 8 },	// Text
+			{ Bool, 1 }	// Vanish
+		}}));
+		Add(JJ2Event::AREA_EOL, [](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ Bool, 1 },	// Secret
+				{ Bool, 1 },	// Fast (Not used)
+				{ UInt, 4 }	// Text ID (Not used)
+			}});
+			// Parameter is `ExitType`, 1 is normal exit and 4 is special exit
+			return { EventType::AreaEndOfLevel, PackParams({ (uint16_t)(GetParam(params, 0) != 0 ? 4 : 1) }) };
+		});
+		Add(JJ2Event::AREA_EOL_WARP, ConstantParamList(EventType::AreaEndOfLevel, PackParams({ 2 })));
+		Add(JJ2Event::EOL_SIGN, ConstantParamList(EventType::SignEOL, PackParams({ 1 })));
+
+		// Triggers and warps
+		Add(JJ2Event::TRIGGER_CRATE, ParamIntToParamList(EventType::TriggerCrate, {{
+			{ UInt, 5 },	// Trigger ID
+			{ Bool, 1 },	// Set to (0: on, 1: off)
+			{ Bool, 1 }	// Switch
+		}}));
+		Add(JJ2Event::TRIGGER_AREA, ParamIntToParamList(EventType::TriggerArea, {{
+			{ UInt, 5 }	// Trigger ID
+		}}));
+		Add(JJ2Event::TRIGGER_ZONE, ParamIntToParamList(EventType::TriggerZone, {{
+			{ UInt, 5 },	// Trigger ID
+			{ Bool, 1 },	// Set to (0: off, 1: on)
+			{ Bool, 1 }	// Switch
+		}}));
+		Add(JJ2Event::WARP_ORIGIN, ParamIntToParamList(EventType::WarpOrigin, {{
+			{ UInt, 8 },	// Warp ID
+			{ UInt, 8 },	// Coins
+			{ Bool, 1 },	// Set Lap
+			{ Bool, 1 },	// Show Anim
+			{ Bool, 1 }	// Fast
+		}}));
+		Add(JJ2Event::WARP_TARGET, ParamIntToParamList(EventType::WarpTarget, {{
+			{ UInt, 8 }	// Warp ID
+		}}));
+		Add(JJ2Event::AREA_SECRET_WARP, [](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 10 },	// Coins
+				{ UInt, 8 },	// Warp ID
+				{ Bool, 1 }	// Fast
+			}});
+			return { EventType::WarpCoinBonus, PackParams({ GetParam(params, 1), GetParam(params, 2), 0, GetParam(params, 0) }) };
+		});
+
+		// Scenery
+		Add(JJ2Event::SCENERY_DESTRUCT, [](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 10 },	// Empty
+				{ UInt, 5 },	// Speed
+				{ UInt, 4 }	// Weapon
+			}});
+
+			// Weapon is stored as `WeaponType` + 1, zero means any weapon
+			uint16_t speed = GetParam(params, 1);
+			uint16_t weapon = GetParam(params, 2);
+			if (weapon == 0 && speed > 0) {
+				return { EventType::SceneryDestructSpeed, PackParams({ (uint16_t)(speed + 5) }) };
+			}
+			return { EventType::SceneryDestruct, PackParams({ weapon }) };
+		});
+		Add(JJ2Event::SCENERY_DESTR_BOMB, ConstantParamList(EventType::SceneryDestruct, PackParams({ 6 + 1 /*TNT*/ })));
+		Add(JJ2Event::SCENERY_BUTTSTOMP, NoParamList(EventType::SceneryDestructButtstomp));
+		Add(JJ2Event::SCENERY_COLLAPSE, ParamIntToParamList(EventType::SceneryCollapse, {{
+			{ UInt, 10 },	// Wait Time
+			{ UInt, 5 }	// FPS
+		}}));
+
+		// Lights
+		Add(JJ2Event::LIGHT_SET, ParamIntToParamList(EventType::LightSet, {{
+			{ UInt, 7 },	// Intensity
+			{ UInt, 4 },	// Red
+			{ UInt, 4 },	// Green
+			{ UInt, 4 },	// Blue
+			{ Bool, 1 }	// Flicker
+		}}));
+		Add(JJ2Event::LIGHT_RESET, NoParamList(EventType::LightReset));
+		Add(JJ2Event::LIGHT_DIM, ConstantParamList(EventType::LightSet, PackParams({ 127, 60, 100, 0, 0 })));
+		Add(JJ2Event::LIGHT_STEADY, [](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 3 },	// Type
+				{ UInt, 7 }	// Size
+			}});
+
+			uint16_t size = GetParam(params, 1);
+			switch (GetParam(params, 0)) {
+				default:
+				case 0: {	// Normal
+					uint16_t radiusNear = (uint16_t)(size == 0 ? 20 : size * 4.8f);
+					uint16_t radiusFar = (uint16_t)(radiusNear * 2.4f);
+					return { EventType::LightSteady, PackParams({ 255, 10, radiusNear, radiusFar }) };
+				}
+				case 1:		// Single point
+					return { EventType::LightSteady, PackParams({ 127, 10, 0, 16 }) };
+				case 2:		// Single point (brighter)
+					return { EventType::LightSteady, PackParams({ 255, 200, 0, 16 }) };
+				case 3:		// Flicker light
+					return { EventType::LightFlicker, PackParams({ 110, 40, (uint16_t)(size == 0 ? 20 : size), (uint16_t)(size == 0 ? 48 : size * 2.4f) }) };
+				case 4: {	// Bright normal light
+					uint16_t radiusNear = (uint16_t)(size == 0 ? 20 : size * 4.8f);
+					uint16_t radiusFar = (uint16_t)(radiusNear * 2.4f);
+					return { EventType::LightSteady, PackParams({ 255, 200, radiusNear, radiusFar }) };
+				}
+				case 5:		// Laser shield / Illuminate surroundings
+					return { EventType::LightIlluminate, PackParams({ (uint16_t)(size < 1 ? 1 : size) }) };
+			}
+		});
+		Add(JJ2Event::LIGHT_PULSE, [](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 8 },	// Speed
+				{ UInt, 4 },	// Sync
+				{ UInt, 3 },	// Type
+				{ UInt, 5 }	// Size
+			}});
+
+			uint16_t speed = (GetParam(params, 0) == 0 ? 6 : GetParam(params, 0));
+			uint16_t sync = GetParam(params, 1);
+			uint16_t size = GetParam(params, 3);
+			uint16_t radiusNear1 = (uint16_t)(size == 0 ? 20 : size * 4.6f);
+			uint16_t radiusNear2 = (uint16_t)(radiusNear1 * 2);
+			uint16_t radiusFar = (uint16_t)(radiusNear1 * 2.4f);
+			return { EventType::LightPulse, PackParams({ 255, 10, radiusNear1, radiusNear2, radiusFar, speed, sync }) };
+		});
+		Add(JJ2Event::LIGHT_FLICKER, ParamIntToParamList(EventType::LightFlicker, {{
+			{ UInt, 8 }	// Sample
+		}}));
+
+		// Environment
+		Add(JJ2Event::SPRING_RED, GetSpringConverter(0, false, false));
+		Add(JJ2Event::SPRING_GREEN, GetSpringConverter(1, false, false));
+		Add(JJ2Event::SPRING_BLUE, GetSpringConverter(2, false, false));
+		Add(JJ2Event::SPRING_GREEN_FROZEN, GetSpringConverter(1, false, true));
+		Add(JJ2Event::SPRING_RED_HOR, GetSpringConverter(0, true, false));
+		Add(JJ2Event::SPRING_GREEN_HOR, GetSpringConverter(1, true, false));
+		Add(JJ2Event::SPRING_BLUE_HOR, GetSpringConverter(2, true, false));
+
+		Add(JJ2Event::BRIDGE, ParamIntToParamList(EventType::Bridge, {{
+			{ UInt, 4 },	// Width
+			{ UInt, 3 },	// Type
+			{ UInt, 4 }	// Toughness
+		}}));
+
+		Add(JJ2Event::PLATFORM_FRUIT, GetPlatformConverter(1));
+		Add(JJ2Event::PLATFORM_BOLL, GetPlatformConverter(2));
+		Add(JJ2Event::PLATFORM_GRASS, GetPlatformConverter(3));
+		Add(JJ2Event::PLATFORM_PINK, GetPlatformConverter(4));
+		Add(JJ2Event::PLATFORM_SONIC, GetPlatformConverter(5));
+		Add(JJ2Event::PLATFORM_SPIKE, GetPlatformConverter(6));
+		Add(JJ2Event::BOLL_SPIKE, GetPlatformConverter(7));
+
+		Add(JJ2Event::POLE_CARROTUS, GetPoleConverter(0));
+		Add(JJ2Event::POLE_DIAMONDUS, GetPoleConverter(1));
+		Add(JJ2Event::POLE_JUNGLE, GetPoleConverter(2));
+		Add(JJ2Event::POLE_PSYCH, GetPoleConverter(3));
+
+		Add(JJ2Event::PUSHABLE_ROCK, ConstantParamList(EventType::PushableBox, PackParams({ 0 })));
+		Add(JJ2Event::PUSHABLE_BOX, ConstantParamList(EventType::PushableBox, PackParams({ 1 })));
+		Add(JJ2Event::EVA, NoParamList(EventType::Eva));
+		Add(JJ2Event::MOTH, ParamIntToParamList(EventType::Moth, {{
+			{ UInt, 3 }	// Type
+		}}));
+		Add(JJ2Event::STEAM, NoParamList(EventType::SteamNote));
+		Add(JJ2Event::SCENERY_BOMB, NoParamList(EventType::Bomb));
+		Add(JJ2Event::PINBALL_BUMP_500, ConstantParamList(EventType::PinballBumper, PackParams({ 0 })));
+		Add(JJ2Event::PINBALL_BUMP_CARROT, ConstantParamList(EventType::PinballBumper, PackParams({ 1 })));
+		Add(JJ2Event::PINBALL_PADDLE_L, ConstantParamList(EventType::PinballPaddle, PackParams({ 1 })));
+		Add(JJ2Event::PINBALL_PADDLE_R, ConstantParamList(EventType::PinballPaddle, PackParams({ 0 })));
+		Add(JJ2Event::CTF_BASE, ParamIntToParamList(EventType::CtfBase, {{
+			{ UInt, 1 },	// Team
+			{ UInt, 1 }	// Direction
+		}}));
+		Add(JJ2Event::AMBIENT_SOUND, ParamIntToParamList(EventType::AreaAmbientSound, {{
+			{ UInt, 8 },	// Sample
+			{ UInt, 8 },	// Amplify
+			{ Bool, 1 },	// Fade [TODO]
+			{ Bool, 1 }	// Sine [TODO]
+		}}));
+		Add(JJ2Event::SCENERY_BUBBLER, ParamIntToParamList(EventType::AreaAmbientBubbles, {{
+			{ UInt, 4 }	// Speed
+		}}));
+		Add(JJ2Event::SWINGING_VINE, NoParamList(EventType::SwingingVine));
+		Add(JJ2Event::COPTER, NoParamList(EventType::Copter));
+		Add(JJ2Event::AIRBOARD, ParamIntToParamList(EventType::AirboardGenerator, {{
+			{ UInt, 5 }	// Delay (Secs.)
+		}}));
+		Add(JJ2Event::BIRDY, ParamIntToParamList(EventType::BirdCage, {{
+			{ Bool, 1 }	// Chuck (Yellow)
+		}}));
+		Add(JJ2Event::STOPWATCH, NoParamList(EventType::Stopwatch));
+
+		// Enemies
+		Add(JJ2Event::ENEMY_TURTLE_NORMAL, ConstantParamList(EventType::EnemyTurtle, PackParams({ 0 })));
+		Add(JJ2Event::ENEMY_NORMAL_TURTLE_XMAS, ConstantParamList(EventType::EnemyTurtle, PackParams({ 1 })));
+		Add(JJ2Event::TURTLE_SHELL, NoParamList(EventType::TurtleShell));
+		Add(JJ2Event::ENEMY_TUF_TURT, NoParamList(EventType::EnemyTurtleTough));
+		Add(JJ2Event::ENEMY_TURTLE_TUBE, NoParamList(EventType::EnemyTurtleTube));
+		Add(JJ2Event::ENEMY_LIZARD, ConstantParamList(EventType::EnemyLizard, PackParams({ 0 })));
+		Add(JJ2Event::ENEMY_LIZARD_XMAS, ConstantParamList(EventType::EnemyLizard, PackParams({ 1 })));
+		Add(JJ2Event::ENEMY_LIZARD_FLOAT, ParamIntToParamList(EventType::EnemyLizardFloat, {{
+			{ UInt, 8 },	// Flying time
+			{ Bool, 1 }	// Fly away
+		}}));
+		Add(JJ2Event::ENEMY_LAB_RAT, NoParamList(EventType::EnemyLabRat));
+		Add(JJ2Event::ENEMY_DRAGON, NoParamList(EventType::EnemyDragon));
+		Add(JJ2Event::ENEMY_BEE, NoParamList(EventType::EnemyBee));
+		Add(JJ2Event::ENEMY_BEE_SWARM, ParamIntToParamList(EventType::EnemyBeeSwarm, {{
+			{ UInt, 8 }	// Number
+		}}));
+		Add(JJ2Event::ENEMY_RAPIER, NoParamList(EventType::EnemyRapier));
+		Add(JJ2Event::ENEMY_SPARKS, NoParamList(EventType::EnemySparks));
+		Add(JJ2Event::ENEMY_BAT, NoParamList(EventType::EnemyBat));
+		Add(JJ2Event::ENEMY_SUCKER, NoParamList(EventType::EnemySucker));
+		Add(JJ2Event::ENEMY_SUCKER_FLOAT, NoParamList(EventType::EnemySuckerFloat));
+		Add(JJ2Event::ENEMY_CATERPILLAR, NoParamList(EventType::EnemyCaterpillar));
+		Add(JJ2Event::ENEMY_MADDER_HATTER, NoParamList(EventType::EnemyMadderHatter));
+		Add(JJ2Event::ENEMY_SKELETON, NoParamList(EventType::EnemySkeleton));
+		Add(JJ2Event::ENEMY_DOGGY_DOGG, NoParamList(EventType::EnemyDoggy));
+		Add(JJ2Event::ENEMY_HELMUT, NoParamList(EventType::EnemyHelmut));
+		Add(JJ2Event::ENEMY_DEMON, NoParamList(EventType::EnemyDemon));
+		Add(JJ2Event::ENEMY_DRAGONFLY, NoParamList(EventType::EnemyDragonfly));
+		Add(JJ2Event::ENEMY_MONKEY, ConstantParamList(EventType::EnemyMonkey, PackParams({ 1 })));
+		Add(JJ2Event::ENEMY_MONKEY_STAND, ConstantParamList(EventType::EnemyMonkey, PackParams({ 0 })));
+		Add(JJ2Event::ENEMY_FAT_CHICK, NoParamList(EventType::EnemyFatChick));
+		Add(JJ2Event::ENEMY_FENCER, NoParamList(EventType::EnemyFencer));
+		Add(JJ2Event::ENEMY_FISH, NoParamList(EventType::EnemyFish));
+		Add(JJ2Event::ENEMY_RAVEN, NoParamList(EventType::EnemyRaven));
+		Add(JJ2Event::ENEMY_CRAB, NoParamList(EventType::EnemyCrab));
+		Add(JJ2Event::ENEMY_WITCH, NoParamList(EventType::EnemyWitch));
+
+		// Bosses
+		Add(JJ2Event::BOSS_TUF_TURT, GetBossConverter(EventType::BossTurtleTough));
+		Add(JJ2Event::BOSS_BILSY, GetBossConverter(EventType::BossBilsy, 0));
+		Add(JJ2Event::EMPTY_BOSS_BILSY_XMAS, GetBossConverter(EventType::BossBilsy, 1));
+		Add(JJ2Event::BOSS_QUEEN, GetBossConverter(EventType::BossQueen));
+		Add(JJ2Event::BOSS_UTERUS, GetBossConverter(EventType::BossUterus));
+		Add(JJ2Event::BOSS_BUBBA, GetBossConverter(EventType::BossBubba));
+		Add(JJ2Event::BOSS_DEVAN_DEVIL, GetBossConverter(EventType::BossDevan));
+		Add(JJ2Event::BOSS_DEVAN_ROBOT, NoParamList(EventType::BossDevanRemote));
+		Add(JJ2Event::BOSS_ROBOT, GetBossConverter(EventType::BossRobot));
+		Add(JJ2Event::BOSS_BOLLY, GetBossConverter(EventType::BossBolly));
+		Add(JJ2Event::BOSS_TWEEDLE, GetBossConverter(EventType::BossTweedle));
+
+		// Collectibles
+		Add(JJ2Event::COIN_SILVER, ConstantParamList(EventType::Coin, PackParams({ 0 })));
+		Add(JJ2Event::COIN_GOLD, ConstantParamList(EventType::Coin, PackParams({ 1 })));
+		Add(JJ2Event::GEM_RED, ConstantParamList(EventType::Gem, PackParams({ 0 })));
+		Add(JJ2Event::GEM_GREEN, ConstantParamList(EventType::Gem, PackParams({ 1 })));
+		Add(JJ2Event::GEM_BLUE, ConstantParamList(EventType::Gem, PackParams({ 2 })));
+		Add(JJ2Event::GEM_PURPLE, ConstantParamList(EventType::Gem, PackParams({ 3 })));
+		Add(JJ2Event::GEM_RED_RECT, ConstantParamList(EventType::Gem, PackParams({ 0 })));
+		Add(JJ2Event::GEM_GREEN_RECT, ConstantParamList(EventType::Gem, PackParams({ 1 })));
+		Add(JJ2Event::GEM_BLUE_RECT, ConstantParamList(EventType::Gem, PackParams({ 2 })));
+		Add(JJ2Event::GEM_SUPER, NoParamList(EventType::GemGiant));
+		Add(JJ2Event::GEM_RING, ParamIntToParamList(EventType::GemRing, {{
+			{ UInt, 5 },	// Length
+			{ UInt, 5 },	// Speed
+			{ Bool, 1 }	// Event
+		}}));
+		Add(JJ2Event::SCENERY_GEMSTOMP, NoParamList(EventType::GemStomp));
+		Add(JJ2Event::CARROT, ConstantParamList(EventType::Carrot, PackParams({ 0 })));
+		Add(JJ2Event::CARROT_FULL, ConstantParamList(EventType::Carrot, PackParams({ 1 })));
+		Add(JJ2Event::CARROT_FLY, NoParamList(EventType::CarrotFly));
+		Add(JJ2Event::CARROT_INVINCIBLE, NoParamList(EventType::CarrotInvincible));
+		Add(JJ2Event::ONEUP, NoParamList(EventType::OneUp));
+		Add(JJ2Event::FAST_FIRE, NoParamList(EventType::FastFire));
+
+		// Food, its type follows order of original events
+		for (uint8_t i = 0; i < 7; i++) {
+			Add((JJ2Event)((uint8_t)JJ2Event::FOOD_APPLE + i), ConstantParamList(EventType::Food, PackParams({ (uint16_t)(1 + i) })));
+		}
+		for (uint8_t i = 0; i < 29; i++) {
+			Add((JJ2Event)((uint8_t)JJ2Event::FOOD_LEMON + i), ConstantParamList(EventType::Food, PackParams({ (uint16_t)(8 + i) })));
+		}
+
+		// Weapons, parameter is `WeaponType`
+		Add(JJ2Event::AMMO_BOUNCER, ConstantParamList(EventType::Ammo, PackParams({ 1 })));
+		Add(JJ2Event::AMMO_FREEZER, ConstantParamList(EventType::Ammo, PackParams({ 2 })));
+		Add(JJ2Event::AMMO_SEEKER, ConstantParamList(EventType::Ammo, PackParams({ 3 })));
+		Add(JJ2Event::AMMO_RF, ConstantParamList(EventType::Ammo, PackParams({ 4 })));
+		Add(JJ2Event::AMMO_TOASTER, ConstantParamList(EventType::Ammo, PackParams({ 5 })));
+		Add(JJ2Event::AMMO_TNT, ConstantParamList(EventType::Ammo, PackParams({ 6 })));
+		Add(JJ2Event::AMMO_PEPPER, ConstantParamList(EventType::Ammo, PackParams({ 7 })));
+		Add(JJ2Event::AMMO_ELECTRO, ConstantParamList(EventType::Ammo, PackParams({ 8 })));
+
+		Add(JJ2Event::POWERUP_BLASTER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 0 })));
+		Add(JJ2Event::POWERUP_BOUNCER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 1 })));
+		Add(JJ2Event::POWERUP_FREEZER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 2 })));
+		Add(JJ2Event::POWERUP_SEEKER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 3 })));
+		Add(JJ2Event::POWERUP_RF, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 4 })));
+		Add(JJ2Event::POWERUP_TOASTER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 5 })));
+		Add(JJ2Event::POWERUP_TNT, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 6 })));
+		Add(JJ2Event::POWERUP_PEPPER, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 7 })));
+		Add(JJ2Event::POWERUP_ELECTRO, ConstantParamList(EventType::PowerUpWeapon, PackParams({ 8 })));
+
+		Add(JJ2Event::POWERUP_SWAP, NoParamList(EventType::PowerUpMorph));
+		Add(JJ2Event::SHIELD_FIRE, ConstantParamList(EventType::PowerUpShield, PackParams({ 1 })));
+		Add(JJ2Event::SHIELD_WATER, ConstantParamList(EventType::PowerUpShield, PackParams({ 2 })));
+		Add(JJ2Event::SHIELD_LIGHTNING, ConstantParamList(EventType::PowerUpShield, PackParams({ 3 })));
+		Add(JJ2Event::SHIELD_LASER, ConstantParamList(EventType::PowerUpShield, PackParams({ 4 })));
+
+		// Containers, crates store the contained event followed by its count
+		Add(JJ2Event::CRATE_AMMO, GetAmmoCrateConverter(0));
+		Add(JJ2Event::CRATE_AMMO_BOUNCER, GetAmmoCrateConverter(1));
+		Add(JJ2Event::CRATE_AMMO_FREEZER, GetAmmoCrateConverter(2));
+		Add(JJ2Event::CRATE_AMMO_SEEKER, GetAmmoCrateConverter(3));
+		Add(JJ2Event::CRATE_AMMO_RF, GetAmmoCrateConverter(4));
+		Add(JJ2Event::CRATE_AMMO_TOASTER, GetAmmoCrateConverter(5));
+		Add(JJ2Event::CRATE_CARROT, ConstantParamList(EventType::Crate, PackParams({ (uint16_t)EventType::Carrot, 1 })));
+		Add(JJ2Event::CRATE_SPRING, ConstantParamList(EventType::Crate, PackParams({ (uint16_t)EventType::Spring, 1 })));
+		Add(JJ2Event::CRATE_ONEUP, ConstantParamList(EventType::Crate, PackParams({ (uint16_t)EventType::OneUp, 1 })));
+		Add(JJ2Event::CRATE_BOMB, ParamIntToParamList(EventType::Crate, {{
+			{ UInt, 8 },	// ExtraEvent
+			{ UInt, 4 },	// NumEvent
+			{ Bool, 1 },	// RandomFly
+			{ Bool, 1 }	// NoBomb
+		}}));
+		Add(JJ2Event::BARREL_AMMO, ConstantParamList(EventType::BarrelAmmo, PackParams({ 0 })));
+		Add(JJ2Event::BARREL_CARROT, ConstantParamList(EventType::Barrel, PackParams({ (uint16_t)EventType::Carrot, 1 })));
+		Add(JJ2Event::BARREL_ONEUP, ConstantParamList(EventType::Barrel, PackParams({ (uint16_t)EventType::OneUp, 1 })));
+		Add(JJ2Event::CRATE_GEM, ParamIntToParamList(EventType::CrateGem, {{
+			{ UInt, 4 },	// Red
+			{ UInt, 4 },	// Green
+			{ UInt, 4 },	// Blue
+			{ UInt, 4 }	// Purple
+		}}));
+		Add(JJ2Event::BARREL_GEM, ParamIntToParamList(EventType::BarrelGem, {{
+			{ UInt, 4 },	// Red
+			{ UInt, 4 },	// Green
+			{ UInt, 4 },	// Blue
+			{ UInt, 4 }	// Purple
+		}}));
+
+		Add(JJ2Event::ROTATING_ROCK, ParamIntToParamList(EventType::RollingRock, {{
+			{ UInt, 8 },	// ID
+			{ Int, 4 },	// X-Speed
+			{ Int, 4 }	// Y-Speed
+		}}));
+		Add(JJ2Event::TRIGGER_ROCK, ParamIntToParamList(EventType::RollingRockTrigger, {{
+			{ UInt, 8 }	// ID
+		}}));
+	}
+
+	EventConverter::ConversionFunction EventConverter::GetSpringConverter(uint16_t type, bool horizontal, bool frozen)
+	{
+		return [type, horizontal, frozen](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ Bool, 1 },	// Orientation (vertical only)
+				{ Bool, 1 },	// Keep X Speed
+				{ Bool, 1 },	// Keep Y Speed
+				{ UInt, 4 }	// Delay
+			}});
+
+			// Horizontal springs are resolved to left or right when activated, vertical springs can be on the ceiling
+			uint16_t orientation = (horizontal ? 5 : (GetParam(params, 0) != 0 ? 2 : 0));
+			return { EventType::Spring, PackParams({ type, orientation, GetParam(params, 1), GetParam(params, 2), GetParam(params, 3), (uint16_t)(frozen ? 1 : 0) }) };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::GetPlatformConverter(uint8_t type)
+	{
+		return [type](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 2 },	// Sync
+				{ Int, 6 },	// Speed
+				{ UInt, 4 },	// Length
+				{ Bool, 1 }	// Swing
+			}});
+			return { EventType::MovingPlatform, PackParams({ type, GetParam(params, 0), GetParam(params, 1), GetParam(params, 2), GetParam(params, 3) }) };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::GetPoleConverter(uint8_t theme)
+	{
+		return [theme](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ Int, 5 },	// Adjust Y
+				{ Int, 6 }	// Adjust X
+			}});
+
+			constexpr int AdjustX = 2;
+			constexpr int AdjustY = 2;
+			int16_t x = (int16_t)((int16_t)GetParam(params, 1) + AdjustX);
+			int16_t y = (int16_t)((int16_t)GetParam(params, 0) + AdjustY);
+			return { EventType::Pole, PackParams({ theme, (uint16_t)x, (uint16_t)y }) };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::GetAmmoCrateConverter(uint8_t type)
+	{
+		return [type](JJ2Level& level, uint32_t e) -> ConversionResult {
+			if (type == 0) {
+				// Generic ammo crate picks the weapon on its own
+				return { EventType::CrateAmmo, PackParams({ 0 }) };
+			}
+			return { EventType::Crate, PackParams({ (uint16_t)EventType::Ammo, 5, type }) };
+		};
+	}
+
+	EventConverter::ConversionFunction EventConverter::GetBossConverter(EventType ev, uint16_t customParam)
+	{
+		return [ev, customParam](JJ2Level& level, uint32_t e) -> ConversionResult {
+			auto params = ConvertParamInt(e, {{
+				{ UInt, 8 }	// Ending Text
+			}});
+			return { ev, PackParams({ GetParam(params, 0), customParam }) };
+		};
+	}
 }
\ No newline at end of file
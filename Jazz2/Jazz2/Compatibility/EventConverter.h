@@ -2,53 +2,57 @@
 
 #include "../../Common.h"
 #include "JJ2Event.h"
-#include "JJ2Level.h"
 #include "../EventType.h"
 
-#include <map>
 #include <functional>
 #include <array>
 
 namespace Jazz2::Compatibility
 {
-    class EventConverter
-    {
-    public:
-        struct ConversionResult {
-            EventType Type;
-            std::array<uint8_t, 16> Params;
-        };
-
-        enum class JJ2EventParamType {
-            None,
-            Bool,
-            UInt,
-            Int
-        };
-
-        using ConversionFunction = std::function<ConversionResult(JJ2Level& level, uint32_t e)>;
-
-        EventConverter();
-
-        ConversionResult TryConvert(JJ2Level& level, JJ2Event old, uint32_t eventParams);
-        void Add(JJ2Event originalEvent, ConversionFunction converter);
-        void Override(JJ2Event originalEvent, ConversionFunction converter);
-
-        ConversionFunction NoParamList(EventType ev);
-        ConversionFunction ConstantParamList(EventType ev, std::array<uint8_t, 16> eventParams);
-        ConversionFunction ParamIntToParamList(EventType ev, std::array<std::pair<JJ2EventParamType, int>, 5> paramDefs);
-
-        static std::array<uint8_t, 16> ConvertParamInt(uint32_t paramInt, std::array<std::pair<JJ2EventParamType, int>, 5> paramTypes);
-
-    private:
-        std::map<JJ2Event, ConversionFunction> _converters;
-
-        void AddDefaultConverters();
-
-        static ConversionFunction GetSpringConverter(uint16_t type, bool horizontal, bool frozen);
-        static ConversionFunction GetPlatformConverter(uint8_t type);
-        static ConversionFunction GetPoleConverter(uint8_t theme);
-        static ConversionFunction GetAmmoCrateConverter(uint8_t type);
-        static ConversionFunction GetBossConverter(EventType ev, uint16_t customParam = 0);
-    };
+	class JJ2Level;
+
+	/// Converts events of original levels to events of the engine
+	/*! Converters are only read during conversion, so one instance can be shared by multiple threads. */
+	class EventConverter
+	{
+	public:
+		struct ConversionResult {
+			EventType Type;
+			std::array<uint8_t, 16> Params;
+		};
+
+		enum class JJ2EventParamType {
+			None,
+			Bool,
+			UInt,
+			Int
+		};
+
+		using ConversionFunction = std::function<ConversionResult(JJ2Level& level, uint32_t e)>;
+
+		EventConverter();
+
+		ConversionResult TryConvert(JJ2Level& level, JJ2Event old, uint32_t eventParams) const;
+		void Add(JJ2Event originalEvent, ConversionFunction converter);
+		void Override(JJ2Event originalEvent, ConversionFunction converter);
+
+		static ConversionFunction NoParamList(EventType ev);
+		static ConversionFunction ConstantParamList(EventType ev, std::array<uint8_t, 16> eventParams);
+		static ConversionFunction ParamIntToParamList(EventType ev, std::array<std::pair<JJ2EventParamType, int>, 5> paramDefs);
+
+		/// Unpacks bit fields of original event parameters, each of them is stored as 16-bit value
+		static std::array<uint8_t, 16> ConvertParamInt(uint32_t paramInt, std::array<std::pair<JJ2EventParamType, int>, 5> paramTypes);
+
+	private:
+		/// Original events are 8-bit, so converters are indexed directly by the event
+		std::array<ConversionFunction, 256> _converters;
+
+		void AddDefaultConverters();
+
+		static ConversionFunction GetSpringConverter(uint16_t type, bool horizontal, bool frozen);
+		static ConversionFunction GetPlatformConverter(uint8_t type);
+		static ConversionFunction GetPoleConverter(uint8_t theme);
+		static ConversionFunction GetAmmoCrateConverter(uint8_t type);
+		static ConversionFunction GetBossConverter(EventType ev, uint16_t customParam = 0);
+	};
 }
\ No newline at end of file
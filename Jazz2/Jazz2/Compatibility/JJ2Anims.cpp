@@ -1,8 +1,527 @@
-﻿#pragma once
+﻿#include "JJ2Anims.h"
+#include "JJ2Block.h"
+#include "JJ2DefaultPalette.h"
+#include "ConversionJobs.h"
+#include "PngWriter.h"
 
-#include "../../Common.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include "../../RapidJson/prettywriter.h"
+#include "../../RapidJson/stringbuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace rapidjson;
 
 namespace Jazz2::Compatibility
 {
+	bool JJ2Anims::Convert(const StringView& path, const StringView& targetPath, bool isPlus)
+	{
+		constexpr uint32_t LibraryMagic = 0x42494C41;	// ALIB
+		constexpr uint32_t LibrarySignature = 0x00BEBA00;
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+
+		uint32_t magic = s->ReadValue<uint32_t>();
+		uint32_t signature = s->ReadValue<uint32_t>();
+		RETURNF_ASSERT_MSG_X(magic == LibraryMagic && signature == LibrarySignature, "Invalid magic string in file \"%s\"", s->filename());
+
+		uint32_t headerLen = s->ReadValue<uint32_t>();
+		uint16_t magicUnknown = s->ReadValue<uint16_t>();	// Probably format version
+		s->ReadValue<uint16_t>();	// Unknown (0x1808)
+		s->ReadValue<uint32_t>();	// File length
+		s->ReadValue<uint32_t>();	// CRC
+		int32_t setCount = s->ReadValue<int32_t>();
+		RETURNF_ASSERT_MSG_X(magicUnknown == 0x0200 && setCount > 0 && headerLen == 28 + setCount * 4, "File \"%s\" is not supported", s->filename());
+
+		std::unique_ptr<uint32_t[]> setAddresses = std::make_unique<uint32_t[]>(setCount);
+		s->ReadValues(setAddresses.get(), setCount);
+
+		// Sets are numbered the same way in all versions, so the number of sets is enough to detect the version
+		JJ2Version version;
+		if (isPlus) {
+			version = JJ2Version::PlusExtension;
+		} else {
+			switch (headerLen) {
+				case 464: version = JJ2Version::BaseGame; break;	// 1.20 - 1.23 and Shareware Demo
+				case 500: version = JJ2Version::TSF; break;			// 1.24
+				case 476: version = JJ2Version::HH; break;			// Holiday Hare '98
+				default: version = JJ2Version::Unknown; break;
+			}
+		}
+
+		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
+		AnimSetMapping sampleMapping = AnimSetMapping::GetSampleMapping(version);
+		if (version == JJ2Version::Unknown) {
+			LOGW_X("Version of file \"%s\" is not recognized, all items are written to \"Unknown\" and they are not used by the game", s->filename());
+		}
+		std::atomic_bool failed = false;
+
+		// Each set is read from its own stream, decompressed and encoded to sprite sheets independently
+		ConversionJobs::Run(setCount, [&](int32_t i) {
+			SmallVector<AnimSection, 0> anims;
+			SmallVector<SampleSection, 0> samples;
+			if (!ReadAnimSet(path, i, setAddresses[i], anims, samples)) {
+				failed = true;
+				return;
+			}
+			ImportAnimations(targetPath, animMapping, anims);
+			ImportAudioSamples(targetPath, sampleMapping, samples);
+		});
+
+		return !failed;
+	}
+
+	bool JJ2Anims::ReadAnimSet(const StringView& path, int set, uint32_t address, SmallVectorImpl<AnimSection>& anims, SmallVectorImpl<SampleSection>& samples)
+	{
+		constexpr uint32_t AnimMagic = 0x4D494E41;	// ANIM
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+
+		s->Seek(address, SeekOrigin::Begin);
+
+		uint32_t magic = s->ReadValue<uint32_t>();
+		RETURNF_ASSERT_MSG_X(magic == AnimMagic, "Invalid magic string of set %i in file \"%s\"", set, s->filename());
+
+		uint8_t animCount = s->ReadValue<uint8_t>();
+		uint8_t sampleCount = s->ReadValue<uint8_t>();
+		uint16_t frameCount = s->ReadValue<uint16_t>();
+		s->ReadValue<uint32_t>();	// Cumulative sample index
+
+		int32_t infoBlockLenC = s->ReadValue<int32_t>();
+		int32_t infoBlockLenU = s->ReadValue<int32_t>();
+		int32_t frameDataBlockLenC = s->ReadValue<int32_t>();
+		int32_t frameDataBlockLenU = s->ReadValue<int32_t>();
+		int32_t imageDataBlockLenC = s->ReadValue<int32_t>();
+		int32_t imageDataBlockLenU = s->ReadValue<int32_t>();
+		int32_t sampleDataBlockLenC = s->ReadValue<int32_t>();
+		int32_t sampleDataBlockLenU = s->ReadValue<int32_t>();
+
+		JJ2Block infoBlock(s, infoBlockLenC, infoBlockLenU);
+		JJ2Block frameDataBlock(s, frameDataBlockLenC, frameDataBlockLenU);
+		JJ2Block imageDataBlock(s, imageDataBlockLenC, imageDataBlockLenU);
+		JJ2Block sampleDataBlock(s, sampleDataBlockLenC, sampleDataBlockLenU);
+		RETURNF_ASSERT_MSG_X(infoBlock.IsValid() && frameDataBlock.IsValid() && imageDataBlock.IsValid() && (sampleCount == 0 || sampleDataBlock.IsValid()),
+			"Set %i in file \"%s\" cannot be decompressed", set, s->filename());
+
+		anims.resize(animCount);
+		for (int i = 0; i < animCount; i++) {
+			AnimSection& anim = anims[i];
+			anim.Set = set;
+			anim.Anim = (uint16_t)i;
+			anim.FrameCount = infoBlock.ReadUInt16();
+			anim.FrameRate = infoBlock.ReadUInt16();
+			anim.Frames.resize(anim.FrameCount);
+			anim.AdjustedSizeX = anim.AdjustedSizeY = 0;
+			anim.LargestOffsetX = anim.LargestOffsetY = 0;
+			anim.NormalizedHotspotX = anim.NormalizedHotspotY = 0;
+			anim.FrameConfigurationX = anim.FrameConfigurationY = 0;
+
+			// Skip the imageAddress field
+			infoBlock.DiscardBytes(4);
+		}
+
+		// Frames of all animations in the set are stored one after another
+		int currentAnim = 0, currentFrame = 0;
+		for (int j = 0; j < frameCount; j++) {
+			while (currentAnim < animCount && currentFrame >= anims[currentAnim].FrameCount) {
+				currentAnim++;
+				currentFrame = 0;
+			}
+			if (currentAnim >= animCount) {
+				break;
+			}
+
+			AnimSection& anim = anims[currentAnim];
+			AnimFrameSection& frame = anim.Frames[currentFrame];
+			frame.SizeX = frameDataBlock.ReadInt16();
+			frame.SizeY = frameDataBlock.ReadInt16();
+			frame.ColdspotX = frameDataBlock.ReadInt16();
+			frame.ColdspotY = frameDataBlock.ReadInt16();
+			frame.HotspotX = frameDataBlock.ReadInt16();
+			frame.HotspotY = frameDataBlock.ReadInt16();
+			frame.GunspotX = frameDataBlock.ReadInt16();
+			frame.GunspotY = frameDataBlock.ReadInt16();
+			frame.ImageAddr = frameDataBlock.ReadInt32();
+			frame.MaskAddr = frameDataBlock.ReadInt32();
+			frame.DrawTransparent = false;
+
+			// All frames are aligned by hotspot, so the cell has to fit the union of all frames
+			anim.NormalizedHotspotX = std::max((int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
+			anim.NormalizedHotspotY = std::max((int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
+			anim.LargestOffsetX = std::max((int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
+			anim.LargestOffsetY = std::max((int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
+			anim.AdjustedSizeX = std::max((int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX), anim.AdjustedSizeX);
+			anim.AdjustedSizeY = std::max((int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY), anim.AdjustedSizeY);
+
+			currentFrame++;
+		}
+
+		RETURNF_ASSERT_MSG_X(!infoBlock.ReachedEndOfStream() && !frameDataBlock.ReachedEndOfStream(), "Set %i in file \"%s\" is corrupted", set, s->filename());
+
+		for (AnimSection& anim : anims) {
+			for (AnimFrameSection& frame : anim.Frames) {
+				ReadFrameImage(imageDataBlock, frame);
+			}
+		}
+
+		samples.resize(sampleCount);
+		for (int i = 0; i < sampleCount; i++) {
+			SampleSection& sample = samples[i];
+			sample.Set = set;
+			sample.IdInSet = (uint16_t)i;
+			RETURNF_ASSERT_MSG_X(ReadSample(sampleDataBlock, sample), "Sample %i in set %i in file \"%s\" is corrupted", i, set, s->filename());
+		}
+
+		return true;
+	}
+
+	bool JJ2Anims::ReadSample(JJ2Block& sampleDataBlock, SampleSection& sample)
+	{
+		constexpr uint32_t RiffMagic = 0x46464952;	// RIFF
+		constexpr uint32_t SampleMagic = 0x504D4153;	// SAMP
+		constexpr uint32_t AsffFormat = 0x46465341;	// ASFF
+
+		int32_t totalSize = sampleDataBlock.ReadInt32();
+		uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
+		int32_t chunkSize = sampleDataBlock.ReadInt32();
+		// "ASFF" for 1.20, "AS  " for 1.24
+		uint32_t format = sampleDataBlock.ReadUInt32();
+		bool isASFF = (format == AsffFormat);
+
+		uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
+		sampleDataBlock.ReadUInt32();	// Sample size
+		if (magicRIFF != RiffMagic || magicSAMP != SampleMagic) {
+			return false;
+		}
+
+		// Padding/unknown data
+		sampleDataBlock.DiscardBytes(40);
+
+		if (isASFF) {
+			// All 1.20 samples seem to be 8-bit
+			sampleDataBlock.DiscardBytes(2);
+			sample.Multiplier = 0;
+		} else {
+			sample.Multiplier = sampleDataBlock.ReadUInt16();
+		}
+
+		// Unknown, payload size and padding
+		sampleDataBlock.DiscardBytes(2 + 4 + 8);
+
+		sample.SampleRate = sampleDataBlock.ReadUInt32();
+		sample.DataLength = chunkSize - 76 + (isASFF ? 12 : 0);
+		if (sample.DataLength <= 0) {
+			return false;
+		}
+
+		sample.Data = std::make_unique<uint8_t[]>(sample.DataLength);
+		sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataLength);
+
+		// Padding
+		sampleDataBlock.DiscardBytes(4);
+
+		if (totalSize > chunkSize + 12) {
+			// Sample data are probably aligned, the next sample doesn't always start right after the previous one
+			sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
+		}
+
+		return !sampleDataBlock.ReachedEndOfStream();
+	}
+
+	void JJ2Anims::ReadFrameImage(JJ2Block& imageDataBlock, AnimFrameSection& frame)
+	{
+		int32_t pxTotal = frame.SizeX * frame.SizeY;
+		if (pxTotal <= 0) {
+			return;
+		}
+
+		frame.ImageData = std::make_unique<uint8_t[]>(pxTotal);
+
+		// Frame starts with its dimensions, highest bit of width is used as transparency flag
+		imageDataBlock.SeekTo(frame.ImageAddr);
+		uint16_t width2 = imageDataBlock.ReadUInt16();
+		imageDataBlock.ReadUInt16();	// Height
+		frame.DrawTransparent = (width2 & 0x8000) != 0;
+
+		// Pixels are RLE-encoded
+		int32_t pxRead = 0;
+		bool lastOpEmpty = true;
+		while (pxRead < pxTotal) {
+			uint8_t op = imageDataBlock.ReadByte();
+			if (op < 0x80) {
+				// Skip the given number of pixels, writing them with the transparent color 0
+				pxRead += op;
+			} else if (op == 0x80) {
+				// Skip until the end of the line
+				int32_t linePxRead = pxRead % frame.SizeX;
+				if (linePxRead != 0 || lastOpEmpty) {
+					pxRead += frame.SizeX - linePxRead;
+				}
+			} else if (op == 0x81) {
+				// End of image
+				break;
+			} else {
+				// Copy specified amount of pixels (ignoring the high bit)
+				int32_t count = std::min((int32_t)(op & 0x7F), pxTotal - pxRead);
+				imageDataBlock.ReadRawBytes(&frame.ImageData[pxRead], count);
+				pxRead += count;
+			}
+
+			if (imageDataBlock.ReachedEndOfStream()) {
+				break;
+			}
+
+			lastOpEmpty = (op == 0x80);
+		}
+	}
+
+	void JJ2Anims::ImportAnimations(const StringView& targetPath, const AnimSetMapping& mapping, SmallVectorImpl<AnimSection>& anims)
+	{
+		for (AnimSection& anim : anims) {
+			if (anim.FrameCount == 0 || anim.AdjustedSizeX <= 0 || anim.AdjustedSizeY <= 0) {
+				continue;
+			}
+
+			const AnimSetMapping::Entry* entry = mapping.Get(anim.Set, anim.Anim);
+			if (entry != nullptr && entry->Category == AnimSetMapping::Discard) {
+				continue;
+			}
+
+			String categoryPath, filename;
+			if (entry != nullptr) {
+				categoryPath = fs::joinPath(targetPath, entry->Category);
+				filename = fs::joinPath(categoryPath, entry->Name + ".png"_s);
+			} else {
+				char unknownName[32];
+				int length = std::snprintf(unknownName, sizeof(unknownName), "s%i_a%i.png", anim.Set, anim.Anim);
+				categoryPath = fs::joinPath(targetPath, "Unknown"_s);
+				filename = fs::joinPath(categoryPath, StringView(unknownName, length));
+			}
+
+			if (!fs::isDirectory(categoryPath)) {
+				// Multiple sets can try to create the same directory at once
+				fs::createDir(categoryPath);
+			}
+
+			int border = (entry != nullptr ? entry->AddBorder : 0);
+			int sizeX = anim.AdjustedSizeX + border * 2;
+			int sizeY = anim.AdjustedSizeY + border * 2;
+			FindFrameConfiguration(anim, sizeX, sizeY);
+
+			int width = anim.FrameConfigurationX * sizeX;
+			int height = anim.FrameConfigurationY * sizeY;
+			std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
+			std::memset(pixels.get(), 0, width * height * sizeof(uint32_t));
+
+			for (int j = 0; j < anim.FrameCount; j++) {
+				const AnimFrameSection& frame = anim.Frames[j];
+				if (frame.ImageData == nullptr) {
+					continue;
+				}
+
+				int offsetX = (j % anim.FrameConfigurationX) * sizeX + border + anim.NormalizedHotspotX + frame.HotspotX;
+				int offsetY = (j / anim.FrameConfigurationX) * sizeY + border + anim.NormalizedHotspotY + frame.HotspotY;
+
+				for (int y = 0; y < frame.SizeY; y++) {
+					uint32_t* dst = &pixels[(offsetY + y) * width + offsetX];
+					for (int x = 0; x < frame.SizeX; x++) {
+						uint8_t colorIdx = frame.ImageData[y * frame.SizeX + x];
+						if (colorIdx == 0) {
+							continue;
+						}
+						if (entry != nullptr && entry->Palette != nullptr) {
+							colorIdx = entry->Palette[colorIdx];
+						}
+
+						// Palette index is stored in color channels, it's resolved with the current palette at runtime
+						uint32_t alpha = JJ2DefaultPalette::Sprite[colorIdx].A();
+						if (frame.DrawTransparent) {
+							alpha = std::min(alpha, 127u);
+						}
+						dst[x] = colorIdx | (colorIdx << 8) | (colorIdx << 16) | (alpha << 24);
+					}
+				}
+			}
+
+			if (PngWriter::Save(filename, pixels.get(), width, height)) {
+				CreateAnimationMetadataFile(filename + ".res"_s, anim, border, sizeX, sizeY);
+			}
+		}
+	}
+
+	void JJ2Anims::FindFrameConfiguration(AnimSection& anim, int sizeX, int sizeY)
+	{
+		constexpr int MaxTextureSize = 4096;
+
+		// Find the grid with the least unused cells, the squarest one is preferred if there are more such grids
+		int bestColumns = 0, bestArea = INT_MAX, bestAspect = INT_MAX;
+		for (int columns = 1; columns <= anim.FrameCount; columns++) {
+			int rows = (anim.FrameCount + columns - 1) / columns;
+			int width = columns * sizeX;
+			int height = rows * sizeY;
+			if (width > MaxTextureSize) {
+				break;
+			}
+			if (height > MaxTextureSize) {
+				continue;
+			}
+
+			int area = width * height;
+			int aspect = std::abs(width - height);
+			if (area < bestArea || (area == bestArea && aspect < bestAspect)) {
+				bestColumns = columns;
+				bestArea = area;
+				bestAspect = aspect;
+			}
+		}
+
+		if (bestColumns == 0) {
+			// Frames don't fit to the maximum texture size, so use the squarest grid
+			bestColumns = (int)std::ceil(std::sqrt((float)anim.FrameCount));
+		}
+
+		anim.FrameConfigurationX = (int16_t)bestColumns;
+		anim.FrameConfigurationY = (int16_t)((anim.FrameCount + bestColumns - 1) / bestColumns);
+	}
+
+	bool JJ2Anims::CreateAnimationMetadataFile(const StringView& filename, const AnimSection& currentAnim, int border, int sizeX, int sizeY)
+	{
+		StringBuffer buffer;
+		PrettyWriter<StringBuffer> w(buffer);
+		w.SetIndent('\t', 1);
+
+		w.StartObject();
+
+		w.Key("Version");
+		w.StartObject();
+		w.Key("Target");
+		w.String("Jazz² Resurrection");
+		w.EndObject();
+
+		w.Key("FrameSize");
+		w.StartArray();
+		w.Int(sizeX);
+		w.Int(sizeY);
+		w.EndArray();
+
+		w.Key("FrameConfiguration");
+		w.StartArray();
+		w.Int(currentAnim.FrameConfigurationX);
+		w.Int(currentAnim.FrameConfigurationY);
+		w.EndArray();
+
+		w.Key("FrameCount");
+		w.Int(currentAnim.FrameCount);
+
+		w.Key("FrameRate");
+		w.Int(currentAnim.FrameRate);
+
+		int hotspotX = currentAnim.NormalizedHotspotX + border;
+		int hotspotY = currentAnim.NormalizedHotspotY + border;
+
+		w.Key("Hotspot");
+		w.StartArray();
+		w.Int(hotspotX);
+		w.Int(hotspotY);
+		w.EndArray();
+
+		// Coldspot and gunspot are relative to hotspot of the first frame
+		const AnimFrameSection& frame = currentAnim.Frames[0];
+		if (frame.ColdspotX != 0 || frame.ColdspotY != 0) {
+			w.Key("Coldspot");
+			w.StartArray();
+			w.Int(hotspotX - frame.HotspotX + frame.ColdspotX);
+			w.Int(hotspotY - frame.HotspotY + frame.ColdspotY);
+			w.EndArray();
+		}
+		if (frame.GunspotX != 0 || frame.GunspotY != 0) {
+			w.Key("Gunspot");
+			w.StartArray();
+			w.Int(hotspotX - frame.HotspotX + frame.GunspotX);
+			w.Int(hotspotY - frame.HotspotY + frame.GunspotY);
+			w.EndArray();
+		}
+
+		w.EndObject();
+
+		auto s = IFileStream::createFileHandle(filename);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\" for writing", String::nullTerminatedView(filename).data());
+		s->Write((void*)buffer.GetString(), (unsigned long int)buffer.GetSize());
+		return true;
+	}
+
+	void JJ2Anims::ImportAudioSamples(const StringView& targetPath, const AnimSetMapping& mapping, SmallVectorImpl<SampleSection>& samples)
+	{
+		for (SampleSection& sample : samples) {
+			if (sample.Data == nullptr) {
+				continue;
+			}
+
+			const AnimSetMapping::Entry* entry = mapping.Get(sample.Set, sample.IdInSet);
+			if (entry != nullptr && entry->Category == AnimSetMapping::Discard) {
+				continue;
+			}
+
+			String categoryPath, filename;
+			if (entry != nullptr) {
+				categoryPath = fs::joinPath(targetPath, entry->Category);
+				filename = fs::joinPath(categoryPath, entry->Name + ".wav"_s);
+			} else {
+				char unknownName[32];
+				int length = std::snprintf(unknownName, sizeof(unknownName), "s%i_s%i.wav", sample.Set, sample.IdInSet);
+				categoryPath = fs::joinPath(targetPath, "Unknown"_s);
+				filename = fs::joinPath(categoryPath, StringView(unknownName, length));
+			}
+
+			if (!fs::isDirectory(categoryPath)) {
+				// Multiple sets can try to create the same directory at once
+				fs::createDir(categoryPath);
+			}
+
+			auto so = IFileStream::createFileHandle(filename);
+			so->setExitOnFailToOpen(false);
+			so->Open(FileAccessMode::Write);
+			if (!so->isOpened()) {
+				LOGE_X("Cannot open file \"%s\" for writing", filename.data());
+				continue;
+			}
+
+			// Create PCM .wav file, 16-bit samples are signed, 8-bit samples are converted to unsigned
+			uint16_t bytesPerSample = (uint16_t)((sample.Multiplier / 4) % 2 + 1);
+			so->WriteValue<uint32_t>(0x46464952);	// RIFF
+			so->WriteValue<uint32_t>(sample.DataLength + 36);
+			so->WriteValue<uint32_t>(0x45564157);	// WAVE
+			so->WriteValue<uint32_t>(0x20746D66);	// fmt
+			so->WriteValue<uint32_t>(16);			// Format chunk length
+			so->WriteValue<uint16_t>(1);			// PCM
+			so->WriteValue<uint16_t>(1);			// Mono
+			so->WriteValue<uint32_t>(sample.SampleRate);
+			so->WriteValue<uint32_t>(sample.SampleRate * bytesPerSample);
+			so->WriteValue<uint16_t>(bytesPerSample);
+			so->WriteValue<uint16_t>(bytesPerSample * 8);
+			so->WriteValue<uint32_t>(0x61746164);	// data
+			so->WriteValue<uint32_t>(sample.DataLength);
 
+			if (bytesPerSample == 1) {
+				for (int32_t i = 0; i < sample.DataLength; i++) {
+					sample.Data[i] ^= 0x80;
+				}
+			}
+			so->Write(sample.Data.get(), sample.DataLength);
+		}
+	}
 }
\ No newline at end of file
@@ -1,8 +1,190 @@
-﻿#pragma once
+﻿#include "JJ2Block.h"
 
-#include "../../Common.h"
+#if defined(DEATH_TARGET_EMSCRIPTEN)
+#	define __USE_ZLIB
+#endif
+
+#if defined(__USE_ZLIB)
+#	include <zlib.h>
+#else
+#	if defined(_MSC_VER) && defined(__has_include)
+#		if __has_include("../../../Libs/libdeflate.h")
+#			define __HAS_LOCAL_LIBDEFLATE
+#		endif
+#	endif
+#	ifdef __HAS_LOCAL_LIBDEFLATE
+#		include "../../../Libs/libdeflate.h"
+#	else
+#		include <libdeflate.h>
+#	endif
+#endif
+
+#include <cstring>
 
 namespace Jazz2::Compatibility
 {
+	JJ2Block::JJ2Block(const std::unique_ptr<IFileStream>& s, int32_t length, int32_t uncompressedLength)
+		: _length(0), _offset(0), _hasOverflowed(false)
+	{
+		if (length <= 0) {
+			return;
+		}
+
+		// Compressed data are decompressed directly from the view, so they are never copied
+		ArrayView<const uint8_t> data = s->ReadView(length);
+		if (data.size() < (std::size_t)length) {
+			LOGE_X("Block in file \"%s\" is truncated", s->filename());
+			return;
+		}
+
+		if (uncompressedLength > 0) {
+			_buffer = std::make_unique<uint8_t[]>(uncompressedLength);
+#if defined(__USE_ZLIB)
+			uLongf bytesWritten = uncompressedLength;
+			int result = uncompress(_buffer.get(), &bytesWritten, data.data(), length);
+			if (result != Z_OK || bytesWritten != (uLongf)uncompressedLength) {
+				LOGE_X("Block in file \"%s\" cannot be decompressed (%i)", s->filename(), result);
+				_buffer = nullptr;
+				return;
+			}
+#else
+			libdeflate_decompressor* decompressor = libdeflate_alloc_decompressor();
+			libdeflate_result result = libdeflate_zlib_decompress(decompressor, data.data(), length, _buffer.get(), uncompressedLength, nullptr);
+			libdeflate_free_decompressor(decompressor);
+			if (result != LIBDEFLATE_SUCCESS) {
+				LOGE_X("Block in file \"%s\" cannot be decompressed (%i)", s->filename(), result);
+				_buffer = nullptr;
+				return;
+			}
+#endif
+			_length = uncompressedLength;
+		} else {
+			_buffer = std::make_unique<uint8_t[]>(length);
+			std::memcpy(_buffer.get(), data.data(), length);
+			_length = length;
+		}
+	}
+
+	void JJ2Block::SeekTo(int32_t offset)
+	{
+		if (offset >= 0 && offset <= _length) {
+			_offset = offset;
+		} else {
+			_offset = _length;
+			_hasOverflowed = true;
+		}
+	}
+
+	void JJ2Block::DiscardBytes(int32_t length)
+	{
+		Advance(length);
+	}
+
+	bool JJ2Block::ReadBool()
+	{
+		return (ReadByte() != 0);
+	}
+
+	uint8_t JJ2Block::ReadByte()
+	{
+		const uint8_t* data = Advance(1);
+		return (data != nullptr ? data[0] : 0);
+	}
+
+	int16_t JJ2Block::ReadInt16()
+	{
+		return (int16_t)ReadUInt16();
+	}
+
+	uint16_t JJ2Block::ReadUInt16()
+	{
+		const uint8_t* data = Advance(2);
+		return (data != nullptr ? (uint16_t)(data[0] | (data[1] << 8)) : 0);
+	}
+
+	int32_t JJ2Block::ReadInt32()
+	{
+		return (int32_t)ReadUInt32();
+	}
+
+	uint32_t JJ2Block::ReadUInt32()
+	{
+		const uint8_t* data = Advance(4);
+		return (data != nullptr ? (uint32_t)(data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24)) : 0);
+	}
+
+	int32_t JJ2Block::ReadUint7bitEncoded()
+	{
+		int32_t result = 0;
+		int shift = 0;
+		while (shift < 32) {
+			uint8_t value = ReadByte();
+			result |= (int32_t)(value & 0x7F) << shift;
+			if ((value & 0x80) == 0 || _hasOverflowed) {
+				break;
+			}
+			shift += 7;
+		}
+		return result;
+	}
+
+	float JJ2Block::ReadFloat()
+	{
+		uint32_t value = ReadUInt32();
+		float result;
+		std::memcpy(&result, &value, sizeof(result));
+		return result;
+	}
+
+	float JJ2Block::ReadFloatEncoded()
+	{
+		// Fixed-point number with 16 bits of fraction
+		return (float)ReadInt32() / 65536.0f;
+	}
+
+	String JJ2Block::ReadString(int32_t length, bool trimToNull)
+	{
+		const uint8_t* data = Advance(length);
+		if (data == nullptr) {
+			return { };
+		}
+
+		int32_t realLength = length;
+		if (trimToNull) {
+			const void* nullChar = std::memchr(data, '\0', length);
+			if (nullChar != nullptr) {
+				realLength = (int32_t)((const uint8_t*)nullChar - data);
+			}
+		}
+
+		// Trailing spaces are never significant in original files
+		while (realLength > 0 && data[realLength - 1] == ' ') {
+			realLength--;
+		}
+
+		return String((const char*)data, realLength);
+	}
+
+	void JJ2Block::ReadRawBytes(uint8_t* dst, int32_t length)
+	{
+		const uint8_t* data = Advance(length);
+		if (data != nullptr) {
+			std::memcpy(dst, data, length);
+		} else {
+			std::memset(dst, 0, length);
+		}
+	}
+
+	const uint8_t* JJ2Block::Advance(int32_t length)
+	{
+		if (length < 0 || length > _length - _offset) {
+			_offset = _length;
+			_hasOverflowed = true;
+			return nullptr;
+		}
 
+		const uint8_t* data = _buffer.get() + _offset;
+		_offset += length;
+		return data;
+	}
 }
\ No newline at end of file
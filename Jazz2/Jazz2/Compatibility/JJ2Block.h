@@ -3,32 +3,57 @@
 #include "../../Common.h"
 #include "../../nCine/IO/IFileStream.h"
 
+#include <memory>
+
+#include <Containers/String.h>
+
+using namespace Death::Containers;
 using namespace nCine;
 
 namespace Jazz2::Compatibility
 {
-    class JJ2Block
-    {
-    public:
-        JJ2Block(std::unique_ptr<IFileStream> s, int length, int uncompressedLength = 0);
-
-        void SeekTo(int offset);
-        void DiscardBytes(int length);
-
-        bool ReadBool();
-        uint8_t ReadByte();
-        int16_t ReadInt16();
-        uint16_t ReadUInt16();
-        int32_t ReadInt32();
-        uint32_t ReadUInt32();
-        int32_t ReadUint7bitEncoded();
-        float ReadFloat();
-        float ReadFloatEncoded();
-        //byte[] ReadRawBytes(int length);
-
-
-    private:
-        std::unique_ptr<IFileStream> _stream;
-        std::unique_ptr<byte[]> _buffer;
-    };
+	/// Block of data read from original game files, it's decompressed if needed
+	/*! Values are read from memory, reading beyond the end of the block returns zeros. */
+	class JJ2Block
+	{
+	public:
+		JJ2Block(const std::unique_ptr<IFileStream>& s, int32_t length, int32_t uncompressedLength = 0);
+
+		void SeekTo(int32_t offset);
+		void DiscardBytes(int32_t length);
+
+		bool ReadBool();
+		uint8_t ReadByte();
+		int16_t ReadInt16();
+		uint16_t ReadUInt16();
+		int32_t ReadInt32();
+		uint32_t ReadUInt32();
+		int32_t ReadUint7bitEncoded();
+		float ReadFloat();
+		float ReadFloatEncoded();
+		/// Reads fixed-length string, it's trimmed to the first null character if requested
+		String ReadString(int32_t length, bool trimToNull);
+		/// Copies raw bytes to a buffer
+		void ReadRawBytes(uint8_t* dst, int32_t length);
+
+		/// Returns true if the block was read and decompressed successfully
+		bool IsValid() const {
+			return (_buffer != nullptr);
+		}
+		/// Returns true if any read reached beyond the end of the block
+		bool ReachedEndOfStream() const {
+			return _hasOverflowed;
+		}
+		int32_t GetLength() const {
+			return _length;
+		}
+
+	private:
+		std::unique_ptr<uint8_t[]> _buffer;
+		int32_t _length;
+		int32_t _offset;
+		bool _hasOverflowed;
+
+		const uint8_t* Advance(int32_t length);
+	};
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+﻿#include "JJ2Converter.h"
+#include "ConversionJobs.h"
+#include "ConversionManifest.h"
+#include "EventConverter.h"
+#include "JJ2Anims.h"
+#include "JJ2Episode.h"
+#include "JJ2Level.h"
+#include "JJ2Strings.h"
+#include "JJ2Tileset.h"
+
+#include "../../nCine/Base/HashMap.h"
+#include "../../nCine/IO/FileSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
+
+namespace Jazz2::Compatibility
+{
+	namespace
+	{
+		/// Changing the version forces all files of the same type to be converted again
+		constexpr uint64_t AnimsFormatVersion = 1;
+		constexpr uint64_t TilesetFormatVersion = 1;
+		constexpr uint64_t StringsFormatVersion = 1;
+
+		/// Levels that don't belong to any episode are stored here
+		constexpr char UnknownEpisode[] = "unknown";
+
+		String ToLowerWithoutExtension(const StringView& value)
+		{
+			String result = value;
+			for (char& c : result) {
+				if (c >= 'A' && c <= 'Z') {
+					c = c - 'A' + 'a';
+				}
+			}
+			StringView extension = fs::extension(result);
+			if (!extension.empty()) {
+				result = result.prefix(result.size() - extension.size() - 1);
+			}
+			return result;
+		}
+
+		struct LevelLinks {
+			String Name;
+			String NextLevel;
+			String SecretLevel;
+		};
+	}
+
+	bool JJ2Converter::Convert(const StringView& sourcePath, const StringView& targetPath)
+	{
+		RETURNF_ASSERT_MSG_X(fs::isDirectory(sourcePath), "Directory \"%s\" doesn't exist", String::nullTerminatedView(sourcePath).data());
+
+		String animationsPath = fs::joinPath(targetPath, "Animations"_s);
+		String episodesPath = fs::joinPath(targetPath, "Episodes"_s);
+		String tilesetsPath = fs::joinPath(targetPath, "Tilesets"_s);
+		String translationsPath = fs::joinPath(targetPath, "Translations"_s);
+		for (const String& path : { String(targetPath), animationsPath, episodesPath, tilesetsPath, translationsPath }) {
+			if (!fs::isDirectory(path) && !fs::createDir(path)) {
+				LOGE_X("Cannot create directory \"%s\"", path.data());
+				return false;
+			}
+		}
+
+		SmallVector<String, 0> animFiles, episodeFiles, levelFiles, stringsFiles, tilesetFiles;
+		{
+			FileSystem::Directory dir(sourcePath);
+			while (const char* name = dir.readNext()) {
+				String path = fs::joinPath(sourcePath, name);
+				if (!fs::isFile(path)) {
+					continue;
+				}
+
+				String extension = ToLowerWithoutExtension(fs::extension(name));
+				if (extension == "j2a"_s) {
+					animFiles.push_back(std::move(path));
+				} else if (extension == "j2e"_s) {
+					episodeFiles.push_back(std::move(path));
+				} else if (extension == "j2l"_s) {
+					levelFiles.push_back(std::move(path));
+				} else if (extension == "j2s"_s) {
+					stringsFiles.push_back(std::move(path));
+				} else if (extension == "j2t"_s) {
+					tilesetFiles.push_back(std::move(path));
+				}
+			}
+		}
+
+		// Order of files in the directory is not defined, but hash of level dependencies must not depend on it
+		std::sort(episodeFiles.begin(), episodeFiles.end());
+		std::sort(levelFiles.begin(), levelFiles.end());
+
+		ConversionManifest manifest(fs::joinPath(targetPath, "Source.manifest"_s));
+
+		// Animation libraries contain many independent sets, so they are converted in parallel internally
+		for (const String& path : animFiles) {
+			uint64_t hash = ConversionManifest::HashFile(path, AnimsFormatVersion);
+			if (manifest.IsUpToDate(path, hash, animationsPath)) {
+				continue;
+			}
+
+			bool isPlus = (ToLowerWithoutExtension(fs::baseName(path)) == "plus"_s);
+			if (JJ2Anims::Convert(path, animationsPath, isPlus)) {
+				manifest.Update(path, hash);
+			}
+		}
+
+		ConversionJobs::Run((int32_t)tilesetFiles.size(), [&](int32_t i) {
+			const String& path = tilesetFiles[i];
+			String tilesetPath = fs::joinPath(tilesetsPath, ToLowerWithoutExtension(fs::baseName(path)));
+			uint64_t hash = ConversionManifest::HashFile(path, TilesetFormatVersion);
+			// Mask is written last, so the tileset was converted completely if it exists
+			if (manifest.IsUpToDate(path, hash, fs::joinPath(tilesetPath, "Mask.tiles"_s))) {
+				return;
+			}
+
+			JJ2Tileset tileset;
+			if (tileset.Open(path, false) && tileset.Convert(tilesetPath)) {
+				manifest.Update(path, hash);
+			}
+		});
+
+		// Levels are assigned to episodes by following links from the first level of each episode,
+		// so only metadata of all levels have to be read before the conversion
+		SmallVector<LevelLinks, 0> levelLinks(levelFiles.size());
+		ConversionJobs::Run((int32_t)levelFiles.size(), [&](int32_t i) {
+			LevelLinks& links = levelLinks[i];
+			links.Name = ToLowerWithoutExtension(fs::baseName(levelFiles[i]));
+
+			JJ2Level level;
+			if (level.Open(levelFiles[i], false, true)) {
+				links.NextLevel = ToLowerWithoutExtension(level.NextLevel);
+				links.SecretLevel = ToLowerWithoutExtension(level.SecretLevel);
+			}
+		});
+
+		HashMap<String, int32_t> levelsByName;
+		for (int32_t i = 0; i < (int32_t)levelLinks.size(); i++) {
+			levelsByName.emplace(levelLinks[i].Name, i);
+		}
+
+		// Converted levels depend on episodes and links between levels, because they determine target paths of levels
+		uint64_t levelDependencyHash = ConversionManifest::HashCombine(1, (uint64_t)episodeFiles.size());
+		SmallVector<JJ2Episode, 0> episodes;
+		for (const String& path : episodeFiles) {
+			levelDependencyHash = ConversionManifest::HashCombine(levelDependencyHash, ConversionManifest::HashFile(path, 0));
+			JJ2Episode episode;
+			if (episode.Open(path)) {
+				episodes.push_back(std::move(episode));
+			}
+		}
+		std::sort(episodes.begin(), episodes.end(), [](const JJ2Episode& a, const JJ2Episode& b) {
+			return a.Position < b.Position;
+		});
+
+		HashMap<String, JJ2Level::LevelToken> levelTokens;
+		for (const JJ2Episode& episode : episodes) {
+			String current = episode.FirstLevel;
+			int number = 1;
+			while (!current.empty() && levelTokens.find(current) == levelTokens.end()) {
+				auto it = levelsByName.find(current);
+				if (it == levelsByName.end()) {
+					// Usually "endepis" or a level that is not installed
+					break;
+				}
+
+				// Levels are numbered, so they are sorted the same way as in the episode
+				char prefix[8];
+				int prefixLength = std::snprintf(prefix, sizeof(prefix), "%02i_", number);
+				levelTokens.emplace(current, JJ2Level::LevelToken { episode.EpisodeToken, StringView(prefix, prefixLength) + current });
+				number++;
+
+				const LevelLinks& links = levelLinks[it->second];
+				if (!links.SecretLevel.empty() && levelTokens.find(links.SecretLevel) == levelTokens.end() &&
+					levelsByName.find(links.SecretLevel) != levelsByName.end()) {
+					levelTokens.emplace(links.SecretLevel, JJ2Level::LevelToken { episode.EpisodeToken, links.SecretLevel });
+				}
+
+				current = links.NextLevel;
+			}
+		}
+
+		for (const LevelLinks& links : levelLinks) {
+			levelDependencyHash = ConversionManifest::HashCombine(levelDependencyHash, links.Name);
+			levelDependencyHash = ConversionManifest::HashCombine(levelDependencyHash, links.NextLevel);
+			levelDependencyHash = ConversionManifest::HashCombine(levelDependencyHash, links.SecretLevel);
+		}
+
+		auto levelTokenConversion = [&levelTokens](const StringView& levelName) -> JJ2Level::LevelToken {
+			String name = ToLowerWithoutExtension(levelName);
+			auto it = levelTokens.find(name);
+			if (it != levelTokens.end()) {
+				return it->second;
+			}
+			return JJ2Level::LevelToken { UnknownEpisode, name };
+		};
+
+		for (int32_t i = 0; i < (int32_t)episodes.size(); i++) {
+			episodes[i].Convert(episodesPath, levelTokenConversion, nullptr, [&episodes, i](JJ2Episode&) {
+				return std::pair<String, String>(i > 0 ? episodes[i - 1].EpisodeToken : String(),
+					i + 1 < (int32_t)episodes.size() ? episodes[i + 1].EpisodeToken : String());
+			});
+		}
+
+		// Translated texts of levels are stored by level tokens, so they depend on the same inputs as levels
+		for (const String& path : stringsFiles) {
+			uint64_t hash = ConversionManifest::HashFile(path, StringsFormatVersion);
+			hash = ConversionManifest::HashCombine(hash, levelDependencyHash);
+			String outputPath = fs::joinPath(translationsPath, ToLowerWithoutExtension(fs::baseName(path)) + ".res"_s);
+			if (manifest.IsUpToDate(path, hash, outputPath)) {
+				continue;
+			}
+
+			JJ2Strings strings;
+			if (strings.Open(path) && strings.Convert(translationsPath, levelTokenConversion)) {
+				manifest.Update(path, hash);
+			}
+		}
+
+		EventConverter eventConverter;
+		int convertedLevels = JJ2Level::ConvertAll(arrayView(levelFiles.data(), levelFiles.size()), episodesPath, eventConverter, &manifest, levelDependencyHash, levelTokenConversion);
+		LOGI_X("%i of %i levels converted", convertedLevels, (int)levelFiles.size());
+
+		return manifest.Save();
+	}
+}
\ No newline at end of file
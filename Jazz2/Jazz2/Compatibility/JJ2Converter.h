@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Compatibility
+{
+	/// Converts the whole installation of the original game to `Content` directory
+	/*! Source files that weren't changed since the last conversion are skipped, so it can run on every start. */
+	class JJ2Converter
+	{
+	public:
+		static bool Convert(const StringView& sourcePath, const StringView& targetPath);
+
+	private:
+		JJ2Converter() = delete;
+	};
+}
\ No newline at end of file
@@ -1,8 +1,135 @@
-﻿#pragma once
+﻿#include "JJ2Episode.h"
+#include "JJ2Text.h"
 
-#include "../../Common.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include "../../RapidJson/prettywriter.h"
+#include "../../RapidJson/stringbuffer.h"
+
+using namespace rapidjson;
 
 namespace Jazz2::Compatibility
 {
+	namespace
+	{
+		String ReadFixedString(const std::unique_ptr<IFileStream>& s, int32_t length)
+		{
+			char buffer[128];
+			length = std::min(length, (int32_t)sizeof(buffer));
+			s->Read(buffer, length);
+
+			int32_t realLength = 0;
+			while (realLength < length && buffer[realLength] != '\0') {
+				realLength++;
+			}
+			return String(buffer, realLength);
+		}
+
+		String ToLower(const StringView& value)
+		{
+			String result = value;
+			for (char& c : result) {
+				if (c >= 'A' && c <= 'Z') {
+					c = c - 'A' + 'a';
+				}
+			}
+			return result;
+		}
+	}
+
+	JJ2Episode::JJ2Episode()
+		: Position(0), _isRegistered(false)
+	{
+	}
+
+	JJ2Episode::JJ2Episode(const String& episodeToken, const String& episodeName, const String& firstLevel, int position)
+		: Position(position), EpisodeToken(episodeToken), EpisodeName(episodeName), FirstLevel(firstLevel), _isRegistered(false)
+	{
+	}
+
+	bool JJ2Episode::Open(const StringView& path)
+	{
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+		RETURNF_ASSERT_MSG_X(s->GetSize() >= 176, "File \"%s\" is too small", s->filename());
+
+		String fileName = ToLower(fs::baseName(path));
+		EpisodeToken = (fileName.hasSuffix(".j2e"_s) ? String(fileName.exceptSuffix(4)) : fileName);
+
+		// TODO: Implement JJ2+ extended data, but I haven't seen it anywhere yet
+		s->ReadValue<int32_t>();	// Header size
+		Position = s->ReadValue<int32_t>();
+		// 0x00000001 = Registered version required
+		_isRegistered = (s->ReadValue<uint32_t>() & 0x01) != 0;
+		s->ReadValue<uint32_t>();	// Unknown
+
+		// Title images follow, they are not used
+		EpisodeName = ReadFixedString(s, 128);
+		FirstLevel = ToLower(ReadFixedString(s, 32));
+		if (FirstLevel.hasSuffix(".j2l"_s)) {
+			FirstLevel = FirstLevel.exceptSuffix(4);
+		}
+
+		return true;
+	}
+
+	bool JJ2Episode::Convert(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion,
+		const std::function<String(JJ2Episode&)>& episodeNameConversion, const std::function<std::pair<String, String>(JJ2Episode&)>& episodePrevNext)
+	{
+		String episodePath = fs::joinPath(targetPath, EpisodeToken);
+		if (!fs::isDirectory(episodePath) && !fs::createDir(episodePath)) {
+			LOGE_X("Cannot create directory \"%s\"", episodePath.data());
+			return false;
+		}
+
+		StringBuffer buffer;
+		PrettyWriter<StringBuffer> w(buffer);
+		w.SetIndent('\t', 1);
+
+		w.StartObject();
+
+		w.Key("Version");
+		w.StartObject();
+		w.Key("Target");
+		w.String("Jazz² Resurrection");
+		w.EndObject();
+
+		String name = (episodeNameConversion != nullptr ? episodeNameConversion(*this) : JJ2Text::ConvertFormattedString(EpisodeName));
+		w.Key("Name");
+		w.String(name.data(), (SizeType)name.size());
+
+		w.Key("Position");
+		w.Int(Position);
+
+		String firstLevel = FirstLevel;
+		if (levelTokenConversion != nullptr) {
+			firstLevel = levelTokenConversion(FirstLevel).Level;
+		}
+		w.Key("FirstLevel");
+		w.String(firstLevel.data(), (SizeType)firstLevel.size());
+
+		if (episodePrevNext != nullptr) {
+			std::pair<String, String> prevNext = episodePrevNext(*this);
+			if (!prevNext.first.empty()) {
+				w.Key("PreviousEpisode");
+				w.String(prevNext.first.data(), (SizeType)prevNext.first.size());
+			}
+			if (!prevNext.second.empty()) {
+				w.Key("NextEpisode");
+				w.String(prevNext.second.data(), (SizeType)prevNext.second.size());
+			}
+		}
+
+		w.EndObject();
 
+		auto so = IFileStream::createFileHandle(fs::joinPath(episodePath, "Episode.res"_s));
+		so->setExitOnFailToOpen(false);
+		so->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(so->isOpened(), "Cannot open file \"%s\" for writing", so->filename());
+		so->Write((void*)buffer.GetString(), (unsigned long int)buffer.GetSize());
+		return true;
+	}
 }
\ No newline at end of file
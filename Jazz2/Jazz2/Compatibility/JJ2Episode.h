@@ -4,7 +4,6 @@
 #include "JJ2Level.h"
 
 #include <functional>
-#include <memory>
 #include <utility>
 
 #include <Containers/String.h>
@@ -22,20 +21,16 @@ namespace Jazz2::Compatibility
 		String EpisodeName;
 		String FirstLevel;
 
-		JJ2Episode(const String& episodeToken, const String& episodeName, const String& firstLevel, int position)
-			: EpisodeToken(episodeToken), EpisodeName(episodeName), FirstLevel(firstLevel), Position(position), _isRegistered(false)
-		{
-		}
+		JJ2Episode();
+		JJ2Episode(const String& episodeToken, const String& episodeName, const String& firstLevel, int position);
 
-		static JJ2Episode Open(const StringView& path);
+		bool Open(const StringView& path);
 
-		void Convert(const String& targetPath, std::function<JJ2Level::LevelToken(const String&)> levelTokenConversion = nullptr, std::function<String(JJ2Episode&)> episodeNameConversion = nullptr, std::function<std::pair<String, String>(JJ2Episode&)> episodePrevNext = nullptr);
+		/// Writes episode description to `targetPath/<episode>/Episode.res`
+		bool Convert(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion = nullptr,
+			const std::function<String(JJ2Episode&)>& episodeNameConversion = nullptr, const std::function<std::pair<String, String>(JJ2Episode&)>& episodePrevNext = nullptr);
 
 	private:
 		bool _isRegistered;
-		std::unique_ptr<uint8_t[]> _titleLight;
-
-		JJ2Episode() { }
-
 	};
 }
\ No newline at end of file
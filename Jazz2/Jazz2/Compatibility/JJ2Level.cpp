@@ -1,8 +1,747 @@
-﻿#pragma once
+﻿#include "JJ2Level.h"
+#include "ConversionJobs.h"
+#include "ConversionManifest.h"
+#include "JJ2Text.h"
+#include "../LevelHandler.h"
 
-#include "../../Common.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include "../../RapidJson/prettywriter.h"
+#include "../../RapidJson/stringbuffer.h"
+
+#include <atomic>
+#include <cstring>
+
+using namespace rapidjson;
 
 namespace Jazz2::Compatibility
 {
+	namespace
+	{
+		/// Changing the seed forces all levels to be converted again, it should be changed with the output format
+		/*! Revision covers changes of the converter that don't change the format, e.g. conversion of texts. */
+		constexpr uint64_t ConverterRevision = 1;
+		constexpr uint64_t ConversionVersion = (ConverterRevision << 32) | ((uint64_t)LevelHandler::LayerFormatVersion << 16) | LevelHandler::EventSetVersion;
+
+		String ToLowerWithoutExtension(const StringView& value, const StringView& extension)
+		{
+			StringView trimmed = value;
+			if (trimmed.size() > extension.size()) {
+				StringView suffix = trimmed.exceptPrefix(trimmed.size() - extension.size());
+				bool matches = true;
+				for (std::size_t i = 0; i < extension.size(); i++) {
+					char c = suffix[i];
+					if (c >= 'A' && c <= 'Z') {
+						c = c - 'A' + 'a';
+					}
+					if (c != extension[i]) {
+						matches = false;
+						break;
+					}
+				}
+				if (matches) {
+					trimmed = trimmed.prefix(trimmed.size() - extension.size());
+				}
+			}
+
+			String result = trimmed;
+			for (char& c : result) {
+				if (c >= 'A' && c <= 'Z') {
+					c = c - 'A' + 'a';
+				}
+			}
+			return result;
+		}
+
+		bool WriteFile(const StringView& path, const void* data, std::size_t size)
+		{
+			auto s = IFileStream::createFileHandle(path);
+			s->setExitOnFailToOpen(false);
+			s->Open(FileAccessMode::Write);
+			if (!s->isOpened()) {
+				LOGE_X("Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+				return false;
+			}
+			return (s->Write((void*)data, (unsigned long int)size) == size);
+		}
+
+		String GetLayerName(int index)
+		{
+			switch (index) {
+				case JJ2Level::SpriteLayerIndex: return "Sprite"_s;
+				case JJ2Level::SkyLayerIndex: return "Sky"_s;
+				default: {
+					char name[2] = { (char)('1' + index), '\0' };
+					return String(name, 1);
+				}
+			}
+		}
+
+		/// Output files are assembled in memory first and written at once
+		class OutputBuffer
+		{
+		public:
+			template<typename T>
+			void WriteValue(T value) {
+				const uint8_t* bytes = (const uint8_t*)&value;
+				_data.append(bytes, bytes + sizeof(T));
+			}
+
+			void Write(const void* data, std::size_t size) {
+				const uint8_t* bytes = (const uint8_t*)data;
+				_data.append(bytes, bytes + size);
+			}
+
+			void Reserve(std::size_t size) {
+				_data.reserve(size);
+			}
+
+			bool Save(const StringView& path) {
+				return WriteFile(path, _data.data(), _data.size());
+			}
+
+		private:
+			SmallVector<uint8_t, 0> _data;
+		};
+	}
+
+	JJ2Level::JJ2Level()
+		: Version(JJ2Version::Unknown), _lightingMin(0), _lightingStart(0), _animCount(0), _verticalMPSplitscreen(false), _isMpLevel(false), _layers{}
+	{
+	}
+
+	bool JJ2Level::Open(const StringView& path, bool strictParser, bool metadataOnly)
+	{
+		constexpr int CopyrightSize = 180;
+		constexpr int HeaderSize = 262;
+		constexpr uint32_t LevelMagic = 0x4C56454C;	// LEVL
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+		RETURNF_ASSERT_MSG_X(s->GetSize() > HeaderSize, "File \"%s\" is too small", s->filename());
+
+		_levelToken = ToLowerWithoutExtension(fs::baseName(path), ".j2l"_s);
+
+		// Skip copyright notice
+		s->Seek(CopyrightSize, SeekOrigin::Current);
+
+		JJ2Block headerBlock(s, HeaderSize - CopyrightSize);
+
+		uint32_t magic = headerBlock.ReadUInt32();
+		RETURNF_ASSERT_MSG_X(magic == LevelMagic, "Invalid magic string in file \"%s\"", s->filename());
+
+		// Password hash is 3 bytes, followed by "hide in Home Cooked Levels" flag
+		headerBlock.DiscardBytes(4);
+
+		Name = headerBlock.ReadString(32, true);
+
+		uint16_t version = headerBlock.ReadUInt16();
+		Version = (version <= 514 ? JJ2Version::BaseGame : JJ2Version::TSF);
+
+		int32_t recordedSize = headerBlock.ReadInt32();
+		RETURNF_ASSERT_MSG_X(!strictParser || s->GetSize() == recordedSize, "Unexpected size of file \"%s\"", s->filename());
+
+		// CRC is not checked, it's not known which part of the file it covers
+		headerBlock.DiscardBytes(4);
+
+		int32_t infoBlockPackedSize = headerBlock.ReadInt32();
+		int32_t infoBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t eventBlockPackedSize = headerBlock.ReadInt32();
+		int32_t eventBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t dictBlockPackedSize = headerBlock.ReadInt32();
+		int32_t dictBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t layoutBlockPackedSize = headerBlock.ReadInt32();
+		int32_t layoutBlockUnpackedSize = headerBlock.ReadInt32();
+		RETURNF_ASSERT_MSG_X(!headerBlock.ReachedEndOfStream(), "Header of file \"%s\" is truncated", s->filename());
+
+		JJ2Block infoBlock(s, infoBlockPackedSize, infoBlockUnpackedSize);
+		RETURNF_ASSERT_MSG_X(infoBlock.IsValid(), "File \"%s\" cannot be decompressed", s->filename());
+		RETURNF_ASSERT_MSG_X(LoadMetadata(infoBlock, strictParser), "Metadata of file \"%s\" are corrupted", s->filename());
+		if (metadataOnly) {
+			return true;
+		}
+
+		JJ2Block eventBlock(s, eventBlockPackedSize, eventBlockUnpackedSize);
+		JJ2Block dictBlock(s, dictBlockPackedSize, dictBlockUnpackedSize);
+		JJ2Block layoutBlock(s, layoutBlockPackedSize, layoutBlockUnpackedSize);
+		RETURNF_ASSERT_MSG_X(eventBlock.IsValid() && dictBlock.IsValid() && layoutBlock.IsValid(),
+			"File \"%s\" cannot be decompressed", s->filename());
+
+		RETURNF_ASSERT_MSG_X(LoadEvents(eventBlock), "Events of file \"%s\" are corrupted", s->filename());
+		RETURNF_ASSERT_MSG_X(LoadLayers(dictBlock, dictBlockUnpackedSize / 8, layoutBlock), "Layers of file \"%s\" are corrupted", s->filename());
+		return true;
+	}
+
+	bool JJ2Level::Convert(const StringView& targetPath, const EventConverter& eventConverter, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion)
+	{
+		if (!fs::isDirectory(targetPath) && !fs::createDir(targetPath)) {
+			LOGE_X("Cannot create directory \"%s\"", String::nullTerminatedView(targetPath).data());
+			return false;
+		}
+
+		if (!WriteDescription(targetPath, levelTokenConversion)) {
+			return false;
+		}
+
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			if ((_layers[i].Used || i == SpriteLayerIndex) && !WriteLayer(targetPath, _layers[i])) {
+				return false;
+			}
+		}
+
+		return (WriteAnimatedTiles(targetPath) && WriteEvents(targetPath, eventConverter));
+	}
+
+	int JJ2Level::ConvertAll(const ArrayView<const String> paths, const StringView& targetPath, const EventConverter& eventConverter,
+		ConversionManifest* manifest, uint64_t dependencyHash, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion)
+	{
+		std::atomic_int convertedCount = 0;
+
+		// Levels don't depend on each other, so each one is a separate job
+		ConversionJobs::Run((int32_t)paths.size(), [&](int32_t i) {
+			const String& path = paths[i];
+
+			// Target path is known before the level is opened, so up-to-date levels are not read at all
+			String levelToken = ToLowerWithoutExtension(fs::baseName(path), ".j2l"_s);
+			String episodePath, levelPath;
+			if (levelTokenConversion != nullptr) {
+				LevelToken token = levelTokenConversion(levelToken);
+				episodePath = fs::joinPath(targetPath, token.Episode);
+				levelPath = fs::joinPath(episodePath, token.Level);
+			} else {
+				levelPath = fs::joinPath(targetPath, levelToken);
+			}
+
+			uint64_t hash = 0;
+			if (manifest != nullptr) {
+				hash = ConversionManifest::HashFile(path, ConversionVersion);
+				hash = ConversionManifest::HashCombine(hash, dependencyHash);
+				// Events are written last, so the level was converted completely if they exist
+				if (manifest->IsUpToDate(path, hash, fs::joinPath(levelPath, "Events.layer"_s))) {
+					return;
+				}
+			}
+
+			JJ2Level level;
+			if (!level.Open(path, false)) {
+				return;
+			}
+
+			if (!episodePath.empty() && !fs::isDirectory(episodePath)) {
+				// Multiple levels of the same episode can try to create the directory at once
+				fs::createDir(episodePath);
+			}
+
+			if (!level.Convert(levelPath, eventConverter, levelTokenConversion)) {
+				return;
+			}
+
+			if (manifest != nullptr) {
+				manifest->Update(path, hash);
+			}
+			convertedCount++;
+		});
+
+		return convertedCount;
+	}
+
+	bool JJ2Level::LoadMetadata(JJ2Block& block, bool strictParser)
+	{
+		// First 9 bytes are JCS coordinates on last save
+		block.DiscardBytes(9);
+
+		_lightingMin = block.ReadByte();
+		_lightingStart = block.ReadByte();
+		_animCount = block.ReadUInt16();
+		_verticalMPSplitscreen = block.ReadBool();
+		_isMpLevel = block.ReadBool();
+
+		// This should be the same as size of block in the start
+		block.DiscardBytes(4);
+
+		String secondLevelName = block.ReadString(32, true);
+		if (strictParser && Name != secondLevelName) {
+			return false;
+		}
+
+		Tileset = block.ReadString(32, true);
+		BonusLevel = block.ReadString(32, true);
+		NextLevel = block.ReadString(32, true);
+		SecretLevel = block.ReadString(32, true);
+		Music = block.ReadString(32, true);
+
+		for (int i = 0; i < TextEventStringsCount; i++) {
+			_textEventStrings[i] = block.ReadString(512, true);
+		}
+
+		LoadLayerMetadata(block);
+
+		uint16_t staticTilesCount = block.ReadUInt16();
+		if (_animCount > GetMaxSupportedAnims() || (strictParser && GetMaxSupportedTiles() - _animCount != staticTilesCount)) {
+			return false;
+		}
+
+		LoadStaticTileData(block);
+
+		// The unused XMask field
+		block.DiscardBytes(GetMaxSupportedTiles());
+
+		LoadAnimatedTiles(block);
+
+		return !block.ReachedEndOfStream();
+	}
+
+	void JJ2Level::LoadLayerMetadata(JJ2Block& block)
+	{
+		// Each property is stored for all layers at once
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Flags = block.ReadUInt32();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Type = block.ReadByte();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Used = block.ReadBool();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Width = block.ReadInt32();
+		}
+		// This is related to how data is presented in the file, the above is a width in tiles
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].InternalWidth = block.ReadInt32();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Height = block.ReadInt32();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].Depth = block.ReadInt32();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].DetailLevel = block.ReadByte();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].OffsetX = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].OffsetY = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].SpeedX = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].SpeedY = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].AutoSpeedX = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].AutoSpeedY = block.ReadFloatEncoded();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].TexturedBackgroundType = block.ReadByte();
+		}
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			_layers[i].TexturedParams1 = block.ReadByte();
+			_layers[i].TexturedParams2 = block.ReadByte();
+			_layers[i].TexturedParams3 = block.ReadByte();
+		}
+	}
+
+	void JJ2Level::LoadStaticTileData(JJ2Block& block)
+	{
+		int tileCount = GetMaxSupportedTiles();
+		_staticTiles = std::make_unique<TilePropertiesSection[]>(tileCount);
+
+		for (int i = 0; i < tileCount; i++) {
+			uint32_t tileEvent = block.ReadUInt32();
+
+			TileEventSection& e = _staticTiles[i].Event;
+			e.EventType = (JJ2Event)(uint8_t)(tileEvent & 0x000000FF);
+			e.Difficulty = (uint8_t)((tileEvent & 0x0000C000) >> 14);
+			e.Illuminate = ((tileEvent & 0x00002000) >> 13) == 1;
+			e.TileParams = (((tileEvent >> 12) & 0x000FFFF0) | ((tileEvent >> 8) & 0x0000000F));
+		}
+		for (int i = 0; i < tileCount; i++) {
+			_staticTiles[i].Flipped = block.ReadBool();
+		}
+		for (int i = 0; i < tileCount; i++) {
+			_staticTiles[i].Type = block.ReadByte();
+		}
+	}
+
+	void JJ2Level::LoadAnimatedTiles(JJ2Block& block)
+	{
+		_animatedTiles.resize(_animCount);
+
+		for (int i = 0; i < _animCount; i++) {
+			AnimatedTileSection& tile = _animatedTiles[i];
+			tile.Delay = block.ReadUInt16();
+			tile.DelayJitter = block.ReadUInt16();
+			tile.ReverseDelay = block.ReadUInt16();
+			tile.IsReverse = block.ReadBool();
+			tile.Speed = block.ReadByte();	// 0-70
+			tile.FrameCount = std::min(block.ReadByte(), (uint8_t)64);
+			for (int j = 0; j < 64; j++) {
+				tile.Frames[j] = block.ReadUInt16();
+			}
+		}
+	}
+
+	bool JJ2Level::LoadEvents(JJ2Block& block)
+	{
+		const LayerSection& sprLayer = _layers[SpriteLayerIndex];
+		if (sprLayer.Width <= 0 || sprLayer.Height <= 0 || block.GetLength() < sprLayer.Width * sprLayer.Height * 4) {
+			return false;
+		}
+
+		int32_t count = sprLayer.Width * sprLayer.Height;
+		_events = std::make_unique<TileEventSection[]>(count);
+
+		for (int32_t i = 0; i < count; i++) {
+			uint32_t eventData = block.ReadUInt32();
+
+			TileEventSection& e = _events[i];
+			e.EventType = (JJ2Event)(uint8_t)(eventData & 0x000000FF);
+			e.Difficulty = (uint8_t)((eventData & 0x00000300) >> 8);
+			e.Illuminate = ((eventData & 0x00000400) >> 10) == 1;
+			e.TileParams = ((eventData & 0xFFFFF000) >> 12);
+		}
+
+		return true;
+	}
+
+	bool JJ2Level::LoadLayers(JJ2Block& dictBlock, int32_t dictLength, JJ2Block& layoutBlock)
+	{
+		// Layout is stored as indices to dictionary of 4-tile words
+		std::unique_ptr<uint16_t[]> dictionary = std::make_unique<uint16_t[]>(dictLength * 4);
+		for (int32_t i = 0; i < dictLength * 4; i++) {
+			dictionary[i] = dictBlock.ReadUInt16();
+		}
+
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			LayerSection& layer = _layers[i];
+			if (layer.Width <= 0 || layer.Height <= 0) {
+				if (layer.Used || i == SpriteLayerIndex) {
+					return false;
+				}
+				layer.Width = 0;
+				layer.Height = 0;
+				continue;
+			}
+
+			layer.Tiles = std::make_unique<uint16_t[]>(layer.Width * layer.Height);
+			if (!layer.Used) {
+				continue;
+			}
+
+			int32_t wordsPerRow = (layer.InternalWidth + 3) / 4;
+			for (int32_t y = 0; y < layer.Height; y++) {
+				uint16_t* row = &layer.Tiles[y * layer.Width];
+				for (int32_t word = 0; word < wordsPerRow; word++) {
+					uint16_t dictIdx = layoutBlock.ReadUInt16();
+					if (dictIdx >= dictLength) {
+						return false;
+					}
+
+					const uint16_t* tiles = &dictionary[dictIdx * 4];
+					for (int32_t j = 0; j < 4; j++) {
+						int32_t x = word * 4 + j;
+						if (x >= layer.Width) {
+							break;
+						}
+						row[x] = tiles[j];
+					}
+				}
+			}
+		}
+
+		return !layoutBlock.ReachedEndOfStream();
+	}
+
+	JJ2Level::DecodedTile JJ2Level::DecodeTile(uint16_t rawTile) const
+	{
+		int maxTiles = GetMaxSupportedTiles();
+		uint8_t flags = 0;
+
+		// Flip flags are stored above the tile index
+		if ((rawTile & maxTiles) != 0) {
+			flags |= 0x01;
+		}
+		if ((rawTile & (maxTiles << 1)) != 0) {
+			flags |= 0x02;
+		}
+
+		uint16_t tileId = (uint16_t)(rawTile & (maxTiles - 1));
+		int firstAnimatedTile = maxTiles - _animCount;
+		if (tileId >= firstAnimatedTile) {
+			tileId = (uint16_t)(tileId - firstAnimatedTile);
+			flags |= 0x04;
+		} else if (_staticTiles != nullptr) {
+			// Tile modifier is stored in the upper half of flags
+			switch (_staticTiles[tileId].Type) {
+				case 1: flags |= (1 << 4); break;	// Translucent
+				case 3: flags |= (2 << 4); break;	// Invisible
+			}
+		}
+
+		return { tileId, flags };
+	}
+
+	String JJ2Level::ConvertLevelName(const StringView& name, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion) const
+	{
+		String levelName = ToLowerWithoutExtension(name, ".j2l"_s);
+		if (levelName.empty() || levelTokenConversion == nullptr) {
+			return levelName;
+		}
+
+		LevelToken token = levelTokenConversion(levelName);
+		return token.Episode + "/"_s + token.Level;
+	}
+
+	bool JJ2Level::WriteDescription(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion)
+	{
+		StringBuffer buffer;
+		PrettyWriter<StringBuffer> w(buffer);
+		w.SetIndent('\t', 1);
+
+		w.StartObject();
+
+		w.Key("Version");
+		w.StartObject();
+		w.Key("LayerFormat");
+		w.Int(LevelHandler::LayerFormatVersion);
+		w.Key("EventSet");
+		w.Int(LevelHandler::EventSetVersion);
+		w.EndObject();
+
+		w.Key("Description");
+		w.StartObject();
+		String name = JJ2Text::ConvertFormattedString(Name);
+		w.Key("Name");
+		w.String(name.data(), (SizeType)name.size());
+		String nextLevel = ConvertLevelName(NextLevel, levelTokenConversion);
+		if (!nextLevel.empty()) {
+			w.Key("NextLevel");
+			w.String(nextLevel.data(), (SizeType)nextLevel.size());
+		}
+		String secretLevel = ConvertLevelName(SecretLevel, levelTokenConversion);
+		if (!secretLevel.empty()) {
+			w.Key("SecretLevel");
+			w.String(secretLevel.data(), (SizeType)secretLevel.size());
+		}
+		String tileset = ToLowerWithoutExtension(Tileset, ".j2t"_s);
+		w.Key("DefaultTileset");
+		w.String(tileset.data(), (SizeType)tileset.size());
+		String music = ToLowerWithoutExtension(Music, ""_s);
+		if (!music.empty()) {
+			w.Key("DefaultMusic");
+			w.String(music.data(), (SizeType)music.size());
+		}
+		// Original ambient light is in range 0-64, it's stored as percentage
+		w.Key("DefaultLight");
+		w.Int(_lightingStart * 100 / 64);
+		w.EndObject();
+
+		w.Key("Layers");
+		w.StartObject();
+		for (int i = 0; i < JJ2LayerCount; i++) {
+			const LayerSection& layer = _layers[i];
+			// Sprite layer is always loaded with fixed properties
+			if (!layer.Used || i == SpriteLayerIndex) {
+				continue;
+			}
+
+			String layerName = GetLayerName(i);
+			w.Key(layerName.data(), (SizeType)layerName.size());
+			w.StartObject();
+			w.Key("XSpeed");
+			w.Double(layer.SpeedX);
+			w.Key("YSpeed");
+			w.Double(layer.SpeedY);
+			if (layer.AutoSpeedX != 0.0f) {
+				w.Key("XAutoSpeed");
+				w.Double(layer.AutoSpeedX);
+			}
+			if (layer.AutoSpeedY != 0.0f) {
+				w.Key("YAutoSpeed");
+				w.Double(layer.AutoSpeedY);
+			}
+			w.Key("XRepeat");
+			w.Bool((layer.Flags & 0x01) != 0);
+			w.Key("YRepeat");
+			w.Bool((layer.Flags & 0x02) != 0);
+			if (layer.OffsetX != 0.0f) {
+				w.Key("XOffset");
+				w.Double(layer.OffsetX);
+			}
+			if (layer.OffsetY != 0.0f) {
+				w.Key("YOffset");
+				w.Double(layer.OffsetY);
+			}
+			w.Key("Depth");
+			w.Int(layer.Depth);
+			w.Key("InherentOffset");
+			w.Bool((layer.Flags & 0x04) != 0);
+
+			// Flag 0x08: Textured background, only the sky layer can have it
+			if (i == SkyLayerIndex && (layer.Flags & 0x08) != 0) {
+				w.Key("BackgroundStyle");
+				w.Int(layer.TexturedBackgroundType + 1);
+				w.Key("BackgroundColor");
+				w.StartArray();
+				w.Int(layer.TexturedParams1);
+				w.Int(layer.TexturedParams2);
+				w.Int(layer.TexturedParams3);
+				w.EndArray();
+				w.Key("ParallaxStarsEnabled");
+				w.Bool((layer.Flags & 0x10) != 0);
+			}
+			w.EndObject();
+		}
+		w.EndObject();
+
+		w.Key("TextEvents");
+		w.StartArray();
+		for (int i = 0; i < TextEventStringsCount; i++) {
+			String text = JJ2Text::ConvertFormattedString(_textEventStrings[i]);
+			w.String(text.data(), (SizeType)text.size());
+		}
+		w.EndArray();
+
+		w.EndObject();
+
+		return WriteFile(fs::joinPath(targetPath, ".res"_s), buffer.GetString(), buffer.GetSize());
+	}
+
+	bool JJ2Level::WriteLayer(const StringView& targetPath, const LayerSection& layer)
+	{
+		int index = (int)(&layer - _layers);
+		String layerName = GetLayerName(index);
+
+		// Each tile is stored as 16-bit tile type followed by 8-bit flags, as expected by `TileMap::ReadLayerConfiguration()`
+		OutputBuffer out;
+		out.Reserve(8 + layer.Width * layer.Height * 3);
+		out.WriteValue<int32_t>(layer.Width);
+		out.WriteValue<int32_t>(layer.Height);
+
+		for (int32_t i = 0; i < layer.Width * layer.Height; i++) {
+			DecodedTile tile = DecodeTile(layer.Tiles[i]);
+			out.WriteValue<uint16_t>(tile.TileID);
+			out.WriteValue<uint8_t>(tile.Flags);
+		}
+
+		return out.Save(fs::joinPath(targetPath, layerName + ".layer"_s));
+	}
+
+	bool JJ2Level::WriteAnimatedTiles(const StringView& targetPath)
+	{
+		OutputBuffer out;
+		out.WriteValue<int32_t>((int32_t)_animatedTiles.size());
+
+		for (const AnimatedTileSection& tile : _animatedTiles) {
+			out.WriteValue<uint16_t>(tile.FrameCount);
+			for (int j = 0; j < tile.FrameCount; j++) {
+				DecodedTile frame = DecodeTile(tile.Frames[j]);
+				out.WriteValue<uint16_t>(frame.TileID);
+				out.WriteValue<uint8_t>(frame.Flags);
+			}
+			out.WriteValue<uint8_t>(tile.Speed);
+			out.WriteValue<uint16_t>(tile.Delay);
+			out.WriteValue<uint16_t>(tile.DelayJitter);
+			out.WriteValue<uint8_t>(tile.IsReverse ? 1 : 0);
+			out.WriteValue<uint16_t>(tile.ReverseDelay);
+		}
+
+		return out.Save(fs::joinPath(targetPath, "Animated.tiles"_s));
+	}
+
+	bool JJ2Level::WriteEvents(const StringView& targetPath, const EventConverter& eventConverter)
+	{
+		const LayerSection& sprLayer = _layers[SpriteLayerIndex];
+		int32_t width = sprLayer.Width;
+		int32_t height = sprLayer.Height;
+		int maxTiles = GetMaxSupportedTiles();
+		int firstAnimatedTile = maxTiles - _animCount;
+
+		OutputBuffer out;
+		out.Reserve(8 + width * height * 3);
+		out.WriteValue<int32_t>(width);
+		out.WriteValue<int32_t>(height);
+
+		for (int32_t i = 0; i < width * height; i++) {
+			TileEventSection e = _events[i];
+
+			// Events can be also assigned to static tiles, they are used only if the tile has no event
+			if (e.EventType == JJ2Event::EMPTY) {
+				int tileId = (sprLayer.Tiles[i] & (maxTiles - 1));
+				if (tileId > 0 && tileId < firstAnimatedTile) {
+					e = _staticTiles[tileId].Event;
+				}
+			}
+
+			uint8_t generatorFlags = 0, generatorDelay = 0;
+			bool isGenerator = false;
+			if (e.EventType == JJ2Event::MODIFIER_GENERATOR) {
+				// Generators are converted differently, the generated event is stored in parameters
+				auto params = EventConverter::ConvertParamInt(e.TileParams, {{
+					{ EventConverter::JJ2EventParamType::UInt, 8 },	// Event
+					{ EventConverter::JJ2EventParamType::UInt, 8 },	// Delay
+					{ EventConverter::JJ2EventParamType::Bool, 1 }	// Initial Delay
+				}});
+				e.EventType = (JJ2Event)params[0];
+				e.TileParams = 0;
+				generatorDelay = params[2];
+				generatorFlags = params[4];
+				isGenerator = true;
+			}
+
+			EventConverter::ConversionResult converted = eventConverter.TryConvert(*this, e.EventType, e.TileParams);
+
+			uint8_t flags = 0;
+			if (e.Illuminate) {
+				flags |= 0x04;
+			}
+			switch (e.Difficulty) {
+				default:
+				case 0: flags |= (0x01 | 0x02 | 0x04) << 4; break;	// All
+				case 1: flags |= 0x01 << 4; break;					// Easy
+				case 2: flags |= 0x04 << 4; break;					// Hard
+				case 3: flags |= 0x80; break;						// Multiplayer only
+			}
+
+			bool hasParams = false;
+			for (uint8_t value : converted.Params) {
+				if (value != 0) {
+					hasParams = true;
+					break;
+				}
+			}
+			if (!hasParams) {
+				flags |= 0x01;
+			}
+
+			if (converted.Type == EventType::Empty) {
+				out.WriteValue<uint16_t>((uint16_t)EventType::Empty);
+				out.WriteValue<uint8_t>(0x01);
+				continue;
+			}
+
+			out.WriteValue<uint16_t>((uint16_t)converted.Type);
+			if (isGenerator) {
+				out.WriteValue<uint8_t>(flags | 0x02);
+				out.WriteValue<uint8_t>(generatorFlags);
+				out.WriteValue<uint8_t>(generatorDelay);
+			} else {
+				out.WriteValue<uint8_t>(flags);
+			}
+			if (hasParams) {
+				out.Write(converted.Params.data(), converted.Params.size());
+			}
+		}
 
+		return out.Save(fs::joinPath(targetPath, "Events.layer"_s));
+	}
 }
\ No newline at end of file
@@ -1,36 +1,158 @@
 ﻿#pragma once
 
 #include "../../Common.h"
+#include "JJ2Block.h"
+#include "JJ2Event.h"
+#include "JJ2Version.h"
+#include "EventConverter.h"
 
+#include <functional>
+#include <memory>
+
+#include <Containers/SmallVector.h>
 #include <Containers/String.h>
+#include <Containers/StringView.h>
 
 using namespace Death::Containers;
 
 namespace Jazz2::Compatibility
 {
-    class JJ2Level // .j2l
-    {
-    public:
-        struct LevelToken {
-            String Episode;
-            String Level;
-        };
-
-        enum class WeatherType {
-            None,
-            Snow,
-            Flowers,
-            Rain,
-            Leaf
-        };
-
-        struct ExtraTilesetEntry {
-            String Name;
-            uint16_t Offset;
-            uint16_t Count;
-        };
-
-
-
-    };
+	class ConversionManifest;
+
+	class JJ2Level // .j2l
+	{
+	public:
+		static constexpr int JJ2LayerCount = 8;
+		static constexpr int SpriteLayerIndex = 3;
+		static constexpr int SkyLayerIndex = 7;
+		static constexpr int TextEventStringsCount = 16;
+
+		struct LevelToken {
+			String Episode;
+			String Level;
+		};
+
+		enum class WeatherType {
+			None,
+			Snow,
+			Flowers,
+			Rain,
+			Leaf
+		};
+
+		struct ExtraTilesetEntry {
+			String Name;
+			uint16_t Offset;
+			uint16_t Count;
+		};
+
+		String Name;
+		String Tileset;
+		String BonusLevel;
+		String NextLevel;
+		String SecretLevel;
+		String Music;
+		JJ2Version Version;
+
+		JJ2Level();
+
+		/// Reads the level file, it can be called from any thread
+		/*! If `metadataOnly` is set, only name, tileset, music and links to other levels are read. */
+		bool Open(const StringView& path, bool strictParser, bool metadataOnly = false);
+		/// Writes the level description, layers, animated tiles and events to the target directory
+		bool Convert(const StringView& targetPath, const EventConverter& eventConverter, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion = nullptr);
+
+		/// Converts all levels to `targetPath/<episode>/<level>`, independent levels are converted in parallel
+		/*! Levels with unchanged content are skipped if they are recorded in the manifest and their output exists. `dependencyHash`
+		 *  should cover all other inputs that affect the output, i.e. episodes and links between levels. \return Number of converted levels */
+		static int ConvertAll(const ArrayView<const String> paths, const StringView& targetPath, const EventConverter& eventConverter,
+			ConversionManifest* manifest, uint64_t dependencyHash, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion);
+
+		int GetMaxSupportedTiles() const {
+			return (Version == JJ2Version::BaseGame ? 1024 : 4096);
+		}
+
+		int GetMaxSupportedAnims() const {
+			return (Version == JJ2Version::BaseGame ? 128 : 256);
+		}
+
+	private:
+		struct TileEventSection {
+			JJ2Event EventType;
+			uint8_t Difficulty;
+			bool Illuminate;
+			uint32_t TileParams;
+		};
+
+		struct TilePropertiesSection {
+			TileEventSection Event;
+			bool Flipped;
+			uint8_t Type;
+		};
+
+		struct AnimatedTileSection {
+			uint16_t Delay;
+			uint16_t DelayJitter;
+			uint16_t ReverseDelay;
+			bool IsReverse;
+			uint8_t Speed;
+			uint8_t FrameCount;
+			uint16_t Frames[64];
+		};
+
+		struct LayerSection {
+			uint32_t Flags;
+			uint8_t Type;
+			bool Used;
+			int32_t Width;
+			int32_t InternalWidth;
+			int32_t Height;
+			int32_t Depth;
+			uint8_t DetailLevel;
+			float OffsetX;
+			float OffsetY;
+			float SpeedX;
+			float SpeedY;
+			float AutoSpeedX;
+			float AutoSpeedY;
+			uint8_t TexturedBackgroundType;
+			uint8_t TexturedParams1;
+			uint8_t TexturedParams2;
+			uint8_t TexturedParams3;
+			std::unique_ptr<uint16_t[]> Tiles;
+		};
+
+		/// Tile decoded from the layout, the same flags are used by `TileMap` when reading layers
+		struct DecodedTile {
+			uint16_t TileID;
+			uint8_t Flags;
+		};
+
+		String _levelToken;
+		uint8_t _lightingMin;
+		uint8_t _lightingStart;
+		uint16_t _animCount;
+		bool _verticalMPSplitscreen;
+		bool _isMpLevel;
+		String _textEventStrings[TextEventStringsCount];
+		LayerSection _layers[JJ2LayerCount];
+		std::unique_ptr<TilePropertiesSection[]> _staticTiles;
+		SmallVector<AnimatedTileSection, 0> _animatedTiles;
+		std::unique_ptr<TileEventSection[]> _events;
+
+		bool LoadMetadata(JJ2Block& block, bool strictParser);
+		void LoadLayerMetadata(JJ2Block& block);
+		void LoadStaticTileData(JJ2Block& block);
+		void LoadAnimatedTiles(JJ2Block& block);
+		bool LoadEvents(JJ2Block& block);
+		bool LoadLayers(JJ2Block& dictBlock, int32_t dictLength, JJ2Block& layoutBlock);
+
+		DecodedTile DecodeTile(uint16_t rawTile) const;
+		String ConvertLevelName(const StringView& name, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion) const;
+
+		bool WriteDescription(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion);
+		bool WriteLayer(const StringView& targetPath, const LayerSection& layer);
+		bool WriteAnimatedTiles(const StringView& targetPath);
+		bool WriteEvents(const StringView& targetPath, const EventConverter& eventConverter);
+	};
 }
\ No newline at end of file
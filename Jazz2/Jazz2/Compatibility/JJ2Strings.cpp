@@ -1,8 +1,211 @@
-﻿#pragma once
+﻿#include "JJ2Strings.h"
+#include "JJ2Text.h"
 
-#include "../../Common.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include "../../RapidJson/prettywriter.h"
+#include "../../RapidJson/stringbuffer.h"
+
+#include <cstring>
+
+using namespace rapidjson;
 
 namespace Jazz2::Compatibility
 {
+	namespace
+	{
+		String ToLower(const StringView& value)
+		{
+			String result = value;
+			for (char& c : result) {
+				if (c >= 'A' && c <= 'Z') {
+					c = c - 'A' + 'a';
+				}
+			}
+			return result;
+		}
+
+		/// Bounds-checked reader of the whole file loaded in memory
+		class MemoryReader
+		{
+		public:
+			MemoryReader(ArrayView<const uint8_t> data)
+				: _data(data), _offset(0), _isValid(true)
+			{
+			}
+
+			bool IsValid() const {
+				return _isValid;
+			}
+
+			std::size_t GetOffset() const {
+				return _offset;
+			}
+
+			const uint8_t* Advance(std::size_t length)
+			{
+				if (!_isValid || _offset + length > _data.size()) {
+					_isValid = false;
+					return nullptr;
+				}
+				const uint8_t* result = _data.data() + _offset;
+				_offset += length;
+				return result;
+			}
+
+			uint8_t ReadByte()
+			{
+				const uint8_t* data = Advance(1);
+				return (data != nullptr ? data[0] : 0);
+			}
+
+			int32_t ReadInt32()
+			{
+				const uint8_t* data = Advance(sizeof(int32_t));
+				if (data == nullptr) {
+					return 0;
+				}
+				int32_t value;
+				std::memcpy(&value, data, sizeof(value));
+				return value;
+			}
+
+			/// Reads null-terminated string from the specified range of the file
+			String ReadStringAt(std::size_t blockOffset, std::size_t blockSize, int32_t offset)
+			{
+				if (offset < 0 || (std::size_t)offset >= blockSize) {
+					_isValid = false;
+					return { };
+				}
+				const char* start = (const char*)_data.data() + blockOffset + offset;
+				const void* nullChar = std::memchr(start, '\0', blockSize - offset);
+				std::size_t length = (nullChar != nullptr ? (const char*)nullChar - start : blockSize - offset);
+				return JJ2Text::ConvertFormattedString(StringView(start, length));
+			}
+
+		private:
+			ArrayView<const uint8_t> _data;
+			std::size_t _offset;
+			bool _isValid;
+		};
+	}
+
+	bool JJ2Strings::Open(const StringView& path)
+	{
+		constexpr int32_t LevelNameLength = 8;
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+
+		String fileName = ToLower(fs::baseName(path));
+		Language = (fileName.hasSuffix(".j2s"_s) ? String(fileName.exceptSuffix(4)) : fileName);
+
+		MemoryReader r(s->ReadView(s->GetSize()));
+
+		// All texts are stored in one block and referenced by offsets
+		int32_t textSize = r.ReadInt32();
+		RETURNF_ASSERT_MSG_X(textSize >= 0, "File \"%s\" is corrupted", s->filename());
+		std::size_t textOffset = r.GetOffset();
+		r.Advance(textSize);
+
+		int32_t commonCount = r.ReadInt32();
+		for (int32_t i = 0; i < commonCount && r.IsValid(); i++) {
+			int32_t offset = r.ReadInt32();
+			CommonTexts.push_back(r.ReadStringAt(textOffset, textSize, offset));
+		}
+
+		int32_t levelCount = r.ReadInt32();
+		SmallVector<int32_t, 0> levelOffsets;
+		for (int32_t i = 0; i < levelCount && r.IsValid(); i++) {
+			const uint8_t* name = r.Advance(LevelNameLength);
+			if (name == nullptr) {
+				break;
+			}
+			const void* nullChar = std::memchr(name, '\0', LevelNameLength);
+			int32_t nameLength = (nullChar != nullptr ? (int32_t)((const uint8_t*)nullChar - name) : LevelNameLength);
+
+			LevelEntry& entry = LevelEntries.emplace_back();
+			entry.Name = ToLower(StringView((const char*)name, nameLength));
+			r.ReadByte();	// Unknown
+			levelOffsets.push_back(r.ReadInt32());
+		}
+
+		// Each level has a list of text indices in its own block
+		int32_t levelBlockSize = r.ReadInt32();
+		const uint8_t* levelBlock = (levelBlockSize >= 0 ? r.Advance(levelBlockSize) : nullptr);
+		RETURNF_ASSERT_MSG_X(levelBlock != nullptr, "File \"%s\" is corrupted", s->filename());
+
+		for (int32_t i = 0; i < (int32_t)LevelEntries.size(); i++) {
+			int32_t offset = levelOffsets[i];
+			RETURNF_ASSERT_MSG_X(offset >= 0 && offset < levelBlockSize, "File \"%s\" is corrupted", s->filename());
+
+			MemoryReader lr(arrayView(levelBlock + offset, levelBlockSize - offset));
+			int32_t textCount = lr.ReadByte();
+			for (int32_t j = 0; j < textCount && lr.IsValid(); j++) {
+				uint8_t index = lr.ReadByte();
+				int32_t textOffsetInBlock = lr.ReadInt32();
+				if (lr.IsValid() && index < JJ2Level::TextEventStringsCount) {
+					LevelEntries[i].TextEvents[index] = r.ReadStringAt(textOffset, textSize, textOffsetInBlock);
+				}
+			}
+		}
+
+		RETURNF_ASSERT_MSG_X(r.IsValid(), "File \"%s\" is corrupted", s->filename());
+		return true;
+	}
+
+	bool JJ2Strings::Convert(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion)
+	{
+		StringBuffer buffer;
+		PrettyWriter<StringBuffer> w(buffer);
+		w.SetIndent('\t', 1);
+
+		w.StartObject();
+
+		w.Key("Version");
+		w.StartObject();
+		w.Key("Target");
+		w.String("Jazz² Resurrection");
+		w.EndObject();
+
+		w.Key("Common");
+		w.StartArray();
+		for (const String& text : CommonTexts) {
+			w.String(text.data(), (SizeType)text.size());
+		}
+		w.EndArray();
+
+		w.Key("Levels");
+		w.StartObject();
+		for (const LevelEntry& entry : LevelEntries) {
+			String levelName = entry.Name;
+			if (levelTokenConversion != nullptr) {
+				JJ2Level::LevelToken token = levelTokenConversion(entry.Name);
+				levelName = token.Episode + "/"_s + token.Level;
+			}
+
+			w.Key(levelName.data(), (SizeType)levelName.size());
+			w.StartObject();
+			w.Key("TextEvents");
+			w.StartArray();
+			for (const String& text : entry.TextEvents) {
+				w.String(text.data(), (SizeType)text.size());
+			}
+			w.EndArray();
+			w.EndObject();
+		}
+		w.EndObject();
+
+		w.EndObject();
 
-}
\ No newline at end of file
+		auto so = IFileStream::createFileHandle(fs::joinPath(targetPath, Language + ".res"_s));
+		so->setExitOnFailToOpen(false);
+		so->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(so->isOpened(), "Cannot open file \"%s\" for writing", so->filename());
+		so->Write((void*)buffer.GetString(), (unsigned long int)buffer.GetSize());
+		return true;
+	}
+}
@@ -1,8 +1,34 @@
 ﻿#pragma once
 
 #include "../../Common.h"
+#include "JJ2Level.h"
+
+#include <functional>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
 
 namespace Jazz2::Compatibility
 {
-    
-}
\ No newline at end of file
+	class JJ2Strings // .j2s
+	{
+	public:
+		struct LevelEntry {
+			String Name;
+			/// Translated text events, empty ones are not translated
+			String TextEvents[JJ2Level::TextEventStringsCount];
+		};
+
+		String Language;
+		SmallVector<String, 0> CommonTexts;
+		SmallVector<LevelEntry, 0> LevelEntries;
+
+		bool Open(const StringView& path);
+
+		/// Writes all translated texts to `targetPath/<language>.res`
+		bool Convert(const StringView& targetPath, const std::function<JJ2Level::LevelToken(const StringView&)>& levelTokenConversion = nullptr);
+	};
+}
@@ -1,8 +1,84 @@
-﻿#pragma once
+﻿#include "JJ2Text.h"
 
-#include "../../Common.h"
+#include <cstdio>
+
+#include <Containers/SmallVector.h>
 
 namespace Jazz2::Compatibility
 {
+	namespace
+	{
+		/// Characters in range 0x80 - 0x9F of Windows-1252, undefined ones are mapped to `?`
+		constexpr uint16_t Windows1252Extended[] = {
+			0x20AC, 0x003F, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x003F, 0x017D, 0x003F,
+			0x003F, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x003F, 0x017E, 0x0178
+		};
+
+		/// Number of colors the per-character colors cycle through
+		constexpr int32_t ColorCount = 7;
+
+		void AppendUtf8(SmallVectorImpl<char>& result, char c)
+		{
+			uint8_t value = (uint8_t)c;
+			uint32_t codepoint = (value >= 0x80 && value < 0xA0 ? Windows1252Extended[value - 0x80] : value);
+			if (codepoint < 0x80) {
+				result.push_back((char)codepoint);
+			} else if (codepoint < 0x800) {
+				result.push_back((char)(0xC0 | (codepoint >> 6)));
+				result.push_back((char)(0x80 | (codepoint & 0x3F)));
+			} else {
+				result.push_back((char)(0xE0 | (codepoint >> 12)));
+				result.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+				result.push_back((char)(0x80 | (codepoint & 0x3F)));
+			}
+		}
+
+		void AppendFormat(SmallVectorImpl<char>& result, const char* format, int32_t value)
+		{
+			char buffer[16];
+			int length = std::snprintf(buffer, sizeof(buffer), format, value);
+			result.append(buffer, buffer + length);
+		}
+	}
+
+	String JJ2Text::ConvertFormattedString(const StringView& text)
+	{
+		SmallVector<char, 256> result;
+		bool colorsEnabled = false;
+		int32_t colorIndex = 0;
+
+		for (std::size_t i = 0; i < text.size(); i++) {
+			char c = text[i];
+			if (c == '@') {
+				result.push_back('\n');
+			} else if (c == '#') {
+				colorsEnabled = !colorsEnabled;
+				if (!colorsEnabled) {
+					// Switch back to the default color
+					AppendFormat(result, "\f[c:%i]", -1);
+				}
+			} else if (c == '\xA7' && i + 1 < text.size() && text[i + 1] >= '0' && text[i + 1] <= '9') {
+				// Spacing is relative to the default one
+				i++;
+				AppendFormat(result, "\f[w:%i]", 100 - (text[i] - '0') * 10);
+			} else {
+				if (colorsEnabled && c != ' ') {
+					AppendFormat(result, "\f[c:%i]", colorIndex);
+					colorIndex = (colorIndex + 1) % ColorCount;
+				}
+				AppendUtf8(result, c);
+			}
+		}
+
+		return String(result.data(), result.size());
+	}
 
-}
\ No newline at end of file
+	String JJ2Text::ConvertString(const StringView& text)
+	{
+		SmallVector<char, 256> result;
+		for (char c : text) {
+			AppendUtf8(result, c);
+		}
+		return String(result.data(), result.size());
+	}
+}
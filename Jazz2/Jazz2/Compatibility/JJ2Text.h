@@ -2,7 +2,25 @@
 
 #include "../../Common.h"
 
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
 namespace Jazz2::Compatibility
 {
-    
-}
\ No newline at end of file
+	/// Conversion of texts from original files
+	class JJ2Text
+	{
+	public:
+		/// Converts Windows-1252 text with formatting of the original game to UTF-8 with formatting of `\f[...]` sequences
+		/*! `@` is converted to new line, `#` toggles per-character colors and `§n` sets character spacing.
+		 *  `|` is kept, because it also separates parts of texts used by some events. */
+		static String ConvertFormattedString(const StringView& text);
+		/// Converts Windows-1252 text to UTF-8 without any other changes
+		static String ConvertString(const StringView& text);
+
+	private:
+		JJ2Text() = delete;
+	};
+}
@@ -1,8 +1,275 @@
-﻿#pragma once
+﻿#include "JJ2Tileset.h"
+#include "PngWriter.h"
+#include "../Tiles/TileSet.h"
 
-#include "../../Common.h"
+#include "../../nCine/IO/FileSystem.h"
+#include "../../nCine/IO/IFileStream.h"
+
+#include <cstring>
 
 namespace Jazz2::Compatibility
 {
+	JJ2Tileset::JJ2Tileset()
+		: Version(JJ2Version::Unknown), _palette{}, _tileCount(0)
+	{
+	}
+
+	bool JJ2Tileset::Open(const StringView& path, bool strictParser)
+	{
+		constexpr int CopyrightSize = 180;
+		constexpr int HeaderSize = 262;
+		constexpr uint32_t TilesetMagic = 0x454C4954;	// TILE
+		constexpr uint32_t TilesetSignature = 0xAFBEADDE;
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\"", String::nullTerminatedView(path).data());
+		RETURNF_ASSERT_MSG_X(s->GetSize() > HeaderSize, "File \"%s\" is too small", s->filename());
+
+		// Skip copyright notice
+		s->Seek(CopyrightSize, SeekOrigin::Current);
+
+		JJ2Block headerBlock(s, HeaderSize - CopyrightSize);
+
+		uint32_t magic = headerBlock.ReadUInt32();
+		uint32_t signature = headerBlock.ReadUInt32();
+		RETURNF_ASSERT_MSG_X(magic == TilesetMagic && signature == TilesetSignature, "Invalid magic string in file \"%s\"", s->filename());
+
+		Name = headerBlock.ReadString(32, true);
+
+		uint16_t versionNum = headerBlock.ReadUInt16();
+		Version = (versionNum <= 512 ? JJ2Version::BaseGame : JJ2Version::TSF);
+
+		int32_t recordedSize = headerBlock.ReadInt32();
+		RETURNF_ASSERT_MSG_X(!strictParser || s->GetSize() == recordedSize, "Unexpected size of file \"%s\"", s->filename());
+
+		// Get the CRC; would check here if it matches if we knew what variant it is AND what it applies to
+		// Test file across all CRC32 variants + Adler had no matches to the value obtained from the file
+		// so either the variant is something else or the CRC is not applied to the whole file but on a part
+		headerBlock.DiscardBytes(4);
+
+		int32_t infoBlockPackedSize = headerBlock.ReadInt32();
+		int32_t infoBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t imageBlockPackedSize = headerBlock.ReadInt32();
+		int32_t imageBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t alphaBlockPackedSize = headerBlock.ReadInt32();
+		int32_t alphaBlockUnpackedSize = headerBlock.ReadInt32();
+		int32_t maskBlockPackedSize = headerBlock.ReadInt32();
+		int32_t maskBlockUnpackedSize = headerBlock.ReadInt32();
+		RETURNF_ASSERT_MSG_X(!headerBlock.ReachedEndOfStream(), "Header of file \"%s\" is truncated", s->filename());
+
+		JJ2Block infoBlock(s, infoBlockPackedSize, infoBlockUnpackedSize);
+		JJ2Block imageBlock(s, imageBlockPackedSize, imageBlockUnpackedSize);
+		JJ2Block alphaBlock(s, alphaBlockPackedSize, alphaBlockUnpackedSize);
+		JJ2Block maskBlock(s, maskBlockPackedSize, maskBlockUnpackedSize);
+		RETURNF_ASSERT_MSG_X(infoBlock.IsValid() && imageBlock.IsValid() && alphaBlock.IsValid() && maskBlock.IsValid(),
+			"File \"%s\" cannot be decompressed", s->filename());
+
+		RETURNF_ASSERT_MSG_X(LoadMetadata(infoBlock), "Metadata of file \"%s\" are corrupted", s->filename());
+		LoadImageData(imageBlock, alphaBlock);
+		LoadMaskData(maskBlock);
+		return true;
+	}
+
+	bool JJ2Tileset::Convert(const StringView& targetPath)
+	{
+		if (!fs::isDirectory(targetPath) && !fs::createDir(targetPath)) {
+			LOGE_X("Cannot create directory \"%s\"", String::nullTerminatedView(targetPath).data());
+			return false;
+		}
+
+		return (WriteDiffuse(targetPath) && WritePalette(targetPath) && WriteMask(targetPath));
+	}
+
+	bool JJ2Tileset::LoadMetadata(JJ2Block& block)
+	{
+		for (int i = 0; i < 256; i++) {
+			uint8_t r = block.ReadByte();
+			uint8_t g = block.ReadByte();
+			uint8_t b = block.ReadByte();
+			block.ReadByte();	// Alpha is not used
+
+			// The first color is always transparent
+			uint32_t a = (i == 0 ? 0 : 255);
+			_palette[i] = r | (g << 8) | (b << 16) | (a << 24);
+		}
+
+		int maxTiles = GetMaxSupportedTiles();
+		_tileCount = block.ReadInt32();
+		if (_tileCount < 0 || _tileCount > maxTiles) {
+			return false;
+		}
+
+		_tiles = std::make_unique<TilesetTileSection[]>(maxTiles);
+
+		for (int i = 0; i < maxTiles; i++) {
+			_tiles[i].Opaque = block.ReadBool();
+		}
+
+		// Block of unknown values, skip
+		block.DiscardBytes(maxTiles);
+
+		for (int i = 0; i < maxTiles; i++) {
+			_tiles[i].ImageDataOffset = block.ReadUInt32();
+		}
+
+		// Block of unknown values, skip
+		block.DiscardBytes(4 * maxTiles);
+
+		for (int i = 0; i < maxTiles; i++) {
+			_tiles[i].AlphaDataOffset = block.ReadUInt32();
+		}
+
+		// Block of unknown values, skip
+		block.DiscardBytes(4 * maxTiles);
+
+		for (int i = 0; i < maxTiles; i++) {
+			_tiles[i].MaskDataOffset = block.ReadUInt32();
+		}
+
+		// We don't care about the flipped masks, those are generated on runtime
+		block.DiscardBytes(4 * maxTiles);
+
+		return !block.ReachedEndOfStream();
+	}
+
+	void JJ2Tileset::LoadImageData(JJ2Block& imageBlock, JJ2Block& alphaBlock)
+	{
+		uint8_t imageData[TileSize * TileSize];
+		uint8_t alphaMask[(TileSize * TileSize + 7) / 8];
+
+		for (int i = 0; i < _tileCount; i++) {
+			TilesetTileSection& tile = _tiles[i];
+
+			imageBlock.SeekTo(tile.ImageDataOffset);
+			imageBlock.ReadRawBytes(imageData, sizeof(imageData));
+			alphaBlock.SeekTo(tile.AlphaDataOffset);
+			alphaBlock.ReadRawBytes(alphaMask, sizeof(alphaMask));
+
+			for (int j = 0; j < TileSize * TileSize; j++) {
+				uint8_t idx = imageData[j];
+				if (((alphaMask[j / 8] >> (j % 8)) & 0x01) == 0) {
+					// Empty pixel
+					idx = 0;
+				}
+				tile.Image[j] = idx;
+			}
+		}
+	}
+
+	void JJ2Tileset::LoadMaskData(JJ2Block& block)
+	{
+		uint8_t maskData[(TileSize * TileSize + 7) / 8];
+
+		for (int i = 0; i < _tileCount; i++) {
+			TilesetTileSection& tile = _tiles[i];
+
+			block.SeekTo(tile.MaskDataOffset);
+			block.ReadRawBytes(maskData, sizeof(maskData));
+
+			for (int j = 0; j < TileSize * TileSize; j++) {
+				tile.Mask[j] = ((maskData[j / 8] >> (j % 8)) & 0x01);
+			}
+		}
+	}
+
+	bool JJ2Tileset::WriteDiffuse(const StringView& targetPath)
+	{
+		int width = TilesPerRow * TileSize;
+		int height = ((_tileCount + TilesPerRow - 1) / TilesPerRow) * TileSize;
+		if (height <= 0) {
+			return false;
+		}
+
+		std::unique_ptr<uint32_t[]> pixels = std::make_unique<uint32_t[]>(width * height);
+		std::memset(pixels.get(), 0, width * height * sizeof(uint32_t));
+
+		for (int i = 0; i < _tileCount; i++) {
+			const TilesetTileSection& tile = _tiles[i];
+			uint32_t* dst = &pixels[(i / TilesPerRow) * TileSize * width + (i % TilesPerRow) * TileSize];
+
+			for (int y = 0; y < TileSize; y++) {
+				for (int x = 0; x < TileSize; x++) {
+					// Palette index is stored in color channels, it's resolved with the current palette at runtime
+					uint32_t idx = tile.Image[y * TileSize + x];
+					if (idx != 0) {
+						dst[y * width + x] = idx | (idx << 8) | (idx << 16) | (255u << 24);
+					}
+				}
+			}
+		}
+
+		return PngWriter::Save(fs::joinPath(targetPath, "Diffuse.png"_s), pixels.get(), width, height);
+	}
+
+	bool JJ2Tileset::WritePalette(const StringView& targetPath)
+	{
+		auto s = IFileStream::createFileHandle(fs::joinPath(targetPath, "Main.palette"_s));
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\" for writing", s->filename());
+
+		s->WriteValue<uint16_t>(256);
+		s->Write(_palette, sizeof(_palette));
+		return true;
+	}
+
+	bool JJ2Tileset::WriteMask(const StringView& targetPath)
+	{
+		constexpr int PackedMaskSize = (TileSize * TileSize + 7) / 8;
+
+		// Per-tile flags are followed by packed masks of tiles that are neither empty nor filled,
+		// so it can be loaded by `ContentResolver::RequestTileSet()` without scanning of all pixels
+		int tileCount = ((_tileCount + TilesPerRow - 1) / TilesPerRow) * TilesPerRow;
+		std::unique_ptr<uint8_t[]> flags = std::make_unique<uint8_t[]>(tileCount);
+		std::unique_ptr<uint8_t[]> packedMasks = std::make_unique<uint8_t[]>(_tileCount * PackedMaskSize);
+		int packedCount = 0;
+
+		for (int i = 0; i < tileCount; i++) {
+			if (i >= _tileCount) {
+				// Padding tiles in the last row are empty
+				flags[i] = Tiles::TileSet::MaskEmptyFlag;
+				continue;
+			}
+
+			const TilesetTileSection& tile = _tiles[i];
+			bool maskEmpty = true;
+			bool maskFilled = true;
+			for (int j = 0; j < TileSize * TileSize; j++) {
+				bool masked = (tile.Mask[j] != 0);
+				maskEmpty &= !masked;
+				maskFilled &= masked;
+			}
+
+			if (maskEmpty) {
+				flags[i] = Tiles::TileSet::MaskEmptyFlag;
+			} else if (maskFilled) {
+				flags[i] = Tiles::TileSet::MaskFilledFlag | Tiles::TileSet::TileFilledFlag;
+			} else {
+				flags[i] = Tiles::TileSet::TileFilledFlag;
+
+				uint8_t* dst = &packedMasks[packedCount * PackedMaskSize];
+				std::memset(dst, 0, PackedMaskSize);
+				for (int j = 0; j < TileSize * TileSize; j++) {
+					if (tile.Mask[j] != 0) {
+						dst[j / 8] |= (1 << (j % 8));
+					}
+				}
+				packedCount++;
+			}
+		}
+
+		auto s = IFileStream::createFileHandle(fs::joinPath(targetPath, "Mask.tiles"_s));
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\" for writing", s->filename());
 
+		s->WriteValue<uint32_t>(Tiles::TileSet::MaskFileSignature);
+		s->WriteValue<uint16_t>(Tiles::TileSet::MaskFileVersion);
+		s->WriteValue<int32_t>(tileCount);
+		s->Write(flags.get(), tileCount);
+		s->Write(packedMasks.get(), packedCount * PackedMaskSize);
+		return true;
+	}
 }
\ No newline at end of file
@@ -13,37 +13,47 @@ using namespace Death::Containers;
 
 namespace Jazz2::Compatibility
 {
-    class JJ2Tileset // .j2t
-    {
-    public:
-        static JJ2Tileset Open(const StringView& path, bool strictParser);
-
-        void Convert(const String& targetPath);
-
-        int MaxSupportedTiles() {
-            return (_version == JJ2Version::BaseGame ? 1024 : 4096);
-        }
-    private:
-        struct TilesetTileSection {
-            bool Opaque;
-            uint32_t ImageDataOffset;
-            uint32_t AlphaDataOffset;
-            uint32_t MaskDataOffset;
-
-            std::unique_ptr<uint8_t[]> Image;
-            std::unique_ptr<uint8_t[]> Mask;
-        };
-
-        String _name;
-        JJ2Version _version;
-        std::unique_ptr<uint8_t[]> _palette;
-        std::unique_ptr<TilesetTileSection[]> _tiles;
-        int _tileCount;
-
-        JJ2Tileset();
-
-        void LoadMetadata(JJ2Block& block);
-        void LoadImageData(JJ2Block& imageBlock, JJ2Block& alphaBlock);
-        void LoadMaskData(JJ2Block& block);
-    };
+	class JJ2Tileset // .j2t
+	{
+	public:
+		static constexpr int TileSize = 32;
+		static constexpr int TilesPerRow = 10;
+
+		String Name;
+		JJ2Version Version;
+
+		JJ2Tileset();
+
+		bool Open(const StringView& path, bool strictParser);
+
+		/// Writes diffuse image, palette and precomputed collision masks to the target directory
+		bool Convert(const StringView& targetPath);
+
+		int GetMaxSupportedTiles() const {
+			return (Version == JJ2Version::BaseGame ? 1024 : 4096);
+		}
+
+	private:
+		struct TilesetTileSection {
+			bool Opaque;
+			uint32_t ImageDataOffset;
+			uint32_t AlphaDataOffset;
+			uint32_t MaskDataOffset;
+
+			uint8_t Image[TileSize * TileSize];
+			uint8_t Mask[TileSize * TileSize];
+		};
+
+		uint32_t _palette[256];
+		std::unique_ptr<TilesetTileSection[]> _tiles;
+		int _tileCount;
+
+		bool LoadMetadata(JJ2Block& block);
+		void LoadImageData(JJ2Block& imageBlock, JJ2Block& alphaBlock);
+		void LoadMaskData(JJ2Block& block);
+
+		bool WriteDiffuse(const StringView& targetPath);
+		bool WritePalette(const StringView& targetPath);
+		bool WriteMask(const StringView& targetPath);
+	};
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+﻿#include "PngWriter.h"
+
+#include "../../nCine/IO/IFileStream.h"
+
+#if defined(DEATH_TARGET_EMSCRIPTEN)
+#	define __USE_ZLIB
+#endif
+
+#if defined(__USE_ZLIB)
+#	include <zlib.h>
+#else
+#	if defined(_MSC_VER) && defined(__has_include)
+#		if __has_include("../../../Libs/libdeflate.h")
+#			define __HAS_LOCAL_LIBDEFLATE
+#		endif
+#	endif
+#	ifdef __HAS_LOCAL_LIBDEFLATE
+#		include "../../../Libs/libdeflate.h"
+#	else
+#		include <libdeflate.h>
+#	endif
+#endif
+
+#include <cstring>
+
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	namespace
+	{
+		uint32_t Crc32(uint32_t crc, const uint8_t* data, std::size_t length)
+		{
+#if defined(__USE_ZLIB)
+			return (uint32_t)crc32(crc, data, (uInt)length);
+#else
+			return libdeflate_crc32(crc, data, length);
+#endif
+		}
+
+		void WriteInt32BigEndian(uint8_t* dst, uint32_t value)
+		{
+			dst[0] = (uint8_t)(value >> 24);
+			dst[1] = (uint8_t)(value >> 16);
+			dst[2] = (uint8_t)(value >> 8);
+			dst[3] = (uint8_t)value;
+		}
+
+		void WriteChunk(const std::unique_ptr<IFileStream>& s, uint32_t type, const uint8_t* data, uint32_t length)
+		{
+			uint8_t header[8];
+			WriteInt32BigEndian(&header[0], length);
+			WriteInt32BigEndian(&header[4], type);
+			s->Write(header, sizeof(header));
+			if (length > 0) {
+				s->Write((void*)data, length);
+			}
+
+			// CRC covers chunk type and data
+			uint32_t crc = Crc32(0, &header[4], 4);
+			if (length > 0) {
+				crc = Crc32(crc, data, length);
+			}
+			uint8_t crcBytes[4];
+			WriteInt32BigEndian(crcBytes, crc);
+			s->Write(crcBytes, sizeof(crcBytes));
+		}
+	}
+
+	bool PngWriter::Save(const StringView& path, const uint32_t* pixels, int32_t width, int32_t height)
+	{
+		constexpr uint8_t PngSignature[] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a };
+		constexpr uint8_t PngTypeColorAlpha = 6;
+		constexpr uint8_t PngFilterNone = 0;
+
+		if (width <= 0 || height <= 0) {
+			return false;
+		}
+
+		// Each row starts with filter type, images contain mostly palette indices, so filtering doesn't help much
+		std::size_t stride = (std::size_t)width * 4;
+		std::size_t rawSize = (stride + 1) * height;
+		std::unique_ptr<uint8_t[]> raw = std::make_unique<uint8_t[]>(rawSize);
+		for (int32_t y = 0; y < height; y++) {
+			uint8_t* row = &raw[y * (stride + 1)];
+			row[0] = PngFilterNone;
+			std::memcpy(&row[1], &pixels[y * width], stride);
+		}
+
+#if defined(__USE_ZLIB)
+		uLongf compressedSize = compressBound((uLong)rawSize);
+		std::unique_ptr<uint8_t[]> compressed = std::make_unique<uint8_t[]>(compressedSize);
+		if (compress2(compressed.get(), &compressedSize, raw.get(), (uLong)rawSize, Z_BEST_COMPRESSION) != Z_OK) {
+			return false;
+		}
+#else
+		libdeflate_compressor* compressor = libdeflate_alloc_compressor(9);
+		if (compressor == nullptr) {
+			return false;
+		}
+		std::size_t compressedBound = libdeflate_zlib_compress_bound(compressor, rawSize);
+		std::unique_ptr<uint8_t[]> compressed = std::make_unique<uint8_t[]>(compressedBound);
+		std::size_t compressedSize = libdeflate_zlib_compress(compressor, raw.get(), rawSize, compressed.get(), compressedBound);
+		libdeflate_free_compressor(compressor);
+		if (compressedSize == 0) {
+			return false;
+		}
+#endif
+
+		auto s = IFileStream::createFileHandle(path);
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Write);
+		RETURNF_ASSERT_MSG_X(s->isOpened(), "Cannot open file \"%s\" for writing", String::nullTerminatedView(path).data());
+
+		s->Write((void*)PngSignature, sizeof(PngSignature));
+
+		uint8_t header[13];
+		WriteInt32BigEndian(&header[0], (uint32_t)width);
+		WriteInt32BigEndian(&header[4], (uint32_t)height);
+		header[8] = 8;					// Bit depth
+		header[9] = PngTypeColorAlpha;
+		header[10] = 0;					// Compression
+		header[11] = 0;					// Filter
+		header[12] = 0;					// Interlace
+		WriteChunk(s, 0x49484452, header, sizeof(header));			// IHDR
+		WriteChunk(s, 0x49444154, compressed.get(), (uint32_t)compressedSize);	// IDAT
+		WriteChunk(s, 0x49454E44, nullptr, 0);						// IEND
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "../../Common.h"
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Compatibility
+{
+	/// Lightweight PNG writer using libdeflate, it's the counterpart of `TextureLoaderPng`
+	class PngWriter
+	{
+	public:
+		/// Saves 32-bit RGBA image, all pixels are stored in a single `IDAT` chunk
+		static bool Save(const StringView& path, const uint32_t* pixels, int32_t width, int32_t height);
+
+	private:
+		PngWriter() = delete;
+	};
+}
\ No newline at end of file
@@ -126,7 +126,10 @@ namespace Jazz2
 		fileHandle->Read(buffer.get(), fileSize);
 		buffer[fileSize] = '\0';
 
-		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
+		ContentPtr<Metadata> metadata(theContentAllocator().newObject<Metadata>());
+		if (metadata == nullptr) {
+			return nullptr;
+		}
 		metadata->Flags |= MetadataFlags::Referenced;
 
 		Document document;
@@ -304,7 +307,10 @@ namespace Jazz2
 		}
 
 		// Try to load it
-		std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
+		ContentPtr<GenericGraphicResource> graphics(theContentAllocator().newObject<GenericGraphicResource>());
+		if (graphics == nullptr) {
+			return nullptr;
+		}
 		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
 
 		String fullPath = fs::joinPath({ "Content"_s, "Animations"_s, path });
@@ -419,6 +425,12 @@ namespace Jazz2
 
 		// TODO: Load normal texture
 
+		// Load precomputed collision mask if exists
+		std::unique_ptr<Tiles::TileSet> tileSet = RequestTileSetMask(path, textureDiffuse);
+		if (tileSet != nullptr) {
+			return tileSet;
+		}
+
 		// Load collision mask
 		std::unique_ptr<uint8_t[]> mask = nullptr;
 		{
@@ -464,6 +476,64 @@ namespace Jazz2
 		return std::make_unique<Tiles::TileSet>(std::move(textureDiffuse), std::move(mask));
 	}
 
+	std::unique_ptr<Tiles::TileSet> ContentResolver::RequestTileSetMask(const StringView& path, std::unique_ptr<Texture>& textureDiffuse)
+	{
+		constexpr int TileMaskSize = Tiles::TileSet::DefaultTileSize * Tiles::TileSet::DefaultTileSize;
+		constexpr int PackedMaskSize = TileMaskSize / 8;
+		constexpr int HeaderSize = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(int32_t);
+
+		auto s = IFileStream::createFileHandle(fs::joinPath({ "Content"_s, "Tilesets"_s, path, "Mask.tiles"_s }));
+		s->setExitOnFailToOpen(false);
+		s->Open(FileAccessMode::Read);
+		if (!s->isOpened() || s->GetSize() < HeaderSize) {
+			return nullptr;
+		}
+
+		uint32_t signature = s->ReadValue<uint32_t>();
+		uint16_t version = s->ReadValue<uint16_t>();
+		if (signature != Tiles::TileSet::MaskFileSignature || version != Tiles::TileSet::MaskFileVersion) {
+			// Mask was precomputed by incompatible version, it will be created from the image instead
+			return nullptr;
+		}
+
+		auto texSize = textureDiffuse->size();
+		int32_t tileCount = s->ReadValue<int32_t>();
+		if (tileCount != (texSize.X / Tiles::TileSet::DefaultTileSize) * (texSize.Y / Tiles::TileSet::DefaultTileSize)) {
+			// Mask doesn't match the texture
+			return nullptr;
+		}
+
+		// Flags of all tiles are followed by packed masks of tiles that are neither empty nor filled
+		ArrayView<const uint8_t> data = s->ReadView(s->GetSize() - HeaderSize);
+		if ((int32_t)data.size() < tileCount) {
+			return nullptr;
+		}
+
+		const uint8_t* tileFlags = data.data();
+		const uint8_t* packedMasks = data.data() + tileCount;
+		const uint8_t* packedMasksEnd = data.data() + data.size();
+
+		std::unique_ptr<uint8_t[]> mask = std::make_unique<uint8_t[]>(tileCount * TileMaskSize);
+		for (int32_t i = 0; i < tileCount; i++) {
+			uint8_t* maskOffset = &mask[i * TileMaskSize];
+			if ((tileFlags[i] & Tiles::TileSet::MaskEmptyFlag) != 0) {
+				std::memset(maskOffset, 0, TileMaskSize);
+			} else if ((tileFlags[i] & Tiles::TileSet::MaskFilledFlag) != 0) {
+				std::memset(maskOffset, 1, TileMaskSize);
+			} else {
+				if (packedMasks + PackedMaskSize > packedMasksEnd) {
+					return nullptr;
+				}
+				for (int j = 0; j < TileMaskSize; j++) {
+					maskOffset[j] = ((packedMasks[j / 8] >> (j % 8)) & 0x01);
+				}
+				packedMasks += PackedMaskSize;
+			}
+		}
+
+		return std::make_unique<Tiles::TileSet>(std::move(textureDiffuse), std::move(mask), tileFlags);
+	}
+
 	bool ContentResolver::LoadLevel(LevelHandler* levelHandler, const StringView& path, GameDifficulty difficulty)
 	{
 		String levelRoot = fs::joinPath({ "Content"_s, "Episodes"_s, path });
@@ -591,7 +661,9 @@ namespace Jazz2
 		std::unique_ptr<Events::EventMap> eventMap = std::make_unique<Events::EventMap>(levelHandler, tileMap->Size());
 		{
 			auto layerFile = IFileStream::createFileHandle(fs::joinPath({ levelRoot, "Events.layer"_s }));
-			eventMap->ReadEvents(layerFile, tileMap, eventSetItem->value.GetInt(), difficulty);
+			if (!eventMap->ReadEvents(layerFile, tileMap, eventSetItem->value.GetInt(), difficulty)) {
+				return false;
+			}
 		}
 
 		levelHandler->OnLevelLoaded(
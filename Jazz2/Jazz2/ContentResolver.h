@@ -10,6 +10,7 @@
 #include "../nCine/Graphics/Texture.h"
 #include "../nCine/Graphics/Viewport.h"
 #include "../nCine/IO/FileSystem.h"
+#include "../nCine/Base/CustomAllocator.h"
 #include "../nCine/Base/HashMap.h"
 
 #include <Containers/Pair.h>
@@ -178,11 +179,18 @@ namespace Jazz2
 		/// Deleted assignment operator
 		ContentResolver& operator=(const ContentResolver&) = delete;
 
+		std::unique_ptr<Tiles::TileSet> RequestTileSetMask(const StringView& path, std::unique_ptr<Texture>& textureDiffuse);
 		void RecreateGemPalettes();
 
 		bool _isLoading;
 		uint32_t _palettes[PaletteCount * ColorsPerPalette];
-		HashMap<String, std::unique_ptr<Metadata>> _cachedMetadata;
-		HashMap<Pair<String, uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
+		/// Cached resources and their tables are accounted to the content allocator
+		template<class T>
+		using ContentPtr = std::unique_ptr<T, CustomDeleter<theContentAllocator>>;
+		template<class K, class V>
+		using ContentHashMap = HashMap<K, V, FNV1aHashFunc<K>, phmap::priv::hash_default_eq<K>, CustomAllocator<std::pair<const K, V>, theContentAllocator>>;
+
+		ContentHashMap<String, ContentPtr<Metadata>> _cachedMetadata;
+		ContentHashMap<Pair<String, uint16_t>, ContentPtr<GenericGraphicResource>> _cachedGraphics;
 	};
 }
\ No newline at end of file
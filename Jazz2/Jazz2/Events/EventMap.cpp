@@ -3,14 +3,19 @@
 
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Base/FrameTimer.h"
+#include "../../nCine/IO/SpanReader.h"
 
 namespace Jazz2::Events
 {
 	EventMap::EventMap(ILevelHandler* levelHandler, Vector2i layoutSize)
 		:
 		_levelHandler(levelHandler),
-		_layoutSize(layoutSize)
+		_layoutSize(layoutSize),
+		_chunksSize((layoutSize.X + ChunkMask) >> ChunkShift, (layoutSize.Y + ChunkMask) >> ChunkShift),
+		_activeRange(0, 0, -1, -1),
+		_elapsedFrames(0.0f)
 	{
+		_chunkIndex.resize(_chunksSize.X * _chunksSize.Y, -1);
 	}
 
 	Vector2f EventMap::GetSpawnPosition(PlayerType type)
@@ -40,11 +45,13 @@ namespace Jazz2::Events
 
 	void EventMap::StoreTileEvent(int x, int y, EventType eventType, ActorFlags eventFlags, uint8_t* tileParams)
 	{
-		if (eventType == EventType::Empty && (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y)) {
+		// Chunks are allocated only when needed, so empty events are never stored into unallocated chunks
+		EventTile* previousEventPtr = (eventType == EventType::Empty ? FindTile(x, y) : GetOrCreateTile(x, y));
+		if (previousEventPtr == nullptr) {
 			return;
 		}
 
-		EventTile& previousEvent = _eventLayout[x + y * _layoutSize.X];
+		EventTile& previousEvent = *previousEventPtr;
 
 		EventTile newEvent = { };
 		newEvent.EventType = eventType,
@@ -58,6 +65,10 @@ namespace Jazz2::Events
 		}
 
 		previousEvent = newEvent;
+
+		if (!newEvent.IsEventActive && eventType != EventType::Empty) {
+			MarkPendingActivation(x, y);
+		}
 	}
 
 	void EventMap::PreloadEventsAsync()
@@ -68,10 +79,12 @@ namespace Jazz2::Events
 		//ContentResolver::Current().SuspendAsync();
 
 		// Preload all events
-		for (auto& tile : _eventLayout) {
-			// ToDo: Exclude also some modifiers here ?
-			if (tile.EventType != EventType::Empty && tile.EventType != EventType::Generator && tile.EventType != EventType::AreaWeather) {
-				eventSpawner->PreloadEvent(tile.EventType, tile.EventParams);
+		for (auto& chunk : _chunks) {
+			for (auto& tile : chunk->Tiles) {
+				// ToDo: Exclude also some modifiers here ?
+				if (tile.EventType != EventType::Empty && tile.EventType != EventType::Generator && tile.EventType != EventType::AreaWeather) {
+					eventSpawner->PreloadEvent(tile.EventType, tile.EventParams);
+				}
 			}
 		}
 
@@ -86,30 +99,49 @@ namespace Jazz2::Events
 
 	void EventMap::ProcessGenerators(float timeMult)
 	{
-		for (auto& generator : _generators) {
-			if (!_eventLayout[generator.EventPos].IsEventActive) {
-				// Generator is inactive (and recharging)
-				generator.TimeLeft -= timeMult;
-			} else if (generator.SpawnedActor == nullptr /*|| generator.SpawnedActor.Scene == null*/) {
-				// TODO: check if actor is still alive
-				if (generator.TimeLeft <= 0.0f) {
-					// Generator is active and is ready to spawn new actor
-					generator.TimeLeft = generator.Delay * FrameTimer::FramesPerSecond;
-
-					int x = generator.EventPos % _layoutSize.X;
-					int y = generator.EventPos / _layoutSize.X;
-
-					std::shared_ptr<ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(generator.EventType,
-						generator.EventParams, ActorFlags::IsFromGenerator, x, y, ILevelHandler::SpritePlaneZ);
-					if (actor != nullptr) {
-						_levelHandler->AddActor(actor);
-						generator.SpawnedActor = actor;
-					}
-				} else {
-					// Generator is active and recharging
-					generator.TimeLeft -= timeMult;
-				}
-			}
+		_elapsedFrames += timeMult;
+
+		_generatorTimers.Advance((uint32_t)_elapsedFrames, [this](uint16_t generatorIdx) {
+			ProcessGenerator(generatorIdx);
+		});
+	}
+
+	void EventMap::ScheduleGenerator(uint16_t generatorIdx)
+	{
+		float readyTime = _generators[generatorIdx].ReadyTime;
+		_generatorTimers.Schedule(readyTime > 0.0f ? (uint32_t)std::ceil(readyTime) : 0, generatorIdx);
+	}
+
+	void EventMap::ProcessGenerator(uint16_t generatorIdx)
+	{
+		auto& generator = _generators[generatorIdx];
+		int x = generator.EventPos % _layoutSize.X;
+		int y = generator.EventPos / _layoutSize.X;
+		EventTile* tile = FindTile(x, y);
+		if (tile == nullptr || !tile->IsEventActive) {
+			// Generator is inactive (and recharging), it will be scheduled again when activated
+			return;
+		}
+		if (generator.SpawnedActor != nullptr /*&& generator.SpawnedActor.Scene != null*/) {
+			// TODO: check if actor is still alive
+			return;
+		}
+		if (generator.ReadyTime > _elapsedFrames) {
+			// Generator is active and recharging
+			ScheduleGenerator(generatorIdx);
+			return;
+		}
+
+		// Generator is active and is ready to spawn new actor
+		generator.ReadyTime = _elapsedFrames + generator.Delay * FrameTimer::FramesPerSecond;
+
+		std::shared_ptr<ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(generator.EventType,
+			generator.EventParams, ActorFlags::IsFromGenerator, x, y, ILevelHandler::SpritePlaneZ);
+		if (actor != nullptr) {
+			_levelHandler->AddActor(actor);
+			generator.SpawnedActor = actor;
+		} else {
+			ScheduleGenerator(generatorIdx);
 		}
 	}
 
@@ -125,24 +157,64 @@ namespace Jazz2::Events
 		int y1 = std::max(0, ty1);
 		int y2 = std::min(_layoutSize.Y - 1, ty2);
 
-		for (int x = x1; x <= x2; x++) {
-			for (int y = y1; y <= y2; y++) {
-				auto& tile = _eventLayout[x + y * _layoutSize.X];
-				if (!tile.IsEventActive && tile.EventType != EventType::Empty) {
-					tile.IsEventActive = true;
-
-					// TODO
-					/*if (tile.EventType == EventType.AreaWeather) {
-						_levelHandler->ApplyWeather((LevelHandler.WeatherType)tile.EventParams[0], tile.EventParams[1], tile.EventParams[2] != 0);
-					} else*/ if (tile.EventType != EventType::Generator) {
-						ActorFlags flags = ActorFlags::IsCreatedFromEventMap | tile.EventFlags;
-						if (allowAsync) {
-							flags |= ActorFlags::Async;
-						}
+		AABBi prevRange = _activeRange;
+		_activeRange = AABBi(x1, y1, x2, y2);
+		if (x1 > x2 || y1 > y2) {
+			_pendingActivations.clear();
+			return;
+		}
+
+		for (int32_t idx : _pendingActivations) {
+			int x = idx % _layoutSize.X;
+			int y = idx / _layoutSize.X;
+			if (x >= x1 && x <= x2 && y >= y1 && y <= y2) {
+				ActivateEvent(x, y, allowAsync);
+			}
+		}
+		_pendingActivations.clear();
+
+		if (prevRange.L > prevRange.R || !prevRange.Overlaps(_activeRange)) {
+			ActivateEventsInRange(x1, y1, x2, y2, allowAsync);
+			return;
+		}
+
+		// Only strips that entered the range since the last call have to be checked
+		if (y1 < prevRange.T) {
+			ActivateEventsInRange(x1, y1, x2, prevRange.T - 1, allowAsync);
+		}
+		if (y2 > prevRange.B) {
+			ActivateEventsInRange(x1, prevRange.B + 1, x2, y2, allowAsync);
+		}
+		int sy1 = std::max(y1, prevRange.T);
+		int sy2 = std::min(y2, prevRange.B);
+		if (x1 < prevRange.L) {
+			ActivateEventsInRange(x1, sy1, prevRange.L - 1, sy2, allowAsync);
+		}
+		if (x2 > prevRange.R) {
+			ActivateEventsInRange(prevRange.R + 1, sy1, x2, sy2, allowAsync);
+		}
+	}
+
+	void EventMap::ActivateEventsInRange(int x1, int y1, int x2, int y2, bool allowAsync)
+	{
+		// Chunks without any event are skipped entirely
+		for (int cy = (y1 >> ChunkShift); cy <= (y2 >> ChunkShift); cy++) {
+			for (int cx = (x1 >> ChunkShift); cx <= (x2 >> ChunkShift); cx++) {
+				int32_t chunkIdx = _chunkIndex[cx + cy * _chunksSize.X];
+				if (chunkIdx < 0) {
+					continue;
+				}
 
-						std::shared_ptr<ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.EventType, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
-						if (actor != nullptr) {
-							_levelHandler->AddActor(actor);
+				EventChunk& chunk = *_chunks[chunkIdx];
+				int cx1 = std::max(x1, cx << ChunkShift);
+				int cx2 = std::min(x2, (cx << ChunkShift) + ChunkMask);
+				int cy1 = std::max(y1, cy << ChunkShift);
+				int cy2 = std::min(y2, (cy << ChunkShift) + ChunkMask);
+				for (int y = cy1; y <= cy2; y++) {
+					for (int x = cx1; x <= cx2; x++) {
+						auto& tile = chunk.Tiles[(x & ChunkMask) + (y & ChunkMask) * ChunkSize];
+						if (!tile.IsEventActive && tile.EventType != EventType::Empty) {
+							ActivateEvent(x, y, allowAsync);
 						}
 					}
 				}
@@ -150,10 +222,47 @@ namespace Jazz2::Events
 		}
 	}
 
+	void EventMap::ActivateEvent(int x, int y, bool allowAsync)
+	{
+		EventTile* tilePtr = FindTile(x, y);
+		if (tilePtr == nullptr || tilePtr->IsEventActive || tilePtr->EventType == EventType::Empty) {
+			return;
+		}
+
+		auto& tile = *tilePtr;
+		tile.IsEventActive = true;
+
+		// TODO
+		/*if (tile.EventType == EventType.AreaWeather) {
+			_levelHandler->ApplyWeather((LevelHandler.WeatherType)tile.EventParams[0], tile.EventParams[1], tile.EventParams[2] != 0);
+		} else*/ if (tile.EventType == EventType::Generator) {
+			ScheduleGenerator(*(uint16_t*)tile.EventParams);
+		} else {
+			ActorFlags flags = ActorFlags::IsCreatedFromEventMap | tile.EventFlags;
+			if (allowAsync) {
+				flags |= ActorFlags::Async;
+			}
+
+			std::shared_ptr<ActorBase> actor = _levelHandler->EventSpawner()->SpawnEvent(tile.EventType, tile.EventParams, flags, x, y, ILevelHandler::SpritePlaneZ);
+			if (actor != nullptr) {
+				_levelHandler->AddActor(actor);
+			}
+		}
+	}
+
+	void EventMap::MarkPendingActivation(int x, int y)
+	{
+		if (x >= _activeRange.L && x <= _activeRange.R && y >= _activeRange.T && y <= _activeRange.B) {
+			_pendingActivations.push_back(x + y * _layoutSize.X);
+		}
+	}
+
 	void EventMap::Deactivate(int x, int y)
 	{
-		if (HasEventByPosition(x, y)) {
-			_eventLayout[x + y * _layoutSize.X].IsEventActive = false;
+		EventTile* tile = FindTile(x, y);
+		if (tile != nullptr && tile->EventType != EventType::Empty) {
+			tile->IsEventActive = false;
+			MarkPendingActivation(x, y);
 		}
 	}
 
@@ -161,8 +270,14 @@ namespace Jazz2::Events
 	{
 		// Linked actor was deactivated, but not destroyed
 		// Reset its generator, so it can be respawned immediately
-		uint16_t generatorIdx = *(uint16_t*)_eventLayout[tx + ty * _layoutSize.X].EventParams;
-		_generators[generatorIdx].TimeLeft = 0.0f;
+		EventTile* tile = FindTile(tx, ty);
+		if (tile == nullptr || tile->EventType != EventType::Generator) {
+			return;
+		}
+
+		uint16_t generatorIdx = *(uint16_t*)tile->EventParams;
+		_generators[generatorIdx].ReadyTime = _elapsedFrames;
+		ScheduleGenerator(generatorIdx);
 	}
 
 	EventType EventMap::GetEventByPosition(float x, float y, uint8_t** eventParams)
@@ -176,16 +291,18 @@ namespace Jazz2::Events
 			return EventType::ModifierDeath;
 		}
 
-		if (HasEventByPosition(x, y)) {
-			*eventParams = _eventLayout[x + y * _layoutSize.X].EventParams;
-			return _eventLayout[x + y * _layoutSize.X].EventType;
+		EventTile* tile = FindTile(x, y);
+		if (tile != nullptr && tile->EventType != EventType::Empty) {
+			*eventParams = tile->EventParams;
+			return tile->EventType;
 		}
 		return EventType::Empty;
 	}
 
 	bool EventMap::HasEventByPosition(int x, int y)
 	{
-		return (x >= 0 && y >= 0 && y < _layoutSize.Y && x < _layoutSize.X && _eventLayout[x + y * _layoutSize.X].EventType != EventType::Empty);
+		EventTile* tile = FindTile(x, y);
+		return (tile != nullptr && tile->EventType != EventType::Empty);
 	}
 
 	bool EventMap::IsHurting(float x, float y)
@@ -244,23 +361,50 @@ namespace Jazz2::Events
 		return Vector2f(-1, -1);
 	}
 
-	void EventMap::ReadEvents(const std::unique_ptr<IFileStream>& s, const std::unique_ptr<Tiles::TileMap>& tileMap, uint32_t layoutVersion, GameDifficulty difficulty)
+	EventMap::EventTile* EventMap::FindTile(int x, int y)
+	{
+		if (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y) {
+			return nullptr;
+		}
+
+		int32_t chunkIdx = _chunkIndex[(x >> ChunkShift) + (y >> ChunkShift) * _chunksSize.X];
+		if (chunkIdx < 0) {
+			return nullptr;
+		}
+
+		return &_chunks[chunkIdx]->Tiles[(x & ChunkMask) + (y & ChunkMask) * ChunkSize];
+	}
+
+	EventMap::EventTile* EventMap::GetOrCreateTile(int x, int y)
+	{
+		if (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y) {
+			return nullptr;
+		}
+
+		int32_t& chunkIdx = _chunkIndex[(x >> ChunkShift) + (y >> ChunkShift) * _chunksSize.X];
+		if (chunkIdx < 0) {
+			chunkIdx = (int32_t)_chunks.size();
+			_chunks.emplace_back(std::make_unique<EventChunk>());
+		}
+
+		return &_chunks[chunkIdx]->Tiles[(x & ChunkMask) + (y & ChunkMask) * ChunkSize];
+	}
+
+	bool EventMap::ReadEvents(const std::unique_ptr<IFileStream>& s, const std::unique_ptr<Tiles::TileMap>& tileMap, uint32_t layoutVersion, GameDifficulty difficulty)
 	{
 		s->Open(FileAccessMode::Read);
 
 		if (s->GetSize() < 4) {
-			return;
+			return true;
 		}
 
 		int32_t width = s->ReadValue<int32_t>();
 		int32_t height = s->ReadValue<int32_t>();
 
 		if (_layoutSize.X != width || _layoutSize.Y != height) {
-			return;
+			return true;
 		}
 
-		_eventLayout.resize(width * height);
-
 		uint8_t difficultyBit;
 		switch (difficulty) {
 			case GameDifficulty::Easy:
@@ -277,10 +421,14 @@ namespace Jazz2::Events
 				break;
 		}
 
+		// Events have variable length, so the rest of the file is read at once and decoded from memory
+		ArrayView<const uint8_t> data = s->ReadView(s->GetSize() - s->GetPosition());
+		SpanReader r(data);
+
 		for (int y = 0; y < height; y++) {
 			for (int x = 0; x < width; x++) {
-				uint16_t eventID = s->ReadValue<uint16_t>();
-				uint8_t flags = s->ReadValue<uint8_t>();
+				uint16_t eventID = r.ReadValue<uint16_t>();
+				uint8_t flags = r.ReadValue<uint8_t>();
 				uint8_t eventParams[16];
 
 				// ToDo: Remove inlined constants
@@ -289,8 +437,8 @@ namespace Jazz2::Events
 				uint8_t generatorFlags, generatorDelay;
 				if ((flags & 0x02) != 0) {
 					//eventFlags ^= 0x02;
-					generatorFlags = s->ReadValue<uint8_t>();
-					generatorDelay = s->ReadValue<uint8_t>();
+					generatorFlags = r.ReadValue<uint8_t>();
+					generatorDelay = r.ReadValue<uint8_t>();
 				} else {
 					generatorFlags = 0;
 					generatorDelay = 0;
@@ -299,11 +447,17 @@ namespace Jazz2::Events
 				// Flag 0x01: No params provided
 				if ((flags & 0x01) == 0) {
 					flags ^= 0x01;
-					s->Read(eventParams, sizeof(eventParams));
+					r.Read(eventParams, sizeof(eventParams));
 				} else {
 					memset(eventParams, 0, sizeof(eventParams));
 				}
 
+				// Truncated file would be decoded as empty events, so the level is not loaded at all
+				if (r.HasOverflowed()) {
+					LOGE_X("Events file \"%s\" is truncated", s->filename());
+					return false;
+				}
+
 				ActorFlags eventFlags = (ActorFlags)(flags & 0x04);
 
 				// Flag 0x02: Generator
@@ -317,7 +471,7 @@ namespace Jazz2::Events
 						generator.EventType = (EventType)eventID;
 						std::memcpy(generator.EventParams, eventParams, sizeof(eventParams));
 						generator.Delay = generatorDelay;
-						generator.TimeLeft = timeLeft;
+						generator.ReadyTime = _elapsedFrames + timeLeft;
 
 						*(uint16_t*)eventParams = generatorIdx;
 						StoreTileEvent(x, y, EventType::Generator, eventFlags, eventParams);
@@ -380,15 +534,18 @@ namespace Jazz2::Events
 
 		// TODO
 		//Array.Copy(eventLayout, eventLayoutForRollback, eventLayout.Length);
+
+		return true;
 	}
 
 	void EventMap::StoreTileEvent(int x, int y, EventType eventType, ActorFlags eventFlags, uint16_t* tileParams)
 	{
-		if (eventType == EventType::Empty && (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y )) {
+		EventTile* previousEventPtr = (eventType == EventType::Empty ? FindTile(x, y) : GetOrCreateTile(x, y));
+		if (previousEventPtr == nullptr) {
 			return;
 		}
 
-		auto& previousEvent = _eventLayout[x + y * _layoutSize.X];
+		auto& previousEvent = *previousEventPtr;
 
 		EventTile newEvent = { };
 		newEvent.EventType = eventType;
@@ -401,6 +558,10 @@ namespace Jazz2::Events
 		}
 
 		previousEvent = newEvent;
+
+		if (!newEvent.IsEventActive && eventType != EventType::Empty) {
+			MarkPendingActivation(x, y);
+		}
 	}
 
 	void EventMap::AddWarpTarget(uint16_t id, int x, int y)
@@ -2,6 +2,7 @@
 
 #include "EventSpawner.h"
 #include "../LevelInitialization.h"
+#include "../TimerWheel.h"
 
 #include "../../nCine/IO/IFileStream.h"
 
@@ -18,6 +19,7 @@ namespace Jazz2::Events
 		void PreloadEventsAsync();
 
 		void ProcessGenerators(float timeMult);
+		/// Activates events in the specified tile range, only tiles that weren't in the range in the previous call are checked
 		void ActivateEvents(int tx1, int ty1, int tx2, int ty2, bool allowAsync);
 		void Deactivate(int x, int y);
 		void ResetGenerator(int tx, int ty);
@@ -30,7 +32,7 @@ namespace Jazz2::Events
 		int GetWarpByPosition(float x, float y);
 		Vector2f GetWarpTarget(uint32_t id);
 
-		void ReadEvents(const std::unique_ptr<IFileStream>& s, const std::unique_ptr<Tiles::TileMap>& tileMap, uint32_t layoutVersion, GameDifficulty difficulty);
+		bool ReadEvents(const std::unique_ptr<IFileStream>& s, const std::unique_ptr<Tiles::TileMap>& tileMap, uint32_t layoutVersion, GameDifficulty difficulty);
 		void StoreTileEvent(int x, int y, EventType eventType, ActorFlags eventFlags, uint16_t* tileParams);
 		void AddWarpTarget(uint16_t id, int x, int y);
 		void AddSpawnPosition(uint8_t typeMask, int x, int y);
@@ -43,13 +45,23 @@ namespace Jazz2::Events
 			bool IsEventActive;
 		};
 
+		/// Events are stored in square chunks, chunks without any event are not allocated at all
+		static constexpr int ChunkShift = 4;
+		static constexpr int ChunkSize = (1 << ChunkShift);
+		static constexpr int ChunkMask = ChunkSize - 1;
+
+		struct EventChunk {
+			EventTile Tiles[ChunkSize * ChunkSize];
+		};
+
 		struct GeneratorInfo {
 			int EventPos;
 
 			EventType EventType;
 			uint8_t EventParams[16];
 			uint8_t Delay;
-			float TimeLeft;
+			/// Time when the generator is recharged, in frames since the level was loaded
+			float ReadyTime;
 
 			std::shared_ptr<ActorBase> SpawnedActor;
 		};
@@ -66,9 +78,27 @@ namespace Jazz2::Events
 
 		ILevelHandler* _levelHandler;
 		Vector2i _layoutSize;
-		SmallVector<EventTile, 0> _eventLayout;
+		Vector2i _chunksSize;
+		/// Index to `_chunks` for each chunk of the layout, or -1 if the chunk is empty
+		SmallVector<int32_t, 0> _chunkIndex;
+		SmallVector<std::unique_ptr<EventChunk>, 0> _chunks;
 		SmallVector<GeneratorInfo, 0> _generators;
+		/// Generators are woken up only when they are recharged or their tile is activated
+		TimerWheel<uint16_t> _generatorTimers;
+		float _elapsedFrames;
 		SmallVector<SpawnPoint, 0> _spawnPoints;
 		SmallVector<WarpTarget, 0> _warpTargets;
+		/// Tile range of the last activation, empty if `L > R`
+		AABBi _activeRange;
+		/// Tiles inside the active range that became inactive, they are checked again in the next activation
+		SmallVector<int32_t, 0> _pendingActivations;
+
+		EventTile* FindTile(int x, int y);
+		EventTile* GetOrCreateTile(int x, int y);
+		void ActivateEventsInRange(int x1, int y1, int x2, int y2, bool allowAsync);
+		void ActivateEvent(int x, int y, bool allowAsync);
+		void MarkPendingActivation(int x, int y);
+		void ScheduleGenerator(uint16_t generatorIdx);
+		void ProcessGenerator(uint16_t generatorIdx);
 	};
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "EventSpawner.h"
+#include "../ActorPool.h"
 
 #include "../Actors/Environment/AmbientSound.h"
 #include "../Actors/Environment/Bomb.h"
@@ -185,7 +186,13 @@ namespace Jazz2::Events
 	void EventSpawner::RegisterSpawnable(EventType type)
 	{
 		_spawnableEvents[type] = { [](const ActorActivationDetails& details) -> std::shared_ptr<ActorBase> {
-			std::shared_ptr<ActorBase> actor = std::make_shared<T>();
+			std::shared_ptr<ActorBase> actor;
+			if constexpr (std::is_base_of_v<Actors::Collectibles::CollectibleBase, T>) {
+				// Collectibles are spawned and destroyed in large numbers, so their memory is recycled
+				actor = ActorPool<T>::Create();
+			} else {
+				actor = std::make_shared<T>();
+			}
 			actor->OnActivated(details);
 			return actor;
 		}, T::Preload };
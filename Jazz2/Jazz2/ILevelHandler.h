@@ -5,6 +5,7 @@
 #include "LevelInitialization.h"
 
 #include "../nCine/Audio/AudioBufferPlayer.h"
+#include "../nCine/Base/FrameAllocator.h"
 
 namespace Jazz2
 {
@@ -65,6 +66,7 @@ namespace Jazz2
 		virtual void SetAmbientLight(float value) = 0;
 
 		virtual void AddActor(const std::shared_ptr<ActorBase>& actor) = 0;
+		virtual ActorBase* GetActor(ActorHandle handle) = 0;
 
 		virtual const std::shared_ptr<AudioBufferPlayer>& PlaySfx(AudioBuffer* buffer, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
 		virtual const std::shared_ptr<AudioBufferPlayer>& PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
@@ -77,9 +79,9 @@ namespace Jazz2
 			return IsPositionEmpty(self, aabb, downwards, &collider);
 		}
 
-		virtual void FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const std::function<bool(ActorBase*)>& callback) = 0;
-		virtual void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(ActorBase*)>& callback) = 0;
-		virtual void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(ActorBase*)> callback) = 0;
+		virtual void FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback) = 0;
+		virtual void FindCollisionActorsByRadius(float x, float y, float radius, const FrameFunction<bool(ActorBase*)>& callback) = 0;
+		virtual void GetCollidingPlayers(const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback) = 0;
 
 		virtual void BeginLevelChange(ExitType exitType, const StringView& nextLevel) = 0;
 		virtual void HandleGameOver() = 0;
@@ -10,12 +10,15 @@
 #include "../nCine/Graphics/Texture.h"
 #include "../nCine/Graphics/Viewport.h"
 #include "../nCine/Graphics/RenderQueue.h"
+#include "../nCine/Graphics/RenderResources.h"
 #include "../nCine/Audio/AudioReaderMpt.h"
+#include "../nCine/Base/FrameAllocator.h"
 #include "../nCine/Base/Random.h"
 
 #include "Actors/Player.h"
 #include "Actors/SolidObjectBase.h"
 
+#include <cstdio>
 #include <float.h>
 
 using namespace nCine;
@@ -37,25 +40,24 @@ namespace Jazz2
 		_difficulty(levelInit.Difficulty),
 		_reduxMode(levelInit.ReduxMode),
 		_cheatsUsed(levelInit.CheatsUsed),
-		_shakeDuration(0.0f),
 		_waterLevel(FLT_MAX),
 		_ambientLightDefault(1.0f),
 		_ambientLightCurrent(1.0f),
 		_ambientLightTarget(1.0f),
+		_deactivationRange(0, 0, -1, -1),
 #if ENABLE_POSTPROCESSING
-		_downsamplePass(this),
-		_blurPass1(this),
-		_blurPass2(this),
-		_blurPass3(this),
-		_blurPass4(this),
+		_blurLevels(DefaultBlurLevels),
 #endif
-		_pressedActions(0),
+		_pressedActions{},
 		_overrideActions(0)
 	{
 		auto& resolver = Jazz2::ContentResolver::Current();
 		resolver.BeginLoading();
 
 		_rootNode = std::make_unique<SceneNode>();
+		_actorsRoot = std::make_unique<ActorsRoot>(this);
+		_actorsRoot->setDeleteChildrenOnDestruction(false);
+		_actorsRoot->setParent(_rootNode.get());
 
 		if (!ContentResolver::Current().LoadLevel(this, _episodeName + "/" + _levelFileName, _difficulty)) {
 			LOGE("Cannot load specified level");
@@ -138,6 +140,11 @@ namespace Jazz2
 
 		_eventMap = std::move(eventMap);
 
+		Vector2i layoutSize = _tileMap->Size();
+		_deactivationBucketsSize = Vector2i((layoutSize.X + DeactivationBucketSize - 1) / DeactivationBucketSize, (layoutSize.Y + DeactivationBucketSize - 1) / DeactivationBucketSize);
+		_deactivationBuckets.clear();
+		_deactivationBuckets.resize(_deactivationBucketsSize.X * _deactivationBucketsSize.Y);
+
 		_levelBounds = _tileMap->LevelBounds();
 		_viewBounds = Rectf((float)_levelBounds.X, (float)_levelBounds.Y, (float)_levelBounds.W, (float)_levelBounds.H);
 		_viewBoundsTarget = _viewBounds;		
@@ -164,14 +171,8 @@ namespace Jazz2
 
 		UpdatePressedActions();
 
-		// Destroy stopped players
-		for (int i = (int)_playingSounds.size() - 1; i >= 0; i--) {
-			if (_playingSounds[i]->state() == IAudioPlayer::PlayerState::Stopped) {
-				_playingSounds.erase(&_playingSounds[i]);
-			} else {
-				break;
-			}
-		}
+		// Recycle finished sound effect voices
+		_sfxVoices.Update();
 
 		/*if (nextLevelInit.HasValue) {
 			bool playersReady = true;
@@ -194,15 +195,15 @@ namespace Jazz2
 
 		if (_difficulty != GameDifficulty::Multiplayer) {
 			if (!_players.empty()) {
+				// Events are activated in the range that covers all players
 				auto& pos = _players[0]->GetPos();
 				int tx1 = (int)pos.X >> 5;
 				int ty1 = (int)pos.Y >> 5;
 				int tx2 = tx1;
 				int ty2 = ty1;
 
-#if ENABLE_SPLITSCREEN
-				for (int i = 1; i < players.Count; i++) {
-					Vector3 pos2 = players[i].Transform.Pos;
+				for (int i = 1; i < (int)_players.size(); i++) {
+					auto& pos2 = _players[i]->GetPos();
 					int tx = (int)pos2.X >> 5;
 					int ty = (int)pos2.Y >> 5;
 					if (tx1 > tx) {
@@ -216,7 +217,6 @@ namespace Jazz2
 						ty2 = ty;
 					}
 				}
-#endif
 
 				constexpr int ActivateTileRange = 26;
 				tx1 -= ActivateTileRange;
@@ -224,11 +224,7 @@ namespace Jazz2
 				tx2 += ActivateTileRange;
 				ty2 += ActivateTileRange;
 
-				for (int i = (int)_actors.size() - 1; i >= 0; i--) {
-					if (_actors[i]->OnTileDeactivate(tx1 - 2, ty1 - 2, tx2 + 2, ty2 + 2)) {
-						// Actor was deactivated
-					}
-				}
+				DeactivateDistantActors(AABBi(tx1 - 2, ty1 - 2, tx2 + 2, ty2 + 2));
 
 				_eventMap->ActivateEvents(tx1, ty1, tx2, ty2, true);
 			}
@@ -344,10 +340,21 @@ namespace Jazz2
 			}
 		}
 
-		UpdateCamera(timeMult);
+		UpdateCameras(timeMult);
 
 #if ENABLE_POSTPROCESSING
-		_lightingView->setClearColor(_ambientLightCurrent, 0.0f, 0.0f, 1.0f);
+		// Lights are collected before drawing, so lighting and blur passes can be skipped if they wouldn't change anything
+		CollectLights();
+
+		for (auto& viewport : _playerViewports) {
+			viewport->_lightingView->setClearColor(_ambientLightCurrent, 0.0f, 0.0f, 1.0f);
+			viewport->_lightingRenderer->CollectVisibleLights(_emittedLights, viewport->GetViewBounds());
+
+			bool postProcessingNeeded = (_ambientLightCurrent < 1.0f || viewport->_lightingRenderer->HasVisibleLights());
+			if (viewport->_postProcessingActive != postProcessingNeeded) {
+				viewport->SetPostProcessingActive(postProcessingNeeded);
+			}
+		}
 #endif
 
 		// TODO: DEBUG
@@ -358,40 +365,14 @@ namespace Jazz2
 		if (_debugRefresh <= 0) {
 			_debugRefresh = 60;
 
-			std::string text = "Jazz² Resurrection | Time: ";
-			text += std::to_string(timeMult);
-			text += ", fps: ";
-			text += std::to_string((int)((1.0f / timeMult) * 60.0f));
-			text += ", camera: {";
-			text += std::to_string(_cameraLastPos.X);
-			text += ", ";
-			text += std::to_string(_cameraLastPos.Y);
-			text += "}; player: {";
-			text += std::to_string(_players[0]->_pos.X);
-			text += ", ";
-			text += std::to_string(_players[0]->_pos.Y);
-			text += "}; dirty: ";
-			text += std::to_string(_debugActorDirtyCount);
-			text += ", pairs: ";
-			text += std::to_string(_debugCollisionPairCount);
-			text += ", AABB: {";
-			text += std::to_string(_players[0]->AABBInner.L);
-			text += ", ";
-			text += std::to_string(_players[0]->AABBInner.T);
-			text += ", ";
-			text += std::to_string(_players[0]->AABBInner.R);
-			text += ", ";
-			text += std::to_string(_players[0]->AABBInner.B);
-			text += "}, level: {";
-			text += std::to_string(_levelBounds.X);
-			text += ", ";
-			text += std::to_string(_levelBounds.Y);
-			text += ", ";
-			text += std::to_string(_levelBounds.W);
-			text += ", ";
-			text += std::to_string(_levelBounds.H);
-			text += "}";
-			theApplication().gfxDevice().setWindowTitle(text.c_str());
+			// The title is needed only until it's passed to the window, so it's allocated from the frame arena
+			constexpr std::size_t MaxTitleLength = 512;
+			char* text = static_cast<char*>(theApplication().frameArena().allocate(MaxTitleLength, 1));
+			std::snprintf(text, MaxTitleLength, "Jazz² Resurrection | Time: %f, fps: %i, camera: {%f, %f}; player: {%f, %f}; dirty: %i, pairs: %i, AABB: {%f, %f, %f, %f}, level: {%i, %i, %i, %i}",
+				timeMult, (int)((1.0f / timeMult) * 60.0f), _playerViewports[0]->_cameraLastPos.X, _playerViewports[0]->_cameraLastPos.Y, _players[0]->_pos.X, _players[0]->_pos.Y,
+				_debugActorDirtyCount, _debugCollisionPairCount, _players[0]->AABBInner.L, _players[0]->AABBInner.T, _players[0]->AABBInner.R, _players[0]->AABBInner.B,
+				_levelBounds.X, _levelBounds.Y, _levelBounds.W, _levelBounds.H);
+			theApplication().gfxDevice().setWindowTitle(text);
 
 			_debugActorDirtyCount = 0;
 			_debugCollisionPairCount = 0;
@@ -404,44 +385,8 @@ namespace Jazz2
 
 	void LevelHandler::OnInitializeViewport(int width, int height)
 	{
-		constexpr float defaultRatio = (float)DefaultWidth / DefaultHeight;
-		float currentRatio = (float)width / height;
-
-		int w, h;
-		if (currentRatio > defaultRatio) {
-			w = std::min(DefaultWidth, width);
-			h = (int)(w / currentRatio);
-		} else if (currentRatio < defaultRatio) {
-			h = std::min(DefaultHeight, height);
-			w = (int)(h * currentRatio);
-		} else {
-			w = std::min(DefaultWidth, width);
-			h = std::min(DefaultHeight, height);
-		}
-
-		bool notInitialized = (_view == nullptr);
-
-		if (notInitialized) {
-			_viewTexture = std::make_unique<Texture>(nullptr, Texture::Format::RGB8, w, h);
-			_view = std::make_unique<Viewport>(_viewTexture.get(), Viewport::DepthStencilFormat::/*DEPTH24_STENCIL8*/NONE);
-
-			_camera = std::make_unique<Camera>();
-			InitializeCamera();
-
-			_view->setCamera(_camera.get());
-			_view->setRootNode(_rootNode.get());
-		} else {
-			_view->removeAllTextures();
-			_viewTexture->init(nullptr, Texture::Format::RGB8, w, h);
-			_view->setTexture(_viewTexture.get());
-		}
-
-		_viewTexture->setMagFiltering(SamplerFilter::Nearest);
-
-		_camera->setOrthoProjection(w * (-0.5f), w * (+0.5f), h * (-0.5f), h * (+0.5f));
-
 #if ENABLE_POSTPROCESSING
-		if (_lightingRenderer == nullptr) {
+		if (_lightingShader == nullptr) {
 			constexpr char LightingVs[] = R"(
 uniform mat4 uProjectionMatrix;
 uniform mat4 uViewMatrix;
@@ -449,22 +394,20 @@ uniform mat4 uViewMatrix;
 layout (std140) uniform InstanceBlock
 {
 	mat4 modelMatrix;
-	vec4 color;
-	vec4 texRect;
-	vec2 spriteSize;
 };
 
+in vec2 aPosition;
+in vec3 aTexCoords;
+in vec4 aColor;
+
 out vec4 vTexCoords;
 out vec4 vColor;
 
 void main()
 {
-	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), 0.5 - float(gl_VertexID % 2));
-	vec4 position = vec4(aPosition.x * spriteSize.x, aPosition.y * spriteSize.y, 0.0, 1.0);
-
-	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
-	vTexCoords = texRect;
-	vColor = vec4(color.x, color.y, aPosition.x * 2.0, aPosition.y * 2.0);
+	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * vec4(aPosition, 0.0, 1.0);
+	vTexCoords = vec4(aTexCoords, 0.0);
+	vColor = aColor;
 }
 )";
 
@@ -514,30 +457,26 @@ void main() {
 }
 )";
 
-			constexpr char BlurFs[] = R"(
+			constexpr char DownsampleFs[] = R"(
 #ifdef GL_ES
 precision mediump float;
 #endif
 uniform sampler2D uTexture;
 uniform vec2 uPixelOffset;
-uniform vec2 uDirection;
 in vec2 vTexCoords;
 out vec4 fragColor;
 void main()
 {
-	vec4 color = vec4(0.0);
-	vec2 off1 = vec2(1.3846153846) * uPixelOffset * uDirection;
-	vec2 off2 = vec2(3.2307692308) * uPixelOffset * uDirection;
-	color += texture(uTexture, vTexCoords) * 0.2270270270;
-	color += texture(uTexture, vTexCoords + off1) * 0.3162162162;
-	color += texture(uTexture, vTexCoords - off1) * 0.3162162162;
-	color += texture(uTexture, vTexCoords + off2) * 0.0702702703;
-	color += texture(uTexture, vTexCoords - off2) * 0.0702702703;
-	fragColor = color;
+	vec4 color = texture(uTexture, vTexCoords) * 4.0;
+	color += texture(uTexture, vTexCoords - uPixelOffset);
+	color += texture(uTexture, vTexCoords + uPixelOffset);
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, -uPixelOffset.y));
+	color += texture(uTexture, vTexCoords - vec2(uPixelOffset.x, -uPixelOffset.y));
+	fragColor = color * vec4(0.125);
 }
 )";
 
-			constexpr char DownsampleFs[] = R"(
+			constexpr char UpsampleFs[] = R"(
 #ifdef GL_ES
 precision mediump float;
 #endif
@@ -547,11 +486,28 @@ in vec2 vTexCoords;
 out vec4 fragColor;
 void main()
 {
-	vec4 color = texture(uTexture, vTexCoords);
-	color += texture(uTexture, vTexCoords + vec2(0.0, uPixelOffset.y));
-	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, 0.0));
-	color += texture(uTexture, vTexCoords + uPixelOffset);
-	fragColor = vec4(0.25) * color;
+	vec4 color = texture(uTexture, vTexCoords + vec2(-uPixelOffset.x * 2.0, 0.0));
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x * 2.0, 0.0));
+	color += texture(uTexture, vTexCoords + vec2(0.0, -uPixelOffset.y * 2.0));
+	color += texture(uTexture, vTexCoords + vec2(0.0, uPixelOffset.y * 2.0));
+	color += texture(uTexture, vTexCoords + vec2(-uPixelOffset.x, uPixelOffset.y)) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, uPixelOffset.y)) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(uPixelOffset.x, -uPixelOffset.y)) * 2.0;
+	color += texture(uTexture, vTexCoords + vec2(-uPixelOffset.x, -uPixelOffset.y)) * 2.0;
+	fragColor = color * vec4(1.0 / 12.0);
+}
+)";
+
+			constexpr char CopyFs[] = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+uniform sampler2D uTexture;
+in vec2 vTexCoords;
+out vec4 fragColor;
+void main()
+{
+	fragColor = vec4(texture(uTexture, vTexCoords).rgb, 1.0);
 }
 )";
 
@@ -563,8 +519,7 @@ uniform vec2 ViewSize;
 
 uniform sampler2D uTexture;
 uniform sampler2D lightTex;
-uniform sampler2D blurHalfTex;
-uniform sampler2D blurQuarterTex;
+uniform sampler2D blurTex;
 
 uniform float ambientLight;
 uniform vec4 darknessColor;
@@ -579,14 +534,11 @@ float lightBlend(float t) {
 }
 
 void main() {
-	vec4 blur1 = texture(blurHalfTex, vTexCoords);
-	vec4 blur2 = texture(blurQuarterTex, vTexCoords);
+	vec4 blur = texture(blurTex, vTexCoords);
 
 	vec4 main = texture(uTexture, vTexCoords);
 	vec4 light = texture(lightTex, vTexCoords);
 
-	vec4 blur = (blur1 + blur2) * vec4(0.5);
-
 	float gray = dot(blur.rgb, vec3(0.299, 0.587, 0.114));
 	blur = vec4(gray, gray, gray, blur.a);
 
@@ -600,67 +552,49 @@ void main() {
 )";
 
 			_lightingShader = std::make_unique<Shader>("Lighting", Shader::LoadMode::STRING, LightingVs, LightingFs);
-			_blurShader = std::make_unique<Shader>("Blur", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, BlurFs);
+			constexpr int LightingStride = PlayerViewport::LightingRenderer::FloatsPerVertex * sizeof(float);
+			_lightingShader->setAttribute(Material::PositionAttributeName, LightingStride, 0);
+			_lightingShader->setAttribute(Material::TexCoordsAttributeName, LightingStride, 2 * sizeof(float));
+			_lightingShader->setAttribute(Material::ColorAttributeName, LightingStride, 5 * sizeof(float));
 			_downsampleShader = std::make_unique<Shader>("Downsample", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, DownsampleFs);
+			_upsampleShader = std::make_unique<Shader>("Upsample", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, UpsampleFs);
 			_combineShader = std::make_unique<Shader>("Combine", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, CombineFs);
-
-			_lightingRenderer = std::make_unique<LightingRenderer>(this);
-
+			_copyShader = std::make_unique<Shader>("Copy", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, CopyFs);
 		}
+#endif
 
-		if (notInitialized) {
-			_lightingBuffer = std::make_unique<Texture>(nullptr, Texture::Format::RG8, w, h);
-			_lightingView = std::make_unique<Viewport>(_lightingBuffer.get(), Viewport::DepthStencilFormat::NONE);
-			_lightingView->setRootNode(_lightingRenderer.get());
-			_lightingView->setCamera(_camera.get());
-		} else {
-			_lightingView->removeAllTextures();
-			_lightingBuffer->init(nullptr, Texture::Format::RG8, w, h);
-			_lightingView->setTexture(_lightingBuffer.get());
-		}
-
-		_lightingBuffer->setMagFiltering(SamplerFilter::Nearest);
-
-		_downsamplePass.Initialize(_viewTexture.get(), w / 2, h / 2, Vector2f::Zero);
-		_blurPass1.Initialize(_downsamplePass.GetTarget(), w / 2, h / 2, Vector2f(1.0f, 0.0f));
-		_blurPass2.Initialize(_blurPass1.GetTarget(), w / 2, h / 2, Vector2f(0.0f, 1.0f));
-		_blurPass3.Initialize(_blurPass2.GetTarget(), w / 4, h / 4, Vector2f(1.0f, 0.0f));
-		_blurPass4.Initialize(_blurPass3.GetTarget(), w / 4, h / 4, Vector2f(0.0f, 1.0f));
-
-		// Viewports must be registered in reverse order
-		_blurPass4.Register();
-		_blurPass3.Register();
-		_blurPass2.Register();
-		_blurPass1.Register();
-		_downsamplePass.Register();
-
-		Viewport::chain().push_back(_lightingView.get());
-
-		if (notInitialized) {
-			SceneNode& rootNode = theApplication().rootNode();
-			_viewSprite = std::make_unique<CombineRenderer>(this);
-			_viewSprite->setParent(&rootNode);
+		// Each player has its own viewport, the screen is split horizontally for two players and into quarters for more
+		int viewportCount = std::max((int)_players.size(), 1);
+		while ((int)_playerViewports.size() < viewportCount) {
+			int index = (int)_playerViewports.size();
+			_playerViewports.emplace_back(std::make_unique<PlayerViewport>(this, index < (int)_players.size() ? _players[index] : nullptr));
 		}
 
-		_viewSprite->Initialize();
-#else
-		if (notInitialized) {
-			SceneNode& rootNode = theApplication().rootNode();
-			_viewSprite = std::make_unique<Sprite>(&rootNode, _viewTexture.get(), 0.0f, 0.0f);
+		int columns = (viewportCount > 2 ? 2 : 1);
+		int rows = (viewportCount > 1 ? 2 : 1);
+		int viewportWidth = width / columns;
+		int viewportHeight = height / rows;
+		for (int i = 0; i < viewportCount; i++) {
+			Recti bounds((i % columns) * viewportWidth, (i / columns) * viewportHeight, viewportWidth, viewportHeight);
+			_playerViewports[i]->Initialize(bounds, Vector2i(width, height));
 		}
 
-		_viewSprite->setBlendingEnabled(false);
-#endif
-		_viewSprite->setSize((float)width, (float)height);
-		_viewSprite->setPosition(0, 0);
-
-		Viewport::chain().push_back(_view.get());
-
 		if (_tileMap != nullptr) {
 			_tileMap->OnInitializeViewport(width, height);
 		}
 	}
 
+	int LevelHandler::GetCurrentViewportIndex() const
+	{
+		const Viewport* currentViewport = RenderResources::currentViewport();
+		for (int i = 0; i < (int)_playerViewports.size(); i++) {
+			if (_playerViewports[i]->_view.get() == currentViewport) {
+				return i;
+			}
+		}
+		return 0;
+	}
+
 	void LevelHandler::OnKeyPressed(const KeyboardEvent& event)
 	{
 		// TODO
@@ -719,19 +653,40 @@ void main() {
 
 	void LevelHandler::AddActor(const std::shared_ptr<ActorBase>& actor)
 	{
-		actor->SetParent(_rootNode.get());
+		actor->SetParent(_actorsRoot.get());
 
 		if ((actor->CollisionFlags & CollisionFlags::ForceDisableCollisions) != CollisionFlags::ForceDisableCollisions) {
 			actor->UpdateAABB();
 			actor->CollisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
 		}
 
-		_actors.emplace_back(actor);
+		actor->RendererProxyID = _cullingTree.CreateProxy(GetRendererBounds(actor.get()), actor.get());
+
+		ActorHandle handle = _actors.Add(actor);
+
+		if ((actor->_flags & (ActorFlags::IsCreatedFromEventMap | ActorFlags::IsFromGenerator)) != ActorFlags::None && !_deactivationBuckets.empty()) {
+			_deactivationBuckets[GetDeactivationBucket(actor->_originTile)].push_back(handle);
+
+			const Vector2i& origin = actor->_originTile;
+			if (origin.X < _deactivationRange.L || origin.Y < _deactivationRange.T || origin.X > _deactivationRange.R || origin.Y > _deactivationRange.B) {
+				_deactivationPending.push_back(handle);
+			}
+		}
+	}
+
+	ActorBase* LevelHandler::GetActor(ActorHandle handle)
+	{
+		return _actors.Get(handle);
 	}
 
 	const std::shared_ptr<AudioBufferPlayer>& LevelHandler::PlaySfx(AudioBuffer* buffer, const Vector3f& pos, float gain, float pitch)
 	{
-		auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(buffer));
+		Vector2f listenerPos = (!_playerViewports.empty() ? _playerViewports[0]->_cameraPos : Vector2f::Zero);
+		auto& player = _sfxVoices.Acquire(buffer, SfxCategory::Actor, Vector3f(pos.X, pos.Y, 0.0f), Vector3f(listenerPos.X, listenerPos.Y, 0.0f));
+		if (player == nullptr) {
+			return player;
+		}
+
 		//player->setPosition(Vector3f((pos.X - _cameraPos.X) / (DefaultWidth * 3), (pos.Y - _cameraPos.Y) / (DefaultHeight * 3), 0.8f));
 		player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
 		player->setGain(gain);
@@ -752,7 +707,12 @@ void main() {
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _commonResources->Sounds.end()) {
 			int idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (int)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(it->second.Buffers[idx].get()));
+			Vector2f listenerPos = (!_playerViewports.empty() ? _playerViewports[0]->_cameraPos : Vector2f::Zero);
+			auto& player = _sfxVoices.Acquire(it->second.Buffers[idx].get(), SfxCategory::Common, Vector3f(pos.X, pos.Y, 0.0f), Vector3f(listenerPos.X, listenerPos.Y, 0.0f));
+			if (player == nullptr) {
+				return player;
+			}
+
 			//player->setPosition(Vector3f((pos.X - _cameraPos.X) / (DefaultWidth * 3), (pos.Y - _cameraPos.Y) / (DefaultHeight * 3), 0.8f));
 			player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
 			player->setGain(gain);
@@ -768,24 +728,26 @@ void main() {
 			return player;
 		} else {
 			LOGE_X("Sound effect \"%s\" was not found", identifier.data());
-			return std::shared_ptr<AudioBufferPlayer>(nullptr);
+			static const std::shared_ptr<AudioBufferPlayer> NoSound;
+			return NoSound;
 		}
 	}
 
 	void LevelHandler::WarpCameraToTarget(const std::shared_ptr<ActorBase>& actor)
 	{
-		// TODO: Allow multiple cameras
-		if (_players[0] != actor.get()) {
-			return;
-		}
+		for (auto& viewport : _playerViewports) {
+			if (viewport->_targetPlayer != actor.get()) {
+				continue;
+			}
 
-		Vector2f focusPos = actor->_pos;
+			Vector2f focusPos = actor->_pos;
 
-		_cameraPos.X = focusPos.X;
-		_cameraPos.Y = focusPos.Y;
-		_cameraLastPos = _cameraPos;
-		_cameraDistanceFactor.X = 0.0f;
-		_cameraDistanceFactor.Y = 0.0f;
+			viewport->_cameraPos.X = focusPos.X;
+			viewport->_cameraPos.Y = focusPos.Y;
+			viewport->_cameraLastPos = viewport->_cameraPos;
+			viewport->_cameraDistanceFactor.X = 0.0f;
+			viewport->_cameraDistanceFactor.Y = 0.0f;
+		}
 	}
 
 	bool LevelHandler::IsPositionEmpty(ActorBase* self, const AABBf& aabb, bool downwards, __out ActorBase** collider)
@@ -834,13 +796,13 @@ void main() {
 		return (*collider == nullptr);
 	}
 
-	void LevelHandler::FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const std::function<bool(ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback)
 	{
 		struct QueryHelper {
 			const LevelHandler* LevelHandler;
 			const ActorBase* Self;
 			const AABBf& AABB;
-			const std::function<bool(ActorBase*)>& Callback;
+			const FrameFunction<bool(ActorBase*)>& Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				ActorBase* actor = (ActorBase*)LevelHandler->_collisions.GetUserData(nodeId);
@@ -858,7 +820,7 @@ void main() {
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(ActorBase*)>& callback)
+	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, const FrameFunction<bool(ActorBase*)>& callback)
 	{
 		AABBf aabb = AABBf(x - radius, y - radius, x + radius, y + radius);
 		float radiusSquared = (radius * radius);
@@ -867,7 +829,7 @@ void main() {
 			const LevelHandler* LevelHandler;
 			const float x, y;
 			const float RadiusSquared;
-			const std::function<bool(ActorBase*)>& Callback;
+			const FrameFunction<bool(ActorBase*)>& Callback;
 
 			bool OnCollisionQuery(int32_t nodeId) {
 				ActorBase* actor = (ActorBase*)LevelHandler->_collisions.GetUserData(nodeId);
@@ -897,7 +859,7 @@ void main() {
 		_collisions.Query(&helper, aabb);
 	}
 
-	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, const std::function<bool(ActorBase*)> callback)
+	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback)
 	{
 		for (auto& player : _players) {
 			if (aabb.Overlaps(player->AABB)) {
@@ -1001,22 +963,22 @@ void main() {
 
 	__success(return) bool LevelHandler::PlayerActionPressed(int index, PlayerActions action, bool includeGamepads, __out bool& isGamepad)
 	{
-		// TODO
-		if (index != 0) {
+		isGamepad = false;
+		if (index < 0 || index >= LevelInitialization::MaxPlayerCount) {
 			return false;
 		}
 
-		isGamepad = false;
-		if ((_pressedActions & (1 << (int)action)) != 0) {
+		if ((_pressedActions[index] & (1 << (int)action)) != 0) {
 			return true;
 		}
 		
 		if (includeGamepads) {
+			const Vector2f& movement = _playerRequiredMovement[index];
 			switch (action) {
-				case PlayerActions::Left: if (_playerRequiredMovement.X < -0.8f) { isGamepad = true; return true; } break;
-				case PlayerActions::Right: if (_playerRequiredMovement.X > 0.8f) { isGamepad = true; return true; } break;
-				case PlayerActions::Up: if (_playerRequiredMovement.Y < -0.8f) { isGamepad = true; return true; } break;
-				case PlayerActions::Down: if (_playerRequiredMovement.Y > 0.8f) { isGamepad = true; return true; } break;
+				case PlayerActions::Left: if (movement.X < -0.8f) { isGamepad = true; return true; } break;
+				case PlayerActions::Right: if (movement.X > 0.8f) { isGamepad = true; return true; } break;
+				case PlayerActions::Up: if (movement.Y < -0.8f) { isGamepad = true; return true; } break;
+				case PlayerActions::Down: if (movement.Y > 0.8f) { isGamepad = true; return true; } break;
 			}
 		}
 
@@ -1031,13 +993,12 @@ void main() {
 
 	__success(return) bool LevelHandler::PlayerActionHit(int index, PlayerActions action, bool includeGamepads, __out bool& isGamepad)
 	{
-		// TODO
-		if (index != 0) {
+		isGamepad = false;
+		if (index < 0 || index >= LevelInitialization::MaxPlayerCount) {
 			return false;
 		}
 
-		isGamepad = false;
-		if ((_pressedActions & ((1 << (int)action) | (1 << (16 + (int)action)))) == (1 << (int)action)) {
+		if ((_pressedActions[index] & ((1 << (int)action) | (1 << (16 + (int)action)))) == (1 << (int)action)) {
 			return true;
 		}
 
@@ -1046,34 +1007,32 @@ void main() {
 
 	float LevelHandler::PlayerHorizontalMovement(int index)
 	{
-		// TODO
-		if (index != 0) {
+		if (index < 0 || index >= LevelInitialization::MaxPlayerCount) {
 			return 0.0f;
 		}
 
-		if ((_pressedActions & (1 << (int)PlayerActions::Right)) != 0) {
+		if ((_pressedActions[index] & (1 << (int)PlayerActions::Right)) != 0) {
 			return 1.0f;
-		} else if ((_pressedActions & (1 << (int)PlayerActions::Left)) != 0) {
+		} else if ((_pressedActions[index] & (1 << (int)PlayerActions::Left)) != 0) {
 			return -1.0f;
 		}
 
-		return _playerRequiredMovement.X;
+		return _playerRequiredMovement[index].X;
 	}
 
 	float LevelHandler::PlayerVerticalMovement(int index)
 	{
-		// TODO
-		if (index != 0) {
+		if (index < 0 || index >= LevelInitialization::MaxPlayerCount) {
 			return 0.0f;
 		}
 
-		if ((_pressedActions & (1 << (int)PlayerActions::Up)) != 0) {
+		if ((_pressedActions[index] & (1 << (int)PlayerActions::Up)) != 0) {
 			return -1.0f;
-		} else if ((_pressedActions & (1 << (int)PlayerActions::Down)) != 0) {
+		} else if ((_pressedActions[index] & (1 << (int)PlayerActions::Down)) != 0) {
 			return 1.0f;
 		}
 
-		return _playerRequiredMovement.Y;
+		return _playerRequiredMovement[index].Y;
 	}
 
 	void LevelHandler::PlayerFreezeMovement(int index, bool enable)
@@ -1081,35 +1040,88 @@ void main() {
 		// TODO
 	}
 
-	void LevelHandler::ResolveCollisions(float timeMult)
+	void LevelHandler::DeactivateDistantActors(const AABBi& range)
 	{
-		auto actor = _actors.begin();
-		while (actor != _actors.end()) {
-			if (((*actor)->CollisionFlags & CollisionFlags::IsDestroyed) == CollisionFlags::IsDestroyed) {
-				if (((*actor)->CollisionFlags & CollisionFlags::ForceDisableCollisions) != CollisionFlags::ForceDisableCollisions) {
-					_collisions.DestroyProxy((*actor)->CollisionProxyID);
-					(*actor)->CollisionProxyID = Collisions::NullNode;
+		for (ActorHandle handle : _deactivationPending) {
+			if (ActorBase* actor = _actors.Get(handle)) {
+				actor->OnTileDeactivate(range.L, range.T, range.R, range.B);
+			}
+		}
+		_deactivationPending.clear();
+
+		AABBi prevRange = _deactivationRange;
+		_deactivationRange = range;
+		if (prevRange == range || prevRange.L > prevRange.R) {
+			// Actors can leave the range only if it moved, actors added outside of it were already checked above
+			return;
+		}
+
+		// Only buckets that overlapped the previous range and aren't fully inside the new one can contain actors that just left
+		int bx1 = std::clamp(prevRange.L / DeactivationBucketSize, 0, _deactivationBucketsSize.X - 1);
+		int by1 = std::clamp(prevRange.T / DeactivationBucketSize, 0, _deactivationBucketsSize.Y - 1);
+		int bx2 = std::clamp(prevRange.R / DeactivationBucketSize, 0, _deactivationBucketsSize.X - 1);
+		int by2 = std::clamp(prevRange.B / DeactivationBucketSize, 0, _deactivationBucketsSize.Y - 1);
+
+		for (int by = by1; by <= by2; by++) {
+			for (int bx = bx1; bx <= bx2; bx++) {
+				int tx1 = bx * DeactivationBucketSize;
+				int ty1 = by * DeactivationBucketSize;
+				if (range.Contains(AABBi(tx1, ty1, tx1 + DeactivationBucketSize - 1, ty1 + DeactivationBucketSize - 1))) {
+					continue;
 				}
 
-				actor = _actors.erase(actor);
-				continue;
+				auto& bucket = _deactivationBuckets[bx + by * _deactivationBucketsSize.X];
+				for (int i = (int)bucket.size() - 1; i >= 0; i--) {
+					ActorBase* actor = _actors.Get(bucket[i]);
+					if (actor == nullptr || actor->OnTileDeactivate(range.L, range.T, range.R, range.B)) {
+						// Actor was already removed or it was just deactivated
+						bucket[i] = bucket.back();
+						bucket.pop_back();
+					}
+				}
 			}
-			
-			if (((*actor)->CollisionFlags & CollisionFlags::IsDirty) == CollisionFlags::IsDirty) {
-				if ((*actor)->CollisionProxyID == Collisions::NullNode) {
-					continue;
+		}
+	}
+
+	int LevelHandler::GetDeactivationBucket(const Vector2i& originTile) const
+	{
+		int bx = std::clamp(originTile.X / DeactivationBucketSize, 0, _deactivationBucketsSize.X - 1);
+		int by = std::clamp(originTile.Y / DeactivationBucketSize, 0, _deactivationBucketsSize.Y - 1);
+		return bx + by * _deactivationBucketsSize.X;
+	}
+
+	void LevelHandler::ResolveCollisions(float timeMult)
+	{
+		// Destroyed actors are compacted out in a single pass instead of erasing them one by one
+		_actors.RemoveAll([&](const std::shared_ptr<ActorBase>& actor) {
+			if ((actor->CollisionFlags & CollisionFlags::IsDestroyed) == CollisionFlags::IsDestroyed) {
+				if (actor->CollisionProxyID != Collisions::NullNode) {
+					_collisions.DestroyProxy(actor->CollisionProxyID);
+					actor->CollisionProxyID = Collisions::NullNode;
+				}
+				if (actor->RendererProxyID != Collisions::NullNode) {
+					_cullingTree.DestroyProxy(actor->RendererProxyID);
+					actor->RendererProxyID = Collisions::NullNode;
 				}
+				return true;
+			}
+
+			// Renderers were already transformed in this frame, the proxy is moved only if it left its fat AABB
+			if (actor->RendererProxyID != Collisions::NullNode) {
+				_cullingTree.MoveProxy(actor->RendererProxyID, GetRendererBounds(actor.get()), actor->_speed * timeMult);
+			}
 
-				(*actor)->UpdateAABB();
-				_collisions.MoveProxy((*actor)->CollisionProxyID, (*actor)->AABB, (*actor)->_speed * timeMult);
-				(*actor)->CollisionFlags &= ~CollisionFlags::IsDirty;
+			if ((actor->CollisionFlags & CollisionFlags::IsDirty) == CollisionFlags::IsDirty && actor->CollisionProxyID != Collisions::NullNode) {
+				actor->UpdateAABB();
+				_collisions.MoveProxy(actor->CollisionProxyID, actor->AABB, actor->_speed * timeMult);
+				actor->CollisionFlags &= ~CollisionFlags::IsDirty;
 
 #if _DEBUG
 				_debugActorDirtyCount++;
 #endif
 			}
-			++actor;
-		}
+			return false;
+		});
 
 		struct UpdatePairsHelper {
 			void OnPairAdded(void* proxyA, void* proxyB) {
@@ -1137,42 +1149,21 @@ void main() {
 		_collisions.UpdatePairs(&helper);
 	}
 
-	void LevelHandler::InitializeCamera()
+	AABBf LevelHandler::GetRendererBounds(ActorBase* actor)
 	{
-		if (_players.empty()) {
-			return;
-		}
-
-		auto targetObj = _players[0];
-
-		// The position to focus on
-		Vector2f focusPos = targetObj->_pos;
-		Vector2i halfView = _view->size() / 2;
-
-		// Clamp camera position to level bounds
-		if (_viewBounds.W > halfView.X * 2) {
-			_cameraPos.X = std::round(std::clamp(focusPos.X, _viewBounds.X + halfView.X, _viewBounds.X + _viewBounds.W - halfView.X));
-		} else {
-			_cameraPos.X = std::round(_viewBounds.X + _viewBounds.W * 0.5f);
-		}
-		if (_viewBounds.H > halfView.Y * 2) {
-			_cameraPos.Y = std::round(std::clamp(focusPos.Y, _viewBounds.Y + halfView.Y, _viewBounds.Y + _viewBounds.H - halfView.Y));
-		} else {
-			_cameraPos.Y = std::round(_viewBounds.Y + _viewBounds.H * 0.5f);
+		Rectf aabb = actor->_renderer.GetUpdatedAabb();
+		if (aabb.W == 0.0f || aabb.H == 0.0f) {
+			// Bounds are not calculated until the renderer is updated for the first time
+			return AABBf(actor->_pos.X, actor->_pos.Y, actor->_pos.X, actor->_pos.Y);
 		}
 
-		_cameraLastPos = _cameraPos;
-		_camera->setView(_cameraPos, 0.0f, 1.0f);
+		Vector2f min = aabb.Min();
+		Vector2f max = aabb.Max();
+		return AABBf(min.X, min.Y, max.X, max.Y);
 	}
 
-	void LevelHandler::UpdateCamera(float timeMult)
+	void LevelHandler::UpdateCameras(float timeMult)
 	{
-		if (_players.empty()) {
-			return;
-		}
-
-		auto targetObj = _players[0];
-
 		// View Bounds Animation
 		if (_viewBounds != _viewBoundsTarget) {
 			if (std::abs(_viewBounds.X - _viewBoundsTarget.X) < 2.0f) {
@@ -1185,149 +1176,419 @@ void main() {
 			}
 		}
 
-		// The position to focus on
-		Vector2f focusPos = targetObj->_pos;
-
-		_cameraLastPos.X = lerp(_cameraLastPos.X, focusPos.X, 0.5f * timeMult);
-		_cameraLastPos.Y = lerp(_cameraLastPos.Y, focusPos.Y, 0.5f * timeMult);
+		for (auto& viewport : _playerViewports) {
+			viewport->UpdateCamera(timeMult);
+		}
 
-		Vector2i halfView = _view->size() / 2;
+		// Update audio listener position, there is only one listener, so it follows the first player
+		if (!_playerViewports.empty() && _playerViewports[0]->_targetPlayer != nullptr) {
+			const PlayerViewport& viewport = *_playerViewports[0];
+			Vector2f speed = viewport._targetPlayer->GetSpeed();
+			IAudioDevice& device = theServiceLocator().audioDevice();
+			device.updateListener(Vector3f(viewport._cameraPos.X, viewport._cameraPos.Y, 0.0f), Vector3f(speed.X, speed.Y, 0.0f));
+		}
+	}
 
-		Vector2f speed = targetObj->_speed;
-		_cameraDistanceFactor.X = lerp(_cameraDistanceFactor.X, speed.X * 8.0f, 0.2f * timeMult);
-		_cameraDistanceFactor.Y = lerp(_cameraDistanceFactor.Y, speed.Y * 5.0f, 0.04f * timeMult);
+#if ENABLE_POSTPROCESSING
+	void LevelHandler::CollectLights()
+	{
+		_emittedLights.clear();
 
-		if (_shakeDuration > 0.0f) {
-			_shakeDuration -= timeMult;
+		// Only actors near any view are asked for lights, the broadphase tree is used to find them
+		struct QueryHelper {
+			const LevelHandler* LevelHandler;
+			Array<ActorBase*>& Actors;
 
-			if (_shakeDuration <= 0.0f) {
-				_shakeOffset = Vector2f::Zero;
-			} else {
-				float shakeFactor = 0.1f * timeMult;
-				_shakeOffset.X = lerp(_shakeOffset.X, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.X, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
-				_shakeOffset.Y = lerp(_shakeOffset.Y, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.Y, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
+			bool OnCollisionQuery(int32_t nodeId) {
+				arrayAppend<ArrayFrameAllocator>(Actors, (ActorBase*)LevelHandler->_collisions.GetUserData(nodeId));
+				return true;
 			}
-		}
+		};
 
-		// Clamp camera position to level bounds
-		if (_viewBounds.W > halfView.X * 2) {
-			_cameraPos.X = std::round(std::clamp(_cameraLastPos.X + _cameraDistanceFactor.X, _viewBounds.X + halfView.X, _viewBounds.X + _viewBounds.W - halfView.X) + _shakeOffset.X);
-		} else {
-			_cameraPos.X = std::round(_viewBounds.X + _viewBounds.W * 0.5f + _shakeOffset.X);
+		// Found actors are needed only during this frame, so they are collected in the frame arena
+		Array<ActorBase*> lightEmitters;
+		QueryHelper helper = { this, lightEmitters };
+		// Query bounds are extended by the largest reach of lights, so no light touching any view is missed
+		for (auto& viewport : _playerViewports) {
+			AABBf viewBounds = viewport->GetViewBounds();
+			AABBf queryBounds(viewBounds.L - ActorBase::MaxLightReach, viewBounds.T - ActorBase::MaxLightReach,
+				viewBounds.R + ActorBase::MaxLightReach, viewBounds.B + ActorBase::MaxLightReach);
+			_collisions.Query(&helper, queryBounds);
 		}
-		if (_viewBounds.H > halfView.Y * 2) {
-			_cameraPos.Y = std::round(std::clamp(_cameraLastPos.Y + _cameraDistanceFactor.Y, _viewBounds.Y + halfView.Y, _viewBounds.Y + _viewBounds.H - halfView.Y) + _shakeOffset.Y);
-		} else {
-			_cameraPos.Y = std::round(_viewBounds.Y + _viewBounds.H * 0.5f + _shakeOffset.Y);
+
+		// Views of multiple players can overlap, but each actor must emit its lights only once
+		std::size_t emitterCount = lightEmitters.size();
+		if (_playerViewports.size() > 1) {
+			std::sort(lightEmitters.begin(), lightEmitters.end());
+			emitterCount = std::unique(lightEmitters.begin(), lightEmitters.end()) - lightEmitters.begin();
 		}
 
-		_camera->setView(_cameraPos, 0.0f, 1.0f);
+		for (std::size_t i = 0; i < emitterCount; i++) {
+			lightEmitters[i]->OnEmitLights(_emittedLights);
+		}
 
-		// Update audio listener position
-		IAudioDevice& device = theServiceLocator().audioDevice();
-		device.updateListener(Vector3f(_cameraPos.X, _cameraPos.Y, 0.0f), Vector3f(speed.X, speed.Y, 0.0f));
+		// Actors without collisions (e.g. placed light sources) are not in the tree, so their lights are not limited by the reach
+		for (auto& actor : _actors) {
+			if (actor->CollisionProxyID == Collisions::NullNode) {
+				actor->OnEmitLights(_emittedLights);
+			}
+		}
 	}
+#endif
 
 	void LevelHandler::UpdatePressedActions()
 	{
 		auto& input = theApplication().inputManager();
 		auto& keyState = input.keyboardState();
 
-		_pressedActions = ((_pressedActions & 0xffff) << 16);
+		for (int i = 0; i < LevelInitialization::MaxPlayerCount; i++) {
+			_pressedActions[i] = ((_pressedActions[i] & 0xffff) << 16);
+			_playerRequiredMovement[i] = Vector2f::Zero;
+		}
 
+		// Keyboard always controls the first player
+		uint32_t& keyboardActions = _pressedActions[0];
 		if (keyState.isKeyDown(KeySym::LEFT)) {
-			_pressedActions |= (1 << (int)PlayerActions::Left);
+			keyboardActions |= (1 << (int)PlayerActions::Left);
 		}
 		if (keyState.isKeyDown(KeySym::RIGHT)) {
-			_pressedActions |= (1 << (int)PlayerActions::Right);
+			keyboardActions |= (1 << (int)PlayerActions::Right);
 		}
 		if (keyState.isKeyDown(KeySym::UP)) {
-			_pressedActions |= (1 << (int)PlayerActions::Up);
+			keyboardActions |= (1 << (int)PlayerActions::Up);
 		}
 		if (keyState.isKeyDown(KeySym::DOWN)) {
-			_pressedActions |= (1 << (int)PlayerActions::Down);
+			keyboardActions |= (1 << (int)PlayerActions::Down);
 		}
 		if (keyState.isKeyDown(KeySym::SPACE)) {
-			_pressedActions |= (1 << (int)PlayerActions::Fire);
+			keyboardActions |= (1 << (int)PlayerActions::Fire);
 		}
 		if (keyState.isKeyDown(KeySym::V)) {
-			_pressedActions |= (1 << (int)PlayerActions::Jump);
+			keyboardActions |= (1 << (int)PlayerActions::Jump);
 		}
 		if (keyState.isKeyDown(KeySym::C)) {
-			_pressedActions |= (1 << (int)PlayerActions::Run);
+			keyboardActions |= (1 << (int)PlayerActions::Run);
 		}
 		if (keyState.isKeyDown(KeySym::X)) {
-			_pressedActions |= (1 << (int)PlayerActions::SwitchWeapon);
+			keyboardActions |= (1 << (int)PlayerActions::SwitchWeapon);
 		}
 
-		int firstJoy = -1;
+		SmallVector<int, 4> joyIndices;
 		for (int i = 0; i < IInputManager::MaxNumJoysticks; i++) {
 			if (input.isJoyPresent(i)) {
 				const int numButtons = input.joyNumButtons(i);
 				const int numAxes = input.joyNumAxes(i);
 				if (numButtons >= 4 && numAxes >= 2) {
-					firstJoy = i;
-					break;
+					joyIndices.push_back(i);
 				}
 			}
 		}
 
-		if (firstJoy >= 0) {
-			const auto& joyState = input.joystickState(firstJoy);
+		// Gamepads are assigned to players in order, the first player shares the keyboard with a gamepad only if there are enough gamepads for everyone
+		int playerCount = std::clamp((int)_players.size(), 1, LevelInitialization::MaxPlayerCount);
+		int playerIndex = ((int)joyIndices.size() >= playerCount ? 0 : 1);
+		for (int joyIndex : joyIndices) {
+			if (playerIndex >= playerCount) {
+				break;
+			}
+
+			const auto& joyState = input.joystickState(joyIndex);
+			uint32_t& joyActions = _pressedActions[playerIndex];
+
 			if (joyState.isButtonPressed(ButtonName::DPAD_LEFT)) {
-				_pressedActions |= (1 << (int)PlayerActions::Left);
+				joyActions |= (1 << (int)PlayerActions::Left);
 			}
 			if (joyState.isButtonPressed(ButtonName::DPAD_RIGHT)) {
-				_pressedActions |= (1 << (int)PlayerActions::Right);
+				joyActions |= (1 << (int)PlayerActions::Right);
 			}
 			if (joyState.isButtonPressed(ButtonName::DPAD_UP)) {
-				_pressedActions |= (1 << (int)PlayerActions::Up);
+				joyActions |= (1 << (int)PlayerActions::Up);
 			}
 			if (joyState.isButtonPressed(ButtonName::DPAD_DOWN)) {
-				_pressedActions |= (1 << (int)PlayerActions::Down);
+				joyActions |= (1 << (int)PlayerActions::Down);
 			}
 
 			if (joyState.isButtonPressed(ButtonName::A)) {
-				_pressedActions |= (1 << (int)PlayerActions::Jump);
+				joyActions |= (1 << (int)PlayerActions::Jump);
 			}
 			if (joyState.isButtonPressed(ButtonName::B)) {
-				_pressedActions |= (1 << (int)PlayerActions::Run);
+				joyActions |= (1 << (int)PlayerActions::Run);
 			}
 			if (joyState.isButtonPressed(ButtonName::X)) {
-				_pressedActions |= (1 << (int)PlayerActions::Fire);
+				joyActions |= (1 << (int)PlayerActions::Fire);
 			}
 			if (joyState.isButtonPressed(ButtonName::Y)) {
-				_pressedActions |= (1 << (int)PlayerActions::SwitchWeapon);
+				joyActions |= (1 << (int)PlayerActions::SwitchWeapon);
+			}
+
+			_playerRequiredMovement[playerIndex].X = joyState.axisNormValue(0);
+			_playerRequiredMovement[playerIndex].Y = joyState.axisNormValue(1);
+			playerIndex++;
+		}
+
+		// Touch controls are shown only for the first player
+		_pressedActions[0] |= _overrideActions;
+	}
+
+	LevelHandler::PlayerViewport::PlayerViewport(LevelHandler* levelHandler, Actors::Player* targetPlayer)
+		: _levelHandler(levelHandler), _targetPlayer(targetPlayer),
+#if ENABLE_POSTPROCESSING
+		_postProcessingActive(true),
+#endif
+		_shakeDuration(0.0f)
+	{
+	}
+
+	void LevelHandler::PlayerViewport::Initialize(const Recti& bounds, const Vector2i& screenSize)
+	{
+		constexpr float defaultRatio = (float)DefaultWidth / DefaultHeight;
+		float currentRatio = (float)bounds.W / bounds.H;
+
+		int w, h;
+		if (currentRatio > defaultRatio) {
+			w = std::min(DefaultWidth, bounds.W);
+			h = (int)(w / currentRatio);
+		} else if (currentRatio < defaultRatio) {
+			h = std::min(DefaultHeight, bounds.H);
+			w = (int)(h * currentRatio);
+		} else {
+			w = std::min(DefaultWidth, bounds.W);
+			h = std::min(DefaultHeight, bounds.H);
+		}
+
+		bool notInitialized = (_view == nullptr);
+
+		if (notInitialized) {
+			_viewTexture = std::make_unique<Texture>(nullptr, Texture::Format::RGB8, w, h);
+			_view = std::make_unique<Viewport>(_viewTexture.get(), Viewport::DepthStencilFormat::/*DEPTH24_STENCIL8*/NONE);
+
+			_camera = std::make_unique<Camera>();
+			InitializeCamera();
+
+			_view->setCamera(_camera.get());
+			_view->setRootNode(_levelHandler->_rootNode.get());
+		} else {
+			_view->removeAllTextures();
+			_viewTexture->init(nullptr, Texture::Format::RGB8, w, h);
+			_view->setTexture(_viewTexture.get());
+		}
+
+		_viewTexture->setMagFiltering(SamplerFilter::Nearest);
+
+		_camera->setOrthoProjection(w * (-0.5f), w * (+0.5f), h * (-0.5f), h * (+0.5f));
+
+#if ENABLE_POSTPROCESSING
+		if (notInitialized) {
+			_lightingRenderer = std::make_unique<LightingRenderer>(this);
+			_lightingBuffer = std::make_unique<Texture>(nullptr, Texture::Format::RG8, w, h);
+			_lightingView = std::make_unique<Viewport>(_lightingBuffer.get(), Viewport::DepthStencilFormat::NONE);
+			_lightingView->setRootNode(_lightingRenderer.get());
+			_lightingView->setCamera(_camera.get());
+		} else {
+			_lightingView->removeAllTextures();
+			_lightingBuffer->init(nullptr, Texture::Format::RG8, w, h);
+			_lightingView->setTexture(_lightingBuffer.get());
+		}
+
+		_lightingBuffer->setMagFiltering(SamplerFilter::Nearest);
+
+		// Dual-filter blur chain, the smallest level shouldn't be just a few pixels
+		int blurLevels = _levelHandler->_blurLevels;
+		while (blurLevels > 1 && (std::min(w, h) >> blurLevels) < 4) {
+			blurLevels--;
+		}
+		while (_downsamplePasses.size() < blurLevels) {
+			_downsamplePasses.emplace_back(std::make_unique<BlurRenderPass>(this));
+		}
+		_downsamplePasses.resize(blurLevels);
+		while (_upsamplePasses.size() < blurLevels - 1) {
+			_upsamplePasses.emplace_back(std::make_unique<BlurRenderPass>(this));
+		}
+		_upsamplePasses.resize(blurLevels - 1);
+
+		Texture* blurSource = _viewTexture.get();
+		for (int i = 0; i < blurLevels; i++) {
+			_downsamplePasses[i]->Initialize(blurSource, w >> (i + 1), h >> (i + 1), false);
+			blurSource = _downsamplePasses[i]->GetTarget();
+		}
+		for (int i = blurLevels - 2; i >= 0; i--) {
+			_upsamplePasses[i]->Initialize(blurSource, w >> (i + 1), h >> (i + 1), true);
+			blurSource = _upsamplePasses[i]->GetTarget();
+		}
+
+		if (notInitialized) {
+			SceneNode& rootNode = theApplication().rootNode();
+			_viewSprite = std::make_unique<CombineRenderer>(this);
+			_viewSprite->setParent(&rootNode);
+		}
+#else
+		if (notInitialized) {
+			SceneNode& rootNode = theApplication().rootNode();
+			_viewSprite = std::make_unique<Sprite>(&rootNode, _viewTexture.get(), 0.0f, 0.0f);
+		}
+
+		_viewSprite->setBlendingEnabled(false);
+#endif
+		// Screen camera has origin in the center and Y axis pointing up
+		_viewSprite->setSize((float)bounds.W, (float)bounds.H);
+		_viewSprite->setPosition(bounds.X + bounds.W * 0.5f - screenSize.X * 0.5f, screenSize.Y * 0.5f - (bounds.Y + bounds.H * 0.5f));
+
+		Viewport::chain().push_back(_view.get());
+
+#if ENABLE_POSTPROCESSING
+		SetPostProcessingActive(_postProcessingActive);
+#endif
+	}
+
+	AABBf LevelHandler::PlayerViewport::GetViewBounds() const
+	{
+		Vector2i halfView = _viewTexture->size() / 2;
+		return AABBf(_cameraPos.X - halfView.X, _cameraPos.Y - halfView.Y, _cameraPos.X + halfView.X, _cameraPos.Y + halfView.Y);
+	}
+
+	void LevelHandler::PlayerViewport::InitializeCamera()
+	{
+		if (_targetPlayer == nullptr) {
+			return;
+		}
+
+		// The position to focus on
+		Vector2f focusPos = _targetPlayer->GetPos();
+		Vector2i halfView = _view->size() / 2;
+		const Rectf& viewBounds = _levelHandler->_viewBounds;
+
+		// Clamp camera position to level bounds
+		if (viewBounds.W > halfView.X * 2) {
+			_cameraPos.X = std::round(std::clamp(focusPos.X, viewBounds.X + halfView.X, viewBounds.X + viewBounds.W - halfView.X));
+		} else {
+			_cameraPos.X = std::round(viewBounds.X + viewBounds.W * 0.5f);
+		}
+		if (viewBounds.H > halfView.Y * 2) {
+			_cameraPos.Y = std::round(std::clamp(focusPos.Y, viewBounds.Y + halfView.Y, viewBounds.Y + viewBounds.H - halfView.Y));
+		} else {
+			_cameraPos.Y = std::round(viewBounds.Y + viewBounds.H * 0.5f);
+		}
+
+		_cameraLastPos = _cameraPos;
+		_camera->setView(_cameraPos, 0.0f, 1.0f);
+	}
+
+	void LevelHandler::PlayerViewport::UpdateCamera(float timeMult)
+	{
+		if (_targetPlayer == nullptr) {
+			return;
+		}
+
+		// The position to focus on
+		Vector2f focusPos = _targetPlayer->GetPos();
+		const Rectf& viewBounds = _levelHandler->_viewBounds;
+
+		_cameraLastPos.X = lerp(_cameraLastPos.X, focusPos.X, 0.5f * timeMult);
+		_cameraLastPos.Y = lerp(_cameraLastPos.Y, focusPos.Y, 0.5f * timeMult);
+
+		Vector2i halfView = _view->size() / 2;
+
+		Vector2f speed = _targetPlayer->GetSpeed();
+		_cameraDistanceFactor.X = lerp(_cameraDistanceFactor.X, speed.X * 8.0f, 0.2f * timeMult);
+		_cameraDistanceFactor.Y = lerp(_cameraDistanceFactor.Y, speed.Y * 5.0f, 0.04f * timeMult);
+
+		if (_shakeDuration > 0.0f) {
+			_shakeDuration -= timeMult;
+
+			if (_shakeDuration <= 0.0f) {
+				_shakeOffset = Vector2f::Zero;
+			} else {
+				float shakeFactor = 0.1f * timeMult;
+				_shakeOffset.X = lerp(_shakeOffset.X, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.X, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
+				_shakeOffset.Y = lerp(_shakeOffset.Y, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.Y, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
 			}
+		}
 
-			_playerRequiredMovement.X = joyState.axisNormValue(0);
-			_playerRequiredMovement.Y = joyState.axisNormValue(1);
+		// Clamp camera position to level bounds
+		if (viewBounds.W > halfView.X * 2) {
+			_cameraPos.X = std::round(std::clamp(_cameraLastPos.X + _cameraDistanceFactor.X, viewBounds.X + halfView.X, viewBounds.X + viewBounds.W - halfView.X) + _shakeOffset.X);
+		} else {
+			_cameraPos.X = std::round(viewBounds.X + viewBounds.W * 0.5f + _shakeOffset.X);
+		}
+		if (viewBounds.H > halfView.Y * 2) {
+			_cameraPos.Y = std::round(std::clamp(_cameraLastPos.Y + _cameraDistanceFactor.Y, viewBounds.Y + halfView.Y, viewBounds.Y + viewBounds.H - halfView.Y) + _shakeOffset.Y);
+		} else {
+			_cameraPos.Y = std::round(viewBounds.Y + viewBounds.H * 0.5f + _shakeOffset.Y);
 		}
 
-		_pressedActions |= _overrideActions;
+		_camera->setView(_cameraPos, 0.0f, 1.0f);
 	}
 
 #if ENABLE_POSTPROCESSING
-	bool LevelHandler::LightingRenderer::OnDraw(RenderQueue& renderQueue)
+	void LevelHandler::PlayerViewport::SetPostProcessingActive(bool active)
+	{
+		_postProcessingActive = active;
+
+		// Viewports are drawn in reverse order, so the passes must be at the beginning of the chain to be drawn after the level
+		SmallVector<Viewport*, MaxBlurLevels * 2> passes;
+		for (auto& pass : _upsamplePasses) {
+			passes.push_back(pass->GetViewport());
+		}
+		for (int i = (int)_downsamplePasses.size() - 1; i >= 0; i--) {
+			passes.push_back(_downsamplePasses[i]->GetViewport());
+		}
+		passes.push_back(_lightingView.get());
+
+		auto& chain = Viewport::chain();
+		for (Viewport* pass : passes) {
+			for (auto it = chain.begin(); it != chain.end(); ++it) {
+				if (*it == pass) {
+					chain.erase(it);
+					break;
+				}
+			}
+		}
+
+		if (active) {
+			chain.insert(chain.begin(), passes.begin(), passes.end());
+		}
+
+		_viewSprite->Initialize();
+	}
+
+	bool LevelHandler::PlayerViewport::LightingRenderer::OnDraw(RenderQueue& renderQueue)
 	{
 		_renderCommandsCount = 0;
 
-		// Collect all active light emitters
-		// TODO: move this to class variable
-		SmallVector<LightEmitter, 8> emittedLights;
-		for (auto& actor : _owner->_actors) {
-			actor->OnEmitLights(emittedLights);
+		// Lights were already collected by LevelHandler::OnEndFrame()
+		int lightCount = (int)_visibleLights.size();
+		if (lightCount == 0) {
+			return true;
 		}
 
-		auto viewSize = _owner->_viewTexture->size();
-		auto viewPos = _owner->_cameraPos;
-		for (auto& light : emittedLights) {
+		// Vertices must not be reallocated until the render commands are committed
+		_vertices.resize_for_overwrite(lightCount * VerticesPerLight * FloatsPerVertex);
+		float* vertices = _vertices.data();
+		for (auto& light : _visibleLights) {
+			// Two triangles covering the light, local coordinates are used to calculate the distance from the center
+			constexpr float Corners[VerticesPerLight][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { -1.0f, 1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f } };
+			float radiusRatio = light.RadiusNear / light.RadiusFar;
+			for (int i = 0; i < VerticesPerLight; i++) {
+				*vertices++ = light.Pos.X + Corners[i][0] * light.RadiusFar;
+				*vertices++ = light.Pos.Y + Corners[i][1] * light.RadiusFar;
+				*vertices++ = light.Pos.X;
+				*vertices++ = light.Pos.Y;
+				*vertices++ = radiusRatio;
+				*vertices++ = light.Intensity;
+				*vertices++ = light.Brightness;
+				*vertices++ = Corners[i][0];
+				*vertices++ = Corners[i][1];
+			}
+		}
+
+		// All lights are drawn at once, split only if they don't fit into a single vertex buffer
+		int maxLightsPerCommand = (int)(theApplication().appConfiguration().vboSize / (VerticesPerLight * FloatsPerVertex * sizeof(float)));
+		for (int firstLight = 0; firstLight < lightCount; firstLight += maxLightsPerCommand) {
+			int count = std::min(lightCount - firstLight, maxLightsPerCommand);
 			auto command = RentRenderCommand();
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(light.Pos.X, light.Pos.Y, light.RadiusNear / light.RadiusFar, 0.0f);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(light.RadiusFar * 2, light.RadiusFar * 2);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatValue(light.Intensity, light.Brightness, 0.0f, 0.0f);
-			command->setTransformation(Matrix4x4f::Translation(light.Pos.X, light.Pos.Y, 0));
+			command->geometry().setNumVertices(count * VerticesPerLight);
+			command->geometry().setHostVertexPointer(_vertices.data() + firstLight * VerticesPerLight * FloatsPerVertex);
+			command->setTransformation(Matrix4x4f::Identity);
 
 			renderQueue.addCommand(command);
 		}
@@ -1335,7 +1596,64 @@ void main() {
 		return true;
 	}
 
-	RenderCommand* LevelHandler::LightingRenderer::RentRenderCommand()
+	void LevelHandler::ActorsRoot::OnVisit(RenderQueue& renderQueue, unsigned int& visitOrderIndex)
+	{
+		if (!drawEnabled_) {
+			return;
+		}
+
+		if (!theApplication().renderingSettings().cullingEnabled) {
+			SceneNode::OnVisit(renderQueue, visitOrderIndex);
+			return;
+		}
+
+		struct QueryHelper {
+			const LevelHandler* LevelHandler;
+			SmallVectorImpl<SceneNode*>& Nodes;
+
+			bool OnCollisionQuery(int32_t nodeId) {
+				ActorBase* actor = (ActorBase*)LevelHandler->_cullingTree.GetUserData(nodeId);
+				// Viewports don't test renderers of actors, so only renderers found in the tree are culled precisely
+				actor->_renderer.UpdateCulling();
+				Nodes.push_back(&actor->_renderer);
+				return true;
+			}
+		};
+
+		// Renderers far from the view are not visited at all
+		Rectf cullingRect = RenderResources::currentViewport()->cullingRect();
+		Vector2f min = cullingRect.Min();
+		Vector2f max = cullingRect.Max();
+
+		_visibleNodes.clear();
+		QueryHelper helper = { _owner, _visibleNodes };
+		_owner->_cullingTree.Query(&helper, AABBf(min.X, min.Y, max.X, max.Y));
+
+		// Keep the order of children, so the drawing order of renderers in the same layer is stable
+		std::sort(_visibleNodes.begin(), _visibleNodes.end(), [](const SceneNode* a, const SceneNode* b) {
+			return a->childOrderIndex() < b->childOrderIndex();
+		});
+
+		for (SceneNode* node : _visibleNodes) {
+			node->OnVisit(renderQueue, visitOrderIndex);
+		}
+	}
+
+	void LevelHandler::PlayerViewport::LightingRenderer::CollectVisibleLights(const SmallVectorImpl<LightEmitter>& lights, const AABBf& viewBounds)
+	{
+		_visibleLights.clear();
+
+		// Remove lights that don't reach the view
+		for (auto& light : lights) {
+			if (light.Pos.X + light.RadiusFar >= viewBounds.L && light.Pos.X - light.RadiusFar <= viewBounds.R &&
+				light.Pos.Y + light.RadiusFar >= viewBounds.T && light.Pos.Y - light.RadiusFar <= viewBounds.B &&
+				light.RadiusFar > 0.0f) {
+				_visibleLights.push_back(light);
+			}
+		}
+	}
+
+	RenderCommand* LevelHandler::PlayerViewport::LightingRenderer::RentRenderCommand()
 	{
 		if (_renderCommandsCount < _renderCommands.size()) {
 			RenderCommand* command = _renderCommands[_renderCommandsCount].get();
@@ -1343,12 +1661,13 @@ void main() {
 			return command;
 		} else {
 			std::unique_ptr<RenderCommand>& command = _renderCommands.emplace_back(std::make_unique<RenderCommand>());
-			command->setType(RenderCommand::CommandTypes::SPRITE);
-			command->material().setShader(_owner->_lightingShader.get());
+			command->setType(RenderCommand::CommandTypes::MESH_SPRITE);
+			command->material().setShader(_owner->_levelHandler->_lightingShader.get());
 			command->material().setBlendingEnabled(true);
 			command->material().setBlendingFactors(GL_SRC_ALPHA, GL_ONE);
 			command->material().reserveUniformsDataMemory();
-			command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+			command->geometry().setDrawParameters(GL_TRIANGLES, 0, 0);
+			command->geometry().setNumElementsPerVertex(FloatsPerVertex);
 
 			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
 			if (textureUniform && textureUniform->intValue(0) != 0) {
@@ -1358,11 +1677,10 @@ void main() {
 		}
 	}
 
-	void LevelHandler::BlurRenderPass::Initialize(Texture* source, int width, int height, const Vector2f& direction)
+	void LevelHandler::PlayerViewport::BlurRenderPass::Initialize(Texture* source, int width, int height, bool upsample)
 	{
 		_source = source;
-		_downsampleOnly = (direction.X <= std::numeric_limits<float>::epsilon() && direction.Y <= std::numeric_limits<float>::epsilon());
-		_direction = direction;
+		_upsample = upsample;
 
 		bool notInitialized = (_view == nullptr);
 
@@ -1378,7 +1696,7 @@ void main() {
 			_view->setRootNode(this);
 			_view->setCamera(_camera.get());
 			_view->setClearMode(Viewport::ClearMode::NEVER);
-		} else {
+		} else if (_target->width() != width || _target->height() != height) {
 			_view->removeAllTextures();
 			_target->init(nullptr, Texture::Format::RGB8, width, height);
 			_view->setTexture(_target.get());
@@ -1387,7 +1705,7 @@ void main() {
 
 		// Prepare render command
 		_renderCommand.setType(RenderCommand::CommandTypes::SPRITE);
-		_renderCommand.material().setShader(_downsampleOnly ? _owner->_downsampleShader.get() : _owner->_blurShader.get());
+		_renderCommand.material().setShader(_upsample ? _owner->_levelHandler->_upsampleShader.get() : _owner->_levelHandler->_downsampleShader.get());
 		//_renderCommand.material().setBlendingEnabled(true);
 		_renderCommand.material().reserveUniformsDataMemory();
 		_renderCommand.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
@@ -1398,24 +1716,17 @@ void main() {
 		}
 	}
 
-	void LevelHandler::BlurRenderPass::Register()
-	{
-		Viewport::chain().push_back(_view.get());
-	}
-
-	bool LevelHandler::BlurRenderPass::OnDraw(RenderQueue& renderQueue)
+	bool LevelHandler::PlayerViewport::BlurRenderPass::OnDraw(RenderQueue& renderQueue)
 	{
 		auto size = _target->size();
 
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(size.X, size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		auto instanceBlock = _renderCommand.material().uniformBlock(_instanceHandles.block);
+		instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(1.0f, 0.0f, -1.0f, 1.0f);
+		instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(size.X, size.Y);
+		instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
-		_renderCommand.material().uniform("uPixelOffset")->setFloatValue(1.0f / size.X, 1.0f / size.Y);
-		if (!_downsampleOnly) {
-			_renderCommand.material().uniform("uDirection")->setFloatValue(_direction.X, _direction.Y);
-		}
+		// Half-pixel offset of the target, so each tap is filtered bilinearly
+		_renderCommand.material().uniform(_pixelOffsetHandle)->setFloatValue(0.5f / size.X, 0.5f / size.Y);
 		_renderCommand.material().setTexture(0, *_source);
 
 		renderQueue.addCommand(&_renderCommand);
@@ -1423,10 +1734,13 @@ void main() {
 		return true;
 	}
 
-	void LevelHandler::CombineRenderer::Initialize()
+	void LevelHandler::PlayerViewport::CombineRenderer::Initialize()
 	{
+		// View is only copied to the screen if there is nothing to combine
+		bool postProcessingActive = _owner->_postProcessingActive;
+
 		_renderCommand.setType(RenderCommand::CommandTypes::SPRITE);
-		_renderCommand.material().setShader(_owner->_combineShader.get());
+		_renderCommand.material().setShader(postProcessingActive ? _owner->_levelHandler->_combineShader.get() : _owner->_levelHandler->_copyShader.get());
 		//_renderCommand.material().setBlendingEnabled(true);
 		_renderCommand.material().reserveUniformsDataMemory();
 		_renderCommand.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
@@ -1435,31 +1749,34 @@ void main() {
 		if (textureUniform && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
 		}
-		GLUniformCache* lightTexUniform = _renderCommand.material().uniform("lightTex");
-		if (lightTexUniform && lightTexUniform->intValue(0) != 1) {
-			lightTexUniform->setIntValue(1); // GL_TEXTURE1
-		}
-		GLUniformCache* blurHalfTexUniform = _renderCommand.material().uniform("blurHalfTex");
-		if (blurHalfTexUniform && blurHalfTexUniform->intValue(0) != 2) {
-			blurHalfTexUniform->setIntValue(2); // GL_TEXTURE2
-		}
-		GLUniformCache* blurQuarterTexUniform = _renderCommand.material().uniform("blurQuarterTex");
-		if (blurQuarterTexUniform && blurQuarterTexUniform->intValue(0) != 3) {
-			blurQuarterTexUniform->setIntValue(3); // GL_TEXTURE3
+		if (postProcessingActive) {
+			GLUniformCache* lightTexUniform = _renderCommand.material().uniform("lightTex");
+			if (lightTexUniform && lightTexUniform->intValue(0) != 1) {
+				lightTexUniform->setIntValue(1); // GL_TEXTURE1
+			}
+			GLUniformCache* blurTexUniform = _renderCommand.material().uniform("blurTex");
+			if (blurTexUniform && blurTexUniform->intValue(0) != 2) {
+				blurTexUniform->setIntValue(2); // GL_TEXTURE2
+			}
 		}
 	}
 
-	bool LevelHandler::CombineRenderer::OnDraw(RenderQueue& renderQueue)
+	bool LevelHandler::PlayerViewport::CombineRenderer::OnDraw(RenderQueue& renderQueue)
 	{
 		_renderCommand.material().setTexture(0, *_owner->_viewTexture);
-		_renderCommand.material().setTexture(1, *_owner->_lightingBuffer);
-		_renderCommand.material().setTexture(2, *_owner->_blurPass2.GetTarget());
-		_renderCommand.material().setTexture(3, *_owner->_blurPass4.GetTarget());
-
-		auto instanceBlock = _renderCommand.material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(_size.X, _size.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+		if (_owner->_postProcessingActive) {
+			auto& blurPass = (_owner->_upsamplePasses.empty() ? _owner->_downsamplePasses[0] : _owner->_upsamplePasses[0]);
+			_renderCommand.material().setTexture(1, *_owner->_lightingBuffer);
+			_renderCommand.material().setTexture(2, *blurPass->GetTarget());
+		}
+
+		auto instanceBlock = _renderCommand.material().uniformBlock(_instanceHandles.block);
+		instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(_size.X, _size.Y);
+		instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+
+		// Each player has its own part of the screen
+		_renderCommand.setTransformation(worldMatrix_);
 
 		renderQueue.addCommand(&_renderCommand);
 
@@ -7,6 +7,7 @@
 #include "Events/EventSpawner.h"
 #include "Tiles/TileMap.h"
 #include "Collisions/DynamicTreeBroadPhase.h"
+#include "SfxVoicePool.h"
 
 #include "../nCine/Graphics/Shader.h"
 #include "../nCine/Graphics/ShaderState.h"
@@ -34,6 +35,11 @@ namespace Jazz2
 		static constexpr int LayerFormatVersion = 1;
 		static constexpr int EventSetVersion = 2;
 
+#if ENABLE_POSTPROCESSING
+		static constexpr int DefaultBlurLevels = 3;
+		static constexpr int MaxBlurLevels = 6;
+#endif
+
 
 		LevelHandler(IRootController* root, const LevelInitialization& levelInit);
 		~LevelHandler() override;
@@ -75,14 +81,15 @@ namespace Jazz2
 		void OnTouchUp(const nCine::TouchEvent& event) override;
 
 		void AddActor(const std::shared_ptr<ActorBase>& actor) override;
+		ActorBase* GetActor(ActorHandle handle) override;
 
 		const std::shared_ptr<AudioBufferPlayer>& PlaySfx(AudioBuffer* buffer, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		const std::shared_ptr<AudioBufferPlayer>& PlayCommonSfx(const StringView& identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(const std::shared_ptr<ActorBase>& actor) override;
 		bool IsPositionEmpty(ActorBase* self, const AABBf& aabb, bool downwards, __out ActorBase** collider) override;
-		void FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const std::function<bool(ActorBase*)>& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, const std::function<bool(ActorBase*)>& callback) override;
-		void GetCollidingPlayers(const AABBf& aabb, const std::function<bool(ActorBase*)> callback) override;
+		void FindCollisionActorsByAABB(ActorBase* self, const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback) override;
+		void FindCollisionActorsByRadius(float x, float y, float radius, const FrameFunction<bool(ActorBase*)>& callback) override;
+		void GetCollidingPlayers(const AABBf& aabb, const FrameFunction<bool(ActorBase*)>& callback) override;
 
 		void BeginLevelChange(ExitType exitType, const StringView& nextLevel) override;
 		void HandleGameOver() override;
@@ -96,112 +103,211 @@ namespace Jazz2
 		float PlayerVerticalMovement(int index) override;
 		void PlayerFreezeMovement(int index, bool enable) override;
 
-		Vector2f GetCameraPos() {
-			return _cameraPos;
-		}
+		/// Returns index of the player viewport that is being drawn, nodes shared by all viewports use it to keep view-dependent state
+		int GetCurrentViewportIndex() const;
 
-		Vector2i GetViewSize() {
-			return _view->size();
+		Vector2f GetCameraPos(int viewportIndex) const {
+			return _playerViewports[viewportIndex]->_cameraPos;
 		}
 
-	private:
-		IRootController* _root;
+		Vector2i GetViewSize(int viewportIndex) const {
+			return _playerViewports[viewportIndex]->_view->size();
+		}
 
-		std::unique_ptr<SceneNode> _rootNode;
-		std::unique_ptr<Viewport> _view;
-		std::unique_ptr<Texture> _viewTexture;
-		std::unique_ptr<Camera> _camera;
 #if ENABLE_POSTPROCESSING
-		class LightingRenderer : public SceneNode
+		/// Sets number of downsampling steps of the bloom chain, it's applied when the viewport is initialized again
+		void SetBlurLevels(int levels) {
+			_blurLevels = std::clamp(levels, 1, MaxBlurLevels);
+		}
+#endif
+
+	private:
+		/// View of one player, all viewports render the same scene, only cameras and post-processing passes are separate
+		class PlayerViewport
 		{
+			friend class LevelHandler;
+
 		public:
-			LightingRenderer(LevelHandler* owner)
-				: _owner(owner), _renderCommandsCount(0)
-			{
-			}
+			PlayerViewport(LevelHandler* levelHandler, Actors::Player* targetPlayer);
 
-			bool OnDraw(RenderQueue& renderQueue) override;
+			/// Creates or resizes render targets, bounds are in pixels of the screen with origin in the top left corner
+			void Initialize(const Recti& bounds, const Vector2i& screenSize);
 
 		private:
-			LevelHandler* _owner;
-			SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
-			int _renderCommandsCount;
+#if ENABLE_POSTPROCESSING
+			class LightingRenderer : public SceneNode
+			{
+			public:
+				/// Number of vertices emitted for each light (two triangles)
+				static constexpr int VerticesPerLight = 6;
+				/// Number of floats for each light vertex (position, light center with radius ratio, intensity with brightness and local position)
+				static constexpr int FloatsPerVertex = 9;
 
-			RenderCommand* RentRenderCommand();
-		};
+				LightingRenderer(PlayerViewport* owner)
+					: _owner(owner), _renderCommandsCount(0)
+				{
+				}
 
-		class BlurRenderPass : public SceneNode
-		{
-		public:
-			BlurRenderPass(LevelHandler* owner)
-				: _owner(owner)
-			{
-			}
+				bool OnDraw(RenderQueue& renderQueue) override;
 
-			void Initialize(Texture* source, int width, int height, const Vector2f& direction);
-			void Register();
+				/// Picks lights that reach the view from lights emitted for all viewports
+				void CollectVisibleLights(const SmallVectorImpl<LightEmitter>& lights, const AABBf& viewBounds);
 
-			bool OnDraw(RenderQueue& renderQueue) override;
+				bool HasVisibleLights() const {
+					return !_visibleLights.empty();
+				}
 
-			Texture* GetTarget() const {
-				return _target.get();
-			}
+			private:
+				PlayerViewport* _owner;
+				SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
+				int _renderCommandsCount;
+				SmallVector<LightEmitter, 0> _visibleLights;
+				SmallVector<float, 0> _vertices;
+
+				RenderCommand* RentRenderCommand();
+			};
+
+			class BlurRenderPass : public SceneNode
+			{
+			public:
+				BlurRenderPass(PlayerViewport* owner)
+					: _owner(owner), _pixelOffsetHandle("uPixelOffset")
+				{
+				}
+
+				void Initialize(Texture* source, int width, int height, bool upsample);
+
+				bool OnDraw(RenderQueue& renderQueue) override;
+
+				Texture* GetTarget() const {
+					return _target.get();
+				}
+
+				Viewport* GetViewport() const {
+					return _view.get();
+				}
+
+			private:
+				PlayerViewport* _owner;
+				std::unique_ptr<Texture> _target;
+				std::unique_ptr<Viewport> _view;
+				std::unique_ptr<Camera> _camera;
+				RenderCommand _renderCommand;
+				InstanceBlockHandles _instanceHandles;
+				GLUniformHandle _pixelOffsetHandle;
+
+				Texture* _source;
+				bool _upsample;
+			};
+
+			class CombineRenderer : public SceneNode
+			{
+			public:
+				CombineRenderer(PlayerViewport* owner)
+					: _owner(owner)
+				{
+				}
+
+				void Initialize();
+
+				bool OnDraw(RenderQueue& renderQueue) override;
+
+				void setSize(float width, float height) {
+					_size.X = width;
+					_size.Y = height;
+				}
+
+			private:
+				PlayerViewport* _owner;
+				RenderCommand _renderCommand;
+				InstanceBlockHandles _instanceHandles;
+				Vector2f _size;
+			};
+#endif
+
+			LevelHandler* _levelHandler;
+			Actors::Player* _targetPlayer;
 
-		private:
-			LevelHandler* _owner;
-			std::unique_ptr<Texture> _target;
 			std::unique_ptr<Viewport> _view;
+			std::unique_ptr<Texture> _viewTexture;
 			std::unique_ptr<Camera> _camera;
-			RenderCommand _renderCommand;
+#if ENABLE_POSTPROCESSING
+			std::unique_ptr<LightingRenderer> _lightingRenderer;
+			std::unique_ptr<CombineRenderer> _viewSprite;
+			std::unique_ptr<Viewport> _lightingView;
+			std::unique_ptr<Texture> _lightingBuffer;
+
+			/// Each downsample pass halves the resolution, upsample passes go back up to half of the view size
+			SmallVector<std::unique_ptr<BlurRenderPass>, 0> _downsamplePasses;
+			SmallVector<std::unique_ptr<BlurRenderPass>, 0> _upsamplePasses;
+			bool _postProcessingActive;
+#else
+			std::unique_ptr<Sprite> _viewSprite;
+#endif
+
+			Vector2f _cameraPos;
+			Vector2f _cameraLastPos;
+			Vector2f _cameraDistanceFactor;
+			float _shakeDuration;
+			Vector2f _shakeOffset;
 
-			Texture* _source;
-			bool _downsampleOnly;
-			Vector2f _direction;
+			AABBf GetViewBounds() const;
+			void InitializeCamera();
+			void UpdateCamera(float timeMult);
+#if ENABLE_POSTPROCESSING
+			void SetPostProcessingActive(bool active);
+#endif
 		};
 
-		class CombineRenderer : public SceneNode
+		IRootController* _root;
+
+		std::unique_ptr<SceneNode> _rootNode;
+		/// One viewport for each player, the screen is split between them
+		SmallVector<std::unique_ptr<PlayerViewport>, LevelInitialization::MaxPlayerCount> _playerViewports;
+#if ENABLE_POSTPROCESSING
+		std::unique_ptr<Shader> _lightingShader;
+		std::unique_ptr<Shader> _downsampleShader;
+		std::unique_ptr<Shader> _upsampleShader;
+		std::unique_ptr<Shader> _combineShader;
+		std::unique_ptr<Shader> _copyShader;
+
+		/// Lights emitted by actors near any viewport, each actor emits only once per frame
+		SmallVector<LightEmitter, 0> _emittedLights;
+		int _blurLevels;
+#endif
+
+		/// Parent of all actor renderers, only renderers that overlap the culling rect of the viewport are visited
+		class ActorsRoot : public SceneNode
 		{
 		public:
-			CombineRenderer(LevelHandler* owner)
+			ActorsRoot(LevelHandler* owner)
 				: _owner(owner)
 			{
+				cullsChildren_ = true;
 			}
 
-			void Initialize();
-
-			bool OnDraw(RenderQueue& renderQueue) override;
-
-			void setSize(float width, float height) {
-				_size.X = width;
-				_size.Y = height;
-			}
+			void OnVisit(RenderQueue& renderQueue, unsigned int& visitOrderIndex) override;
 
 		private:
 			LevelHandler* _owner;
-			RenderCommand _renderCommand;
-			Vector2f _size;
+			SmallVector<SceneNode*, 0> _visibleNodes;
 		};
 
-		std::unique_ptr<LightingRenderer> _lightingRenderer;
-		std::unique_ptr<CombineRenderer> _viewSprite;
-		std::unique_ptr<Viewport> _lightingView;
-		std::unique_ptr<Texture> _lightingBuffer;
-
-		std::unique_ptr<Shader> _lightingShader;
-		std::unique_ptr<Shader> _blurShader;
-		std::unique_ptr<Shader> _downsampleShader;
-		std::unique_ptr<Shader> _combineShader;
-		
-		BlurRenderPass _downsamplePass;
-		BlurRenderPass _blurPass2;
-		BlurRenderPass _blurPass1;
-		BlurRenderPass _blurPass3;
-		BlurRenderPass _blurPass4;
-#else
-		std::unique_ptr<Sprite> _viewSprite;
-#endif
-
-		SmallVector<std::shared_ptr<ActorBase>, 0> _actors;
+		/// Must be destroyed after all actors, because their renderers are its children
+		std::unique_ptr<ActorsRoot> _actorsRoot;
+		/// Renderers of all actors indexed by their bounds, even of those without collisions
+		Collisions::DynamicTree _cullingTree;
+
+		ActorStore _actors;
+		/// Size of deactivation buckets in tiles
+		static constexpr int DeactivationBucketSize = 8;
+
+		/// Actors created from the event map bucketed by their origin tile, only buckets at the edge of the activation range are checked for deactivation
+		SmallVector<SmallVector<ActorHandle, 0>, 0> _deactivationBuckets;
+		Vector2i _deactivationBucketsSize;
+		/// Actors that were added outside the last deactivation range
+		SmallVector<ActorHandle, 0> _deactivationPending;
+		AABBi _deactivationRange;
 		SmallVector<Actors::Player*, LevelInitialization::MaxPlayerCount> _players;
 
 		String _levelFileName;
@@ -218,30 +324,33 @@ namespace Jazz2
 		std::unique_ptr<Tiles::TileMap> _tileMap;
 		Collisions::DynamicTreeBroadPhase _collisions;
 
+		/// Area of the level the cameras of all viewports are limited to
 		Rectf _viewBounds;
 		Rectf _viewBoundsTarget;
-		Vector2f _cameraPos;
-		Vector2f _cameraLastPos;
-		Vector2f _cameraDistanceFactor;
-		float _shakeDuration;
-		Vector2f _shakeOffset;
 		float _waterLevel;
 		float _ambientLightDefault, _ambientLightCurrent, _ambientLightTarget;
 		std::unique_ptr<AudioStreamPlayer> _music;
-		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
+		SfxVoicePool _sfxVoices;
 		Metadata* _commonResources;
 
-		uint32_t _pressedActions;
+		/// Actions of each player in the lower half, actions from the previous frame in the upper half
+		uint32_t _pressedActions[LevelInitialization::MaxPlayerCount];
+		/// Actions from touch controls, they are merged into actions of the first player
 		uint32_t _overrideActions;
-		Vector2f _playerRequiredMovement;
+		Vector2f _playerRequiredMovement[LevelInitialization::MaxPlayerCount];
 
 		void OnLevelLoaded(const StringView& name, const StringView& nextLevel, const StringView& secretLevel,
 			std::unique_ptr<Tiles::TileMap>& tileMap, std::unique_ptr<Events::EventMap>& eventMap,
 			const StringView& musicPath, float ambientLight);
 
 		void ResolveCollisions(float timeMult);
-		void InitializeCamera();
-		void UpdateCamera(float timeMult);
+		static AABBf GetRendererBounds(ActorBase* actor);
+		void DeactivateDistantActors(const AABBi& range);
+		int GetDeactivationBucket(const Vector2i& originTile) const;
+		void UpdateCameras(float timeMult);
+#if ENABLE_POSTPROCESSING
+		void CollectLights();
+#endif
 		void UpdatePressedActions();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+﻿#include "SfxVoicePool.h"
+
+#include "../nCine/ServiceLocator.h"
+
+namespace Jazz2
+{
+	namespace
+	{
+		const std::shared_ptr<AudioBufferPlayer> NoVoice;
+
+		/// Number of sources reserved for streamed music and other players outside of the pool
+		constexpr uint32_t ReservedSources = 4;
+
+		inline float DistanceSquared(const Vector3f& a, const Vector3f& b)
+		{
+			float dx = a.X - b.X;
+			float dy = a.Y - b.Y;
+			return dx * dx + dy * dy;
+		}
+	}
+
+	SfxVoicePool::SfxVoicePool()
+	{
+		uint32_t maxPlayers = theServiceLocator().audioDevice().maxNumPlayers();
+		_maxVoices = (maxPlayers > ReservedSources * 2 ? maxPlayers - ReservedSources : maxPlayers / 2);
+		_categoryLimits[(int)SfxCategory::Actor] = _maxVoices * 3 / 4;
+		_categoryLimits[(int)SfxCategory::Common] = _maxVoices / 4;
+
+		_active.reserve(_maxVoices);
+		_free.reserve(_maxVoices);
+	}
+
+	const std::shared_ptr<AudioBufferPlayer>& SfxVoicePool::Acquire(AudioBuffer* buffer, SfxCategory category, const Vector3f& pos, const Vector3f& listenerPos)
+	{
+		if (_maxVoices == 0) {
+			return NoVoice;
+		}
+
+		uint32_t instanceCount = 0;
+		uint32_t categoryCount = 0;
+		for (const Voice& voice : _active) {
+			if (voice.Buffer == buffer) {
+				instanceCount++;
+			}
+			if (voice.Category == category) {
+				categoryCount++;
+			}
+		}
+
+		float distance = DistanceSquared(pos, listenerPos);
+		int32_t stealIndex = -1;
+		if (instanceCount >= MaxInstancesPerSound) {
+			stealIndex = FindVoiceToSteal(buffer, category, distance, listenerPos, true, false);
+		} else if (categoryCount >= _categoryLimits[(int)category]) {
+			stealIndex = FindVoiceToSteal(buffer, category, distance, listenerPos, false, true);
+		} else if (_active.size() >= _maxVoices) {
+			stealIndex = FindVoiceToSteal(buffer, category, distance, listenerPos, false, false);
+		} else {
+			// There is still a free slot
+			stealIndex = INT32_MAX;
+		}
+
+		if (stealIndex < 0) {
+			// Every candidate is closer to the listener than the new sound, so drop the new one instead
+			return NoVoice;
+		}
+		if (stealIndex != INT32_MAX) {
+			_active[stealIndex].Player->stop();
+			Release(stealIndex);
+		}
+
+		std::shared_ptr<AudioBufferPlayer> player;
+		if (!_free.empty()) {
+			player = _free.pop_back_val();
+			player->setAudioBuffer(buffer);
+		} else {
+			player = std::make_shared<AudioBufferPlayer>(buffer);
+		}
+
+		// Restore default state of a recycled voice
+		player->setLooping(false);
+		player->setLowPass(1.0f);
+		player->setPitch(1.0f);
+		player->setGain(1.0f);
+
+		Voice& voice = _active.emplace_back();
+		voice.Player = std::move(player);
+		voice.Buffer = buffer;
+		voice.Category = category;
+		return voice.Player;
+	}
+
+	void SfxVoicePool::Update()
+	{
+		uint32_t count = (uint32_t)_active.size();
+		uint32_t target = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			Voice& voice = _active[i];
+			if (voice.Player->state() == IAudioPlayer::PlayerState::Stopped) {
+				// Voices still referenced by an actor cannot be reused yet, they are just dropped
+				if (voice.Player.use_count() == 1 && _free.size() < _maxVoices) {
+					_free.push_back(std::move(voice.Player));
+				}
+				continue;
+			}
+			if (target != i) {
+				_active[target] = std::move(voice);
+			}
+			target++;
+		}
+
+		if (target != count) {
+			_active.erase(_active.begin() + target, _active.end());
+		}
+	}
+
+	void SfxVoicePool::StopAll()
+	{
+		for (Voice& voice : _active) {
+			voice.Player->stop();
+		}
+		Update();
+	}
+
+	int32_t SfxVoicePool::FindVoiceToSteal(AudioBuffer* buffer, SfxCategory category, float distance, const Vector3f& listenerPos, bool sameBufferOnly, bool sameCategoryOnly)
+	{
+		int32_t bestIndex = -1;
+		float bestDistance = distance;
+		for (int32_t i = 0; i < (int32_t)_active.size(); i++) {
+			const Voice& voice = _active[i];
+			if ((sameBufferOnly && voice.Buffer != buffer) || (sameCategoryOnly && voice.Category != category)) {
+				continue;
+			}
+			// Sounds that are referenced outside of the pool are controlled by their owners
+			if (voice.Player.use_count() > 1 || voice.Player->isLooping()) {
+				continue;
+			}
+
+			float voiceDistance = DistanceSquared(voice.Player->position(), listenerPos);
+			if (voiceDistance >= bestDistance) {
+				bestDistance = voiceDistance;
+				bestIndex = i;
+			}
+		}
+		return bestIndex;
+	}
+
+	void SfxVoicePool::Release(int32_t index)
+	{
+		std::shared_ptr<AudioBufferPlayer> player = std::move(_active[index].Player);
+		_active.erase(_active.begin() + index);
+		if (player.use_count() == 1) {
+			_free.push_back(std::move(player));
+		}
+	}
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include "../nCine/Audio/AudioBufferPlayer.h"
+#include "../nCine/Primitives/Vector3.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2
+{
+	enum class SfxCategory {
+		/// Sounds emitted by actors in the level
+		Actor,
+		/// Shared sounds (pickups, user interface)
+		Common,
+
+		Count
+	};
+
+	/// Fixed pool of sound effect voices with per-category and per-sound limits
+	class SfxVoicePool
+	{
+	public:
+		/// Maximum number of simultaneous instances of the same audio buffer
+		static constexpr uint32_t MaxInstancesPerSound = 4;
+
+		SfxVoicePool();
+
+		/// Returns a voice ready to play the buffer or `nullptr` if none could be acquired
+		/*! A voice that is still referenced outside of the pool (e.g. looping sounds) is never stolen. */
+		const std::shared_ptr<AudioBufferPlayer>& Acquire(AudioBuffer* buffer, SfxCategory category, const Vector3f& pos, const Vector3f& listenerPos);
+		/// Returns all finished voices to the free list in a single pass
+		void Update();
+		/// Stops all voices
+		void StopAll();
+
+		uint32_t GetActiveCount() const {
+			return (uint32_t)_active.size();
+		}
+
+	private:
+		struct Voice {
+			std::shared_ptr<AudioBufferPlayer> Player;
+			AudioBuffer* Buffer;
+			SfxCategory Category;
+		};
+
+		SmallVector<Voice, 0> _active;
+		SmallVector<std::shared_ptr<AudioBufferPlayer>, 0> _free;
+		uint32_t _maxVoices;
+		uint32_t _categoryLimits[(int)SfxCategory::Count];
+
+		int32_t FindVoiceToSteal(AudioBuffer* buffer, SfxCategory category, float distance, const Vector3f& listenerPos, bool sameBufferOnly, bool sameCategoryOnly);
+		void Release(int32_t index);
+	};
+}
@@ -4,6 +4,7 @@
 
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/IO/IFileStream.h"
+#include "../../nCine/IO/SpanReader.h"
 #include "../../nCine/Base/Random.h"
 
 namespace Jazz2::Tiles
@@ -51,6 +52,9 @@ namespace Jazz2::Tiles
 	{
 		SceneNode::OnUpdate(timeMult);
 
+		// Render commands are rented by all viewports during the frame, so they are returned only once per frame
+		_renderCommandsCount = 0;
+
 		// Update animated tiles
 		for (auto& animTile : _animatedTiles) {
 			if (animTile.FrameDuration <= 0.0f || animTile.Tiles.size() < 2) {
@@ -87,6 +91,10 @@ namespace Jazz2::Tiles
 			}
 		}
 
+		if (_texturedBackgroundLayer != -1) {
+			_texturedBackgroundPass.InvalidateAnimatedTiles();
+		}
+
 		// Update layer scrolling
 		for (auto& layer : _layers) {
 			if (std::abs(layer.AutoSpeedX) > 0) {
@@ -127,10 +135,9 @@ namespace Jazz2::Tiles
 	{
 		SceneNode::OnDraw(renderQueue);
 
-		_renderCommandsCount = 0;
-
+		int viewportIndex = _levelHandler->GetCurrentViewportIndex();
 		for (auto& layer : _layers) {
-			DrawLayer(renderQueue, layer);
+			DrawLayer(renderQueue, layer, viewportIndex);
 		}
 
 		DrawDebris(renderQueue);
@@ -151,7 +158,7 @@ namespace Jazz2::Tiles
 			return _hasPit;
 		}
 
-		LayerTile& tile = _layers[_sprLayerIndex].Layout[y * layoutSize.X + x];
+		LayerTile tile = _layers[_sprLayerIndex].Layout[y * layoutSize.X + x];
 		int tileId = ResolveTileID(tile);
 		return _tileSet->IsTileMaskEmpty(tileId);
 	}
@@ -189,15 +196,22 @@ namespace Jazz2::Tiles
 		int hy1t = hy1 / TileSet::DefaultTileSize;
 		int hy2t = hy2 / TileSet::DefaultTileSize;
 
-		auto sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		auto sprLayerLayout = sprLayer.Layout.get();
 
 		for (int y = hy1t; y <= hy2t; y++) {
 			for (int x = hx1t; x <= hx2t; x++) {
-				LayerTile& tile = sprLayerLayout[y * layoutSize.X + x];
+				LayerTile tile = sprLayerLayout[y * layoutSize.X + x];
 				int tileId = ResolveTileID(tile);
-				if (tile.SuspendType != SuspendType::None || _tileSet->IsTileMaskEmpty(tileId) || (tile.IsOneWay && !downwards)) {
+				if (_tileSet->IsTileMaskEmpty(tileId)) {
 					continue;
 				}
+				if (tile.HasExtra()) {
+					LayerTileExtra* extra = GetTileExtra(sprLayer, y * layoutSize.X + x);
+					if (extra->SuspendType != SuspendType::None || (extra->IsOneWay && !downwards)) {
+						continue;
+					}
+				}
 
 				int tx = x * TileSet::DefaultTileSize;
 				int ty = y * TileSet::DefaultTileSize;
@@ -207,12 +221,12 @@ namespace Jazz2::Tiles
 				int top = std::max(hy1 - ty, 0);
 				int bottom = std::min(hy2 - ty, TileSet::DefaultTileSize - 1);
 
-				if (tile.IsFlippedX) {
+				if (tile.IsFlippedX()) {
 					int left2 = left;
 					left = (TileSet::DefaultTileSize - 1 - right);
 					right = (TileSet::DefaultTileSize - 1 - left2);
 				}
-				if (tile.IsFlippedY) {
+				if (tile.IsFlippedY()) {
 					int top2 = top;
 					top = (TileSet::DefaultTileSize - 1 - bottom);
 					bottom = (TileSet::DefaultTileSize - 1 - top2);
@@ -252,8 +266,12 @@ namespace Jazz2::Tiles
 		}
 
 		TileMapLayer& layer = _layers[_sprLayerIndex];
-		LayerTile& tile = layer.Layout[ax + ay * layer.LayoutSize.X];
-		if (tile.SuspendType == SuspendType::None) {
+		LayerTile tile = layer.Layout[ax + ay * layer.LayoutSize.X];
+		if (!tile.HasExtra()) {
+			return SuspendType::None;
+		}
+		SuspendType suspendType = GetTileExtra(layer, ax + ay * layer.LayoutSize.X)->SuspendType;
+		if (suspendType == SuspendType::None) {
 			return SuspendType::None;
 		}
 
@@ -263,10 +281,10 @@ namespace Jazz2::Tiles
 		int rx = (int)x & 31;
 		int ry = (int)y & 31;
 
-		if (tile.IsFlippedX) {
+		if (tile.IsFlippedX()) {
 			rx = (TileSet::DefaultTileSize - 1 - rx);
 		}
-		if (tile.IsFlippedY) {
+		if (tile.IsFlippedY()) {
 			ry = (TileSet::DefaultTileSize - 1 - ry);
 		}
 
@@ -275,7 +293,7 @@ namespace Jazz2::Tiles
 
 		for (int ti = bottom | rx; ti >= top; ti -= TileSet::DefaultTileSize) {
 			if (mask[ti]) {
-				return tile.SuspendType;
+				return suspendType;
 			}
 		}
 
@@ -291,12 +309,18 @@ namespace Jazz2::Tiles
 		int y1 = std::max(0, (int)aabb.T / TileSet::DefaultTileSize);
 		int y2 = std::min((int)aabb.B / TileSet::DefaultTileSize, layoutSize.Y - 1);
 
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+
 		int hit = 0;
 		for (int tx = x1; tx <= x2; tx++) {
 			for (int ty = y1; ty <= y2; ty++) {
-				auto& tile = _layers[_sprLayerIndex].Layout[tx + ty * layoutSize.X];
-				if (tile.DestructType == TileDestructType::Weapon) {
-					if (weapon == WeaponType::Freezer && (_animatedTiles[tile.DestructAnimation].Tiles.size() - 2) > tile.DestructFrameIndex) {
+				auto& tile = sprLayer.Layout[tx + ty * layoutSize.X];
+				if (!tile.HasExtra()) {
+					continue;
+				}
+				auto& extra = *GetTileExtra(sprLayer, tx + ty * layoutSize.X);
+				if (extra.DestructType == TileDestructType::Weapon) {
+					if (weapon == WeaponType::Freezer && (_animatedTiles[extra.DestructAnimation].Tiles.size() - 2) > extra.DestructFrameIndex) {
 						// TODO
 						/*FrozenBlock frozen = new FrozenBlock();
 						frozen.OnActivated(new ActorActivationDetails {
@@ -305,8 +329,8 @@ namespace Jazz2::Tiles
 						});
 						levelHandler.AddActor(frozen);*/
 						hit++;
-					} else if (tile.ExtraData == 0 || tile.ExtraData == ((unsigned int)weapon + 1)) {
-						if (AdvanceDestructibleTileAnimation(tile, tx, ty, strength, "SceneryDestruct"_s)) {
+					} else if (extra.ExtraData == 0 || extra.ExtraData == ((unsigned int)weapon + 1)) {
+						if (AdvanceDestructibleTileAnimation(tile, extra, tx, ty, strength, "SceneryDestruct"_s)) {
 							hit++;
 						}
 
@@ -330,13 +354,19 @@ namespace Jazz2::Tiles
 		int y1 = std::max(0, (int)aabb.T / TileSet::DefaultTileSize);
 		int y2 = std::min((int)aabb.B / TileSet::DefaultTileSize, layoutSize.Y - 1);
 
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+
 		int hit = 0;
 		for (int tx = x1; tx <= x2; tx++) {
 			for (int ty = y1; ty <= y2; ty++) {
-				auto& tile = _layers[_sprLayerIndex].Layout[tx + ty * layoutSize.X];
-				if (tile.DestructType == TileDestructType::Special) {
+				auto& tile = sprLayer.Layout[tx + ty * layoutSize.X];
+				if (!tile.HasExtra()) {
+					continue;
+				}
+				auto& extra = *GetTileExtra(sprLayer, tx + ty * layoutSize.X);
+				if (extra.DestructType == TileDestructType::Special) {
 					int amount = 1;
-					if (AdvanceDestructibleTileAnimation(tile, tx, ty, amount, "SceneryDestruct"_s)) {
+					if (AdvanceDestructibleTileAnimation(tile, extra, tx, ty, amount, "SceneryDestruct"_s)) {
 						hit++;
 					}
 				}
@@ -354,13 +384,19 @@ namespace Jazz2::Tiles
 		int y1 = std::max(0, (int)aabb.T / TileSet::DefaultTileSize);
 		int y2 = std::min((int)aabb.B / TileSet::DefaultTileSize, layoutSize.Y - 1);
 
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+
 		int hit = 0;
 		for (int tx = x1; tx <= x2; tx++) {
 			for (int ty = y1; ty <= y2; ty++) {
-				auto& tile = _layers[_sprLayerIndex].Layout[tx + ty * layoutSize.X];
-				if (tile.DestructType == TileDestructType::Speed && /*tile.ExtraData +*/ 5 <= speed) {
+				auto& tile = sprLayer.Layout[tx + ty * layoutSize.X];
+				if (!tile.HasExtra()) {
+					continue;
+				}
+				auto& extra = *GetTileExtra(sprLayer, tx + ty * layoutSize.X);
+				if (extra.DestructType == TileDestructType::Speed && /*extra.ExtraData +*/ 5 <= speed) {
 					int amount = 1;
-					if (AdvanceDestructibleTileAnimation(tile, tx, ty, amount, "SceneryDestruct"_s)) {
+					if (AdvanceDestructibleTileAnimation(tile, extra, tx, ty, amount, "SceneryDestruct"_s)) {
 						hit++;
 					}
 				}
@@ -379,23 +415,24 @@ namespace Jazz2::Tiles
 		int y1 = std::max(0, (int)aabb.T / TileSet::DefaultTileSize);
 		int y2 = std::min((int)aabb.B / TileSet::DefaultTileSize, layoutSize.Y - 1);
 
+		if (_collapsingTileState.Size() != (unsigned int)(layoutSize.X * layoutSize.Y)) {
+			_collapsingTileState.SetSize(layoutSize.X * layoutSize.Y);
+			_collapsingTileState.ClearAll();
+		}
+
 		int hit = 0;
 		for (int tx = x1; tx <= x2; tx++) {
 			for (int ty = y1; ty <= y2; ty++) {
-				auto& tile = _layers[_sprLayerIndex].Layout[tx + ty * layoutSize.X];
-				if (tile.DestructType == TileDestructType::Collapse) {
-					bool found = false;
-					for (auto& current : _activeCollapsingTiles) {
-						if (current == Vector2i(tx, ty)) {
-							found = true;
-							break;
-						}
-					}
-
-					if (!found) {
-						_activeCollapsingTiles.emplace_back(tx, ty);
-						hit++;
-					}
+				int32_t tileIdx = tx + ty * layoutSize.X;
+				if (!_layers[_sprLayerIndex].Layout[tileIdx].HasExtra() || _collapsingTileState[tileIdx]) {
+					continue;
+				}
+				auto& extra = *GetTileExtra(_layers[_sprLayerIndex], tileIdx);
+				if (extra.DestructType == TileDestructType::Collapse) {
+					// Tile starts to collapse after the specified delay
+					_collapsingTileState.Set(tileIdx);
+					_collapsingTiles.Schedule(_collapsingTiles.GetCurrentTick() + extra.ExtraData, tileIdx);
+					hit++;
 				}
 			}
 		}
@@ -403,21 +440,21 @@ namespace Jazz2::Tiles
 		return hit;
 	}
 
-	bool TileMap::AdvanceDestructibleTileAnimation(LayerTile& tile, int tx, int ty, int& amount, const StringView& soundName)
+	bool TileMap::AdvanceDestructibleTileAnimation(LayerTile& tile, LayerTileExtra& extra, int tx, int ty, int& amount, const StringView& soundName)
 	{
-		int max = (int)(_animatedTiles[tile.DestructAnimation].Tiles.size() - 2);
-		if (tile.DestructFrameIndex < max) {
+		int max = (int)(_animatedTiles[extra.DestructAnimation].Tiles.size() - 2);
+		if (extra.DestructFrameIndex < max) {
 			// Tile not destroyed yet, advance counter by one
-			int current = std::min(amount, max - tile.DestructFrameIndex);
+			int current = std::min(amount, max - extra.DestructFrameIndex);
 
-			tile.DestructFrameIndex += current;
-			tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[tile.DestructFrameIndex].TileID;
-			if (tile.DestructFrameIndex >= max) {
+			extra.DestructFrameIndex += current;
+			tile.SetTileID(_animatedTiles[extra.DestructAnimation].Tiles[extra.DestructFrameIndex].TileID);
+			if (extra.DestructFrameIndex >= max) {
 				if (!soundName.empty()) {
 					_levelHandler->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
 						ty * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2), 0.0f));
 				}
-				AnimatedTile& anim = _animatedTiles[tile.DestructAnimation];
+				AnimatedTile& anim = _animatedTiles[extra.DestructAnimation];
 				CreateTileDebris(anim.Tiles[anim.Tiles.size() - 1].TileID, tx, ty);
 			}
 
@@ -442,22 +479,20 @@ namespace Jazz2::Tiles
 
 		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
 
-		for (int i = 0; i < _activeCollapsingTiles.size(); i++) {
-			Vector2i tilePos = _activeCollapsingTiles[i];
-			auto& tile = _layers[_sprLayerIndex].Layout[tilePos.X + tilePos.Y * layoutSize.X];
-			if (tile.ExtraData == 0) {
-				int amount = 1;
-				if (!AdvanceDestructibleTileAnimation(tile, tilePos.X, tilePos.Y, amount, "SceneryCollapse"_s)) {
-					tile.DestructType = TileDestructType::None;
-					_activeCollapsingTiles.erase(_activeCollapsingTiles.begin() + i);
-					i--;
-				} else {
-					tile.ExtraData = 4;
-				}
+		_collapsingTiles.Advance(_collapsingTiles.GetCurrentTick(), [&](int32_t tileIdx) {
+			int tx = tileIdx % layoutSize.X;
+			int ty = tileIdx / layoutSize.X;
+			auto& tile = _layers[_sprLayerIndex].Layout[tileIdx];
+			auto& extra = *GetTileExtra(_layers[_sprLayerIndex], tileIdx);
+			int amount = 1;
+			if (!AdvanceDestructibleTileAnimation(tile, extra, tx, ty, amount, "SceneryCollapse"_s)) {
+				extra.DestructType = TileDestructType::None;
+				_collapsingTileState.Reset(tileIdx);
 			} else {
-				tile.ExtraData--;
+				// Next frame of the animation is shown after 5 ticks
+				_collapsingTiles.Schedule(_collapsingTiles.GetCurrentTick() + 4, tileIdx);
 			}
-		}
+		});
 	}
 
 	void TileMap::SetSolidLimit(int tileLeft, int tileWidth)
@@ -480,14 +515,14 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer)
+	void TileMap::DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex)
 	{
 		if (!layer.Visible) {
 			return;
 		}
 
-		Vector2i viewSize = _levelHandler->GetViewSize();
-		Vector2f viewCenter = _levelHandler->GetCameraPos();
+		Vector2i viewSize = _levelHandler->GetViewSize(viewportIndex);
+		Vector2f viewCenter = _levelHandler->GetCameraPos(viewportIndex);
 
 		Vector2i tileCount = layer.LayoutSize;
 		Vector2i tileSize = Vector2i(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
@@ -503,7 +538,7 @@ namespace Jazz2::Tiles
 		if (layer.BackgroundStyle != BackgroundStyle::Plain && tileCount.Y == 8 && tileCount.X == 8) {
 			constexpr float PerspectiveSpeedX = 0.4f;
 			constexpr float PerspectiveSpeedY = 0.16f;
-			RenderTexturedBackground(renderQueue, layer, x1 * PerspectiveSpeedX + loX, y1 * PerspectiveSpeedY + loY);
+			RenderTexturedBackground(renderQueue, layer, viewportIndex, x1 * PerspectiveSpeedX + loX, y1 * PerspectiveSpeedY + loY);
 		} else {
 			// Figure out the floating point offset from the calculated coordinates and the actual tile corner coordinates
 			float xt = TranslateCoordinate(x1, layer.SpeedX, loX, false, viewSize.Y, viewSize.X);
@@ -538,6 +573,14 @@ namespace Jazz2::Tiles
 				}
 			}
 
+			if (layer.LayoutTexture != nullptr) {
+				// Offset from view coordinates to layer coordinates, aligned so tile boundaries fall on whole pixels
+				float offsetX = tileAbsX * TileSet::DefaultTileSize - std::floor(x1 - remX);
+				float offsetY = tileAbsY * TileSet::DefaultTileSize - std::floor(y1 - remY);
+				RenderLayoutLayer(renderQueue, layer, viewportIndex, offsetX, offsetY);
+				return;
+			}
+
 			// update x1 and y1 with the remainder so that we start at the tile boundary
 			// minus 1 because indices are updated in the beginning of the loops
 			x1 -= remX - (float)TileSet::DefaultTileSize;
@@ -566,7 +609,8 @@ namespace Jazz2::Tiles
 					tileY = (tileY + 1) % tileCount.Y;
 					tile_yo++;
 
-					LayerTile tile = layer.Layout[tileX + tileY * layer.LayoutSize.X];
+					int32_t tileIdx = tileX + tileY * layer.LayoutSize.X;
+					LayerTile tile = layer.Layout[tileIdx];
 
 					if (!layer.RepeatY) {
 						// If the current tile isn't in the first iteration of the layer vertically, don't draw it
@@ -578,9 +622,9 @@ namespace Jazz2::Tiles
 					int tileId;
 					bool isFlippedX, isFlippedY;
 					int alpha;
-					if (tile.IsAnimated) {
-						if (tile.TileID < _animatedTiles.size()) {
-							tileId = _animatedTiles[tile.TileID].Tiles[_animatedTiles[tile.TileID].CurrentTileIdx].TileID;
+					if (tile.IsAnimated()) {
+						if (tile.TileID() < _animatedTiles.size()) {
+							tileId = _animatedTiles[tile.TileID()].Tiles[_animatedTiles[tile.TileID()].CurrentTileIdx].TileID;
 							// TODO
 							//isFlippedX = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedX != tile.IsFlippedX);
 							//isFlippedY = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedY != tile.IsFlippedY);
@@ -594,10 +638,10 @@ namespace Jazz2::Tiles
 							continue;
 						}
 					} else {
-						tileId = tile.TileID;
-						isFlippedX = tile.IsFlippedX;
-						isFlippedY = tile.IsFlippedY;
-						alpha = tile.MaterialAlpha;
+						tileId = tile.TileID();
+						isFlippedX = tile.IsFlippedX();
+						isFlippedY = tile.IsFlippedY();
+						alpha = (tile.HasExtra() ? GetTileExtra(layer, tileIdx)->MaterialAlpha : 255);
 					}
 
 					if (alpha == 0) {
@@ -629,10 +673,10 @@ namespace Jazz2::Tiles
 						texBiasY -= 0.5f / float(texSize.Y);
 					}
 
-					auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-					instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-					instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-					instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, alpha / 255.0f).Data());
+					auto instanceBlock = command->material().uniformBlock(_instanceHandles.block);
+					instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+					instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+					instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, alpha / 255.0f).Data());
 
 					Matrix4x4f worldMatrix = Matrix4x4f::Translation(std::floor(x2 + (TileSet::DefaultTileSize / 2)), std::floor(y2 + (TileSet::DefaultTileSize / 2)), 0.0f);
 					command->setTransformation(worldMatrix);
@@ -691,19 +735,45 @@ namespace Jazz2::Tiles
 		int32_t width = s->ReadValue<int32_t>();
 		int32_t height = s->ReadValue<int32_t>();
 
-		std::unique_ptr<LayerTile[]> layout = std::make_unique<LayerTile[]>(width * height);
+		// Each tile is stored as 16-bit tile type followed by 8-bit flags, the whole layout is decoded from one block
+		constexpr int TileRecordSize = 3;
+		if (width <= 0 || height <= 0 || s->GetSize() - s->GetPosition() < width * height * TileRecordSize) {
+			LOGE_X("Layer file \"%s\" is truncated", s->filename());
+			return;
+		}
+
+		ArrayView<const uint8_t> data = s->ReadView(width * height * TileRecordSize);
+		if (data.size() < (std::size_t)(width * height * TileRecordSize)) {
+			LOGE_X("Layer file \"%s\" is truncated", s->filename());
+			return;
+		}
 
-		for (int i = 0; i < (width * height); i++) {
-			uint16_t tileType = s->ReadValue<uint16_t>();
+		std::unique_ptr<LayerTile[]> layout = std::make_unique<LayerTile[]>(width * height);
+		HashMap<int32_t, LayerTileExtra> extra;
+		bool hasAnimatedTiles = false;
+		bool hasInvalidTiles = false;
+
+		const uint8_t* record = data.data();
+		for (int i = 0; i < (width * height); i++, record += TileRecordSize) {
+			uint16_t tileType = (uint16_t)(record[0] | (record[1] << 8));
+			if (tileType > LayerTile::TileIDMask) {
+				// Only 12 bits are available for tile ID, such tile would turn into a different one
+				if (!hasInvalidTiles) {
+					LOGW_X("Layer file \"%s\" contains tile ID %i that is out of range, it was replaced with empty tile", s->filename(), tileType);
+					hasInvalidTiles = true;
+				}
+				tileType = 0;
+			}
 
-			uint8_t flags = s->ReadValue<uint8_t>();
+			uint8_t flags = record[2];
 			bool isFlippedX = (flags & 0x01) != 0;
 			bool isFlippedY = (flags & 0x02) != 0;
 			bool isAnimated = (flags & 0x04) != 0;
 			uint8_t tileModifier = (uint8_t)(flags >> 4);
 
 			LayerTile& tile = layout[i];
-			tile.TileID = tileType;
+			tile.Value = 0;
+			tile.SetTileID(tileType);
 
 			// Copy the default tile and do stuff with it
 			/*if (!isAnimated) {
@@ -716,16 +786,17 @@ namespace Jazz2::Tiles
 				tile.TileID = tileType;
 			}*/
 
-			tile.IsFlippedX = isFlippedX;
-			tile.IsFlippedY = isFlippedY;
-			tile.IsAnimated = isAnimated;
-
-			if (tileModifier == 1 /*Translucent*/) {
-				tile.MaterialAlpha = /*127*/140;
-			} else if (tileModifier == 2 /*Invisible*/) {
-				tile.MaterialAlpha = 0;
-			} else {
-				tile.MaterialAlpha = 255;
+			tile.SetFlag(LayerTile::FlippedXFlag, isFlippedX);
+			tile.SetFlag(LayerTile::FlippedYFlag, isFlippedY);
+			tile.SetFlag(LayerTile::AnimatedFlag, isAnimated);
+			hasAnimatedTiles |= isAnimated;
+
+			// Only tiles with non-default alpha need extra data
+			if (tileModifier == 1 /*Translucent*/ || tileModifier == 2 /*Invisible*/) {
+				LayerTileExtra& tileExtra = extra[i];
+				tileExtra = { };
+				tileExtra.MaterialAlpha = (tileModifier == 1 ? /*127*/140 : 0);
+				tile.SetFlag(LayerTile::HasExtraFlag, true);
 			}
 		}
 
@@ -740,6 +811,7 @@ namespace Jazz2::Tiles
 		newLayer.Visible = true;
 		newLayer.LayoutSize = Vector2i(width, height);
 		newLayer.Layout = std::move(layout);
+		newLayer.Extra = std::move(extra);
 
 		newLayer.SpeedX = layer.SpeedX;
 		newLayer.SpeedY = layer.SpeedY;
@@ -754,6 +826,9 @@ namespace Jazz2::Tiles
 		newLayer.BackgroundStyle = layer.BackgroundStyle;
 		newLayer.BackgroundColor = layer.BackgroundColor;
 		newLayer.ParallaxStarsEnabled = layer.ParallaxStarsEnabled;
+
+		// Tiles of the sprite layer can be destroyed and animated tiles change over time, so they can't be baked into a texture
+		newLayer.UseLayoutTexture = (type != LayerType::Sprite && !hasAnimatedTiles);
 	}
 
 	void TileMap::ReadAnimatedTiles(const std::unique_ptr<IFileStream>& s)
@@ -764,84 +839,116 @@ namespace Jazz2::Tiles
 			return;
 		}
 
-		int32_t count = s->ReadValue<int32_t>();
+		// Records have variable length, so the rest of the file is read at once and decoded from memory
+		ArrayView<const uint8_t> data = s->ReadView(s->GetSize() - s->GetPosition());
+		SpanReader r(data);
+
+		int32_t count = r.ReadValue<int32_t>();
 
 		_animatedTiles.reserve(count);
 
 		for (int i = 0; i < count; i++) {
-			uint16_t frameCount = s->ReadValue<uint16_t>();
+			uint16_t frameCount = r.ReadValue<uint16_t>();
 			if (frameCount == 0) {
 				continue;
 			}
 
 			AnimatedTile& animTile = _animatedTiles.emplace_back();
+			animTile.Tiles.reserve(frameCount);
 
 			for (int j = 0; j < frameCount; j++) {
 				auto& frame = animTile.Tiles.emplace_back();
-				frame.TileID = s->ReadValue<uint16_t>();
+				frame.TileID = r.ReadValue<uint16_t>();
 				// TODO: flags
-				uint8_t flag = s->ReadValue<uint8_t>();
+				uint8_t flag = r.ReadValue<uint8_t>();
 			}
 
 			// TODO: Adjust FPS in Import
-			uint8_t speed = s->ReadValue<uint8_t>();
+			uint8_t speed = r.ReadValue<uint8_t>();
 			animTile.FrameDuration = 70.0f / (speed * 14 / 10);
-			animTile.Delay = s->ReadValue<uint16_t>();
+			animTile.Delay = r.ReadValue<uint16_t>();
 
-			//animTile.DelayJitter = s->ReadValue<uint16_t>();
-			uint16_t delayJitter = s->ReadValue<uint16_t>();
+			//animTile.DelayJitter = r.ReadValue<uint16_t>();
+			uint16_t delayJitter = r.ReadValue<uint16_t>();
 
-			animTile.PingPong = s->ReadValue<uint8_t>();
-			animTile.PingPongDelay = s->ReadValue<uint16_t>();
+			animTile.PingPong = r.ReadValue<uint8_t>();
+			animTile.PingPongDelay = r.ReadValue<uint16_t>();
+
+			if (r.HasOverflowed()) {
+				LOGE_X("Animated tiles file \"%s\" is truncated", s->filename());
+				_animatedTiles.pop_back();
+				break;
+			}
 		}
 	}
 
 	void TileMap::SetTileEventFlags(int x, int y, EventType tileEvent, uint8_t* tileParams)
 	{
-		auto& tile = _layers[_sprLayerIndex].Layout[x + y * _layers[_sprLayerIndex].LayoutSize.X];
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		int32_t tileIdx = x + y * sprLayer.LayoutSize.X;
+		auto& tile = sprLayer.Layout[tileIdx];
 
 		switch (tileEvent) {
 			case EventType::ModifierOneWay:
-				tile.IsOneWay = true;
+				GetOrCreateTileExtra(sprLayer, tileIdx).IsOneWay = true;
 				break;
 			case EventType::ModifierVine:
-				tile.SuspendType = SuspendType::Vine;
+				GetOrCreateTileExtra(sprLayer, tileIdx).SuspendType = SuspendType::Vine;
 				break;
 			case EventType::ModifierHook:
-				tile.SuspendType = SuspendType::Hook;
+				GetOrCreateTileExtra(sprLayer, tileIdx).SuspendType = SuspendType::Hook;
 				break;
 			case EventType::SceneryDestruct:
-				SetTileDestructibleEventFlag(tile, TileDestructType::Weapon, tileParams[0]);
+				SetTileDestructibleEventFlag(tile, GetOrCreateTileExtra(sprLayer, tileIdx), TileDestructType::Weapon, tileParams[0]);
 				break;
 			case EventType::SceneryDestructButtstomp:
-				SetTileDestructibleEventFlag(tile, TileDestructType::Special, tileParams[0]);
+				SetTileDestructibleEventFlag(tile, GetOrCreateTileExtra(sprLayer, tileIdx), TileDestructType::Special, tileParams[0]);
 				break;
 			case EventType::TriggerArea:
-				SetTileDestructibleEventFlag(tile, TileDestructType::Trigger, tileParams[0]);
+				SetTileDestructibleEventFlag(tile, GetOrCreateTileExtra(sprLayer, tileIdx), TileDestructType::Trigger, tileParams[0]);
 				break;
 			case EventType::SceneryDestructSpeed:
-				SetTileDestructibleEventFlag(tile, TileDestructType::Speed, tileParams[0]);
+				SetTileDestructibleEventFlag(tile, GetOrCreateTileExtra(sprLayer, tileIdx), TileDestructType::Speed, tileParams[0]);
 				break;
 			case EventType::SceneryCollapse:
 				// ToDo: FPS (tileParams[1]) not used...
-				SetTileDestructibleEventFlag(tile, TileDestructType::Collapse, tileParams[0]);
+				SetTileDestructibleEventFlag(tile, GetOrCreateTileExtra(sprLayer, tileIdx), TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
 	}
 
-	void TileMap::SetTileDestructibleEventFlag(LayerTile& tile, TileDestructType type, uint16_t extraData)
+	void TileMap::SetTileDestructibleEventFlag(LayerTile& tile, LayerTileExtra& extra, TileDestructType type, uint16_t extraData)
 	{
-		if (!tile.IsAnimated) {
+		if (!tile.IsAnimated()) {
 			return;
 		}
 
-		tile.DestructType = type;
-		tile.IsAnimated = false;
-		tile.DestructAnimation = tile.TileID;
-		tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[0].TileID;
-		tile.DestructFrameIndex = 0;
+		extra.DestructType = type;
+		tile.SetFlag(LayerTile::AnimatedFlag, false);
+		extra.DestructAnimation = tile.TileID();
+		tile.SetTileID(_animatedTiles[extra.DestructAnimation].Tiles[0].TileID);
+		extra.DestructFrameIndex = 0;
 		//tile.MaterialOffset = tileset.GetTileTextureRect(tile.TileID);
-		tile.ExtraData = extraData;
+		extra.ExtraData = extraData;
+	}
+
+	LayerTileExtra* TileMap::GetTileExtra(TileMapLayer& layer, int32_t tileIdx)
+	{
+		auto it = layer.Extra.find(tileIdx);
+		return (it != layer.Extra.end() ? &it->second : nullptr);
+	}
+
+	LayerTileExtra& TileMap::GetOrCreateTileExtra(TileMapLayer& layer, int32_t tileIdx)
+	{
+		LayerTile& tile = layer.Layout[tileIdx];
+		if (!tile.HasExtra()) {
+			LayerTileExtra& extra = layer.Extra[tileIdx];
+			extra = { };
+			extra.MaterialAlpha = 255;
+			tile.SetFlag(LayerTile::HasExtraFlag, true);
+			return extra;
+		}
+		return layer.Extra[tileIdx];
 	}
 
 	void TileMap::CreateDebris(const DestructibleDebris& debris)
@@ -1075,10 +1182,10 @@ namespace Jazz2::Tiles
 		for (auto& debris : _debrisList) {
 			auto command = RentRenderCommand();
 
-			auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-			instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(debris.Size.X, debris.Size.Y);
-			instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			auto instanceBlock = command->material().uniformBlock(_instanceHandles.block);
+			instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
+			instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(debris.Size.X, debris.Size.Y);
+			instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
 
 			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
 			worldMatrix.RotateZ(debris.Angle);
@@ -1104,54 +1211,58 @@ namespace Jazz2::Tiles
 
 		_triggerState.Set(triggerId, newState);
 
-		// Go through all tiles and update any that are influenced by this trigger
-		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
-		int n = layoutSize.X * layoutSize.Y;
-		for (int i = 0; i < n; i++) {
-			LayerTile& tile = _layers[_sprLayerIndex].Layout[i];
-			if (tile.DestructType == TileDestructType::Trigger && tile.ExtraData == triggerId) {
-				if (_animatedTiles[tile.DestructAnimation].Tiles.size() > 1) {
-					tile.DestructFrameIndex = (newState ? 1 : 0);
-					tile.TileID = _animatedTiles[tile.DestructAnimation].Tiles[tile.DestructFrameIndex].TileID;
+		// Go through all tiles with extra data and update any that are influenced by this trigger
+		TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		for (auto& [tileIdx, extra] : sprLayer.Extra) {
+			if (extra.DestructType == TileDestructType::Trigger && extra.ExtraData == triggerId) {
+				if (_animatedTiles[extra.DestructAnimation].Tiles.size() > 1) {
+					extra.DestructFrameIndex = (newState ? 1 : 0);
+					sprLayer.Layout[tileIdx].SetTileID(_animatedTiles[extra.DestructAnimation].Tiles[extra.DestructFrameIndex].TileID);
 				}
 			}
 		}
 	}
 
-	void TileMap::RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y)
+	void TileMap::RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex, float x, float y)
 	{
 		auto target = _texturedBackgroundPass._target.get();
 		if (target == nullptr) {
 			return;
 		}
 
-		Vector2i viewSize = _levelHandler->GetViewSize();
-		Vector2f viewCenter = _levelHandler->GetCameraPos();
+		Vector2i viewSize = _levelHandler->GetViewSize(viewportIndex);
+		Vector2f viewCenter = _levelHandler->GetCameraPos(viewportIndex);
 
-		auto command = &_texturedBackgroundPass._outputRenderCommand;
+		// Output command is persistent, uniforms that don't depend on camera are set only when they change
+		auto output = _texturedBackgroundPass.GetOutputCommand(viewportIndex);
+		auto command = &output->Command;
+		if (!(output->ViewSize == viewSize)) {
+			output->ViewSize = viewSize;
 
-		auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
-		instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(viewSize.X, viewSize.Y);
-		instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+			auto instanceBlock = command->material().uniformBlock(_texturedBackgroundPass._outputInstanceHandles.block);
+			instanceBlock->uniform(_texturedBackgroundPass._outputInstanceHandles.spriteSize)->setFloatValue(viewSize.X, viewSize.Y);
+			command->material().uniform(_texturedBackgroundPass._viewSizeHandle)->setFloatValue(viewSize.X, viewSize.Y);
+		}
 
-		command->material().uniform("ViewSize")->setFloatValue(viewSize.X, viewSize.Y);
-		command->material().uniform("CameraPosition")->setFloatValue(viewCenter.X, viewCenter.Y);
-		command->material().uniform("shift")->setFloatValue(x, y);
-		command->material().uniform("horizonColor")->setFloatValue(layer.BackgroundColor.X, layer.BackgroundColor.Y, layer.BackgroundColor.Z);
-		command->material().uniform("parallaxStarsEnabled")->setFloatValue(layer.ParallaxStarsEnabled ? 1.0f : 0.0f);
+		command->material().uniform(_texturedBackgroundPass._cameraPositionHandle)->setFloatValue(viewCenter.X, viewCenter.Y);
+		command->material().uniform(_texturedBackgroundPass._shiftHandle)->setFloatValue(x, y);
 
 		Matrix4x4f worldMatrix = Matrix4x4f::Translation(viewCenter.X, viewCenter.Y, 0.0f);
 		command->setTransformation(worldMatrix);
-		command->setLayer(layer.Depth);
-		command->material().setTexture(*target);
 
 		renderQueue.addCommand(command);
 	}
 
 	void TileMap::OnInitializeViewport(int width, int height)
 	{
+		for (auto& layer : _layers) {
+			if (layer.UseLayoutTexture && layer.LayoutTexture == nullptr) {
+				InitializeLayoutLayer(layer);
+			}
+		}
+
 		if (_texturedBackgroundLayer != -1) {
+			// Both background styles share one shader, the style is selected by uniform
 			constexpr char TexturedBackgroundFs[] = R"(
 #ifdef GL_ES
 precision highp float;
@@ -1165,11 +1276,14 @@ uniform vec2 CameraPosition;
 uniform vec3 horizonColor;
 uniform vec2 shift;
 uniform float parallaxStarsEnabled;
+uniform float circleStyle;
 
 in vec2 vTexCoords;
 
 out vec4 fragColor;
 
+#define INV_PI 0.31830988618379067153776752675
+
 vec2 hash2D(in vec2 p) {
 	float h = dot(p, vec2(12.9898, 78.233));
 	float h2 = dot(p, vec2(37.271, 377.632));
@@ -1211,19 +1325,44 @@ float addStarField(vec2 samplePosition, float threshold) {
 }
 
 void main() {
-	// Distance to center of screen from top or bottom (1: center of screen, 0: edge of screen)
-	float distance = 1.3 - abs(2.0 * vTexCoords.y - 1.0);
-	float horizonDepth = pow(distance, 2.0);
+	vec2 texturePos;
+	float horizonOpacity;
+
+	if (circleStyle > 0.0) {
+		// Position of pixel on screen (between -1 and 1)
+		vec2 targetCoord = vec2(2.0) * vTexCoords - vec2(1.0);
+
+		// Aspect ratio correction, so display circle instead of ellipse
+		targetCoord.x *= ViewSize.x / ViewSize.y;
+
+		// Distance to center of screen
+		float distance = length(targetCoord);
+
+		// x-coordinate of tunnel
+		float xShift = (targetCoord.x == 0.0 ? sign(targetCoord.y) * 0.5 : atan(targetCoord.y, targetCoord.x) * INV_PI);
+
+		texturePos = vec2(
+			(xShift)         * 1.0 + (shift.x * 0.01),
+			(1.0 / distance) * 1.4 + (shift.y * 0.002)
+		);
 
-	float yShift = (vTexCoords.y > 0.5 ? 1.0 : 0.0);
+		horizonOpacity = 1.0 - clamp(pow(distance, 1.4) - 0.3, 0.0, 1.0);
+	} else {
+		// Distance to center of screen from top or bottom (1: center of screen, 0: edge of screen)
+		float distance = 1.3 - abs(2.0 * vTexCoords.y - 1.0);
+		float horizonDepth = pow(distance, 2.0);
 
-	vec2 texturePos = vec2(
-		(shift.x / 256.0) + (vTexCoords.x - 0.5   ) * (0.5 + (1.5 * horizonDepth)),
-		(shift.y / 256.0) + (vTexCoords.y - yShift) * 2.0 * distance
-	);
+		float yShift = (vTexCoords.y > 0.5 ? 1.0 : 0.0);
+
+		texturePos = vec2(
+			(shift.x / 256.0) + (vTexCoords.x - 0.5   ) * (0.5 + (1.5 * horizonDepth)),
+			(shift.y / 256.0) + (vTexCoords.y - yShift) * 2.0 * distance
+		);
+
+		horizonOpacity = clamp(pow(distance, 1.8) - 0.4, 0.0, 1.0);
+	}
 
 	vec4 texColor = texture(uTexture, texturePos);
-	float horizonOpacity = clamp(pow(distance, 1.8) - 0.4, 0.0, 1.0);
 	
 	vec4 horizonColorWithStars = vec4(horizonColor, 1.0);
 	if (parallaxStarsEnabled > 0.0) {
@@ -1239,111 +1378,158 @@ void main() {
 }
 )";
 
-			constexpr char TexturedBackgroundCircleFs[] = R"(
+			if (_texturedBackgroundShader == nullptr) {
+				_texturedBackgroundShader = std::make_unique<Shader>("TexturedBackground", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, TexturedBackgroundFs);
+			}
+
+			Vector2i layoutSize = _layers[_texturedBackgroundLayer].LayoutSize;
+			width = layoutSize.X * TileSet::DefaultTileSize;
+			height = layoutSize.Y * TileSet::DefaultTileSize;
+			_texturedBackgroundPass.Initialize(width, height);
+		}
+	}
+
+	void TileMap::InitializeLayoutLayer(TileMapLayer& layer)
+	{
+		if (_layoutLayerShader == nullptr) {
+			constexpr char LayoutLayerFs[] = R"(
 #ifdef GL_ES
 precision highp float;
+precision highp int;
 #endif
 
-uniform sampler2D uTexture; // Normal
-
-uniform vec2 ViewSize;
-uniform vec2 CameraPosition;
+uniform sampler2D uTexture;
+uniform sampler2D layoutTex;
 
-uniform vec3 horizonColor;
-uniform vec2 shift;
-uniform float parallaxStarsEnabled;
+uniform vec2 LayoutSize;
+uniform vec2 LayoutRepeat;
+uniform vec2 AtlasSize;
+uniform int TilesPerRow;
 
 in vec2 vTexCoords;
-
+in vec4 vColor;
 out vec4 fragColor;
 
-#define INV_PI 0.31830988618379067153776752675
+void main() {
+	// Texture coordinates are in pixels of the layer
+	vec2 tilePos = floor(vTexCoords / 32.0);
+	if ((LayoutRepeat.x < 0.5 && (tilePos.x < 0.0 || tilePos.x >= LayoutSize.x)) ||
+		(LayoutRepeat.y < 0.5 && (tilePos.y < 0.0 || tilePos.y >= LayoutSize.y))) {
+		discard;
+	}
+	tilePos = mod(tilePos, LayoutSize);
 
-vec2 hash2D(in vec2 p) {
-	float h = dot(p, vec2(12.9898, 78.233));
-	float h2 = dot(p, vec2(37.271, 377.632));
-	return -1.0 + 2.0 * vec2(fract(sin(h) * 43758.5453), fract(sin(h2) * 43758.5453));
-}
+	// R: low 8 bits of tile ID, G: high 4 bits of tile ID and flip flags, B: alpha
+	vec4 tile = texelFetch(layoutTex, ivec2(tilePos), 0);
+	if (tile.b <= 0.0) {
+		discard;
+	}
 
-vec3 voronoi(in vec2 p) {
-	vec2 n = floor(p);
-	vec2 f = fract(p);
+	int low = int(tile.r * 255.0 + 0.5);
+	int high = int(tile.g * 255.0 + 0.5);
+	int tileId = low | ((high & 0x0F) << 8);
 
-	vec2 mg, mr;
+	vec2 inTile = vTexCoords - floor(vTexCoords / 32.0) * 32.0;
+	if ((high & 0x10) != 0) {
+		inTile.x = 32.0 - inTile.x;
+	}
+	if ((high & 0x20) != 0) {
+		inTile.y = 32.0 - inTile.y;
+	}
 
-	float md = 8.0;
-	for (int j = -1; j <= 1; ++j) {
-		for (int i = -1; i <= 1; ++i) {
-			vec2 g = vec2(float(i), float(j));
-			vec2 o = hash2D(n + g);
+	vec2 atlasPos = vec2(float(tileId % TilesPerRow), float(tileId / TilesPerRow)) * 32.0 + inTile;
+	fragColor = texture(uTexture, atlasPos / AtlasSize) * vec4(1.0, 1.0, 1.0, tile.b) * vColor;
+}
+)";
 
-			vec2 r = g + o - f;
-			float d = dot(r, r);
+			_layoutLayerShader = std::make_unique<Shader>("LayoutLayer", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE, LayoutLayerFs);
+		}
 
-			if (d < md) {
-				md = d;
-				mr = r;
-				mg = g;
-			}
+		Vector2i layoutSize = layer.LayoutSize;
+		std::unique_ptr<uint8_t[]> texels = std::make_unique<uint8_t[]>(layoutSize.X * layoutSize.Y * 4);
+		for (int i = 0; i < layoutSize.X * layoutSize.Y; i++) {
+			LayerTile tile = layer.Layout[i];
+			int tileId = tile.TileID();
+			uint8_t alpha = (tile.HasExtra() ? GetTileExtra(layer, i)->MaterialAlpha : 255);
+
+			uint8_t* texel = &texels[i * 4];
+			texel[0] = (uint8_t)(tileId & 0xFF);
+			texel[1] = (uint8_t)((tileId >> 8) & 0x0F) | (tile.IsFlippedX() ? 0x10 : 0) | (tile.IsFlippedY() ? 0x20 : 0);
+			texel[2] = alpha;
+			texel[3] = 255;
 		}
-	}
-	return vec3(md, mr);
-}
 
-float addStarField(vec2 samplePosition, float threshold) {
-	vec3 starValue = voronoi(samplePosition);
-	if (starValue.x < threshold) {
-		float power = 1.0 - (starValue.x / threshold);
-		return min(power * power * power, 0.5);
+		layer.LayoutTexture = std::make_unique<Texture>("TileLayout", Texture::Format::RGBA8, layoutSize.X, layoutSize.Y);
+		layer.LayoutTexture->loadFromTexels(texels.get());
+		layer.LayoutTexture->setMinFiltering(SamplerFilter::Nearest);
+		layer.LayoutTexture->setMagFiltering(SamplerFilter::Nearest);
 	}
-	return 0.0;
-}
-
-void main() {
-	// Position of pixel on screen (between -1 and 1)
-	vec2 targetCoord = vec2(2.0) * vTexCoords - vec2(1.0);
-
-	// Aspect ratio correction, so display circle instead of ellipse
-	targetCoord.x *= ViewSize.x / ViewSize.y;
 
-	// Distance to center of screen
-	float distance = length(targetCoord);
+	RenderCommand* TileMap::GetLayoutRenderCommand(TileMapLayer& layer, int viewportIndex)
+	{
+		// Commands are created when the viewport draws the layer for the first time
+		while (layer.LayoutRenderCommands.size() <= viewportIndex) {
+			auto command = layer.LayoutRenderCommands.emplace_back(std::make_unique<RenderCommand>()).get();
+			command->setType(RenderCommand::CommandTypes::SPRITE);
+			command->material().setShader(_layoutLayerShader.get());
+			command->material().setBlendingEnabled(true);
+			command->material().reserveUniformsDataMemory();
+			command->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
 
-	// x-coordinate of tunnel
-	float xShift = (targetCoord.x == 0.0 ? sign(targetCoord.y) * 0.5 : atan(targetCoord.y, targetCoord.x) * INV_PI);
+			GLUniformCache* textureUniform = command->material().uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->intValue(0) != 0) {
+				textureUniform->setIntValue(0); // GL_TEXTURE0
+			}
+			GLUniformCache* layoutTexUniform = command->material().uniform("layoutTex");
+			if (layoutTexUniform && layoutTexUniform->intValue(0) != 1) {
+				layoutTexUniform->setIntValue(1); // GL_TEXTURE1
+			}
 
-	vec2 texturePos = vec2(
-		(xShift)         * 1.0 + (shift.x * 0.01),
-		(1.0 / distance) * 1.4 + (shift.y * 0.002)
-	);
+			// Layout and tile set don't change, so uniforms are set only once
+			Vector2i layoutSize = layer.LayoutSize;
+			Vector2i texSize = _tileSet->_textureDiffuse->size();
+			command->material().uniform("LayoutSize")->setFloatValue(layoutSize.X, layoutSize.Y);
+			command->material().uniform("LayoutRepeat")->setFloatValue(layer.RepeatX ? 1.0f : 0.0f, layer.RepeatY ? 1.0f : 0.0f);
+			command->material().uniform("AtlasSize")->setFloatValue(texSize.X, texSize.Y);
+			command->material().uniform("TilesPerRow")->setIntValue(_tileSet->_tilesPerRow);
+			command->material().setTexture(0, *_tileSet->_textureDiffuse);
+			command->material().setTexture(1, *layer.LayoutTexture);
+		}
 
-	vec4 texColor = texture(uTexture, texturePos);
-	float horizonOpacity = 1.0 - clamp(pow(distance, 1.4) - 0.3, 0.0, 1.0);
-	
-	vec4 horizonColorWithStars = vec4(horizonColor, 1.0);
-	if (parallaxStarsEnabled > 0.0) {
-		vec2 samplePosition = (vTexCoords * ViewSize / ViewSize.xx) + CameraPosition.xy * 0.00012;
-		horizonColorWithStars += vec4(addStarField(samplePosition * 7.0, 0.00008));
-		
-		samplePosition = (vTexCoords * ViewSize / ViewSize.xx) + CameraPosition.xy * 0.00018 + 0.5;
-		horizonColorWithStars += vec4(addStarField(samplePosition * 7.0, 0.00008));
+		return layer.LayoutRenderCommands[viewportIndex].get();
 	}
 
-	fragColor = mix(texColor, horizonColorWithStars, horizonOpacity);
-	fragColor.a = 1.0;
-}
-)";
+	void TileMap::RenderLayoutLayer(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex, float offsetX, float offsetY)
+	{
+		Vector2i viewSize = _levelHandler->GetViewSize(viewportIndex);
+		Vector2f viewCenter = _levelHandler->GetCameraPos(viewportIndex);
 
-			if (_texturedBackgroundShader == nullptr) {
-				_texturedBackgroundShader = std::make_unique<Shader>("TexturedBackground", Shader::LoadMode::STRING, Shader::DefaultVertex::SPRITE,
-					_layers[_texturedBackgroundLayer].BackgroundStyle == BackgroundStyle::Circle ? TexturedBackgroundCircleFs : TexturedBackgroundFs);
-			}
+		// Quad is slightly larger than the view, so no edge is left uncovered
+		float width = (float)(viewSize.X + 2);
+		float height = (float)(viewSize.Y + 2);
+		float texBiasX = viewCenter.X - width * 0.5f + offsetX;
+		float texBiasY = viewCenter.Y - height * 0.5f + offsetY;
 
-			Vector2i layoutSize = _layers[_texturedBackgroundLayer].LayoutSize;
-			width = layoutSize.X * TileSet::DefaultTileSize;
-			height = layoutSize.Y * TileSet::DefaultTileSize;
-			_texturedBackgroundPass.Initialize(width, height);
+		if ((viewSize.X & 1) == 1) {
+			texBiasX += 0.5f;
+		}
+		if ((viewSize.Y & 1) == 1) {
+			texBiasY -= 0.5f;
 		}
+
+		auto command = GetLayoutRenderCommand(layer, viewportIndex);
+
+		// Texture coordinates of the quad are in pixels of the layer
+		auto instanceBlock = command->material().uniformBlock(_layoutLayerHandles.block);
+		instanceBlock->uniform(_layoutLayerHandles.texRect)->setFloatValue(width, texBiasX, height, texBiasY);
+		instanceBlock->uniform(_layoutLayerHandles.spriteSize)->setFloatValue(width, height);
+		instanceBlock->uniform(_layoutLayerHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+
+		Matrix4x4f worldMatrix = Matrix4x4f::Translation(viewCenter.X, viewCenter.Y, 0.0f);
+		command->setTransformation(worldMatrix);
+		command->setLayer(layer.Depth);
+
+		renderQueue.addCommand(command);
 	}
 
 	void TileMap::TexturedBackgroundPass::Initialize(int width, int height)
@@ -1362,8 +1548,11 @@ void main() {
 			_target->setMagFiltering(SamplerFilter::Linear);
 			_target->setWrap(SamplerWrapping::Repeat);
 
-			// Prepare render commands
-			int renderCommandCount = (width * height) / (TileSet::DefaultTileSize * TileSet::DefaultTileSize);
+			TileMapLayer& layer = _owner->_layers[_owner->_texturedBackgroundLayer];
+			Vector2i layoutSize = layer.LayoutSize;
+
+			// Prepare render commands, one for each tile of the layout
+			int renderCommandCount = layoutSize.X * layoutSize.Y;
 			_renderCommands.reserve(renderCommandCount);
 			for (int i = 0; i < renderCommandCount; i++) {
 				std::unique_ptr<RenderCommand>& command = _renderCommands.emplace_back(std::make_unique<RenderCommand>());
@@ -1376,107 +1565,179 @@ void main() {
 				if (textureUniform && textureUniform->intValue(0) != 0) {
 					textureUniform->setIntValue(0); // GL_TEXTURE0
 				}
-			}
 
-			// Prepare output render command
-			_outputRenderCommand.setType(RenderCommand::CommandTypes::SPRITE);
-			_outputRenderCommand.material().setShader(_owner->_texturedBackgroundShader.get());
-			_outputRenderCommand.material().reserveUniformsDataMemory();
-			_outputRenderCommand.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+				int x = i % layoutSize.X;
+				int y = i / layoutSize.X;
+				Matrix4x4f worldMatrix = Matrix4x4f::Translation(std::floor(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2)), std::floor(y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2)), 0.0f);
+				command->setTransformation(worldMatrix);
+				command->material().setTexture(*_owner->_tileSet->_textureDiffuse);
 
-			GLUniformCache* textureUniform = _outputRenderCommand.material().uniform(Material::TextureUniformName);
-			if (textureUniform && textureUniform->intValue(0) != 0) {
-				textureUniform->setIntValue(0); // GL_TEXTURE0
+				auto instanceBlock = command->material().uniformBlock(_instanceHandles.block);
+				instanceBlock->uniform(_instanceHandles.spriteSize)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
+				instanceBlock->uniform(_instanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+
+				if (layer.Layout[i].IsAnimated()) {
+					_animatedPositions.push_back(i);
+				}
+			}
+
+			// Whole target has to be rendered for the first time
+			_renderedTileIds.assign(renderCommandCount, -1);
+			_dirtyTiles.reserve(renderCommandCount);
+			for (int i = 0; i < renderCommandCount; i++) {
+				_dirtyTiles.push_back(i);
 			}
 		}
 
-		Viewport::chain().push_back(_view.get());
+		// Viewport chain was cleared, the pass is added back only if there is something to render
+		_isInChain = false;
+		UpdateViewportChain();
 	}
 
-	bool TileMap::TexturedBackgroundPass::OnDraw(RenderQueue& renderQueue)
+	void TileMap::TexturedBackgroundPass::InvalidateAnimatedTiles()
 	{
+		if (_view == nullptr) {
+			return;
+		}
+
 		TileMapLayer& layer = _owner->_layers[_owner->_texturedBackgroundLayer];
-		Vector2i layoutSize = layer.LayoutSize;
-		Vector2i targetSize = _target->size();
+		for (int32_t tileIdx : _animatedPositions) {
+			// Tiles that weren't rendered yet are already in the list
+			int32_t renderedTileId = _renderedTileIds[tileIdx];
+			if (renderedTileId == -1) {
+				continue;
+			}
 
-		int renderCommandIndex = 0;
-		bool isAnimated = false;
+			int animTileId = layer.Layout[tileIdx].TileID();
+			if (animTileId < _owner->_animatedTiles.size()) {
+				AnimatedTile& animTile = _owner->_animatedTiles[animTileId];
+				if (animTile.Tiles[animTile.CurrentTileIdx].TileID != renderedTileId) {
+					_renderedTileIds[tileIdx] = -1;
+					_dirtyTiles.push_back(tileIdx);
+				}
+			}
+		}
 
-		for (int y = 0; y < layoutSize.Y; y++) {
-			for (int x = 0; x < layoutSize.X; x++) {
-				LayerTile tile = layer.Layout[x + y * layer.LayoutSize.X];
+		UpdateViewportChain();
+	}
 
-				int tileId;
-				bool isFlippedX, isFlippedY;
-				if (tile.IsAnimated) {
-					isAnimated = true;
-					if (tile.TileID < _owner->_animatedTiles.size()) {
-						tileId = _owner->_animatedTiles[tile.TileID].Tiles[_owner->_animatedTiles[tile.TileID].CurrentTileIdx].TileID;
-						// TODO
-						//isFlippedX = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedX != tile.IsFlippedX);
-						//isFlippedY = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedY != tile.IsFlippedY);
-						isFlippedX = false;
-						isFlippedY = false;
-					} else {
-						continue;
-					}
-				} else {
-					tileId = tile.TileID;
-					isFlippedX = tile.IsFlippedX;
-					isFlippedY = tile.IsFlippedY;
+	void TileMap::TexturedBackgroundPass::UpdateViewportChain()
+	{
+		// Viewport can't be removed in OnDraw(), because it wouldn't be drawn in that frame at all
+		bool shouldBeInChain = !_dirtyTiles.empty();
+		if (_isInChain == shouldBeInChain) {
+			return;
+		}
+
+		_isInChain = shouldBeInChain;
+		if (shouldBeInChain) {
+			Viewport::chain().push_back(_view.get());
+		} else {
+			auto it = Viewport::chain().begin();
+			while (it != Viewport::chain().end()) {
+				if (*it == _view.get()) {
+					Viewport::chain().erase(it);
+					break;
 				}
+				++it;
+			}
+		}
+	}
+
+	TileMap::TexturedBackgroundPass::OutputCommand* TileMap::TexturedBackgroundPass::GetOutputCommand(int viewportIndex)
+	{
+		// Commands are created when the viewport draws the background for the first time
+		while (_outputCommands.size() <= viewportIndex) {
+			auto output = _outputCommands.emplace_back(std::make_unique<OutputCommand>()).get();
+			output->ViewSize = Vector2i(0, 0);
+
+			TileMapLayer& layer = _owner->_layers[_owner->_texturedBackgroundLayer];
+			auto& command = output->Command;
+			command.setType(RenderCommand::CommandTypes::SPRITE);
+			command.material().setShader(_owner->_texturedBackgroundShader.get());
+			command.material().reserveUniformsDataMemory();
+			command.geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+
+			GLUniformCache* textureUniform = command.material().uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->intValue(0) != 0) {
+				textureUniform->setIntValue(0); // GL_TEXTURE0
+			}
 
-				auto command = _renderCommands[renderCommandIndex++].get();
+			auto instanceBlock = command.material().uniformBlock(_outputInstanceHandles.block);
+			instanceBlock->uniform(_outputInstanceHandles.texRect)->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+			instanceBlock->uniform(_outputInstanceHandles.color)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
 
-				Vector2i texSize = _owner->_tileSet->_textureDiffuse->size();
-				float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
-				float texBiasX = (tileId % _owner->_tileSet->_tilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
-				float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
-				float texBiasY = (tileId / _owner->_tileSet->_tilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
+			command.material().uniform("horizonColor")->setFloatValue(layer.BackgroundColor.X, layer.BackgroundColor.Y, layer.BackgroundColor.Z);
+			command.material().uniform("parallaxStarsEnabled")->setFloatValue(layer.ParallaxStarsEnabled ? 1.0f : 0.0f);
+			command.material().uniform("circleStyle")->setFloatValue(layer.BackgroundStyle == BackgroundStyle::Circle ? 1.0f : 0.0f);
+			command.material().setTexture(*_target);
+			command.setLayer(layer.Depth);
+		}
 
-				// ToDo: Flip normal map somehow
-				if (isFlippedX) {
-					texBiasX += texScaleX;
-					texScaleX *= -1;
-				}
-				if (isFlippedY) {
-					texBiasY += texScaleY;
-					texScaleY *= -1;
-				}
+		return _outputCommands[viewportIndex].get();
+	}
 
-				if ((targetSize.X & 1) == 1) {
-					texBiasX += 0.5f / float(texSize.X);
-				}
-				if ((targetSize.Y & 1) == 1) {
-					texBiasY -= 0.5f / float(texSize.Y);
+	bool TileMap::TexturedBackgroundPass::OnDraw(RenderQueue& renderQueue)
+	{
+		TileMapLayer& layer = _owner->_layers[_owner->_texturedBackgroundLayer];
+		Vector2i targetSize = _target->size();
+
+		// Target is never cleared, so only tiles that changed since the last pass are rendered again
+		for (int32_t tileIdx : _dirtyTiles) {
+			LayerTile tile = layer.Layout[tileIdx];
+
+			int tileId;
+			bool isFlippedX, isFlippedY;
+			if (tile.IsAnimated()) {
+				if (tile.TileID() < _owner->_animatedTiles.size()) {
+					tileId = _owner->_animatedTiles[tile.TileID()].Tiles[_owner->_animatedTiles[tile.TileID()].CurrentTileIdx].TileID;
+					// TODO
+					//isFlippedX = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedX != tile.IsFlippedX);
+					//isFlippedY = (_animatedTiles[tile.TileID].CurrentTile.IsFlippedY != tile.IsFlippedY);
+					isFlippedX = false;
+					isFlippedY = false;
+				} else {
+					continue;
 				}
+			} else {
+				tileId = tile.TileID();
+				isFlippedX = tile.IsFlippedX();
+				isFlippedY = tile.IsFlippedY();
+			}
 
-				auto instanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-				instanceBlock->uniform(Material::TexRectUniformName)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
-				instanceBlock->uniform(Material::SpriteSizeUniformName)->setFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
-				instanceBlock->uniform(Material::ColorUniformName)->setFloatVector(Colorf(1.0f, 1.0f, 1.0f, 1.0f).Data());
+			auto command = _renderCommands[tileIdx].get();
 
-				Matrix4x4f worldMatrix = Matrix4x4f::Translation(std::floor(x * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2)), std::floor(y * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2)), 0.0f);
-				command->setTransformation(worldMatrix);
-				command->material().setTexture(*_owner->_tileSet->_textureDiffuse);
+			Vector2i texSize = _owner->_tileSet->_textureDiffuse->size();
+			float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
+			float texBiasX = (tileId % _owner->_tileSet->_tilesPerRow) * TileSet::DefaultTileSize / float(texSize.X);
+			float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
+			float texBiasY = (tileId / _owner->_tileSet->_tilesPerRow) * TileSet::DefaultTileSize / float(texSize.Y);
 
-				renderQueue.addCommand(command);
+			// ToDo: Flip normal map somehow
+			if (isFlippedX) {
+				texBiasX += texScaleX;
+				texScaleX *= -1;
+			}
+			if (isFlippedY) {
+				texBiasY += texScaleY;
+				texScaleY *= -1;
 			}
-		}
 
-		if (!isAnimated && _alreadyRendered) {
-			// If it's not animated, it can be rendered only once
-			auto it = Viewport::chain().begin();
-			while (it != Viewport::chain().end()) {
-				if (*it == _view.get()) {
-					Viewport::chain().erase(it);
-					break;
-				}
-				++it;
+			if ((targetSize.X & 1) == 1) {
+				texBiasX += 0.5f / float(texSize.X);
 			}
+			if ((targetSize.Y & 1) == 1) {
+				texBiasY -= 0.5f / float(texSize.Y);
+			}
+
+			auto instanceBlock = command->material().uniformBlock(_instanceHandles.block);
+			instanceBlock->uniform(_instanceHandles.texRect)->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+
+			renderQueue.addCommand(command);
+			_renderedTileIds[tileIdx] = tileId;
 		}
 
-		_alreadyRendered = true;
+		_dirtyTiles.clear();
 		return true;
 	}
 }
\ No newline at end of file
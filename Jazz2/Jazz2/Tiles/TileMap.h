@@ -1,8 +1,10 @@
 ﻿#pragma once
 
 #include "../ILevelHandler.h"
+#include "../TimerWheel.h"
 #include "TileSet.h"
 
+#include "../../nCine/Base/HashMap.h"
 #include "../../nCine/IO/IFileStream.h"
 
 namespace Jazz2
@@ -12,16 +14,46 @@ namespace Jazz2
 
 namespace Jazz2::Tiles
 {
+	/// Packed tile stored in the dense layout of a layer, only data needed for rendering and collisions are included
 	struct LayerTile {
-		int TileID;
+		static constexpr uint16_t TileIDMask = 0x0FFF;
+		static constexpr uint16_t FlippedXFlag = 0x1000;
+		static constexpr uint16_t FlippedYFlag = 0x2000;
+		static constexpr uint16_t AnimatedFlag = 0x4000;
+		/// Tile has rarely used data stored in `TileMapLayer::Extra`
+		static constexpr uint16_t HasExtraFlag = 0x8000;
 
-		//Material* Material;
-		//Vector2i MaterialOffset;
-		uint8_t MaterialAlpha;
+		uint16_t Value;
+
+		int TileID() const {
+			return (Value & TileIDMask);
+		}
+		void SetTileID(int tileId) {
+			ASSERT_MSG_X(tileId >= 0 && tileId <= TileIDMask, "Tile ID %i doesn't fit into 12 bits", tileId);
+			Value = (uint16_t)((Value & ~TileIDMask) | (tileId & TileIDMask));
+		}
+
+		bool IsFlippedX() const {
+			return (Value & FlippedXFlag) != 0;
+		}
+		bool IsFlippedY() const {
+			return (Value & FlippedYFlag) != 0;
+		}
+		bool IsAnimated() const {
+			return (Value & AnimatedFlag) != 0;
+		}
+		bool HasExtra() const {
+			return (Value & HasExtraFlag) != 0;
+		}
 
-		bool IsFlippedX;
-		bool IsFlippedY;
-		bool IsAnimated;
+		void SetFlag(uint16_t flag, bool value) {
+			Value = (uint16_t)(value ? (Value | flag) : (Value & ~flag));
+		}
+	};
+
+	/// Rarely used data of a tile, stored aside from the dense layout
+	struct LayerTileExtra {
+		uint8_t MaterialAlpha;
 
 		// Collision affecting modifiers
 		bool IsOneWay;
@@ -33,8 +65,6 @@ namespace Jazz2::Tiles
 
 		// ToDo: I don't know if it's good solution for this
 		unsigned int ExtraData;
-		// ToDo: I don't know if it's used at all
-		//public bool TilesetDefault;
 	};
 
 	struct TileMapLayer {
@@ -42,6 +72,8 @@ namespace Jazz2::Tiles
 
 		std::unique_ptr<LayerTile[]> Layout;
 		Vector2i LayoutSize;
+		/// Extra data of tiles with `LayerTile::HasExtraFlag`, indexed by position in the layout
+		HashMap<int32_t, LayerTileExtra> Extra;
 
 		uint16_t Depth;
 		float SpeedX;
@@ -60,6 +92,12 @@ namespace Jazz2::Tiles
 		BackgroundStyle BackgroundStyle;
 		Vector3f BackgroundColor;
 		bool ParallaxStarsEnabled;
+
+		/// Layer content never changes, so the layout can be uploaded once and tiles looked up on GPU
+		bool UseLayoutTexture;
+		std::unique_ptr<Texture> LayoutTexture;
+		/// View-dependent uniforms differ for each viewport, so each viewport has its own command
+		SmallVector<std::unique_ptr<RenderCommand>, 1> LayoutRenderCommands;
 	};
 
 	struct AnimatedTileFrame {
@@ -176,11 +214,14 @@ namespace Jazz2::Tiles
 
 		public:
 			TexturedBackgroundPass(TileMap* owner)
-				: _owner(owner), _alreadyRendered(false)
+				: _owner(owner), _isInChain(false), _viewSizeHandle("ViewSize"),
+					_cameraPositionHandle("CameraPosition"), _shiftHandle("shift")
 			{
 			}
 
 			void Initialize(int width, int height);
+			/// Finds animated tiles that changed frame since they were rendered, so only they are rendered again
+			void InvalidateAnimatedTiles();
 
 			bool OnDraw(RenderQueue& renderQueue) override;
 
@@ -190,8 +231,30 @@ namespace Jazz2::Tiles
 			std::unique_ptr<Viewport> _view;
 			std::unique_ptr<Camera> _camera;
 			SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
-			RenderCommand _outputRenderCommand;
-			bool _alreadyRendered;
+			/// Output command of each viewport, uniforms that don't depend on camera are set only when the view size changes
+			struct OutputCommand
+			{
+				RenderCommand Command;
+				Vector2i ViewSize;
+			};
+			SmallVector<std::unique_ptr<OutputCommand>, 1> _outputCommands;
+
+			/// Tile ID rendered to each position of the target, -1 if it has to be rendered again
+			SmallVector<int32_t, 0> _renderedTileIds;
+			/// Positions of the layout with animated tiles
+			SmallVector<int32_t, 0> _animatedPositions;
+			/// Positions of the layout to render in the next pass
+			SmallVector<int32_t, 0> _dirtyTiles;
+			bool _isInChain;
+
+			InstanceBlockHandles _instanceHandles;
+			InstanceBlockHandles _outputInstanceHandles;
+			GLUniformHandle _viewSizeHandle;
+			GLUniformHandle _cameraPositionHandle;
+			GLUniformHandle _shiftHandle;
+
+			void UpdateViewportChain();
+			OutputCommand* GetOutputCommand(int viewportIndex);
 		};
 
 		LevelHandler* _levelHandler;
@@ -202,36 +265,49 @@ namespace Jazz2::Tiles
 		std::unique_ptr<TileSet> _tileSet;
 		SmallVector<TileMapLayer, 0> _layers;
 		SmallVector<AnimatedTile, 0> _animatedTiles;
-		SmallVector<Vector2i, 0> _activeCollapsingTiles;
+		/// Collapsing tiles are woken up only when their next animation frame is due
+		TimerWheel<int32_t> _collapsingTiles;
+		BitArray _collapsingTileState;
 		float _collapsingTimer;
 		BitArray _triggerState;
 
 		SmallVector<DestructibleDebris, 0> _debrisList;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		int _renderCommandsCount;
+		InstanceBlockHandles _instanceHandles;
 
 		int _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 		std::unique_ptr<Shader> _texturedBackgroundShader;
+		std::unique_ptr<Shader> _layoutLayerShader;
+		/// Handles used only with the layout layer shader, the shared ones are resolved for the sprite shader
+		InstanceBlockHandles _layoutLayerHandles;
 
-		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer);
+		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex);
 		static float TranslateCoordinate(float coordinate, float speed, float offset, bool isY, int viewHeight, int viewWidth);
 		RenderCommand* RentRenderCommand();
 
-		bool AdvanceDestructibleTileAnimation(LayerTile& tile, int tx, int ty, int& amount, const StringView& soundName);
+		bool AdvanceDestructibleTileAnimation(LayerTile& tile, LayerTileExtra& extra, int tx, int ty, int& amount, const StringView& soundName);
 		void AdvanceCollapsingTileTimers(float timeMult);
 
-		void SetTileDestructibleEventFlag(LayerTile& tile, TileDestructType type, uint16_t extraData);
+		void SetTileDestructibleEventFlag(LayerTile& tile, LayerTileExtra& extra, TileDestructType type, uint16_t extraData);
 
 		void UpdateDebris(float timeMult);
 		void DrawDebris(RenderQueue& renderQueue);
 
-		void RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, float x, float y);
+		void RenderTexturedBackground(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex, float x, float y);
+
+		void InitializeLayoutLayer(TileMapLayer& layer);
+		RenderCommand* GetLayoutRenderCommand(TileMapLayer& layer, int viewportIndex);
+		void RenderLayoutLayer(RenderQueue& renderQueue, TileMapLayer& layer, int viewportIndex, float offsetX, float offsetY);
+
+		static LayerTileExtra* GetTileExtra(TileMapLayer& layer, int32_t tileIdx);
+		static LayerTileExtra& GetOrCreateTileExtra(TileMapLayer& layer, int32_t tileIdx);
 
-		inline int ResolveTileID(LayerTile& tile)
+		inline int ResolveTileID(LayerTile tile)
 		{
-			int tileId = tile.TileID;
-			if (tile.IsAnimated) {
+			int tileId = tile.TileID();
+			if (tile.IsAnimated()) {
 				tileId = _animatedTiles[tileId].Tiles[_animatedTiles[tileId].CurrentTileIdx].TileID;
 			}
 			return tileId;
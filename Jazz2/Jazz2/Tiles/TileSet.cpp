@@ -69,4 +69,35 @@ namespace Jazz2::Tiles
 		}
 	}
 
+	TileSet::TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask, const uint8_t* tileFlags)
+		:
+		_textureDiffuse(std::move(textureDiffuse)),
+		_mask(std::move(mask)),
+		_isMaskEmpty(),
+		_isMaskFilled(),
+		_isTileFilled()
+	{
+		auto texSize = _textureDiffuse->size();
+
+		int tw = (texSize.X / DefaultTileSize);
+		int th = (texSize.Y / DefaultTileSize);
+
+		_tileCount = tw * th;
+		_tilesPerRow = tw;
+		_isMaskEmpty.SetSize(_tileCount);
+		_isMaskFilled.SetSize(_tileCount);
+		_isTileFilled.SetSize(_tileCount);
+
+		for (int i = 0; i < _tileCount; i++) {
+			if ((tileFlags[i] & MaskEmptyFlag) != 0) {
+				_isMaskEmpty.Set(i);
+			}
+			if ((tileFlags[i] & MaskFilledFlag) != 0) {
+				_isMaskFilled.Set(i);
+			}
+			if ((tileFlags[i] & TileFilledFlag) != 0) {
+				_isTileFilled.Set(i);
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -12,7 +12,18 @@ namespace Jazz2::Tiles
 	public:
 		static constexpr int DefaultTileSize = 32;
 
+		/// Flags of precomputed tile masks
+		static constexpr uint8_t MaskEmptyFlag = 0x01;
+		static constexpr uint8_t MaskFilledFlag = 0x02;
+		static constexpr uint8_t TileFilledFlag = 0x04;
+
+		/// Header of precomputed tile mask files, files with different signature or version are ignored
+		static constexpr uint32_t MaskFileSignature = 0x4B53414D;	// MASK
+		static constexpr uint16_t MaskFileVersion = 1;
+
 		TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask);
+		/// Creates tile set with precomputed flags of each tile, so the mask doesn't have to be scanned
+		TileSet(std::unique_ptr<Texture> textureDiffuse, std::unique_ptr<uint8_t[]> mask, const uint8_t* tileFlags);
 
 		uint8_t* GetTileMask(int tileId) const
 		{
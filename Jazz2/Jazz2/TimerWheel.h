@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include <utility>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2
+{
+	/// Hierarchical timer wheel keyed by integer ticks
+	/*! Timers are kept in slots of the level matching their distance from the current tick and cascade
+	 *  to lower levels as the wheel turns, so advancing the wheel touches only timers that are due. */
+	template<typename T>
+	class TimerWheel
+	{
+	public:
+		static constexpr uint32_t SlotBits = 6;
+		static constexpr uint32_t SlotCount = (1 << SlotBits);
+		static constexpr uint32_t SlotMask = SlotCount - 1;
+		static constexpr uint32_t LevelCount = 4;
+
+		TimerWheel()
+			: _currentTick(0), _count(0)
+		{
+		}
+
+		/// Returns the next tick that will be processed
+		uint32_t GetCurrentTick() const {
+			return _currentTick;
+		}
+
+		std::size_t size() const {
+			return _count;
+		}
+		bool empty() const {
+			return (_count == 0);
+		}
+
+		/// Schedules the value to be fired at the specified tick, ticks that already passed are fired in the next advance
+		void Schedule(uint32_t tick, const T& value)
+		{
+			if (tick < _currentTick) {
+				tick = _currentTick;
+			}
+			Insert(tick, value);
+			_count++;
+		}
+
+		/// Processes all ticks up to (and including) the specified tick and calls the callback for each due value
+		template<typename Callback>
+		void Advance(uint32_t tick, Callback&& callback)
+		{
+			while (_currentTick <= tick) {
+				if (_count == 0) {
+					_currentTick = tick + 1;
+					break;
+				}
+
+				// Move timers of higher levels down when the lower level wraps around
+				for (uint32_t level = 1; level < LevelCount; level++) {
+					if ((_currentTick & ((1u << (SlotBits * level)) - 1)) != 0) {
+						break;
+					}
+					std::swap(_cascading, _slots[level][(_currentTick >> (SlotBits * level)) & SlotMask]);
+					for (auto& entry : _cascading) {
+						Insert(entry.Tick, entry.Value);
+					}
+					_cascading.clear();
+				}
+
+				// Callbacks can schedule new timers, they will be fired on the next tick at the earliest
+				std::swap(_firing, _slots[0][_currentTick & SlotMask]);
+				_currentTick++;
+				_count -= (uint32_t)_firing.size();
+				for (auto& entry : _firing) {
+					callback(entry.Value);
+				}
+				_firing.clear();
+			}
+		}
+
+		void Clear()
+		{
+			for (auto& level : _slots) {
+				for (auto& slot : level) {
+					slot.clear();
+				}
+			}
+			_count = 0;
+		}
+
+	private:
+		struct Entry {
+			uint32_t Tick;
+			T Value;
+		};
+
+		SmallVector<Entry, 0> _slots[LevelCount][SlotCount];
+		SmallVector<Entry, 0> _cascading;
+		SmallVector<Entry, 0> _firing;
+		uint32_t _currentTick;
+		uint32_t _count;
+
+		void Insert(uint32_t tick, const T& value)
+		{
+			// The lowest level whose upper bits match the current tick, ticks too far in the future stay in the highest level until it turns around
+			uint32_t level = 0;
+			while (level < LevelCount - 1 && (tick >> (SlotBits * (level + 1))) != (_currentTick >> (SlotBits * (level + 1)))) {
+				level++;
+			}
+			_slots[level][(tick >> (SlotBits * level)) & SlotMask].push_back({ tick, value });
+		}
+	};
+}
@@ -19,6 +19,8 @@
 #include "Jazz2/IRootController.h"
 #include "Jazz2/ContentResolver.h"
 #include "Jazz2/LevelHandler.h"
+#include "Jazz2/ActorPool.h"
+#include "Jazz2/Compatibility/JJ2Converter.h"
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(WITH_QT5)
 #	include <cstdlib> // for `__argc` and `__argv`
@@ -157,15 +159,31 @@ void GameEventHandler::onInit()
 	theApplication().inputManager().addJoyMappingsFromFile(fs::joinPath({ "Content"_s, "gamecontrollerdb.txt"_s }));
 #endif
 
+	// Game code doesn't read absolute transformations of nodes during update
+	theApplication().renderingSettings().flattenedUpdateEnabled = true;
+
+	// "--players [count]" starts local multiplayer with split screen
+	int playerCount = 1;
+	const AppConfiguration& appCfg = theApplication().appConfiguration();
+	for (int i = 1; i < appCfg.argc() - 1; i++) {
+		if (strcmp(appCfg.argv(i), "--players") == 0) {
+			playerCount = std::clamp(atoi(appCfg.argv(i + 1)), 1, Jazz2::LevelInitialization::MaxPlayerCount);
+		}
+	}
+
 	// TODO
-	Jazz2::PlayerType players[] = { Jazz2::PlayerType::Spaz };
-	Jazz2::LevelInitialization levelInit("share"_s, "01_share1"_s, Jazz2::GameDifficulty::Normal, false, false, players, _countof(players));
+	Jazz2::PlayerType players[] = { Jazz2::PlayerType::Spaz, Jazz2::PlayerType::Jazz, Jazz2::PlayerType::Spaz, Jazz2::PlayerType::Jazz };
+	Jazz2::LevelInitialization levelInit("share"_s, "01_share1"_s, Jazz2::GameDifficulty::Normal, false, false, players, playerCount);
 	ChangeLevel(std::move(levelInit));
 }
 
 void GameEventHandler::onFrameStart()
 {
 	if (_pendingLevelChange != nullptr) {
+		// Previous level is unloaded first, so blocks cached by actor pools can be released before the next one is loaded
+		_currentHandler = nullptr;
+		Jazz2::ActorPools::TrimAll();
+
 		_currentHandler = std::make_unique<Jazz2::LevelHandler>(this, *_pendingLevelChange.get());
 
 		Viewport::chain().clear();
@@ -190,6 +208,7 @@ void GameEventHandler::onPostUpdate()
 void GameEventHandler::onShutdown()
 {
 	_currentHandler = nullptr;
+	Jazz2::ActorPools::TrimAll();
 
 	Jazz2::ContentResolver::Current().Release();
 }
@@ -265,6 +284,27 @@ int main(int argc, char** argv)
 #	define __argv argv
 #endif
 
+#if !defined(DEATH_TARGET_ANDROID) && !defined(DEATH_TARGET_EMSCRIPTEN)
+	// Files of the original game are converted before start, unchanged files are skipped,
+	// "--convert [path]" converts them and exits without starting the game
+	const char* sourcePath = "Source";
+	bool convertOnly = false;
+	for (int i = 1; i < __argc && __argv != nullptr; i++) {
+		if (strcmp(__argv[i], "--convert") == 0) {
+			convertOnly = true;
+			if (i + 1 < __argc) {
+				sourcePath = __argv[++i];
+			}
+		}
+	}
+	if (convertOnly || fs::isDirectory(sourcePath)) {
+		bool success = Jazz2::Compatibility::JJ2Converter::Convert(sourcePath, "Content"_s);
+		if (convertOnly) {
+			return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+#endif
+
 	return PCApplication::start([]() -> std::unique_ptr<IAppEventHandler> {
 		return std::make_unique<GameEventHandler>();
 	}, __argc, __argv);
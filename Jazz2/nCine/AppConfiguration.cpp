@@ -27,6 +27,8 @@ namespace nCine
 #endif
 		vaoPoolSize(16),
 		renderCommandPoolSize(32),
+		audioStreamBufferCount(3),
+		audioStreamBufferSize(16 * 1024),
 		withDebugOverlay(false),
 		withAudio(true),
 		withThreads(false),
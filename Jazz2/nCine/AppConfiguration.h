@@ -58,6 +58,11 @@ namespace nCine
 		unsigned int vaoPoolSize;
 		/// The initial size for the pool of render commands
 		unsigned int renderCommandPoolSize;
+		/// The number of OpenAL buffers queued for each audio stream
+		unsigned int audioStreamBufferCount;
+		/// The size in bytes of each audio stream buffer
+		/*! \note With threading support, the same amount of decoded data is kept ready by the streaming thread */
+		unsigned int audioStreamBufferSize;
 
 		/// The flag is `true` if the debug overlay is enabled
 		bool withDebugOverlay;
@@ -38,6 +38,8 @@ extern "C"
 #include "Graphics/ScreenViewport.h"
 #include "Graphics/GL/GLDebug.h"
 #include "Base/Timer.h" // for `sleep()`
+#include "Base/AllocManager.h"
+#include "Base/FrameArena.h"
 #include "Base/FrameTimer.h"
 #include "Graphics/SceneNode.h"
 #include "Input/IInputManager.h"
@@ -166,6 +168,7 @@ namespace nCine
 		gfxDevice_->update();
 
 		frameTimer_ = std::make_unique<FrameTimer>(appCfg_.frameTimerLogInterval, appCfg_.profileTextUpdateTime());
+		frameArena_ = std::make_unique<FrameArena>();
 
 #ifdef WITH_IMGUI
 		imguiDrawing_ = std::make_unique<ImGuiDrawing>(appCfg_.withScenegraph);
@@ -219,6 +222,8 @@ namespace nCine
 	{
 
 		frameTimer_->addFrame();
+		// Transient data of the previous frame are not referenced anymore
+		frameArena_->reset();
 
 #ifdef WITH_IMGUI
 		{
@@ -364,9 +369,12 @@ namespace nCine
 		rootNode_.reset(nullptr);
 		RenderResources::dispose();
 		frameTimer_.reset(nullptr);
+		frameArena_.reset(nullptr);
 		inputManager_.reset(nullptr);
 		gfxDevice_.reset(nullptr);
 
+		AllocManager::logStatistics();
+
 		if (!theServiceLocator().indexer().empty()) {
 			LOGW_X("The object indexer is not empty, %u object(s) left", theServiceLocator().indexer().size());
 			//theServiceLocator().indexer().logReport();
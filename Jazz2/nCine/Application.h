@@ -9,6 +9,7 @@
 
 namespace nCine
 {
+	class FrameArena;
 	class FrameTimer;
 	class SceneNode;
 	class Viewport;
@@ -27,7 +28,7 @@ namespace nCine
 		{
 			RenderingSettings()
 				: batchingEnabled(true), batchingWithIndices(false),
-				cullingEnabled(true), minBatchSize(4), maxBatchSize(500) {}
+				cullingEnabled(true), flattenedUpdateEnabled(false), minBatchSize(4), maxBatchSize(500) {}
 
 			/// True if batching is enabled
 			bool batchingEnabled;
@@ -35,6 +36,10 @@ namespace nCine
 			bool batchingWithIndices;
 			/// True if node culling is enabled
 			bool cullingEnabled;
+			/// True if node transformations and culling are done in linear passes over a flattened node list
+			/*! Absolute transformations are then calculated after the whole tree has been updated,
+			 *  so they are not available to `OnUpdate()` of the same frame. */
+			bool flattenedUpdateEnabled;
 			/// Minimum size for a batch to be collected
 			unsigned int minBatchSize;
 			/// Maximum size for a batch before a forced split
@@ -116,6 +121,10 @@ namespace nCine
 		inline IInputManager& inputManager() {
 			return *inputManager_;
 		}
+		/// Returns the linear allocator for data that live no longer than the current frame
+		inline FrameArena& frameArena() {
+			return *frameArena_;
+		}
 
 		/// Returns the total number of frames already rendered
 		unsigned long int numFrames() const;
@@ -200,6 +209,7 @@ namespace nCine
 
 		TimeStamp profileStartTime_;
 		std::unique_ptr<FrameTimer> frameTimer_;
+		std::unique_ptr<FrameArena> frameArena_;
 		std::unique_ptr<IGfxDevice> gfxDevice_;
 		std::unique_ptr<SceneNode> rootNode_;
 		std::unique_ptr<ScreenViewport> screenViewport_;
@@ -3,6 +3,7 @@
 
 #include "AudioBuffer.h"
 #include "IAudioLoader.h"
+#include "../Base/CustomAllocator.h"
 
 namespace nCine
 {
@@ -179,7 +180,8 @@ namespace nCine
 
 		// Buffer size calculated as samples * channels * bytes per samples
 		const unsigned long int bufferSize = audioLoader.bufferSize();
-		std::unique_ptr<unsigned char[]> buffer = std::make_unique<unsigned char[]>(bufferSize);
+		std::unique_ptr<unsigned char[], CustomDeleter<theAudioAllocator>> buffer(static_cast<unsigned char*>(theAudioAllocator().allocate(bufferSize)));
+		RETURNF_ASSERT_MSG_X(buffer != nullptr, "Cannot allocate %lu bytes for audio buffer", bufferSize);
 
 		std::unique_ptr<IAudioReader> audioReader = audioLoader.createReader();
 		audioReader->read(buffer.get(), bufferSize);
@@ -4,25 +4,211 @@
 #include "AudioStream.h"
 #include "IAudioLoader.h"
 #include "IAudioReader.h"
+#include "../Application.h"
 #include "../ServiceLocator.h"
 
+#if defined(WITH_THREADS)
+#	include "../Base/Timer.h"
+#	include "../Threading/Thread.h"
+#	include "../Threading/ThreadSync.h"
+
+#	include <atomic>
+#endif
+
 namespace nCine
 {
+#if defined(WITH_THREADS)
+	/// Ring of decoded chunks filled by the streaming thread and drained by `AudioStream::enqueue()`
+	/*! There is exactly one producer and one consumer, so chunks are handed over through the two indices alone.
+	 *  The reader mutex is only contended when the main thread rewinds or replaces the reader. */
+	struct AudioStream::DecodeQueue
+	{
+		DecodeQueue(int numChunks, int chunkSize);
+		~DecodeQueue();
+
+		/// Decodes as many chunks as there are free slots, called from the streaming thread
+		void decode();
+		/// Discards every decoded chunk, the reader mutex has to be locked by the caller
+		void reset();
+
+		/// Protects the reader from concurrent access by the streaming thread
+		Mutex readerMutex;
+		/// The reader owned by the audio stream, or `nullptr` if not loaded yet
+		IAudioReader* reader;
+		std::atomic<bool> isLooping;
+		/// Set when the reader has no more data to decode
+		std::atomic<bool> endOfStream;
+
+		int numChunks;
+		int chunkSize;
+		std::unique_ptr<char[], CustomDeleter<theAudioAllocator>> data;
+		std::unique_ptr<unsigned long[]> sizes;
+		/// Total number of chunks consumed, only written by the main thread
+		std::atomic<unsigned int> readIndex;
+		/// Total number of chunks decoded, only written by the streaming thread
+		std::atomic<unsigned int> writeIndex;
+	};
+
+	namespace
+	{
+		/// Shared thread decoding every registered stream
+		class StreamingThread
+		{
+		public:
+			void add(AudioStream::DecodeQueue* queue);
+			void remove(AudioStream::DecodeQueue* queue);
+
+		private:
+			/// Time in seconds to wait between two decoding rounds
+			static constexpr float SleepTime = 0.005f;
+
+			Thread thread_;
+			Mutex queuesMutex_;
+			SmallVector<AudioStream::DecodeQueue*, 4> queues_;
+			std::atomic<bool> shouldQuit_ { false };
+			bool isRunning_ = false;
+
+			static void threadFunction(void* arg);
+		};
+
+		StreamingThread& streamingThread()
+		{
+			static StreamingThread instance;
+			return instance;
+		}
+
+		void StreamingThread::add(AudioStream::DecodeQueue* queue)
+		{
+			queuesMutex_.lock();
+			queues_.push_back(queue);
+			queuesMutex_.unlock();
+
+			// Streams are only created and destroyed by the main thread, the thread state doesn't need locking
+			if (!isRunning_) {
+				shouldQuit_ = false;
+				thread_.run(threadFunction, this);
+#if !defined(DEATH_TARGET_EMSCRIPTEN) && !defined(DEATH_TARGET_APPLE)
+				thread_.setName("Audio streaming");
+#endif
+				isRunning_ = true;
+			}
+		}
+
+		void StreamingThread::remove(AudioStream::DecodeQueue* queue)
+		{
+			queuesMutex_.lock();
+			for (unsigned int i = 0; i < queues_.size(); i++) {
+				if (queues_[i] == queue) {
+					queues_.erase(queues_.begin() + i);
+					break;
+				}
+			}
+			const bool isEmpty = queues_.empty();
+			queuesMutex_.unlock();
+
+			if (isEmpty && isRunning_) {
+				shouldQuit_ = true;
+				thread_.join();
+				isRunning_ = false;
+			}
+		}
+
+		void StreamingThread::threadFunction(void* arg)
+		{
+			StreamingThread* _this = static_cast<StreamingThread*>(arg);
+
+			while (!_this->shouldQuit_) {
+				_this->queuesMutex_.lock();
+				for (AudioStream::DecodeQueue* queue : _this->queues_) {
+					queue->decode();
+				}
+				_this->queuesMutex_.unlock();
+
+				Timer::sleep(SleepTime);
+			}
+		}
+	}
+
+	AudioStream::DecodeQueue::DecodeQueue(int numChunks, int chunkSize)
+		: reader(nullptr), isLooping(false), endOfStream(false), numChunks(numChunks), chunkSize(chunkSize),
+			data(static_cast<char*>(theAudioAllocator().allocate(numChunks * chunkSize))), sizes(std::make_unique<unsigned long[]>(numChunks)),
+			readIndex(0), writeIndex(0)
+	{
+		FATAL_ASSERT_MSG_X(data != nullptr, "Cannot allocate %i bytes for audio stream", numChunks * chunkSize);
+		streamingThread().add(this);
+	}
+
+	AudioStream::DecodeQueue::~DecodeQueue()
+	{
+		// After removal the streaming thread is guaranteed not to touch this queue anymore
+		streamingThread().remove(this);
+	}
+
+	void AudioStream::DecodeQueue::decode()
+	{
+		readerMutex.lock();
+
+		if (reader != nullptr) {
+			unsigned int index = writeIndex.load(std::memory_order_relaxed);
+			while (!endOfStream && index - readIndex.load(std::memory_order_acquire) < (unsigned int)numChunks) {
+				char* chunk = data.get() + (index % numChunks) * chunkSize;
+				unsigned long bytes = reader->read(chunk, chunkSize);
+
+				// EOF reached
+				if (bytes < (unsigned long)chunkSize && isLooping) {
+					reader->rewind();
+					const unsigned long moreBytes = reader->read(chunk + bytes, chunkSize - bytes);
+					bytes += moreBytes;
+				}
+
+				if (bytes == 0) {
+					endOfStream = true;
+					break;
+				}
+
+				sizes[index % numChunks] = bytes;
+				index++;
+				writeIndex.store(index, std::memory_order_release);
+			}
+		}
+
+		readerMutex.unlock();
+	}
+
+	void AudioStream::DecodeQueue::reset()
+	{
+		readIndex.store(0, std::memory_order_relaxed);
+		writeIndex.store(0, std::memory_order_relaxed);
+		endOfStream = false;
+	}
+#endif
+
 	///////////////////////////////////////////////////////////
 	// CONSTRUCTORS and DESTRUCTOR
 	///////////////////////////////////////////////////////////
 
 	/*! Private constructor called only by `AudioStreamPlayer`. */
 	AudioStream::AudioStream()
-		: nextAvailableBufferIndex_(0),
+		: numBuffers_(int(theApplication().appConfiguration().audioStreamBufferCount)), nextAvailableBufferIndex_(0),
+		bufferSize_(int(theApplication().appConfiguration().audioStreamBufferSize)),
 		currentBufferId_(0), bytesPerSample_(0), numChannels_(0), isLooping_(false),
-		frequency_(0), numSamples_(0), duration_(0.0f), buffersIds_(NumBuffers)
+		frequency_(0), numSamples_(0), duration_(0.0f)
 	{
+		if (numBuffers_ < 2) {
+			numBuffers_ = DefaultNumBuffers;
+		}
+
+		buffersIds_.resize(numBuffers_);
 		alGetError();
-		alGenBuffers(NumBuffers, buffersIds_.data());
+		alGenBuffers(numBuffers_, buffersIds_.data());
 		const ALenum error = alGetError();
 		ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
-		memBuffer_ = std::make_unique<char[]>(BufferSize);
+#if defined(WITH_THREADS)
+		decodeQueue_ = std::make_unique<DecodeQueue>(numBuffers_, bufferSize_);
+#else
+		memBuffer_.reset(static_cast<char*>(theAudioAllocator().allocate(bufferSize_)));
+		FATAL_ASSERT_MSG_X(memBuffer_ != nullptr, "Cannot allocate %i bytes for audio stream", bufferSize_);
+#endif
 	}
 
 	/*! Private constructor called only by `AudioStreamPlayer`. */
@@ -47,9 +233,14 @@ namespace nCine
 
 	AudioStream::~AudioStream()
 	{
+#if defined(WITH_THREADS)
+		// The queue has to be unregistered from the streaming thread before the reader is destroyed
+		decodeQueue_ = nullptr;
+#endif
+
 		// Don't delete buffers if this is a moved out object
-		if (buffersIds_.size() == NumBuffers) {
-			alDeleteBuffers(NumBuffers, buffersIds_.data());
+		if (!buffersIds_.empty()) {
+			alDeleteBuffers(numBuffers_, buffersIds_.data());
 		}
 	}
 
@@ -64,7 +255,7 @@ namespace nCine
 	unsigned long int AudioStream::numStreamSamples() const
 	{
 		if (numChannels_ * bytesPerSample_ > 0) {
-			return BufferSize / (numChannels_ * bytesPerSample_);
+			return bufferSize_ / (numChannels_ * bytesPerSample_);
 		}
 		return 0UL;
 	}
@@ -91,17 +282,42 @@ namespace nCine
 			numProcessedBuffers--;
 		}
 
+#if defined(WITH_THREADS)
+		decodeQueue_->isLooping = looping;
+
+		// Queueing of chunks already decoded by the streaming thread
+		while (nextAvailableBufferIndex_ < numBuffers_) {
+			const unsigned int readIndex = decodeQueue_->readIndex.load(std::memory_order_relaxed);
+			if (readIndex == decodeQueue_->writeIndex.load(std::memory_order_acquire)) {
+				break;
+			}
+
+			const int slot = readIndex % decodeQueue_->numChunks;
+			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
+			alBufferData(currentBufferId_, format_, decodeQueue_->data.get() + slot * bufferSize_, decodeQueue_->sizes[slot], frequency_);
+			alSourceQueueBuffers(source, 1, &currentBufferId_);
+			nextAvailableBufferIndex_++;
+			decodeQueue_->readIndex.store(readIndex + 1, std::memory_order_release);
+		}
+
+		// If there is no more data left to decode and the queue is empty
+		if (nextAvailableBufferIndex_ == 0 && decodeQueue_->endOfStream &&
+			decodeQueue_->readIndex.load(std::memory_order_relaxed) == decodeQueue_->writeIndex.load(std::memory_order_acquire)) {
+			shouldKeepPlaying = false;
+			stop(source);
+		}
+#else
 		// Queueing
-		if (nextAvailableBufferIndex_ < NumBuffers) {
+		if (nextAvailableBufferIndex_ < numBuffers_) {
 			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
 
-			unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
+			unsigned long bytes = audioReader_->read(memBuffer_.get(), bufferSize_);
 
 			// EOF reached
-			if (bytes < BufferSize) {
+			if (bytes < bufferSize_) {
 				if (looping) {
 					audioReader_->rewind();
-					const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
+					const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, bufferSize_ - bytes);
 					bytes += moreBytes;
 				}
 			}
@@ -119,6 +335,7 @@ namespace nCine
 				stop(source);
 			}
 		}
+#endif
 
 		ALenum state;
 		alGetSourcei(source, AL_SOURCE_STATE, &state);
@@ -153,7 +370,14 @@ namespace nCine
 			numProcessedBuffers--;
 		}
 
+#if defined(WITH_THREADS)
+		decodeQueue_->readerMutex.lock();
+		audioReader_->rewind();
+		decodeQueue_->reset();
+		decodeQueue_->readerMutex.unlock();
+#else
 		audioReader_->rewind();
+#endif
 		currentBufferId_ = 0;
 	}
 
@@ -162,7 +386,13 @@ namespace nCine
 		isLooping_ = isLooping;
 
 		if (audioReader_ != nullptr) {
+#if defined(WITH_THREADS)
+			decodeQueue_->readerMutex.lock();
 			audioReader_->setLooping(isLooping_);
+			decodeQueue_->readerMutex.unlock();
+#else
+			audioReader_->setLooping(isLooping_);
+#endif
 		}
 	}
 
@@ -213,8 +443,17 @@ namespace nCine
 			duration_ = -1.0;
 		}
 
+#if defined(WITH_THREADS)
+		decodeQueue_->readerMutex.lock();
+		audioReader_ = audioLoader.createReader();
+		audioReader_->setLooping(isLooping_);
+		decodeQueue_->reader = audioReader_.get();
+		decodeQueue_->reset();
+		decodeQueue_->readerMutex.unlock();
+#else
 		audioReader_ = audioLoader.createReader();
 		audioReader_->setLooping(isLooping_);
+#endif
 	}
 
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../Base/CustomAllocator.h"
+
 #include <memory>
 
 #include <Containers/SmallVector.h>
@@ -54,7 +56,7 @@ namespace nCine
 		unsigned long int numStreamSamples() const;
 		/// Returns the size of the streaming buffer in bytes
 		inline int streamBufferSize() const {
-			return BufferSize;
+			return bufferSize_;
 		}
 
 		/// Enqueues new buffers and unqueues processed ones
@@ -69,18 +71,30 @@ namespace nCine
 		/// Sets stream looping property
 		void setLooping(bool isLooping);
 
+#if defined(WITH_THREADS)
+		/// Decoded data shared with the streaming thread, only defined in the implementation file
+		struct DecodeQueue;
+#endif
+
 	private:
+		/// Default number of buffers for streaming
+		static const int DefaultNumBuffers = 3;
 		/// Number of buffers for streaming
-		static const int NumBuffers = 3;
+		int numBuffers_;
 		/// OpenAL buffer queue for streaming
-		SmallVector<unsigned int, NumBuffers> buffersIds_;
+		SmallVector<unsigned int, DefaultNumBuffers> buffersIds_;
 		/// Index of the next available OpenAL buffer
 		int nextAvailableBufferIndex_;
 
 		/// Size in bytes of each streaming buffer
-		static const int BufferSize = 16 * 1024;
+		int bufferSize_;
+#if defined(WITH_THREADS)
+		/// Decoded buffers produced by the streaming thread and consumed by `enqueue()`
+		std::unique_ptr<DecodeQueue> decodeQueue_;
+#else
 		/// Memory buffer to feed OpenAL ones
-		std::unique_ptr<char[]> memBuffer_;
+		std::unique_ptr<char[], CustomDeleter<theAudioAllocator>> memBuffer_;
+#endif
 
 		/// OpenAL id of the currently playing buffer, or 0 if not
 		unsigned int currentBufferId_;
@@ -0,0 +1,67 @@
+#include "AllocManager.h"
+#include "../../Common.h"
+
+#if defined(USE_FREELIST)
+#	include "FreeListAllocator.h"
+#else
+#	include "MallocAllocator.h"
+#endif
+
+namespace nCine
+{
+	namespace
+	{
+		/// Allocators are never destroyed, so memory can be released safely even during static destruction
+		template<class T>
+		struct StaticStorage
+		{
+			alignas(T) unsigned char data[sizeof(T)];
+		};
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	IAllocator& AllocManager::defaultAllocator()
+	{
+#if defined(USE_FREELIST)
+		static StaticStorage<FreeListAllocator> storage;
+		static IAllocator* allocator = new(storage.data) FreeListAllocator("Default", FREELIST_BUFFER);
+#else
+		static StaticStorage<MallocAllocator> storage;
+		static IAllocator* allocator = new(storage.data) MallocAllocator("Default");
+#endif
+		return *allocator;
+	}
+
+	ProxyAllocator& AllocManager::subsystemAllocator(Subsystem subsystem)
+	{
+		constexpr int Count = static_cast<int>(Subsystem::Count);
+		static StaticStorage<ProxyAllocator> storage[Count];
+		static ProxyAllocator* allocators[Count] = {
+			new(storage[0].data) ProxyAllocator("Content", defaultAllocator()),
+			new(storage[1].data) ProxyAllocator("Rendering", defaultAllocator()),
+			new(storage[2].data) ProxyAllocator("Audio", defaultAllocator()),
+			new(storage[3].data) ProxyAllocator("Actors", defaultAllocator())
+		};
+		static_assert(Count == 4, "All subsystems have to be initialized");
+
+		ASSERT(subsystem < Subsystem::Count);
+		return *allocators[static_cast<int>(subsystem)];
+	}
+
+	void AllocManager::logStatistics()
+	{
+		const auto logAllocator = [](const IAllocator& allocator) {
+			LOGI_X("Allocator \"%s\": %zu bytes in %zu allocations (peak %zu bytes, %zu total allocations, %zu failed)", allocator.name(),
+				allocator.usedMemory(), allocator.numAllocations(), allocator.peakMemory(), allocator.totalAllocations(), allocator.failedAllocations());
+		};
+
+		logAllocator(defaultAllocator());
+		for (int i = 0; i < static_cast<int>(Subsystem::Count); i++) {
+			logAllocator(subsystemAllocator(static_cast<Subsystem>(i)));
+		}
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IAllocator.h"
+#include "ProxyAllocator.h"
+
+namespace nCine
+{
+	/// Owns the default allocator and the allocators used to account memory of engine subsystems
+	/*! \note Allocators are not thread-safe, they should be used only from the main thread */
+	class AllocManager
+	{
+	public:
+		enum class Subsystem
+		{
+			Content,
+			Rendering,
+			Audio,
+			Actors,
+
+			Count
+		};
+
+		/// Returns the allocator all subsystem allocators allocate from
+		/*! It uses a free list in a preallocated buffer if `USE_FREELIST` is defined, otherwise `malloc()`. */
+		static IAllocator& defaultAllocator();
+		/// Returns the allocator of the specified subsystem
+		static ProxyAllocator& subsystemAllocator(Subsystem subsystem);
+
+		/// Writes statistics of all allocators to the log
+		static void logStatistics();
+
+	private:
+		AllocManager() = delete;
+	};
+
+	inline IAllocator& theDefaultAllocator() {
+		return AllocManager::defaultAllocator();
+	}
+	inline IAllocator& theContentAllocator() {
+		return AllocManager::subsystemAllocator(AllocManager::Subsystem::Content);
+	}
+	inline IAllocator& theRenderingAllocator() {
+		return AllocManager::subsystemAllocator(AllocManager::Subsystem::Rendering);
+	}
+	inline IAllocator& theAudioAllocator() {
+		return AllocManager::subsystemAllocator(AllocManager::Subsystem::Audio);
+	}
+	inline IAllocator& theActorsAllocator() {
+		return AllocManager::subsystemAllocator(AllocManager::Subsystem::Actors);
+	}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "AllocManager.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <Containers/GrowableArray.h>
+
+namespace nCine
+{
+	/// Standard allocator adaptor that allocates from an engine allocator
+	/*! The allocator is selected by a function, so the adaptor is stateless and can be used with default-constructed containers. */
+	template<class T, IAllocator& (*GetAllocator)() = theDefaultAllocator>
+	class CustomAllocator
+	{
+	public:
+		using value_type = T;
+
+		template<class U>
+		struct rebind {
+			using other = CustomAllocator<U, GetAllocator>;
+		};
+
+		CustomAllocator() noexcept {}
+		template<class U>
+		CustomAllocator(const CustomAllocator<U, GetAllocator>&) noexcept {}
+
+		T* allocate(std::size_t n) {
+			void* ptr = GetAllocator().allocate(n * sizeof(T), alignof(T));
+			FATAL_ASSERT_MSG_X(ptr != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", GetAllocator().name(), n * sizeof(T));
+			return static_cast<T*>(ptr);
+		}
+		void deallocate(T* p, std::size_t n) noexcept {
+			GetAllocator().deallocate(p);
+		}
+
+		template<class U>
+		bool operator==(const CustomAllocator<U, GetAllocator>&) const noexcept {
+			return true;
+		}
+		template<class U>
+		bool operator!=(const CustomAllocator<U, GetAllocator>&) const noexcept {
+			return false;
+		}
+	};
+
+	/// Growable array allocator that allocates from an engine allocator
+	/*! Usable with `arrayAppend<T, ArrayCustomAllocator<T, ...>>()` and similar functions. */
+	template<class T, IAllocator& (*GetAllocator)() = theDefaultAllocator>
+	struct ArrayCustomAllocator
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types are usable with this allocator");
+
+		typedef T Type;
+
+		enum : std::size_t {
+			AllocationOffset = Death::Containers::Implementation::AllocatorTraits<T>::Offset
+		};
+
+		static T* allocate(std::size_t capacity) {
+			char* const memory = static_cast<char*>(GetAllocator().allocate(capacity * sizeof(T) + AllocationOffset, AllocationOffset));
+			FATAL_ASSERT_MSG_X(memory != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", GetAllocator().name(), capacity * sizeof(T));
+			reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+			return reinterpret_cast<T*>(memory + AllocationOffset);
+		}
+
+		static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+			T* newArray = allocate(newCapacity);
+			if (prevSize > 0)
+				std::memcpy(newArray, array, prevSize * sizeof(T));
+			deallocate(array);
+			array = newArray;
+		}
+
+		static void deallocate(T* data) {
+			if (data)
+				GetAllocator().deallocate(base(data));
+		}
+
+		static std::size_t grow(T* array, std::size_t desired) {
+			return Death::Containers::Implementation::arrayGrowth<T>(array ? capacity(array) : 0, desired);
+		}
+
+		static std::size_t capacity(T* array) {
+			return *reinterpret_cast<std::size_t*>(reinterpret_cast<char*>(array) - AllocationOffset);
+		}
+
+		static void* base(T* array) {
+			return reinterpret_cast<char*>(array) - AllocationOffset;
+		}
+
+		static void deleter(T* data, std::size_t size) {
+			deallocate(data);
+		}
+	};
+
+	/// Deleter for `std::unique_ptr` of objects and trivial arrays allocated from an engine allocator
+	template<IAllocator& (*GetAllocator)()>
+	struct CustomDeleter
+	{
+		template<class T>
+		void operator()(T* ptr) const {
+			if constexpr (!std::is_trivially_destructible<T>::value)
+				ptr->~T();
+			GetAllocator().deallocate(const_cast<std::remove_const_t<T>*>(ptr));
+		}
+	};
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "FrameArena.h"
+#include "../Application.h"
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <Containers/GrowableArray.h>
+
+namespace nCine
+{
+	/// Standard allocator adaptor that allocates from the frame arena of the application
+	/*! Containers using it must not outlive the current frame, `deallocate()` does nothing. */
+	template<class T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocator() noexcept
+			: arena_(&theApplication().frameArena()) {}
+		explicit FrameAllocator(FrameArena& arena) noexcept
+			: arena_(&arena) {}
+		template<class U>
+		FrameAllocator(const FrameAllocator<U>& other) noexcept
+			: arena_(other.arena_) {}
+
+		T* allocate(std::size_t n) {
+			return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T* p, std::size_t n) noexcept {}
+
+		template<class U>
+		bool operator==(const FrameAllocator<U>& other) const noexcept {
+			return arena_ == other.arena_;
+		}
+		template<class U>
+		bool operator!=(const FrameAllocator<U>& other) const noexcept {
+			return arena_ != other.arena_;
+		}
+
+	private:
+		FrameArena* arena_;
+
+		template<class U> friend class FrameAllocator;
+	};
+
+	/// Growable array allocator that allocates from the frame arena of the application
+	/*! Usable with `arrayAppend<ArrayFrameAllocator>()` and similar functions. Arrays using it
+	 *  must not outlive the current frame, previous storage is abandoned on reallocation. */
+	template<class T>
+	struct ArrayFrameAllocator
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types are usable with this allocator");
+
+		typedef T Type;
+
+		enum : std::size_t {
+			AllocationOffset = Death::Containers::Implementation::AllocatorTraits<T>::Offset
+		};
+
+		static T* allocate(std::size_t capacity) {
+			char* const memory = static_cast<char*>(theApplication().frameArena().allocate(capacity * sizeof(T) + AllocationOffset));
+			reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+			return reinterpret_cast<T*>(memory + AllocationOffset);
+		}
+
+		static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+			T* newArray = allocate(newCapacity);
+			if (prevSize > 0)
+				std::memcpy(newArray, array, prevSize * sizeof(T));
+			array = newArray;
+		}
+
+		static void deallocate(T* data) {}
+
+		static std::size_t grow(T* array, std::size_t desired) {
+			return Death::Containers::Implementation::arrayGrowth<T>(array ? capacity(array) : 0, desired);
+		}
+
+		static std::size_t capacity(T* array) {
+			return *reinterpret_cast<std::size_t*>(reinterpret_cast<char*>(array) - AllocationOffset);
+		}
+
+		static void* base(T* array) {
+			return reinterpret_cast<char*>(array) - AllocationOffset;
+		}
+
+		static void deleter(T* data, std::size_t size) {}
+	};
+
+	/// Type-erased callable with captures stored in the frame arena of the application
+	/*! It can be used instead of `std::function` for callbacks that don't outlive the current frame,
+	 *  captures are never allocated on the heap regardless of their size. */
+	template<class Signature>
+	class FrameFunction;
+
+	template<class R, class... Args>
+	class FrameFunction<R(Args...)>
+	{
+	public:
+		template<class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, FrameFunction>::value>>
+		FrameFunction(F&& f)
+		{
+			using Callable = std::decay_t<F>;
+			// Captures are never destroyed, memory is reclaimed with the rest of the frame
+			static_assert(std::is_trivially_destructible<Callable>::value, "only trivially destructible callables are usable with this function");
+
+			void* memory = theApplication().frameArena().allocate(sizeof(Callable), alignof(Callable));
+			callable_ = new(memory) Callable(std::forward<F>(f));
+			invoke_ = [](void* callable, Args... args) -> R {
+				return (*static_cast<Callable*>(callable))(std::forward<Args>(args)...);
+			};
+		}
+
+		R operator()(Args... args) const {
+			return invoke_(callable_, std::forward<Args>(args)...);
+		}
+
+	private:
+		void* callable_;
+		R(*invoke_)(void*, Args...);
+	};
+
+}
@@ -0,0 +1,81 @@
+#include "FrameArena.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	FrameArena::FrameArena(std::size_t chunkSize)
+		: chunkSize_(chunkSize), usedBytes_(0), peakBytes_(0)
+	{
+		addChunk(chunkSize_);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* FrameArena::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+		Chunk* chunk = &chunks_.back();
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(chunk->buffer.get()) + chunk->offset;
+		std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+		if (chunk->offset + padding + bytes > chunk->size) {
+			// Allocations larger than a chunk get their own one, the padding is reserved for the worst case
+			addChunk(std::max(chunkSize_, bytes + alignment));
+			chunk = &chunks_.back();
+			address = reinterpret_cast<std::uintptr_t>(chunk->buffer.get());
+			padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+		}
+
+		unsigned char* ptr = chunk->buffer.get() + chunk->offset + padding;
+		chunk->offset += padding + bytes;
+		usedBytes_ += padding + bytes;
+		return ptr;
+	}
+
+	void FrameArena::reset()
+	{
+		peakBytes_ = std::max(peakBytes_, usedBytes_);
+		usedBytes_ = 0;
+
+		if (chunks_.size() > 1) {
+			// Coalesce all chunks, so the same amount of data doesn't need more chunks in the next frame
+			std::size_t totalSize = capacity();
+			chunks_.clear();
+			addChunk(totalSize);
+		} else {
+			chunks_[0].offset = 0;
+		}
+	}
+
+	std::size_t FrameArena::capacity() const
+	{
+		std::size_t totalSize = 0;
+		for (const Chunk& chunk : chunks_) {
+			totalSize += chunk.size;
+		}
+		return totalSize;
+	}
+
+	///////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void FrameArena::addChunk(std::size_t size)
+	{
+		Chunk& chunk = chunks_.emplace_back();
+		chunk.buffer = std::make_unique<unsigned char[]>(size);
+		chunk.size = size;
+		chunk.offset = 0;
+	}
+
+}
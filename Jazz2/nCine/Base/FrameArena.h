@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// Linear allocator for transient data that live no longer than one frame
+	/*! Allocations are just bumping an offset and they are never freed individually,
+	 *  all memory is reclaimed at once by `reset()` at the beginning of the next frame. */
+	class FrameArena
+	{
+	public:
+		static constexpr std::size_t DefaultChunkSize = 256 * 1024;
+		static constexpr std::size_t DefaultAlignment = 16;
+
+		explicit FrameArena(std::size_t chunkSize = DefaultChunkSize);
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/// Returns a block of memory valid until the next call to `reset()`
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment);
+		/// Reclaims all memory allocated since the last reset
+		/*! If more than one chunk was needed, they are replaced by a single one large enough for the whole frame. */
+		void reset();
+
+		/// Returns the number of bytes allocated since the last reset, including the alignment padding
+		inline std::size_t usedBytes() const {
+			return usedBytes_;
+		}
+		/// Returns the highest number of bytes allocated during a single frame
+		inline std::size_t peakBytes() const {
+			return peakBytes_;
+		}
+		/// Returns the total size of all chunks
+		std::size_t capacity() const;
+
+	private:
+		struct Chunk
+		{
+			std::unique_ptr<unsigned char[]> buffer;
+			std::size_t size;
+			std::size_t offset;
+		};
+
+		std::size_t chunkSize_;
+		std::size_t usedBytes_;
+		std::size_t peakBytes_;
+		SmallVector<Chunk, 1> chunks_;
+
+		void addChunk(std::size_t size);
+	};
+
+}
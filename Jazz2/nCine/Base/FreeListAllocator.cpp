@@ -0,0 +1,125 @@
+#include "FreeListAllocator.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace nCine
+{
+	namespace
+	{
+		inline std::size_t roundUp(std::size_t value, std::size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	FreeListAllocator::FreeListAllocator(const char* name, std::size_t size)
+		: IAllocator(name, size), base_(static_cast<unsigned char*>(std::malloc(size))), freeBlocks_(nullptr)
+	{
+		if (base_ != nullptr && size >= sizeof(FreeBlock)) {
+			freeBlocks_ = reinterpret_cast<FreeBlock*>(base_);
+			freeBlocks_->size = size & ~(alignof(FreeBlock) - 1);
+			freeBlocks_->next = nullptr;
+		}
+	}
+
+	FreeListAllocator::~FreeListAllocator()
+	{
+		std::free(base_);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* FreeListAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(Header));
+
+		FreeBlock* prevBlock = nullptr;
+		FreeBlock* block = freeBlocks_;
+		while (block != nullptr) {
+			const std::size_t adjustment = alignAdjustment(block, alignment, sizeof(Header));
+			// Blocks always start at an address suitable for the free block structure
+			std::size_t totalSize = roundUp(adjustment + bytes, alignof(FreeBlock));
+			if (block->size < totalSize) {
+				prevBlock = block;
+				block = block->next;
+				continue;
+			}
+
+			FreeBlock* nextBlock;
+			if (block->size - totalSize < sizeof(FreeBlock)) {
+				// The rest of the block would be too small to be tracked, so it's allocated too
+				totalSize = block->size;
+				nextBlock = block->next;
+			} else {
+				nextBlock = reinterpret_cast<FreeBlock*>(reinterpret_cast<unsigned char*>(block) + totalSize);
+				nextBlock->size = block->size - totalSize;
+				nextBlock->next = block->next;
+			}
+
+			if (prevBlock != nullptr) {
+				prevBlock->next = nextBlock;
+			} else {
+				freeBlocks_ = nextBlock;
+			}
+
+			unsigned char* ptr = reinterpret_cast<unsigned char*>(block) + adjustment;
+			Header* header = reinterpret_cast<Header*>(ptr - sizeof(Header));
+			header->size = totalSize;
+			header->adjustment = adjustment;
+
+			usedMemory_ += totalSize;
+			return ptr;
+		}
+
+		return nullptr;
+	}
+
+	void FreeListAllocator::deallocateImpl(void* ptr)
+	{
+		const Header* header = reinterpret_cast<const Header*>(static_cast<unsigned char*>(ptr) - sizeof(Header));
+		unsigned char* blockStart = static_cast<unsigned char*>(ptr) - header->adjustment;
+		const std::size_t blockSize = header->size;
+		unsigned char* blockEnd = blockStart + blockSize;
+		ASSERT(blockStart >= base_ && blockEnd <= base_ + size_);
+
+		FreeBlock* prevBlock = nullptr;
+		FreeBlock* nextBlock = freeBlocks_;
+		while (nextBlock != nullptr && reinterpret_cast<unsigned char*>(nextBlock) < blockEnd) {
+			prevBlock = nextBlock;
+			nextBlock = nextBlock->next;
+		}
+
+		FreeBlock* block;
+		if (prevBlock != nullptr && reinterpret_cast<unsigned char*>(prevBlock) + prevBlock->size == blockStart) {
+			// Merge with the previous free block
+			block = prevBlock;
+			block->size += blockSize;
+		} else {
+			block = reinterpret_cast<FreeBlock*>(blockStart);
+			block->size = blockSize;
+			block->next = nextBlock;
+			if (prevBlock != nullptr) {
+				prevBlock->next = block;
+			} else {
+				freeBlocks_ = block;
+			}
+		}
+
+		if (nextBlock != nullptr && reinterpret_cast<unsigned char*>(block) + block->size == reinterpret_cast<unsigned char*>(nextBlock)) {
+			// Merge with the next free block
+			block->size += nextBlock->size;
+			block->next = nextBlock->next;
+		}
+
+		usedMemory_ -= blockSize;
+	}
+
+}
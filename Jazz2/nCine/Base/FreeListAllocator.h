@@ -0,0 +1,37 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// General purpose allocator that uses a list of free blocks in a fixed buffer
+	/*! The first block that is large enough is used, adjacent free blocks are merged when memory is released. */
+	class FreeListAllocator : public IAllocator
+	{
+	public:
+		FreeListAllocator(const char* name, std::size_t size);
+		~FreeListAllocator() override;
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		struct Header
+		{
+			std::size_t size;
+			std::size_t adjustment;
+		};
+
+		struct FreeBlock
+		{
+			std::size_t size;
+			FreeBlock* next;
+		};
+
+		unsigned char* base_;
+		/// Free blocks sorted by address
+		FreeBlock* freeBlocks_;
+	};
+
+}
@@ -8,7 +8,8 @@ namespace nCine
 	// Use flat_hash_map from Parallel Hashmap library
 	template <class K, class V,
 		class Hash = FNV1aHashFunc<K>,
-		class Eq = phmap::priv::hash_default_eq<K>>
-	using HashMap = phmap::flat_hash_map<K, V, Hash, Eq>;
+		class Eq = phmap::priv::hash_default_eq<K>,
+		class Alloc = phmap::priv::Allocator<phmap::priv::Pair<const K, V>>>
+	using HashMap = phmap::flat_hash_map<K, V, Hash, Eq, Alloc>;
 }
 
@@ -0,0 +1,73 @@
+#include "IAllocator.h"
+#include "../../Common.h"
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	IAllocator::IAllocator(const char* name, std::size_t size)
+		: name_(name), size_(size), usedMemory_(0), peakMemory_(0), numAllocations_(0),
+			totalAllocations_(0), failedAllocations_(0), budget_(0)
+	{
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* IAllocator::allocate(std::size_t bytes, std::size_t alignment)
+	{
+		ASSERT(bytes > 0);
+		ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+		if (budget_ > 0 && usedMemory_ + bytes > budget_) {
+			if (failedAllocations_ == 0) {
+				LOGW_X("Allocator \"%s\" exceeded its budget of %zu bytes", name_, budget_);
+			}
+			failedAllocations_++;
+			return nullptr;
+		}
+
+		void* ptr = allocateImpl(bytes, alignment);
+		if (ptr == nullptr) {
+			failedAllocations_++;
+			return nullptr;
+		}
+
+		numAllocations_++;
+		totalAllocations_++;
+		if (peakMemory_ < usedMemory_) {
+			peakMemory_ = usedMemory_;
+		}
+		return ptr;
+	}
+
+	void IAllocator::deallocate(void* ptr)
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+
+		ASSERT(numAllocations_ > 0);
+		deallocateImpl(ptr);
+		numAllocations_--;
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	std::size_t IAllocator::alignAdjustment(const void* ptr, std::size_t alignment, std::size_t headerSize)
+	{
+		std::size_t adjustment = alignAdjustment(ptr, alignment);
+		if (adjustment < headerSize) {
+			// Increase the adjustment by multiples of the alignment until the header fits
+			const std::size_t neededSpace = headerSize - adjustment;
+			adjustment += alignment * ((neededSpace + alignment - 1) / alignment);
+		}
+		return adjustment;
+	}
+
+}
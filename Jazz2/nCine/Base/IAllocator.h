@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace nCine
+{
+	/// Base class of all custom memory allocators
+	/*! Every allocator tracks the memory it handed out, so memory of each subsystem can be inspected and capped. */
+	class IAllocator
+	{
+	public:
+		static constexpr std::size_t DefaultAlignment = alignof(std::max_align_t);
+
+		IAllocator(const char* name, std::size_t size = 0);
+		virtual ~IAllocator() {}
+
+		IAllocator(const IAllocator&) = delete;
+		IAllocator& operator=(const IAllocator&) = delete;
+
+		/// Allocates a block of memory, returns `nullptr` if the allocator is full or the budget would be exceeded
+		void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment);
+		/// Returns a block of memory to the allocator, `nullptr` is ignored
+		void deallocate(void* ptr);
+
+		/// Allocates and constructs an object
+		template<class T, typename... Args>
+		T* newObject(Args&&... args)
+		{
+			void* ptr = allocate(sizeof(T), alignof(T));
+			return (ptr != nullptr ? new(ptr) T(std::forward<Args>(args)...) : nullptr);
+		}
+		/// Destructs and deallocates an object allocated by `newObject()`
+		template<class T>
+		void deleteObject(T* ptr)
+		{
+			if (ptr != nullptr) {
+				ptr->~T();
+				deallocate(ptr);
+			}
+		}
+
+		/// Returns the name used for statistics
+		inline const char* name() const {
+			return name_;
+		}
+		/// Returns the size of the managed buffer in bytes, zero if the allocator is not backed by a buffer
+		inline std::size_t size() const {
+			return size_;
+		}
+		/// Returns the number of bytes currently allocated, including the bookkeeping overhead
+		inline std::size_t usedMemory() const {
+			return usedMemory_;
+		}
+		/// Returns the highest number of bytes allocated at the same time
+		inline std::size_t peakMemory() const {
+			return peakMemory_;
+		}
+		/// Returns the number of active allocations
+		inline std::size_t numAllocations() const {
+			return numAllocations_;
+		}
+		/// Returns the number of allocations since the creation of the allocator
+		inline std::size_t totalAllocations() const {
+			return totalAllocations_;
+		}
+		/// Returns the number of allocations that failed or were refused because of the budget
+		inline std::size_t failedAllocations() const {
+			return failedAllocations_;
+		}
+
+		/// Returns the maximum number of bytes that can be allocated at the same time, zero means unlimited
+		inline std::size_t budget() const {
+			return budget_;
+		}
+		/// Sets the maximum number of bytes that can be allocated at the same time, zero means unlimited
+		inline void setBudget(std::size_t bytes) {
+			budget_ = bytes;
+		}
+
+	protected:
+		const char* name_;
+		std::size_t size_;
+		/// Has to be updated by the implementation, so it can include its own overhead
+		std::size_t usedMemory_;
+
+		/// Returns the number of bytes needed to align the address
+		static inline std::size_t alignAdjustment(const void* ptr, std::size_t alignment)
+		{
+			const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+			return (alignment - (address & (alignment - 1))) & (alignment - 1);
+		}
+
+		/// Returns the number of bytes needed to align the address with enough space for a header in front of it
+		static std::size_t alignAdjustment(const void* ptr, std::size_t alignment, std::size_t headerSize);
+
+		/// Forgets all active allocations at once, used by allocators that can release everything together
+		inline void releaseAll() {
+			usedMemory_ = 0;
+			numAllocations_ = 0;
+		}
+
+		virtual void* allocateImpl(std::size_t bytes, std::size_t alignment) = 0;
+		virtual void deallocateImpl(void* ptr) = 0;
+
+	private:
+		std::size_t peakMemory_;
+		std::size_t numAllocations_;
+		std::size_t totalAllocations_;
+		std::size_t failedAllocations_;
+		std::size_t budget_;
+	};
+
+}
@@ -0,0 +1,53 @@
+#include "LinearAllocator.h"
+
+#include <cstdlib>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	LinearAllocator::LinearAllocator(const char* name, std::size_t size)
+		: IAllocator(name, size), base_(static_cast<unsigned char*>(std::malloc(size))), offset_(0)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		std::free(base_);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void LinearAllocator::clear()
+	{
+		offset_ = 0;
+		releaseAll();
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* LinearAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		unsigned char* current = base_ + offset_;
+		const std::size_t adjustment = alignAdjustment(current, alignment);
+		if (base_ == nullptr || offset_ + adjustment + bytes > size_) {
+			return nullptr;
+		}
+
+		offset_ += adjustment + bytes;
+		usedMemory_ = offset_;
+		return current + adjustment;
+	}
+
+	void LinearAllocator::deallocateImpl(void* ptr)
+	{
+		// Memory is released only by `clear()`
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// Allocator that only bumps an offset in a fixed buffer
+	/*! Single allocations cannot be released, `clear()` releases all of them at once. */
+	class LinearAllocator : public IAllocator
+	{
+	public:
+		LinearAllocator(const char* name, std::size_t size);
+		~LinearAllocator() override;
+
+		/// Releases all allocations
+		void clear();
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		unsigned char* base_;
+		std::size_t offset_;
+	};
+
+}
@@ -0,0 +1,49 @@
+#include "MallocAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	MallocAllocator::MallocAllocator(const char* name)
+		: IAllocator(name)
+	{
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* MallocAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(Header));
+
+		// The header with the block size is stored right in front of the returned pointer
+		const std::size_t size = bytes + alignment - 1 + sizeof(Header);
+		void* block = std::malloc(size);
+		if (block == nullptr) {
+			return nullptr;
+		}
+
+		const std::size_t adjustment = alignAdjustment(block, alignment, sizeof(Header));
+		unsigned char* ptr = static_cast<unsigned char*>(block) + adjustment;
+		Header* header = reinterpret_cast<Header*>(ptr - sizeof(Header));
+		header->size = size;
+		header->adjustment = adjustment;
+
+		usedMemory_ += size;
+		return ptr;
+	}
+
+	void MallocAllocator::deallocateImpl(void* ptr)
+	{
+		const Header* header = reinterpret_cast<const Header*>(static_cast<unsigned char*>(ptr) - sizeof(Header));
+		usedMemory_ -= header->size;
+		std::free(static_cast<unsigned char*>(ptr) - header->adjustment);
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// Allocator that uses `malloc()` and `free()`
+	class MallocAllocator : public IAllocator
+	{
+	public:
+		explicit MallocAllocator(const char* name = "Malloc");
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		struct Header
+		{
+			std::size_t size;
+			std::size_t adjustment;
+		};
+	};
+
+}
@@ -0,0 +1,62 @@
+#include "PoolAllocator.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	PoolAllocator::PoolAllocator(const char* name, std::size_t elementSize, std::size_t numElements, std::size_t alignment)
+		: IAllocator(name), numElements_(numElements), alignment_(std::max(alignment, alignof(void*))), freeList_(nullptr)
+	{
+		// Every element has to be aligned and has to be large enough to hold the free list pointer
+		elementSize = std::max(elementSize, sizeof(void*));
+		elementSize_ = (elementSize + alignment_ - 1) & ~(alignment_ - 1);
+		size_ = elementSize_ * numElements_;
+
+		base_ = static_cast<unsigned char*>(std::malloc(size_ + alignment_ - 1));
+		if (base_ != nullptr) {
+			unsigned char* first = base_ + alignAdjustment(base_, alignment_);
+			for (std::size_t i = numElements_; i > 0; i--) {
+				void** element = reinterpret_cast<void**>(first + (i - 1) * elementSize_);
+				*element = freeList_;
+				freeList_ = element;
+			}
+		}
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		std::free(base_);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* PoolAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		ASSERT_MSG(bytes <= elementSize_ && alignment <= alignment_, "Allocation doesn't fit the pool element");
+		if (freeList_ == nullptr || bytes > elementSize_ || alignment > alignment_) {
+			return nullptr;
+		}
+
+		void** element = freeList_;
+		freeList_ = static_cast<void**>(*element);
+		usedMemory_ += elementSize_;
+		return element;
+	}
+
+	void PoolAllocator::deallocateImpl(void* ptr)
+	{
+		void** element = static_cast<void**>(ptr);
+		*element = freeList_;
+		freeList_ = element;
+		usedMemory_ -= elementSize_;
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// Allocator of fixed-size elements from a preallocated buffer
+	class PoolAllocator : public IAllocator
+	{
+	public:
+		PoolAllocator(const char* name, std::size_t elementSize, std::size_t numElements, std::size_t alignment = DefaultAlignment);
+		~PoolAllocator() override;
+
+		/// Returns the size of one element including padding
+		inline std::size_t elementSize() const {
+			return elementSize_;
+		}
+		/// Returns the number of elements that can be allocated at the same time
+		inline std::size_t numElements() const {
+			return numElements_;
+		}
+		/// Returns `true` if the memory block was allocated by this allocator
+		inline bool owns(const void* ptr) const {
+			const unsigned char* p = static_cast<const unsigned char*>(ptr);
+			return (base_ != nullptr && p >= base_ && p < base_ + size_ + alignment_ - 1);
+		}
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		std::size_t elementSize_;
+		std::size_t numElements_;
+		std::size_t alignment_;
+		unsigned char* base_;
+		/// Free elements are linked through their first bytes
+		void** freeList_;
+	};
+
+}
@@ -0,0 +1,47 @@
+#include "ProxyAllocator.h"
+
+#include <algorithm>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	ProxyAllocator::ProxyAllocator(const char* name, IAllocator& parent)
+		: IAllocator(name), parent_(parent)
+	{
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* ProxyAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(Header));
+
+		// The requested size is stored in front of the block, so it can be subtracted when the block is released
+		const std::size_t offset = (sizeof(Header) + alignment - 1) & ~(alignment - 1);
+		unsigned char* block = static_cast<unsigned char*>(parent_.allocate(bytes + offset, alignment));
+		if (block == nullptr) {
+			return nullptr;
+		}
+
+		unsigned char* ptr = block + offset;
+		Header* header = reinterpret_cast<Header*>(ptr - sizeof(Header));
+		header->size = bytes;
+		header->offset = offset;
+
+		usedMemory_ += bytes;
+		return ptr;
+	}
+
+	void ProxyAllocator::deallocateImpl(void* ptr)
+	{
+		const Header* header = reinterpret_cast<const Header*>(static_cast<unsigned char*>(ptr) - sizeof(Header));
+		usedMemory_ -= header->size;
+		parent_.deallocate(static_cast<unsigned char*>(ptr) - header->offset);
+	}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// Allocator that forwards all requests to another one and keeps its own statistics
+	/*! It's used to account and limit memory of a subsystem without a dedicated buffer. */
+	class ProxyAllocator : public IAllocator
+	{
+	public:
+		ProxyAllocator(const char* name, IAllocator& parent);
+
+		inline IAllocator& parent() const {
+			return parent_;
+		}
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		struct Header
+		{
+			std::size_t size;
+			std::size_t offset;
+		};
+
+		IAllocator& parent_;
+	};
+
+}
@@ -0,0 +1,69 @@
+#include "StackAllocator.h"
+#include "../../Common.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace nCine
+{
+	///////////////////////////////////////////////////////////
+	// CONSTRUCTORS and DESTRUCTOR
+	///////////////////////////////////////////////////////////
+
+	StackAllocator::StackAllocator(const char* name, std::size_t size)
+		: IAllocator(name, size), base_(static_cast<unsigned char*>(std::malloc(size))), offset_(0), lastAllocation_(nullptr)
+	{
+	}
+
+	StackAllocator::~StackAllocator()
+	{
+		std::free(base_);
+	}
+
+	///////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void StackAllocator::clear()
+	{
+		offset_ = 0;
+		lastAllocation_ = nullptr;
+		releaseAll();
+	}
+
+	///////////////////////////////////////////////////////////
+	// PROTECTED FUNCTIONS
+	///////////////////////////////////////////////////////////
+
+	void* StackAllocator::allocateImpl(std::size_t bytes, std::size_t alignment)
+	{
+		alignment = std::max(alignment, alignof(Header));
+
+		unsigned char* current = base_ + offset_;
+		const std::size_t adjustment = alignAdjustment(current, alignment, sizeof(Header));
+		if (base_ == nullptr || offset_ + adjustment + bytes > size_) {
+			return nullptr;
+		}
+
+		unsigned char* ptr = current + adjustment;
+		Header* header = reinterpret_cast<Header*>(ptr - sizeof(Header));
+		header->prevOffset = offset_;
+		header->prevAllocation = lastAllocation_;
+
+		offset_ += adjustment + bytes;
+		lastAllocation_ = ptr;
+		usedMemory_ = offset_;
+		return ptr;
+	}
+
+	void StackAllocator::deallocateImpl(void* ptr)
+	{
+		ASSERT_MSG(ptr == lastAllocation_, "Memory has to be released in the reverse order of allocation");
+
+		const Header* header = reinterpret_cast<const Header*>(static_cast<unsigned char*>(ptr) - sizeof(Header));
+		offset_ = header->prevOffset;
+		lastAllocation_ = header->prevAllocation;
+		usedMemory_ = offset_;
+	}
+
+}
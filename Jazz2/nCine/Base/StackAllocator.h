@@ -0,0 +1,33 @@
+#pragma once
+
+#include "IAllocator.h"
+
+namespace nCine
+{
+	/// Allocator that releases memory in the reverse order of allocation
+	class StackAllocator : public IAllocator
+	{
+	public:
+		StackAllocator(const char* name, std::size_t size);
+		~StackAllocator() override;
+
+		/// Releases all allocations
+		void clear();
+
+	protected:
+		void* allocateImpl(std::size_t bytes, std::size_t alignment) override;
+		void deallocateImpl(void* ptr) override;
+
+	private:
+		struct Header
+		{
+			std::size_t prevOffset;
+			void* prevAllocation;
+		};
+
+		unsigned char* base_;
+		std::size_t offset_;
+		void* lastAllocation_;
+	};
+
+}
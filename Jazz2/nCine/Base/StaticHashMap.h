@@ -119,6 +119,14 @@ namespace nCine
 		/// Removes a key from the hashmap, if it exists
 		bool remove(const K& key);
 
+		/// Returns the index of the bucket containing the key, or `Capacity` if it is not in the hashmap
+		/*! \note The index stays valid until the key is removed, copies of the hashmap keep the same layout. */
+		unsigned int bucketIndexOf(const K& key) const;
+		/// Returns the element stored in the specified bucket, or `nullptr` if the bucket is empty
+		inline T* atBucket(unsigned int bucketIndex) {
+			return (bucketIndex < Capacity && hashes_[bucketIndex] != NullHash ? &nodes_[bucketIndex].value : nullptr);
+		}
+
 	private:
 		/// The template class for the node stored inside the hashmap
 		class Node
@@ -486,6 +494,14 @@ namespace nCine
 		return found;
 	}
 
+	template <class K, class T, unsigned int Capacity, class HashFunc>
+	unsigned int StaticHashMap<K, T, Capacity, HashFunc>::bucketIndexOf(const K& key) const
+	{
+		unsigned int bucketIndex = 0;
+		const bool found = findBucketIndex(key, bucketIndex);
+		return (found ? bucketIndex : Capacity);
+	}
+
 	/*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
 	template <class K, class T, unsigned int Capacity, class HashFunc>
 	T* StaticHashMap<K, T, Capacity, HashFunc>::find(const K& key)
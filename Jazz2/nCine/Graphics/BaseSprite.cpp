@@ -10,7 +10,8 @@ namespace nCine {
 
 	BaseSprite::BaseSprite(SceneNode* parent, Texture* texture, float xx, float yy)
 		: DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0),
-		flippedX_(false), flippedY_(false), instanceBlock_(nullptr)
+		flippedX_(false), flippedY_(false), instanceBlock_(nullptr),
+		colorUniform_(nullptr), spriteSizeUniform_(nullptr), texRectUniform_(nullptr)
 	{
 		renderCommand_.material().setBlendingEnabled(true);
 	}
@@ -100,7 +101,8 @@ namespace nCine {
 
 	BaseSprite::BaseSprite(const BaseSprite& other)
 		: DrawableNode(other), texture_(other.texture_), texRect_(other.texRect_),
-		flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr)
+		flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr),
+		colorUniform_(nullptr), spriteSizeUniform_(nullptr), texRectUniform_(nullptr)
 	{
 	}
 
@@ -112,6 +114,9 @@ namespace nCine {
 	{
 		renderCommand_.material().reserveUniformsDataMemory();
 		instanceBlock_ = renderCommand_.material().uniformBlock(Material::InstanceBlockName);
+		colorUniform_ = (instanceBlock_ != nullptr ? instanceBlock_->uniform(Material::ColorUniformName) : nullptr);
+		spriteSizeUniform_ = (instanceBlock_ != nullptr ? instanceBlock_->uniform(Material::SpriteSizeUniformName) : nullptr);
+		texRectUniform_ = (instanceBlock_ != nullptr ? instanceBlock_->uniform(Material::TexRectUniformName) : nullptr);
 		GLUniformCache* textureUniform = renderCommand_.material().uniform(Material::TextureUniformName);
 		if (textureUniform && textureUniform->intValue(0) != 0) {
 			textureUniform->setIntValue(0); // GL_TEXTURE0
@@ -132,15 +137,13 @@ namespace nCine {
 			dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::ColorBit)) {
-			GLUniformCache* colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
-			if (colorUniform)
-				colorUniform->setFloatVector(Colorf(absColor()).Data());
+			if (colorUniform_)
+				colorUniform_->setFloatVector(Colorf(absColor()).Data());
 			dirtyBits_.reset(DirtyBitPositions::ColorBit);
 		}
 		if (dirtyBits_.test(DirtyBitPositions::SizeBit)) {
-			GLUniformCache* spriteSizeUniform = instanceBlock_->uniform(Material::SpriteSizeUniformName);
-			if (spriteSizeUniform)
-				spriteSizeUniform->setFloatValue(width_, height_);
+			if (spriteSizeUniform_)
+				spriteSizeUniform_->setFloatValue(width_, height_);
 			dirtyBits_.reset(DirtyBitPositions::SizeBit);
 		}
 
@@ -148,15 +151,14 @@ namespace nCine {
 			if (texture_) {
 				renderCommand_.material().setTexture(*texture_);
 
-				GLUniformCache* texRectUniform = instanceBlock_->uniform(Material::TexRectUniformName);
-				if (texRectUniform) {
+				if (texRectUniform_) {
 					const Vector2i texSize = texture_->size();
 					const float texScaleX = texRect_.W / float(texSize.X);
 					const float texBiasX = texRect_.X / float(texSize.X);
 					const float texScaleY = texRect_.H / float(texSize.Y);
 					const float texBiasY = texRect_.Y / float(texSize.Y);
 
-					texRectUniform->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+					texRectUniform_->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
 				}
 			} else {
 				renderCommand_.material().setTexture(nullptr);
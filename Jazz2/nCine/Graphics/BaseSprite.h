@@ -66,6 +66,10 @@ namespace nCine
 		bool flippedY_;
 
 		GLUniformBlockCache* instanceBlock_;
+		/// Uniforms of the instance block, resolved once when the shader changes
+		GLUniformCache* colorUniform_;
+		GLUniformCache* spriteSizeUniform_;
+		GLUniformCache* texRectUniform_;
 
 		/// Protected constructor accessible only by derived sprite classes
 		BaseSprite(SceneNode* parent, Texture* texture, float xx, float yy);
@@ -192,8 +192,6 @@ namespace nCine
 
 	void DrawableNode::updateAabb()
 	{
-		ZoneScoped;
-
 		const float width = absWidth();
 		const float height = absHeight();
 		float rotatedWidth = width;
@@ -15,6 +15,7 @@ namespace nCine {
 	///////////////////////////////////////////////////////////
 
 	GLuint GLShaderProgram::boundProgram_ = 0;
+	unsigned int GLShaderProgram::lastGeneration_ = 0;
 #if defined(ENABLE_LOG)
 	char GLShaderProgram::infoLogString_[MaxInfoLogLength];
 #endif
@@ -31,7 +32,7 @@ namespace nCine {
 	GLShaderProgram::GLShaderProgram(QueryPhase queryPhase)
 		: glHandle_(0),
 		status_(Status::NOT_LINKED), queryPhase_(queryPhase), shouldLogOnErrors_(true),
-		uniformsSize_(0), uniformBlocksSize_(0)
+		uniformsSize_(0), uniformBlocksSize_(0), generation_(++lastGeneration_)
 	{
 		glHandle_ = glCreateProgram();
 
@@ -213,6 +214,7 @@ namespace nCine {
 			uniforms_.clear();
 			uniformBlocks_.clear();
 			attributes_.clear();
+			generation_ = ++lastGeneration_;
 
 			attributeLocations_.clear();
 			vertexFormat_.reset();
@@ -300,6 +302,8 @@ namespace nCine {
 			discoverAttributes();
 			initVertexFormat();
 			status_ = Status::LINKED_WITH_INTROSPECTION;
+			// Handles resolved for previously discovered uniforms are not valid anymore
+			generation_ = ++lastGeneration_;
 		}
 	}
 
@@ -71,6 +71,12 @@ namespace nCine
 		/// Retrieves the information log and copies it in the provided string object
 		void retrieveInfoLog(std::string& infoLog) const;
 
+		/// Returns a number that changes every time uniforms and uniform blocks are discovered again
+		/*! It's unique among all shader programs, so it also tells apart a program allocated at the address of a deleted one. */
+		inline unsigned int generation() const {
+			return generation_;
+		}
+
 		/// Returns the total memory needed for all uniforms outside of blocks
 		inline unsigned int uniformsSize() const {
 			return uniformsSize_;
@@ -127,6 +133,7 @@ namespace nCine
 #endif
 
 		static GLuint boundProgram_;
+		static unsigned int lastGeneration_;
 
 		GLuint glHandle_;
 		static const int AttachedShadersInitialSize = 4;
@@ -140,6 +147,7 @@ namespace nCine
 
 		unsigned int uniformsSize_;
 		unsigned int uniformBlocksSize_;
+		unsigned int generation_;
 
 		static const int UniformsInitialSize = 8;
 		SmallVector<GLUniform, 0> uniforms_;
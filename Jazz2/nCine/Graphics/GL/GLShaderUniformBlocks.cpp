@@ -60,6 +60,7 @@ namespace nCine
 		shaderProgram_ = shaderProgram;
 		shaderProgram_->deferredQueries();
 		uniformBlockCaches_.clear();
+		uniformBlockBuckets_.clear();
 
 		if (shaderProgram->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
 			importUniformBlocks(includeOnly, exclude);
@@ -93,6 +94,25 @@ namespace nCine
 		return uniformBlockCache;
 	}
 
+	GLUniformBlockCache* GLShaderUniformBlocks::uniformBlock(GLUniformHandle& handle)
+	{
+		if (handle.owner_ == shaderProgram_ && handle.generation_ == shaderProgram_->generation_ && handle.index_ < uniformBlockBuckets_.size()) {
+			GLUniformBlockCache* uniformBlockCache = uniformBlockCaches_.atBucket(uniformBlockBuckets_[handle.index_]);
+			// The uniform block could be excluded from the caches of this instance
+			if (uniformBlockCache != nullptr && uniformBlockCache->uniformBlock() == &shaderProgram_->uniformBlocks_[handle.index_]) {
+				return uniformBlockCache;
+			}
+		}
+
+		GLUniformBlockCache* uniformBlockCache = uniformBlock(handle.name_);
+		if (uniformBlockCache != nullptr) {
+			handle.owner_ = shaderProgram_;
+			handle.generation_ = shaderProgram_->generation_;
+			handle.index_ = static_cast<unsigned int>(uniformBlockCache->uniformBlock() - shaderProgram_->uniformBlocks_.data());
+		}
+		return uniformBlockCache;
+	}
+
 	void GLShaderUniformBlocks::commitUniformBlocks()
 	{
 		if (shaderProgram_) {
@@ -135,7 +155,9 @@ namespace nCine
 		const unsigned int MaxUniformBlockName = 128;
 
 		unsigned int importedCount = 0;
-		for (GLUniformBlock& uniformBlock : shaderProgram_->uniformBlocks_) {
+		uniformBlockBuckets_.resize(shaderProgram_->uniformBlocks_.size());
+		for (unsigned int i = 0; i < shaderProgram_->uniformBlocks_.size(); i++) {
+			GLUniformBlock& uniformBlock = shaderProgram_->uniformBlocks_[i];
 			const char* uniformBlockName = uniformBlock.name();
 			const char* currentIncludeOnly = includeOnly;
 			const char* currentExclude = exclude;
@@ -163,9 +185,10 @@ namespace nCine
 			}
 
 			if (shouldImport) {
-				uniformBlockCaches_.emplace(uniformBlockName, &uniformBlock);
+				uniformBlockCaches_.emplace(uniformBlockName, &uniformBlock, shaderProgram_->generation_);
 				importedCount++;
 			}
+			uniformBlockBuckets_[i] = static_cast<unsigned char>(uniformBlockCaches_.bucketIndexOf(uniformBlockName));
 		}
 
 		if (importedCount > UniformBlockCachesHashSize) {
@@ -3,6 +3,7 @@
 #include "../../Base/StaticHashMap.h"
 
 #include "GLUniformBlockCache.h"
+#include "GLUniformHandle.h"
 #include "../RenderBuffersManager.h"
 
 namespace nCine
@@ -33,6 +34,8 @@ namespace nCine
 			return (uniformBlockCaches_.find(String::nullTerminatedView(name)) != nullptr);
 		}
 		GLUniformBlockCache* uniformBlock(const char* name);
+		/// Returns the uniform block cache through a handle, the name is only looked up when the handle is not resolved for this program
+		GLUniformBlockCache* uniformBlock(GLUniformHandle& handle);
 		inline const UniformHashMapType allUniformBlocks() const {
 			return uniformBlockCaches_;
 		}
@@ -49,6 +52,8 @@ namespace nCine
 		RenderBuffersManager::Parameters uboParams_;
 
 		UniformHashMapType uniformBlockCaches_;
+		/// Hashmap bucket of each imported uniform block, indexed by the position of the block in the shader program
+		SmallVector<unsigned char, 0> uniformBlockBuckets_;
 
 		/// Imports the uniform blocks with the option of including only some or excluing others
 		void importUniformBlocks(const char* includeOnly, const char* exclude);
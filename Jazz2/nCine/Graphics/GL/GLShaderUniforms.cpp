@@ -39,6 +39,7 @@ namespace nCine
 		shaderProgram_ = shaderProgram;
 		shaderProgram_->deferredQueries();
 		uniformCaches_.clear();
+		uniformBuckets_.clear();
 
 		if (shaderProgram_->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
 			importUniforms(includeOnly, exclude);
@@ -81,6 +82,25 @@ namespace nCine
 		return uniformCache;
 	}
 
+	GLUniformCache* GLShaderUniforms::uniform(GLUniformHandle& handle)
+	{
+		if (handle.owner_ == shaderProgram_ && handle.generation_ == shaderProgram_->generation_ && handle.index_ < uniformBuckets_.size()) {
+			GLUniformCache* uniformCache = uniformCaches_.atBucket(uniformBuckets_[handle.index_]);
+			// The uniform could be excluded from the caches of this instance
+			if (uniformCache != nullptr && uniformCache->uniform() == &shaderProgram_->uniforms_[handle.index_]) {
+				return uniformCache;
+			}
+		}
+
+		GLUniformCache* uniformCache = uniform(handle.name_);
+		if (uniformCache != nullptr) {
+			handle.owner_ = shaderProgram_;
+			handle.generation_ = shaderProgram_->generation_;
+			handle.index_ = static_cast<unsigned int>(uniformCache->uniform() - shaderProgram_->uniforms_.data());
+		}
+		return uniformCache;
+	}
+
 	void GLShaderUniforms::commitUniforms()
 	{
 		if (shaderProgram_) {
@@ -104,7 +124,9 @@ namespace nCine
 		const unsigned int MaxUniformName = 128;
 
 		unsigned int importedCount = 0;
-		for (const GLUniform& uniform : shaderProgram_->uniforms_) {
+		uniformBuckets_.resize(shaderProgram_->uniforms_.size());
+		for (unsigned int i = 0; i < shaderProgram_->uniforms_.size(); i++) {
+			const GLUniform& uniform = shaderProgram_->uniforms_[i];
 			const char* uniformName = uniform.name();
 			const char* currentIncludeOnly = includeOnly;
 			const char* currentExclude = exclude;
@@ -136,6 +158,7 @@ namespace nCine
 				uniformCaches_[uniformName] = uniformCache;
 				importedCount++;
 			}
+			uniformBuckets_[i] = static_cast<unsigned char>(uniformCaches_.bucketIndexOf(uniformName));
 		}
 
 		if (importedCount > UniformCachesHashSize) {
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "GLUniformCache.h"
+#include "GLUniformHandle.h"
 #include "../../Base/StaticHashMap.h"
 
 #include <string>
 
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
 namespace nCine
 {
 	class GLShaderProgram;
@@ -33,6 +38,8 @@ namespace nCine
 			return (uniformCaches_.find(String::nullTerminatedView(name)) != nullptr);
 		}
 		GLUniformCache* uniform(const char* name);
+		/// Returns the uniform cache through a handle, the name is only looked up when the handle is not resolved for this program
+		GLUniformCache* uniform(GLUniformHandle& handle);
 		inline const UniformHashMapType allUniforms() const {
 			return uniformCaches_;
 		}
@@ -41,6 +48,8 @@ namespace nCine
 	private:
 		GLShaderProgram* shaderProgram_;
 		UniformHashMapType uniformCaches_;
+		/// Hashmap bucket of each imported uniform, indexed by the position of the uniform in the shader program
+		SmallVector<unsigned char, 0> uniformBuckets_;
 
 		/// Imports the uniforms with the option of including only some or excluing others
 		void importUniforms(const char* includeOnly, const char* exclude);
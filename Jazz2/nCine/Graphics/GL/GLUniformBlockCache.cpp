@@ -9,12 +9,12 @@ namespace nCine
 	///////////////////////////////////////////////////////////
 
 	GLUniformBlockCache::GLUniformBlockCache()
-		: uniformBlock_(nullptr), dataPointer_(nullptr), usedSize_(0)
+		: uniformBlock_(nullptr), generation_(0), dataPointer_(nullptr), usedSize_(0)
 	{
 	}
 
-	GLUniformBlockCache::GLUniformBlockCache(GLUniformBlock* uniformBlock)
-		: uniformBlock_(uniformBlock), dataPointer_(nullptr), usedSize_(0)
+	GLUniformBlockCache::GLUniformBlockCache(GLUniformBlock* uniformBlock, unsigned int generation)
+		: uniformBlock_(uniformBlock), generation_(generation), dataPointer_(nullptr), usedSize_(0)
 	{
 		ASSERT(uniformBlock);
 		usedSize_ = uniformBlock->size();
@@ -99,6 +99,26 @@ namespace nCine
 		return uniformCaches_.find(String::nullTerminatedView(name));
 	}
 
+	GLUniformCache* GLUniformBlockCache::uniform(GLUniformHandle& handle)
+	{
+		// Every cache of the same block imports uniforms in the same order, so they share bucket indices
+		if (handle.owner_ == uniformBlock_ && handle.generation_ == generation_) {
+			GLUniformCache* uniformCache = uniformCaches_.atBucket(handle.index_);
+			if (uniformCache != nullptr) {
+				return uniformCache;
+			}
+		}
+
+		const unsigned int bucketIndex = uniformCaches_.bucketIndexOf(String::nullTerminatedView(handle.name_));
+		GLUniformCache* uniformCache = uniformCaches_.atBucket(bucketIndex);
+		if (uniformCache != nullptr) {
+			handle.owner_ = uniformBlock_;
+			handle.generation_ = generation_;
+			handle.index_ = bucketIndex;
+		}
+		return uniformCache;
+	}
+
 	void GLUniformBlockCache::setBlockBinding(GLuint blockBinding)
 	{
 		if (uniformBlock_)
@@ -4,6 +4,7 @@
 #include "../../CommonHeaders.h"
 
 #include "GLUniformCache.h"
+#include "GLUniformHandle.h"
 #include "../../Base/StaticHashMap.h"
 
 namespace nCine
@@ -16,11 +17,15 @@ namespace nCine
 	{
 	public:
 		GLUniformBlockCache();
-		explicit GLUniformBlockCache(GLUniformBlock* uniformBlock);
+		GLUniformBlockCache(GLUniformBlock* uniformBlock, unsigned int generation);
 
 		inline const GLUniformBlock* uniformBlock() const {
 			return uniformBlock_;
 		}
+		/// Returns the generation of the shader program the uniform block belongs to
+		inline unsigned int generation() const {
+			return generation_;
+		}
 		/// Wrapper around `GLUniformBlock::index()`
 		GLuint index() const;
 		/// Wrapper around `GLUniformBlock::bindingIndex()`
@@ -49,11 +54,14 @@ namespace nCine
 		}
 
 		GLUniformCache* uniform(const StringView& name);
+		/// Returns the uniform cache through a handle, the name is only looked up when the handle is not resolved for this block
+		GLUniformCache* uniform(GLUniformHandle& handle);
 		/// Wrapper around `GLUniformBlock::setBlockBinding()`
 		void setBlockBinding(GLuint blockBinding);
 
 	private:
 		GLUniformBlock* uniformBlock_;
+		unsigned int generation_;
 		GLubyte* dataPointer_;
 		/// Keeps tracks of how much of the cache needs to be uploaded to the UBO
 		GLint usedSize_;
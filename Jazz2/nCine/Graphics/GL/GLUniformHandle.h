@@ -0,0 +1,33 @@
+#pragma once
+
+namespace nCine
+{
+	/// A uniform or uniform block name resolved to a compact index on first use
+	/*! The index is remembered together with the shader program (or uniform block) it was resolved for and its generation,
+	 *  so the name is only hashed again when the handle is used with a different one. The generation changes when the program
+	 *  is linked again, so an index is never reused for a different program allocated at the same address.
+	 *  Handles are meant to be long-lived, one for each call site that updates uniforms every frame. */
+	class GLUniformHandle
+	{
+	public:
+		explicit GLUniformHandle(const char* name)
+			: name_(name), owner_(nullptr), generation_(0), index_(0) {}
+
+		inline const char* name() const {
+			return name_;
+		}
+
+	private:
+		const char* name_;
+		/// The shader program or uniform block the index has been resolved for
+		const void* owner_;
+		/// Generation of the shader program the index has been resolved for, see `GLShaderProgram::generation()`
+		unsigned int generation_;
+		unsigned int index_;
+
+		friend class GLShaderUniforms;
+		friend class GLShaderUniformBlocks;
+		friend class GLUniformBlockCache;
+	};
+
+}
@@ -128,6 +128,14 @@ namespace nCine
 		inline GLUniformBlockCache* uniformBlock(const char* name) {
 			return shaderUniformBlocks_.uniformBlock(name);
 		}
+		/// Wrapper around `GLShaderUniforms::uniform()` with a precompiled handle
+		inline GLUniformCache* uniform(GLUniformHandle& handle) {
+			return shaderUniforms_.uniform(handle);
+		}
+		/// Wrapper around `GLShaderUniformBlocks::uniformBlock()` with a precompiled handle
+		inline GLUniformBlockCache* uniformBlock(GLUniformHandle& handle) {
+			return shaderUniformBlocks_.uniformBlock(handle);
+		}
 
 		/// Wrapper around `GLShaderUniforms::allUniforms()`
 		inline const GLShaderUniforms::UniformHashMapType allUniforms() const {
@@ -184,5 +192,18 @@ namespace nCine
 		friend class RenderCommand;
 	};
 
+	/// Precompiled handles for the instance block of sprite shaders and its uniforms
+	struct InstanceBlockHandles
+	{
+		InstanceBlockHandles()
+			: block(Material::InstanceBlockName), texRect(Material::TexRectUniformName),
+				spriteSize(Material::SpriteSizeUniformName), color(Material::ColorUniformName) {}
+
+		GLUniformHandle block;
+		GLUniformHandle texRect;
+		GLUniformHandle spriteSize;
+		GLUniformHandle color;
+	};
+
 }
 
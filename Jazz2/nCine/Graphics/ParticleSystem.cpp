@@ -219,6 +219,10 @@ namespace nCine
 			}
 		}
 
+		// Particles are already transformed, with the flattened update they only have to be culled by the viewport
+		if (flattenedNodes_ != nullptr)
+			collectFlattenedNodes();
+
 		lastFrameUpdated_ = theApplication().numFrames();
 
 #ifdef WITH_TRACY
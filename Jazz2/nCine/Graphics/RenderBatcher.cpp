@@ -7,6 +7,7 @@
 #include "RenderResources.h"
 #include "../Application.h"
 #include "../ServiceLocator.h"
+#include "../Base/FrameArena.h"
 #include "../Base/StaticHashMapIterator.h"
 
 namespace nCine
@@ -28,9 +29,6 @@ namespace nCine
 
 		// Clamping the value as some drivers report a maximum size similar to SSBO one
 		UboMaxSize = maxUniformBlockSize <= 64 * 1024 ? maxUniformBlockSize : 64 * 1024;
-
-		// Create the first buffer right away
-		createBuffer(UboMaxSize);
 	}
 
 	///////////////////////////////////////////////////////////
@@ -122,14 +120,6 @@ namespace nCine
 			destQueue.push_back(srcQueue[0]);
 	}
 
-	void RenderBatcher::reset()
-	{
-		// Reset managed buffers
-		for (ManagedBuffer& buffer : buffers_) {
-			buffer.freeSpace = buffer.size;
-		}
-	}
-
 	///////////////////////////////////////////////////////////
 	// PRIVATE FUNCTIONS
 	///////////////////////////////////////////////////////////
@@ -388,32 +378,7 @@ namespace nCine
 	{
 		FATAL_ASSERT(bytes <= UboMaxSize);
 
-		unsigned char* ptr = nullptr;
-
-		for (ManagedBuffer& buffer : buffers_) {
-			if (buffer.freeSpace >= bytes) {
-				const unsigned int offset = buffer.size - buffer.freeSpace;
-				ptr = buffer.buffer.get() + offset;
-				buffer.freeSpace -= bytes;
-				break;
-			}
-		}
-
-		if (ptr == nullptr) {
-			createBuffer(UboMaxSize);
-			ptr = buffers_.back().buffer.get();
-			buffers_.back().freeSpace -= bytes;
-		}
-
-		return ptr;
-	}
-
-	void RenderBatcher::createBuffer(unsigned int size)
-	{
-		ManagedBuffer& managedBuffer = buffers_.emplace_back();
-		managedBuffer.size = size;
-		managedBuffer.freeSpace = size;
-		managedBuffer.buffer = std::make_unique<unsigned char[]>(size);
+		return static_cast<unsigned char*>(theApplication().frameArena().allocate(bytes));
 	}
 
 }
@@ -4,7 +4,9 @@
 #include "RenderResources.h"
 #include "Camera.h"
 #include "DrawableNode.h"
+#include "../Base/AllocManager.h"
 #include "../tracy.h"
+#include "../../Common.h"
 
 namespace nCine
 {
@@ -21,7 +23,8 @@ namespace nCine
 	RenderCommand::RenderCommand(CommandTypes profilingType)
 		: materialSortKey_(0), layer_(0),
 		numInstances_(0), batchSize_(0), transformationCommitted_(false),
-		profilingType_(profilingType), modelMatrix_(Matrix4x4f::Identity)
+		profilingType_(profilingType), modelMatrix_(Matrix4x4f::Identity),
+		instanceBlockHandle_(Material::InstanceBlockName), modelMatrixHandle_(Material::ModelMatrixUniformName)
 	{
 	}
 
@@ -30,6 +33,18 @@ namespace nCine
 	{
 	}
 
+	void* RenderCommand::operator new(std::size_t size)
+	{
+		void* ptr = theRenderingAllocator().allocate(size, alignof(RenderCommand));
+		FATAL_ASSERT_MSG_X(ptr != nullptr, "Allocator \"%s\" cannot allocate %zu bytes", theRenderingAllocator().name(), size);
+		return ptr;
+	}
+
+	void RenderCommand::operator delete(void* ptr)
+	{
+		theRenderingAllocator().deallocate(ptr);
+	}
+
 	///////////////////////////////////////////////////////////
 	// PUBLIC FUNCTIONS
 	///////////////////////////////////////////////////////////
@@ -90,10 +105,10 @@ namespace nCine
 		modelMatrix_[3][2] = calculateDepth(layer_, cameraValues.near, cameraValues.far);
 
 		if (material_.shaderProgram_ && material_.shaderProgram_->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION) {
-			GLUniformBlockCache* instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
+			GLUniformBlockCache* instanceBlock = material_.uniformBlock(instanceBlockHandle_);
 			GLUniformCache* matrixUniform = instanceBlock
-				? instanceBlock->uniform(Material::ModelMatrixUniformName)
-				: material_.uniform(Material::ModelMatrixUniformName);
+				? instanceBlock->uniform(modelMatrixHandle_)
+				: material_.uniform(modelMatrixHandle_);
 			if (matrixUniform) {
 				ZoneScopedN("Set model matrix");
 				matrixUniform->setFloatVector(modelMatrix_.Data());
@@ -35,6 +35,10 @@ namespace nCine
 		explicit RenderCommand(CommandTypes profilingType);
 		RenderCommand();
 
+		/// Dynamically allocated commands are accounted to the rendering allocator
+		static void* operator new(std::size_t size);
+		static void operator delete(void* ptr);
+
 		/// Returns the command type for profiling counter
 		inline CommandTypes profilingType() const {
 			return profilingType_;
@@ -166,6 +170,10 @@ namespace nCine
 		Material material_;
 		Geometry geometry_;
 
+		/// Handles used to commit the model matrix without looking up names every frame
+		GLUniformHandle instanceBlockHandle_;
+		GLUniformHandle modelMatrixHandle_;
+
 		/// Returns the final layer sort key for this command
 		inline uint32_t layerSortKey() const {
 			return static_cast<uint32_t>(layer_ << 16) + visitOrder_;
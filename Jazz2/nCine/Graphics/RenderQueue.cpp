@@ -206,8 +206,6 @@ namespace nCine
 		opaqueBatchedQueue_.clear();
 		transparentQueue_.clear();
 		transparentBatchedQueue_.clear();
-
-		RenderResources::renderBatcher().reset();
 	}
 
 }
@@ -5,6 +5,8 @@
 
 namespace nCine
 {
+	SmallVectorImpl<SceneNode*>* SceneNode::flattenedNodes_ = nullptr;
+
 	///////////////////////////////////////////////////////////
 	// CONSTRUCTORS and DESTRUCTOR
 	///////////////////////////////////////////////////////////
@@ -19,7 +21,7 @@ namespace nCine
 		color_(Color::White), layer_(0), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f),
 		absRotation_(0.0f), absColor_(Color::White), absLayer_(0),
 		worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-		shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0)
+		shouldDeleteChildrenOnDestruction_(true), cullsChildren_(false), dirtyBits_(0xFF), lastFrameUpdated_(0), flattenedIndex_(0)
 	{
 		setParent(parent);
 	}
@@ -43,6 +45,14 @@ namespace nCine
 
 	SceneNode::~SceneNode()
 	{
+		if (flattenedNodes_ != nullptr) {
+			// Node destroyed in the middle of the update must not be processed by the flattened pass, the slot is cleared
+			// instead of removed, because parents have to precede their children
+			if (flattenedIndex_ < flattenedNodes_->size() && (*flattenedNodes_)[flattenedIndex_] == this) {
+				(*flattenedNodes_)[flattenedIndex_] = nullptr;
+			}
+		}
+
 		if (shouldDeleteChildrenOnDestruction_) {
 			for (SceneNode* child : children_)
 				delete child;
@@ -61,8 +71,8 @@ namespace nCine
 		visitOrderState_(other.visitOrderState_),
 		position_(other.position_), anchorPoint_(other.anchorPoint_),
 		scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
-		layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
-		dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_)
+		layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), cullsChildren_(other.cullsChildren_),
+		dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_), flattenedIndex_(0)
 	{
 		swapChildPointer(this, &other);
 		for (SceneNode* child : children_)
@@ -85,6 +95,7 @@ namespace nCine
 		color_ = other.color_;
 		layer_ = other.layer_;
 		shouldDeleteChildrenOnDestruction_ = other.shouldDeleteChildrenOnDestruction_;
+		cullsChildren_ = other.cullsChildren_;
 		dirtyBits_ = other.dirtyBits_;
 		lastFrameUpdated_ = other.lastFrameUpdated_;
 
@@ -268,19 +279,27 @@ namespace nCine
 		// Early return not needed, the first call to this method is on the root node
 
 		if (updateEnabled_) {
-			transform();
+			// With the flattened update, the viewport transforms all collected nodes after the whole tree is updated
+			if (flattenedNodes_ != nullptr) {
+				flattenedIndex_ = (unsigned int)flattenedNodes_->size();
+				flattenedNodes_->push_back(this);
+			} else {
+				transform();
+			}
 
 			for (unsigned int i = 0; i < (unsigned int)children_.size(); i++) {
 				children_[i]->OnUpdate(timeMult);
 			}
 
 			// A non drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
-			if (type_ == ObjectType::SCENENODE) {
+			if (type_ == ObjectType::SCENENODE && flattenedNodes_ == nullptr) {
 				dirtyBits_.reset(DirtyBitPositions::TransformationBit);
 				dirtyBits_.reset(DirtyBitPositions::ColorBit);
 			}
 
 			lastFrameUpdated_ = theApplication().numFrames();
+		} else if (flattenedNodes_ != nullptr) {
+			collectFlattenedNodes();
 		}
 	}
 
@@ -317,7 +336,7 @@ namespace nCine
 		scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
 		layer_(other.layer_), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f), absRotation_(0.0f),
 		absColor_(Color::White), absLayer_(0), worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-		shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF)
+		shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), cullsChildren_(other.cullsChildren_), dirtyBits_(0xFF), lastFrameUpdated_(0), flattenedIndex_(0)
 	{
 		setParent(other.parent_);
 	}
@@ -340,10 +359,17 @@ namespace nCine
 		}
 	}
 
-	void SceneNode::transform()
+	void SceneNode::collectFlattenedNodes()
 	{
-		ZoneScoped;
+		flattenedIndex_ = (unsigned int)flattenedNodes_->size();
+		flattenedNodes_->push_back(this);
+		for (SceneNode* child : children_) {
+			child->collectFlattenedNodes();
+		}
+	}
 
+	void SceneNode::transform()
+	{
 		if (parent_ && layer_ == 0)
 			absLayer_ = parent_->absLayer_;
 		else
@@ -341,12 +341,16 @@ namespace nCine
 
 		/// A flag indicating whether the destructor should also delete all children
 		bool shouldDeleteChildrenOnDestruction_;
+		/// A flag indicating whether the node culls its direct children by itself in `OnVisit()`, viewports don't test them then
+		bool cullsChildren_;
 
 		/// Bitset that stores the various dirty states bits
 		BitSet<uint8_t> dirtyBits_;
 
 		/// The last frame any viewport updated this node
 		unsigned long int lastFrameUpdated_;
+		/// Position of the node in `flattenedNodes_` when it was collected last time, it's valid only if the node is still there
+		unsigned int flattenedIndex_;
 
 		/// Deleted assignment operator
 		SceneNode& operator=(const SceneNode&) = delete;
@@ -358,6 +362,14 @@ namespace nCine
 		void swapChildPointer(SceneNode* first, SceneNode* second);
 
 		virtual void transform();
+
+		/// Nodes collected in depth-first order while a viewport is updated, `nullptr` if the flattened update is not active
+		static SmallVectorImpl<SceneNode*>* flattenedNodes_;
+
+		/// Collects nodes of a subtree that is not updated by `SceneNode::OnUpdate()`, they are still culled
+		void collectFlattenedNodes();
+
+		friend class Viewport;
 	};
 
 	inline const SmallVectorImpl<const SceneNode*>& SceneNode::children() const
@@ -61,6 +61,11 @@ namespace nCine
 	///////////////////////////////////////////////////////////
 
 	SmallVector<Viewport*> Viewport::chain_;
+	SmallVector<DrawableNode*, 0> Viewport::cullingNodes_;
+	SmallVector<Rectf, 0> Viewport::cullingAabbs_;
+	SmallVector<uint8_t, 0> Viewport::cullingOverlaps_;
+	const SceneNode* Viewport::cullingRootNode_ = nullptr;
+	unsigned long int Viewport::cullingFrame_ = 0;
 
 	///////////////////////////////////////////////////////////
 	// CONSTRUCTORS and DESTRUCTOR
@@ -326,10 +331,26 @@ namespace nCine
 		calculateCullingRect();
 		if (rootNode_) {
 			ZoneScoped;
-			if (rootNode_->lastFrameUpdated() < theApplication().numFrames())
-				rootNode_->OnUpdate(theApplication().timeMult());
-			// AABBs should update after nodes have been transformed
-			updateCulling(rootNode_);
+			const bool flattenedUpdate = theApplication().renderingSettings().flattenedUpdateEnabled;
+			if (rootNode_->lastFrameUpdated() < theApplication().numFrames()) {
+				if (flattenedUpdate) {
+					flattenedNodes_.clear();
+					SceneNode::flattenedNodes_ = &flattenedNodes_;
+					rootNode_->OnUpdate(theApplication().timeMult());
+					updateFlattenedNodes();
+					SceneNode::flattenedNodes_ = nullptr;
+				} else {
+					rootNode_->OnUpdate(theApplication().timeMult());
+					// AABBs should update after nodes have been transformed
+					updateCulling(rootNode_);
+				}
+			} else if (flattenedUpdate && cullingRootNode_ == rootNode_ && cullingFrame_ == theApplication().numFrames()) {
+				// Root node was already updated by another viewport, nodes it gathered are only tested against this one
+				cullGatheredNodes();
+			} else {
+				// Root node was already updated by another viewport, only the culling is needed
+				updateCulling(rootNode_);
+			}
 		}
 
 		stateBits_.set(StateBitPositions::UpdatedBit);
@@ -463,13 +484,103 @@ namespace nCine
 	// PRIVATE FUNCTIONS
 	///////////////////////////////////////////////////////////
 
+	void Viewport::updateFlattenedNodes()
+	{
+		ZoneScoped;
+
+		const unsigned long int numFrames = theApplication().numFrames();
+
+		// Parents precede their children, so transformations are propagated in a single linear pass
+		for (SceneNode* node : flattenedNodes_) {
+			if (node != nullptr && node->lastFrameUpdated_ == numFrames) {
+				node->transform();
+			}
+		}
+
+		// A non drawable scenenode does not have the `updateRenderCommand()` method to reset the flags,
+		// they can be reset only after all its children have been transformed
+		for (SceneNode* node : flattenedNodes_) {
+			if (node != nullptr && node->type() == Object::ObjectType::SCENENODE && node->lastFrameUpdated_ == numFrames) {
+				node->dirtyBits_.reset(SceneNode::DirtyBitPositions::TransformationBit);
+				node->dirtyBits_.reset(SceneNode::DirtyBitPositions::ColorBit);
+			}
+		}
+
+		if (!theApplication().renderingSettings().cullingEnabled) {
+			flattenedNodes_.clear();
+			return;
+		}
+
+		// Gather AABBs of drawable nodes, other viewports with the same root node reuse them in this frame
+		cullingNodes_.clear();
+		cullingAabbs_.clear();
+		for (SceneNode* node : flattenedNodes_) {
+			if (node == nullptr || node->type() == Object::ObjectType::SCENENODE || node->type() == Object::ObjectType::PARTICLE_SYSTEM) {
+				continue;
+			}
+			// Children of such nodes are culled by their parent when it's visited
+			if (node->parent_ != nullptr && node->parent_->cullsChildren_) {
+				continue;
+			}
+
+			DrawableNode* drawable = static_cast<DrawableNode*>(node);
+			if (drawable->drawEnabled_ && drawable->width_ > 0 && drawable->height_ > 0) {
+				if (drawable->dirtyBits_.test(SceneNode::DirtyBitPositions::AabbBit)) {
+					drawable->updateAabb();
+					drawable->dirtyBits_.reset(SceneNode::DirtyBitPositions::AabbBit);
+				}
+				cullingNodes_.push_back(drawable);
+				cullingAabbs_.push_back(drawable->aabb_);
+			}
+		}
+		cullingRootNode_ = rootNode_;
+		cullingFrame_ = numFrames;
+
+		// Nodes can be destroyed before the next update, gathered ones are only used by viewports updated in this frame
+		flattenedNodes_.clear();
+
+		cullGatheredNodes();
+	}
+
+	void Viewport::cullGatheredNodes()
+	{
+		ZoneScoped;
+
+		const unsigned long int numFrames = theApplication().numFrames();
+
+		// Overlap tests only read the contiguous array of AABBs, nodes are touched only if they are visible
+		const unsigned int count = (unsigned int)cullingAabbs_.size();
+		cullingOverlaps_.resize_for_overwrite(count);
+		const Rectf* aabbs = cullingAabbs_.data();
+		uint8_t* overlaps = cullingOverlaps_.data();
+		const Vector2f cullMin = cullingRect_.Min();
+		const Vector2f cullMax = cullingRect_.Max();
+		for (unsigned int i = 0; i < count; i++) {
+			// Size can be negative for flipped nodes, same as in `Rect::Overlaps()`
+			const Rectf& aabb = aabbs[i];
+			const float minX = std::min(aabb.X, aabb.X + aabb.W);
+			const float maxX = std::max(aabb.X, aabb.X + aabb.W);
+			const float minY = std::min(aabb.Y, aabb.Y + aabb.H);
+			const float maxY = std::max(aabb.Y, aabb.Y + aabb.H);
+			overlaps[i] = (uint8_t)((minX <= cullMax.X) & (maxX >= cullMin.X) & (minY <= cullMax.Y) & (maxY >= cullMin.Y));
+		}
+
+		// Nodes already marked by another viewport are marked again, it's cheaper than filtering them out
+		for (unsigned int i = 0; i < count; i++) {
+			if (overlaps[i]) {
+				cullingNodes_[i]->lastFrameRendered_ = numFrames;
+			}
+		}
+	}
+
 	void Viewport::updateCulling(SceneNode* node)
 	{
 		for (SceneNode* child : node->children())
 			updateCulling(child);
 
 		if (node->type() != Object::ObjectType::SCENENODE &&
-			node->type() != Object::ObjectType::PARTICLE_SYSTEM) {
+			node->type() != Object::ObjectType::PARTICLE_SYSTEM &&
+			(node->parent_ == nullptr || !node->parent_->cullsChildren_)) {
 			DrawableNode* drawable = static_cast<DrawableNode*>(node);
 			drawable->updateCulling();
 		}
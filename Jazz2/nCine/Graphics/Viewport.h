@@ -14,6 +14,7 @@ using namespace Death::Containers;
 namespace nCine
 {
 	class SceneNode;
+	class DrawableNode;
 	class Camera;
 	class RenderQueue;
 	class GLFramebuffer;
@@ -285,7 +286,20 @@ namespace nCine
 	private:
 		unsigned int numColorAttachments_;
 
+		/// Nodes collected in depth-first order by the update of the root node, parents always precede their children
+		SmallVector<SceneNode*, 0> flattenedNodes_;
+		/// Drawable nodes which are tested for culling, with their AABBs in a contiguous array
+		/*! They are shared by all viewports, so viewports with the same root node gather them only once per frame. */
+		static SmallVector<DrawableNode*, 0> cullingNodes_;
+		static SmallVector<Rectf, 0> cullingAabbs_;
+		static SmallVector<uint8_t, 0> cullingOverlaps_;
+		/// Root node and frame number the culling nodes were gathered for
+		static const SceneNode* cullingRootNode_;
+		static unsigned long int cullingFrame_;
+
 		void updateCulling(SceneNode* node);
+		void updateFlattenedNodes();
+		void cullGatheredNodes();
 
 		friend class Application;
 		friend class ScreenViewport;
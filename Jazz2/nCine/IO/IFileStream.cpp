@@ -15,7 +15,7 @@ namespace nCine
 
 	IFileStream::IFileStream(const String& filename)
 		: type_(FileType::Base), filename_(filename), fileDescriptor_(-1), filePointer_(nullptr),
-		shouldCloseOnDestruction_(true), shouldExitOnFailToOpen_(true), fileSize_(0)
+		shouldCloseOnDestruction_(true), shouldExitOnFailToOpen_(true), fileSize_(0), readViewBufferSize_(0)
 	{
 	}
 
@@ -31,6 +31,18 @@ namespace nCine
 			return false;
 	}
 
+	ArrayView<const uint8_t> IFileStream::ReadView(unsigned long int bytes)
+	{
+		// The buffer is only grown, so reading a file in blocks of the same size allocates just once
+		if (readViewBufferSize_ < bytes) {
+			readViewBuffer_ = std::make_unique<uint8_t[]>(bytes);
+			readViewBufferSize_ = bytes;
+		}
+
+		unsigned long int bytesRead = Read(readViewBuffer_.get(), bytes);
+		return ArrayView<const uint8_t>(readViewBuffer_.get(), bytesRead);
+	}
+
 	std::unique_ptr<IFileStream> IFileStream::createFromMemory(const char* bufferName, unsigned char* bufferPtr, unsigned long int bufferSize)
 	{
 		ASSERT(bufferName);
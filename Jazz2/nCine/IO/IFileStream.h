@@ -6,6 +6,7 @@
 #include <cstdint> // for endianness conversions
 #include <memory>
 
+#include <Containers/ArrayView.h>
 #include <Containers/String.h>
 
 using namespace Death::Containers;
@@ -63,6 +64,10 @@ namespace nCine
 		/// Writes a certain amount of bytes from a buffer to the file
 		/*! \return Number of bytes written */
 		virtual unsigned long int Write(void* buffer, unsigned long int bytes) = 0;
+		/// Reads a certain amount of bytes from the file and returns a view of them
+		/*! The view stays valid only until the next call of this function or until the file is closed.
+		 *  It can be shorter than requested if the end of the file is reached. */
+		virtual ArrayView<const uint8_t> ReadView(unsigned long int bytes);
 
 		/// Sets the close on destruction flag
 		/*! If the flag is true the file is closed upon object destruction. */
@@ -102,6 +107,18 @@ namespace nCine
 			return buffer;
 		}
 
+		/// Reads an array of values with a single call
+		/*! \return Number of whole values read */
+		template<typename T>
+		inline unsigned long int ReadValues(T* buffer, unsigned long int count) {
+			return Read(buffer, count * sizeof(T)) / sizeof(T);
+		}
+
+		template<typename T>
+		inline void WriteValue(const T& value) {
+			Write((void*)&value, sizeof(T));
+		}
+
 		/// Reads a little endian 16 bit unsigned integer
 		inline static uint16_t int16FromLE(uint16_t number) {
 			return number;
@@ -167,6 +184,10 @@ namespace nCine
 		/// File size in bytes
 		unsigned long int fileSize_;
 
+		/// Buffer returned by the default implementation of `ReadView()`
+		std::unique_ptr<uint8_t[]> readViewBuffer_;
+		unsigned long int readViewBufferSize_;
+
 	private:
 		/// The `TextureSaverPng` class needs to access the `filePointer_`
 		//friend class TextureSaverPng;
@@ -110,6 +110,19 @@ namespace nCine
 		return bytesRead;
 	}
 
+	ArrayView<const uint8_t> MemoryFile::ReadView(unsigned long int bytes)
+	{
+		unsigned long int bytesRead = 0;
+		const uint8_t* data = bufferPtr_ + seekOffset_;
+
+		if (fileDescriptor_ >= 0) {
+			bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+			seekOffset_ += bytesRead;
+		}
+
+		return ArrayView<const uint8_t>(data, bytesRead);
+	}
+
 	unsigned long int MemoryFile::Write(void* buffer, unsigned long int bytes)
 	{
 		ASSERT(buffer);
@@ -19,6 +19,8 @@ namespace nCine
 		long int GetPosition() const override;
 		unsigned long int Read(void* buffer, unsigned long int bytes) const override;
 		unsigned long int Write(void* buffer, unsigned long int bytes) override;
+		/// Returns a view directly into the memory buffer, no data are copied
+		ArrayView<const uint8_t> ReadView(unsigned long int bytes) override;
 
 	private:
 		unsigned char* bufferPtr_;
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../Common.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <Containers/ArrayView.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/// Reads typed values from a block of memory, usually returned by `IFileStream::ReadView()`
+	/*! Values are copied from the block directly, so no virtual calls are involved.
+	 *  Reading beyond the end of the block returns zeros and sets the overflow flag. */
+	class SpanReader
+	{
+	public:
+		explicit SpanReader(ArrayView<const uint8_t> data)
+			: data_(data), position_(0), hasOverflowed_(false) {}
+
+		/// Reads a value of the specified type
+		template<typename T>
+		inline T ReadValue() {
+			T value;
+			Read(&value, sizeof(T));
+			return value;
+		}
+
+		/// Copies a certain amount of bytes to a buffer
+		inline void Read(void* buffer, std::size_t bytes) {
+			if (bytes <= data_.size() - position_) {
+				std::memcpy(buffer, data_.data() + position_, bytes);
+				position_ += bytes;
+			} else {
+				std::memset(buffer, 0, bytes);
+				position_ = data_.size();
+				hasOverflowed_ = true;
+			}
+		}
+
+		/// Skips a certain amount of bytes
+		inline void Skip(std::size_t bytes) {
+			if (bytes <= data_.size() - position_) {
+				position_ += bytes;
+			} else {
+				position_ = data_.size();
+				hasOverflowed_ = true;
+			}
+		}
+
+		/// Returns the read position in bytes
+		inline std::size_t GetPosition() const {
+			return position_;
+		}
+		/// Returns the number of bytes left to read
+		inline std::size_t GetRemaining() const {
+			return data_.size() - position_;
+		}
+		/// Returns true if any read reached beyond the end of the block
+		inline bool HasOverflowed() const {
+			return hasOverflowed_;
+		}
+
+	private:
+		ArrayView<const uint8_t> data_;
+		std::size_t position_;
+		bool hasOverflowed_;
+	};
+
+}
@@ -85,19 +85,20 @@ namespace nCine
 
 		unsigned int numStrings = 0;
 
-		// Add mappings from the database, without searching for duplicates
+		// Index mappings from the database only by GUID, the whole string is parsed when a joystick connects
 		const char** mappingStrings = ControllerMappings;
-		MappedJoystick mapping;
+		pendingMappings_.reserve(sizeof(ControllerMappings) / sizeof(ControllerMappings[0]));
+		pendingOrder_.reserve(sizeof(ControllerMappings) / sizeof(ControllerMappings[0]));
+		MappedJoystick::Guid guid;
 		while (*mappingStrings) {
 			numStrings++;
-			const bool parsed = parseMappingFromString(*mappingStrings, mapping);
-			if (parsed) {
-				mappings_.push_back(mapping);
-			}
+			// The first mapping with the same GUID is used
+			if (parseGuidFromString(*mappingStrings, guid) && pendingMappings_.emplace(guid, *mappingStrings).second)
+				pendingOrder_.push_back(guid);
 			mappingStrings++;
 		}
 
-		LOGI_X("Parsed %u strings for %u mappings", numStrings, mappings_.size());
+		LOGI_X("Indexed %u strings for %u mappings", numStrings, pendingMappings_.size());
 	}
 
 	///////////////////////////////////////////////////////////
@@ -137,11 +138,9 @@ namespace nCine
 		MappedJoystick newMapping;
 		const bool parsed = parseMappingFromString(mappingString, newMapping);
 		if (parsed) {
-			int index = findMappingByGuid(newMapping.guid);
-			// if GUID is not found then mapping has to be added, not replaced
-			if (index < 0)
-				index = mappings_.size();
-			mappings_[index] = newMapping;
+			// User mappings replace the ones from the database
+			pendingMappings_.erase(newMapping.guid);
+			addMapping(newMapping);
 		}
 		checkConnectedJoystics();
 
@@ -156,11 +155,8 @@ namespace nCine
 			MappedJoystick newMapping;
 			const bool parsed = parseMappingFromString(*mappingStrings, newMapping);
 			if (parsed) {
-				int index = findMappingByGuid(newMapping.guid);
-				// if GUID is not found then mapping has to be added, not replaced
-				if (index < 0)
-					index = mappings_.size();
-				mappings_[index] = newMapping;
+				pendingMappings_.erase(newMapping.guid);
+				addMapping(newMapping);
 			}
 			mappingStrings++;
 		}
@@ -192,13 +188,8 @@ namespace nCine
 			const bool parsed = parseMappingFromString(buffer, newMapping);
 			if (parsed) {
 				numParsed++;
-				int index = findMappingByGuid(newMapping.guid);
-				// if GUID is not found then mapping has to be added, not replaced
-				if (index < 0) {
-					mappings_.push_back(newMapping);
-				} else {
-					mappings_[index] = newMapping;
-				}
+				pendingMappings_.erase(newMapping.guid);
+				addMapping(newMapping);
 			}
 
 		} while (strchr(buffer, '\n') && (buffer = strchr(buffer, '\n') + 1) < fileBuffer.get() + fileSize);
@@ -388,34 +379,104 @@ namespace nCine
 
 	int JoyMapping::findMappingByGuid(const MappedJoystick::Guid& guid)
 	{
-		int index = -1;
+		auto it = mappingsByGuid_.find(guid);
+		if (it != mappingsByGuid_.end())
+			return it->second;
 
-		const unsigned int size = mappings_.size();
-		for (unsigned int i = 0; i < size; i++) {
-			if (mappings_[i].guid == guid) {
-				index = static_cast<int>(i);
-				break;
-			}
-		}
+		auto pending = pendingMappings_.find(guid);
+		if (pending == pendingMappings_.end())
+			return -1;
 
-		return index;
+		// The string is removed from pending mappings even if it cannot be parsed, so it's never parsed again
+		const char* mappingString = pending->second;
+		pendingMappings_.erase(pending);
+
+		MappedJoystick mapping;
+		if (!parseMappingFromString(mappingString, mapping))
+			return -1;
+
+		return addMapping(mapping);
 	}
 
 	int JoyMapping::findMappingByName(const char* name)
 	{
-		int index = -1;
-
 		const unsigned int size = mappings_.size();
 		for (unsigned int i = 0; i < size; i++) {
-			if (strncmp(mappings_[i].name, name, MaxNameLength) == 0) {
-				index = static_cast<int>(i);
-				break;
-			}
+			if (strncmp(mappings_[i].name, name, MaxNameLength) == 0)
+				return static_cast<int>(i);
+		}
+
+		// Joysticks without GUID are rare, so only the name field of pending mappings is compared here,
+		// in the order of the database, mappings that were already parsed or replaced are skipped
+		for (const MappedJoystick::Guid& guid : pendingOrder_) {
+			auto it = pendingMappings_.find(guid);
+			if (it == pendingMappings_.end())
+				continue;
+
+			const char* nameStart = strchr(it->second, ',');
+			const char* nameEnd = (nameStart != nullptr ? strchr(nameStart + 1, ',') : nullptr);
+			if (nameEnd == nullptr)
+				continue;
+
+			nameStart++;
+			trimSpaces(&nameStart, &nameEnd);
+			const unsigned int nameLength = std::min(static_cast<unsigned int>(nameEnd - nameStart), MaxNameLength);
+			if (strncmp(nameStart, name, nameLength) != 0 || name[nameLength] != '\0')
+				continue;
+
+			// The string is removed from pending mappings even if it cannot be parsed, the search continues with the next one
+			const char* mappingString = it->second;
+			pendingMappings_.erase(it);
+
+			MappedJoystick mapping;
+			if (parseMappingFromString(mappingString, mapping))
+				return addMapping(mapping);
+		}
+
+		return -1;
+	}
+
+	int JoyMapping::addMapping(const MappedJoystick& mapping)
+	{
+		// If GUID is not found then mapping has to be added, not replaced
+		auto it = mappingsByGuid_.find(mapping.guid);
+		if (it != mappingsByGuid_.end()) {
+			mappings_[it->second] = mapping;
+			return it->second;
 		}
 
+		const int index = static_cast<int>(mappings_.size());
+		mappings_.push_back(mapping);
+		mappingsByGuid_.emplace(mapping.guid, index);
 		return index;
 	}
 
+	bool JoyMapping::parseGuidFromString(const char* mappingString, MappedJoystick::Guid& guid) const
+	{
+		if (mappingString[0] == '\0' ||
+			mappingString[0] == '\n' ||
+			mappingString[0] == '#') {
+			return false;
+		}
+
+		const char* subStart = mappingString;
+		const char* subEnd = strchr(subStart, ',');
+		if (subEnd == nullptr)
+			return false;
+		trimSpaces(&subStart, &subEnd);
+
+#ifndef __EMSCRIPTEN__
+		const unsigned int GuidNumCharacters = 32;
+#else
+		const unsigned int GuidNumCharacters = 7; // "default"
+#endif
+		if (static_cast<unsigned int>(subEnd - subStart) != GuidNumCharacters)
+			return false;
+
+		guid.fromString(subStart);
+		return true;
+	}
+
 	bool JoyMapping::parseMappingFromString(const char* mappingString, MappedJoystick& map)
 	{
 		// Early out if the string is empty or a comment
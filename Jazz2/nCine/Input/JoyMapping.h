@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "InputEvents.h"
+#include "../Base/HashMap.h"
 
 #include <Containers/SmallVector.h>
 #include <Containers/StringView.h>
@@ -70,7 +71,7 @@ namespace nCine
 		void addMappingsFromStrings(const char** mappingStrings);
 		void addMappingsFromFile(const StringView& filename);
 		inline unsigned int numMappings() const {
-			return (unsigned int)mappings_.size();
+			return (unsigned int)(mappings_.size() + pendingMappings_.size());
 		}
 
 		void onJoyButtonPressed(const JoyButtonEvent& event);
@@ -129,6 +130,12 @@ namespace nCine
 		static const int MaxNumJoysticks = 4;
 		int mappingIndex_[MaxNumJoysticks];
 		SmallVector<MappedJoystick, 0> mappings_;
+		/// Indices to `mappings_` of already parsed mappings
+		HashMap<MappedJoystick::Guid, int> mappingsByGuid_;
+		/// Strings from the embedded database that are parsed on the first request
+		HashMap<MappedJoystick::Guid, const char*> pendingMappings_;
+		/// GUIDs of pending mappings in the order of the database, so the name fallback finds the same mapping as a linear scan
+		SmallVector<MappedJoystick::Guid, 0> pendingOrder_;
 
 		static JoyMappedStateImpl nullMappedJoyState_;
 		static SmallVector<JoyMappedStateImpl, MaxNumJoysticks> mappedJoyStates_;
@@ -141,6 +148,8 @@ namespace nCine
 		void checkConnectedJoystics();
 		int findMappingByGuid(const MappedJoystick::Guid& guid);
 		int findMappingByName(const char* name);
+		int addMapping(const MappedJoystick& mapping);
+		bool parseGuidFromString(const char* mappingString, MappedJoystick::Guid& guid) const;
 		bool parseMappingFromString(const char* mappingString, MappedJoystick& map);
 		bool parsePlatformKeyword(const char* start, const char* end) const;
 		bool parsePlatformName(const char* start, const char* end) const;
@@ -34,7 +34,7 @@ option(NCINE_WITH_VORBIS "Enable Ogg Vorbis audio file loading" OFF)
 #	option(NCINE_WITH_SCRIPTING_API "Enable Lua scripting API" OFF)
 #endif()
 
-#option(NCINE_WITH_ALLOCATORS "Enable the custom memory allocators" OFF)
+option(NCINE_USE_FREELIST "Use the free list custom allocator instead of malloc()/free() as the default allocator" OFF)
 #option(NCINE_WITH_IMGUI "Enable the integration with Dear ImGui" OFF)
 #option(NCINE_WITH_NUKLEAR "Enable the integration with Nuklear" OFF)
 option(NCINE_WITH_TRACY "Enable the integration with the Tracy frame profiler" OFF)
@@ -56,10 +56,7 @@ if(NCINE_BUILD_ANDROID)
 	option(NCINE_ASSEMBLE_APK "Assemble the Android APK of the startup test with Gradle" OFF)
 endif()
 
-if(NCINE_WITH_ALLOCATORS)
-	option(NCINE_RECORD_ALLOCATIONS "Record a timestamp of every allocation and deallocation" OFF)
-	option(NCINE_OVERRIDE_NEW "Override global new and delete operators to use custom allocators" OFF)
-	option(NCINE_USE_FREELIST "Use the free list custom allocator instead of malloc()/free()" OFF)
+if(NCINE_USE_FREELIST)
 	set(NCINE_FREELIST_BUFFER "33554432" CACHE STRING "Size in bytes of the free list allocator buffer")
 endif()
 
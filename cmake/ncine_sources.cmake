@@ -7,12 +7,21 @@ set(SOURCES
 )
 
 list(APPEND SOURCES
+	${NCINE_SOURCE_DIR}/nCine/Base/AllocManager.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/BitArray.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Clock.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameArena.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/FrameTimer.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/FreeListAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/IAllocator.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/LinearAllocator.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/MallocAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Object.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/PoolAllocator.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/ProxyAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Random.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/StackAllocator.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Timer.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/TimeStamp.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/AnimatedSprite.cpp
@@ -101,8 +110,10 @@ list(APPEND SOURCES
 list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Main.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/ActorBase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/ActorStore.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/ContentResolver.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/LevelHandler.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/SfxVoicePool.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.cpp
@@ -150,6 +161,19 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/ToasterShot.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/ConversionJobs.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/ConversionManifest.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Block.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Converter.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Episode.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Level.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Strings.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Text.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Tileset.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/PngWriter.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventSpawner.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.cpp